@@ -4,10 +4,16 @@
 #include "nvg_util.hpp"
 // NanoVG Deko3D渲染器 (NanoVG Deko3D renderer)
 #include "nanovg/deko3d/nanovg_dk.h"
-// STB图像库 (STB image library)
-#include "nanovg/stb_image.h"
 // 语言管理器 (Language manager)
 #include "lang_manager.hpp"
+// 并行应用扫描器 (Parallel application scanner)
+#include "app_scanner.hpp"
+// 应用信息服务 (Title service)
+#include "title_service.hpp"
+// 后台图标解码池 (Background icon decode pool)
+#include "icon_decoder.hpp"
+// 图标纹理图集 (Icon texture atlas)
+#include "icon_atlas.hpp"
 // 原子操作 (Atomic operations)
 #include <atomic>
 // 智能指针 (Smart pointers)
@@ -19,8 +25,12 @@
 
 // 算法库 (Algorithm library)
 #include <algorithm>
+#include <iterator>
 // 范围库 (Ranges library)
 #include <ranges>
+// 哈希表 (Hash tables)
+#include <unordered_map>
+#include <unordered_set>
 
 // 调试模式日志宏定义 (Debug mode log macro definition)
 #ifndef NDEBUG
@@ -41,6 +51,8 @@ std::atomic<size_t> App::scanned_count{0};
 std::atomic<size_t> App::total_count{0};
 // 标记扫描是否正在运行 (Flag indicating if scanning is running)
 std::atomic<bool> App::is_scan_running{true};
+// 标记大小计算是否正在运行，只限制依赖大小的操作 (Flag indicating if the size pass is running, only gates size-dependent actions)
+std::atomic<bool> App::is_size_pass_running{false};
 // 保护应用条目列表的互斥锁 (Mutex to protect application entries list)
 std::mutex App::entries_mutex;
 
@@ -50,56 +62,51 @@ namespace {
 
 
 
-// 感谢Shchmue的贡献 (Thank you Shchmue ^^)
-// 应用程序占用空间条目结构体 (Application occupied size entry structure)
-struct ApplicationOccupiedSizeEntry {
-    std::uint8_t storageId;        // 存储设备ID (Storage device ID)
-    std::uint64_t sizeApplication; // 应用程序本体大小 (Application base size)
-    std::uint64_t sizePatch;       // 补丁大小 (Patch size)
-    std::uint64_t sizeAddOnContent; // 追加内容大小 (Add-on content size)
-};
-
-// 应用程序占用空间结构体 (Application occupied size structure)
-struct ApplicationOccupiedSize {
-    ApplicationOccupiedSizeEntry entry[4]; // 最多4个存储设备的条目 (Up to 4 storage device entries)
-};
-
 // 屏幕尺寸常量 (Screen dimension constants)
 constexpr float SCREEN_WIDTH = 1280.f;  // 屏幕宽度 (Screen width)
 constexpr float SCREEN_HEIGHT = 720.f;  // 屏幕高度 (Screen height)
 constexpr int BATCH_SIZE = 4; // 首批加载的应用数量 (Initial batch size for loading apps)
 
-// 验证JPEG数据完整性的辅助函数
-// Helper function to validate JPEG data integrity
-bool IsValidJpegData(const std::vector<unsigned char>& data) {
-    if (data.size() < 4) return false;
-    
-    // 检查JPEG文件头和文件尾
-    // Check JPEG file header and trailer
-    bool has_jpeg_header = (data[0] == 0xFF && data[1] == 0xD8);
-    bool has_jpeg_trailer = (data[data.size()-2] == 0xFF && data[data.size()-1] == 0xD9);
-    return has_jpeg_header && has_jpeg_trailer;
+// 逐个卸载应用，每卸载一个产出一条结果；每次恢复时检查是否需要停止
+// Uninstall titles one by one, yielding a result for each; checks for a stop request every time it resumes
+util::Generator<DeleteResult> DeleteTitles(std::stop_token stop_token, std::vector<AppID> entries) {
+    for (const AppID app_id : entries) {
+        if (stop_token.stop_requested()) {
+            co_return;
+        }
+        // 执行删除操作并记录耗时 (Execute the deletion and record its latency)
+        const auto title_start = std::chrono::steady_clock::now();
+        const auto result = GetTitleService().DeleteApplicationCompletely(app_id);
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - title_start);
+        co_yield DeleteResult{app_id, R_FAILED(result), latency};
+    }
 }
 
-
-// 异步删除应用程序函数 (Asynchronous application deletion function)
-void NsDeleteAppsAsync(std::stop_token stop_token, NsDeleteData&& data) {
-    // 遍历所有要删除的应用条目 (Iterate through all application entries to delete)
-    for (const auto&p : data.entries) {
-        // 先执行删除操作 (Execute deletion operation first)
-        const auto result = nsDeleteApplicationCompletely(p);
-        if (R_FAILED(result)) {
-            data.del_cb(true);  // 删除失败回调 (Deletion failure callback)
-        } else {
-            data.del_cb(false); // 删除成功回调 (Deletion success callback)
+// 删除协程：把每条结果无锁地发布给渲染线程，列表更新和存储空间刷新不在此线程进行
+// Deletion coroutine: posts each result to the render thread without locking; list updates and storage refreshes happen off this thread
+util::Task<void> DeleteAppsTask(std::stop_token stop_token, std::vector<AppID> entries, DeleteChannel& channel, util::ThreadPool& pool) {
+    [[maybe_unused]] const auto delete_start = std::chrono::steady_clock::now(); // 用于调试计时 (For debug timing)
+    const std::size_t total = entries.size();
+    std::size_t deleted = 0;
+    bool stopped = false;
+    for (const auto& result : DeleteTitles(stop_token, std::move(entries))) {
+        // 通道已满时挂起，渲染线程取出结果后在线程池上恢复；请求停止也会恢复协程，这条结果由回到列表时的增量刷新补上
+        // Suspend while the channel is full, the render thread's drain resumes the coroutine on the pool; a stop request
+        // resumes it too, and the incremental refresh back on the list picks up this result
+        while (!channel.try_push(result)) {
+            if (!co_await channel.wait_for_space(pool, stop_token)) {
+                stopped = true;
+                break;
+            }
         }
-        
-        // 删除完成后检查是否需要停止 (Check if stop is requested after deletion completes)
-        if (stop_token.stop_requested()) {
-            return;
+        if (stopped) {
+            break;
         }
+        deleted++;
     }
-    data.done_cb(); // 所有删除操作完成回调 (All deletion operations completed callback)
+    LOG("删除完成 (Delete finished): %zu/%zu titles, %lld ms\n", deleted, total,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - delete_start).count()));
+    channel.close(!stopped && deleted == total);
 }
 
 // 来自游戏卡安装器的脉冲颜色结构体 (Pulse color structure from gamecard installer)
@@ -153,111 +160,106 @@ std::string FormatStorageSize(std::size_t size_bytes) {
     }
 }
 
-// ResourceLoadManager 实现 (ResourceLoadManager implementation)
-// 资源加载管理器的具体实现 (Concrete implementation of resource load manager)
-void ResourceLoadManager::submitLoadTask(const ResourceLoadTask& task) { // 提交加载任务 (Submit loading task)
-    std::scoped_lock lock{task_mutex}; // 获取互斥锁保护任务队列 (Acquire mutex lock to protect task queue)
-    pending_tasks.push(task); // 将任务添加到待处理队列 (Add task to pending queue)
-}
+namespace {
 
-void ResourceLoadManager::processFrameLoads() { // 处理每帧的加载任务 (Process loading tasks per frame)
-    int icon_loads_this_frame = 0; // 当前帧已加载的图标数量 (Number of icons loaded in current frame)
-    
-    std::scoped_lock lock{task_mutex}; // 获取互斥锁保护任务队列 (Acquire mutex lock to protect task queue)
-    
-    // 处理任务，只对图标任务限制每帧最多2个 (Process tasks, only limit icon tasks to max 2 per frame)
-    // 这样可以避免图标加载造成的帧率下降 (This prevents frame rate drops caused by icon loading)
-    while (!pending_tasks.empty()) { // 当队列不为空时继续处理 (Continue processing while queue is not empty)
-        auto task = pending_tasks.top(); // 获取优先级最高的任务 (Get highest priority task)
-        
-        // 如果是图标任务且已达到每帧图标加载限制，则停止处理图标任务 (If it's an icon task and we've reached the per-frame icon loading limit, stop processing icon tasks)
-        // 但仍然尝试处理其他类型的任务以保持响应性 (But still try to process other types of tasks to maintain responsiveness)
-        if (task.task_type == ResourceTaskType::ICON && icon_loads_this_frame >= MAX_ICON_LOADS_PER_FRAME) {
-            // 检查是否还有非图标任务可以处理 (Check if there are non-icon tasks that can be processed)
-            // 这确保了非图标任务不会被图标任务阻塞 (This ensures non-icon tasks are not blocked by icon tasks)
-            std::vector<ResourceLoadTask> temp_tasks; // 临时存储任务的容器 (Temporary container for storing tasks)
-            bool found_non_icon = false; // 是否找到非图标任务的标志 (Flag indicating if non-icon task is found)
-            
-            // 临时移除任务来查找非图标任务 (Temporarily remove tasks to find non-icon tasks)
-            // 这是一个线性搜索过程，但任务队列通常不会很大 (This is a linear search process, but task queue is usually not large)
-            while (!pending_tasks.empty()) {
-                auto temp_task = pending_tasks.top(); // 获取队列顶部任务 (Get top task from queue)
-                pending_tasks.pop(); // 从队列中移除任务 (Remove task from queue)
-                temp_tasks.push_back(temp_task); // 添加到临时容器 (Add to temporary container)
-                
-                if (temp_task.task_type != ResourceTaskType::ICON) { // 如果不是图标任务 (If it's not an icon task)
-                    found_non_icon = true; // 标记找到非图标任务 (Mark that non-icon task is found)
-                    task = temp_task; // 使用找到的非图标任务 (Use the found non-icon task)
-                    temp_tasks.pop_back(); // 移除找到的非图标任务 (Remove the found non-icon task)
-                    break; // 跳出搜索循环 (Break out of search loop)
-                }
-            }
-            
-            // 将临时移除的任务放回队列 (Put temporarily removed tasks back to queue)
-            // 保持任务队列的完整性 (Maintain integrity of task queue)
-            for (const auto& temp_task : temp_tasks) {
-                pending_tasks.push(temp_task); // 重新添加到队列 (Re-add to queue)
-            }
-            
-            if (!found_non_icon) { // 如果没有找到非图标任务 (If no non-icon task is found)
-                break; // 没有可处理的任务，退出循环 (No processable tasks, exit loop)
-            }
-        } else {
-            pending_tasks.pop(); // 从队列中移除当前任务 (Remove current task from queue)
-        }
-        
-        // 执行加载任务 (Execute loading task)
-        // 调用任务的回调函数来执行实际的加载操作 (Call task's callback function to perform actual loading operation)
-        if (task.load_callback) { // 如果回调函数存在 (If callback function exists)
-            task.load_callback(); // 执行回调函数 (Execute callback function)
-        }
-        
-        // 只对图标任务计数 (Only count icon tasks)
-        // 这样可以准确控制每帧的图标加载数量 (This allows accurate control of icon loading count per frame)
-        if (task.task_type == ResourceTaskType::ICON) {
-            icon_loads_this_frame++; // 增加图标加载计数 (Increment icon loading count)
-        }
+// 文本缓存中各类容量文本的标签 (Tags of the size strings kept in the text cache)
+enum SizeTextTag : u8 {
+    SIZE_TEXT_NAND,     // 列表行的NAND容量 (NAND size of a list row)
+    SIZE_TEXT_SD,       // 列表行的SD卡容量 (SD size of a list row)
+    SIZE_TEXT_TOTAL,    // 列表行的总容量 (Total size of a list row)
+    SIZE_TEXT_PLUS,     // 侧栏带加号的容量 (Side panel size with a plus sign)
+    SIZE_TEXT_FREE,     // 侧栏的可用空间 (Side panel free space)
+};
+
+// 列表行的容量，100以上不保留小数 (Size shown in a list row, no decimal from 100 up)
+std::string FormatRowSize(std::size_t size) {
+    char buffer[32];
+    if (size >= 1024 * 1024 * 1024) {
+        const float size_in_gb = static_cast<float>(size) / static_cast<float>(1024*1024*1024);
+        snprintf(buffer, sizeof(buffer), size >= 1024ULL * 1024ULL * 1024ULL * 100ULL ? "%.0f GB" : "%.1f GB", size_in_gb);
+    } else {
+        const float size_in_mb = static_cast<float>(size) / static_cast<float>(1024*1024);
+        snprintf(buffer, sizeof(buffer), size >= 1024 * 1024 * 100 ? "%.0f MB" : "%.1f MB", size_in_mb);
     }
+    return std::string(buffer);
+}
+
+// 以下函数返回文本缓存中的字符串，相同的容量每帧只查找不再格式化
+// The functions below return strings from the text cache, so an unchanged size is looked up instead of formatted every frame
+
+// 列表行的存储位置和容量，容量为0时显示"-----" (Storage name and size of a list row, "-----" when the size is 0)
+const char* RowSizeText(SizeTextTag tag, const char* name, std::size_t size) {
+    return gfx::getTextCache().Format(gfx::TextCache::Key(tag, size), [name, size] {
+        return std::string(name) + ": " + (size == 0 ? std::string("-----") : FormatRowSize(size));
+    });
+}
+
+// 列表行的总容量 (Total size of a list row)
+const char* TotalSizeText(std::size_t size) {
+    return gfx::getTextCache().Format(gfx::TextCache::Key(SIZE_TEXT_TOTAL, size), [size] {
+        return FormatRowSize(size);
+    });
 }
 
-bool ResourceLoadManager::hasPendingTasks() const { // 检查是否有待处理任务 (Check if there are pending tasks)
-    std::scoped_lock lock{task_mutex}; // 获取互斥锁保护任务队列 (Acquire mutex lock to protect task queue)
-    return !pending_tasks.empty(); // 返回队列是否非空 (Return whether queue is not empty)
+// 侧栏带加号的容量 (Side panel size with a plus sign)
+const char* PlusSizeText(std::size_t size) {
+    return gfx::getTextCache().Format(gfx::TextCache::Key(SIZE_TEXT_PLUS, size), [size] {
+        return plus_sign + FormatStorageSize(size);
+    });
 }
 
-size_t ResourceLoadManager::getPendingTaskCount() const { // 获取待处理任务数量 (Get pending task count)
-    std::scoped_lock lock{task_mutex}; // 获取互斥锁保护任务队列 (Acquire mutex lock to protect task queue)
-    return pending_tasks.size(); // 返回队列大小 (Return queue size)
+// 侧栏的可用空间 (Side panel free space)
+const char* FreeSpaceText(std::size_t size) {
+    return gfx::getTextCache().Format(gfx::TextCache::Key(SIZE_TEXT_FREE, size), [size] {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.1f GB", static_cast<float>(size) / static_cast<float>(0x40000000));
+        return std::string(buffer);
+    });
 }
 
+} // namespace
+
 void App::Loop() { // 应用程序主循环方法 (Application main loop method)
-    // 60FPS限制：每帧16.666667毫秒 (Frame rate limit: 16.666667ms per frame for 60FPS)
-    // 这确保了游戏在Switch上的流畅运行 (This ensures smooth gameplay on Switch)
-    constexpr auto target_frame_time = std::chrono::microseconds(16667); // 1/60秒 (1/60 second)
+    // 帧率由FramePacer限制到显示器的60Hz (The frame rate is held to the display's 60Hz by FramePacer)
     auto last_frame_time = std::chrono::steady_clock::now(); // 记录上一帧的时间戳 (Record timestamp of last frame)
     
     // 主循环：持续运行直到退出或applet停止 (Main loop: continue running until quit or applet stops)
     // appletMainLoop()检查Switch系统是否允许应用继续运行 (appletMainLoop() checks if Switch system allows app to continue)
     while (!this->quit && appletMainLoop()) {
-        auto frame_start = std::chrono::steady_clock::now(); // 记录当前帧开始时间 (Record current frame start time)
+        const u64 frame_begin_tick = armGetSystemTick(); // 记录当前帧开始时间 (Record current frame start time)
+        this->profiler.BeginFrame(); // 开始记录本帧各阶段耗时 (Start timing the phases of this frame)
         
         // 执行每帧的核心操作 (Execute core operations per frame)
-        this->Poll(); // 处理输入事件 (Process input events)
-        this->Update(); // 更新游戏逻辑 (Update game logic)
-        this->Draw(); // 渲染画面 (Render graphics)
-        
-        // 计算帧时间并限制到60FPS (Calculate frame time and limit to 60FPS)
-        // 这是帧率控制的关键部分 (This is the key part of frame rate control)
-        auto frame_end = std::chrono::steady_clock::now(); // 记录当前帧结束时间 (Record current frame end time)
-        auto frame_duration = frame_end - frame_start; // 计算帧处理耗时 (Calculate frame processing time)
+        {
+            FrameProfiler::Scope scope{this->profiler, ProfilePhase::Poll};
+            this->Poll(); // 处理输入事件 (Process input events)
+        }
+        {
+            FrameProfiler::Scope scope{this->profiler, ProfilePhase::Update};
+            this->Update(); // 更新游戏逻辑 (Update game logic)
+        }
+        // 画面没有变化时跳过绘制和提交，屏幕继续显示上一帧 (Skip drawing and submitting when nothing changed, the screen keeps showing the last frame)
+        if (this->ShouldDraw()) {
+            FrameProfiler::Scope scope{this->profiler, ProfilePhase::Draw};
+            this->Draw(); // 渲染画面 (Render graphics)
+            this->drawn_sources = this->CurrentFrameSources();
+            this->frame_dirty = false;
+            this->frames_since_draw = 0;
+        } else {
+            this->frames_since_draw++;
+            this->skipped_frames++;
+            this->profiler.AddCount(ProfileCounter::SkippedFrames, 1);
+        }
+
+        // 休眠前查询GPU栅栏，记录本帧GPU耗时 (Poll the GPU fences before sleeping to time this frame's GPU work)
+        this->pollCommandFences();
         
-        // 如果帧处理时间少于目标时间，则休眠剩余时间 (If frame processing time is less than target, sleep for remaining time)
-        // 这确保了稳定的60FPS帧率 (This ensures stable 60FPS frame rate)
-        if (frame_duration < target_frame_time) {
-            auto sleep_time = target_frame_time - frame_duration; // 计算需要休眠的时间 (Calculate sleep time needed)
-            auto sleep_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(sleep_time).count(); // 转换为纳秒 (Convert to nanoseconds)
-            svcSleepThread(sleep_ns); // 使用Switch系统调用进行精确休眠 (Use Switch system call for precise sleep)
+        // 等待下一次垂直同步，下一帧在垂直同步后立即采样输入 (Wait for the next vsync, the next frame samples input right after it)
+        {
+            FrameProfiler::Scope scope{this->profiler, ProfilePhase::Sleep};
+            this->frame_pacer.WaitNextFrame(frame_begin_tick);
         }
+        this->profiler.EndFrame(); // 写入最近帧的环形缓冲区 (Store the frame in the recent-frame ring)
         
         // 计算实际FPS (Calculate actual FPS) - 在延时后计算以获得准确的帧时间
         // 这用于性能监控和调试 (This is used for performance monitoring and debugging)
@@ -290,6 +292,34 @@ void Controller::UpdateButtonHeld(bool& down, bool held) { // 更新按钮长按
     }
 }
 
+// 当前画面内容来源的快照 (Snapshot of what the frame currently shows)
+App::FrameSources App::CurrentFrameSources() const {
+    return FrameSources{
+        .menu_mode = this->menu_mode,
+        .title_list_version = this->title_list.Acquire()->version,
+        .scanned_count = scanned_count.load(),
+        .total_count = total_count.load(),
+        .scan_running = is_scan_running.load(),
+        .size_pass_running = is_size_pass_running.load(),
+        .delete_running = this->delete_thread.valid(),
+        .delete_finished = this->delete_progress.finished,
+        .delete_index = this->delete_progress.index,
+        .deleted_nand_bytes = this->delete_progress.deleted_nand_bytes,
+        .deleted_sd_bytes = this->delete_progress.deleted_sd_bytes,
+    };
+}
+
+// 判断本帧是否需要绘制：有输入或事件、显示的数据变化，或空闲刷新间隔已到
+// Whether this frame needs drawing: input or an event arrived, the shown data changed, or the idle refresh interval elapsed
+bool App::ShouldDraw() const {
+    if (this->frame_dirty || this->CurrentFrameSources() != this->drawn_sources) {
+        return true;
+    }
+    // 脉冲边框和帧耗时图表只在空闲刷新时推进 (The pulse border and frame graph only move on idle refreshes)
+    const bool animated = this->menu_mode != MenuMode::LOAD || this->profiler.IsOverlayVisible();
+    return animated && this->frames_since_draw + 1 >= IDLE_REDRAW_FRAMES;
+}
+
 void App::Poll() { // 输入事件轮询方法 (Input event polling method)
     // 输入事件处理时间限制：最大3毫秒，防止复杂输入处理影响帧率 (Input processing time limit: max 3ms to prevent complex input handling from affecting frame rate)
     // 这确保了即使在复杂输入处理时也能维持60FPS (This ensures 60FPS is maintained even during complex input processing)
@@ -300,6 +330,24 @@ void App::Poll() { // 输入事件轮询方法 (Input event polling method)
 
     const auto down = padGetButtonsDown(&this->pad); // 获取本帧新按下的按钮 (Get buttons pressed this frame)
     const auto held = padGetButtons(&this->pad); // 获取当前持续按住的按钮 (Get buttons currently held)
+    this->frame_pacer.InputSampled(down != 0); // 新按键从这里开始计算延迟 (Latency of a new press is measured from here)
+
+    // 触摸屏只使用第一个触点 (Only the first touch point is used)
+    HidTouchScreenState touch_state{};
+    this->controller.TOUCH = hidGetTouchScreenStates(&touch_state, 1) && touch_state.count > 0;
+    if (this->controller.TOUCH) {
+        this->controller.touch_x = static_cast<float>(touch_state.touches[0].x);
+        this->controller.touch_y = static_cast<float>(touch_state.touches[0].y);
+    }
+
+    // 有按键或触摸时本帧需要重绘，松开后的第一帧也重绘一次 (Redraw while any button or touch is down, and once more on the frame it is released)
+    static u64 prev_held = 0;
+    static bool prev_touch = false;
+    if (down || held || prev_held || this->controller.TOUCH || prev_touch) {
+        this->MarkDirty();
+    }
+    prev_held = held;
+    prev_touch = this->controller.TOUCH;
 
     // 检查是否超时，如果超时则跳过复杂的按键处理 (Check for timeout, skip complex key processing if timed out)
     // 这是第一个超时检查点，确保基础输入获取不会超时 (This is the first timeout checkpoint, ensuring basic input acquisition doesn't timeout)
@@ -341,6 +389,11 @@ void App::Poll() { // 输入事件轮询方法 (Input event polling method)
     } else {
         this->controller.RIGHT_AND_A = false;
     }
+
+    // 分析器组合键：两个摇杆键同时按住，其中一个是本帧新按下的 (Profiler combos: both stick buttons held, one of them newly pressed)
+    const bool sticks_held = (held & HidNpadButton_StickL) && (held & HidNpadButton_StickR);
+    this->controller.PROFILER_TOGGLE = sticks_held && (down & (HidNpadButton_StickL | HidNpadButton_StickR));
+    this->controller.PROFILER_DUMP = (held & HidNpadButton_Minus) && (down & HidNpadButton_StickR);
     
     // 再次检查时间，避免方向键处理超时 (Check time again to avoid directional key processing timeout)
     // 这是第二个超时检查点，确保方向键处理有足够时间 (This is the second timeout checkpoint, ensuring directional key processing has enough time)
@@ -391,11 +444,49 @@ void App::Poll() { // 输入事件轮询方法 (Input event polling method)
 // App::Update() - 应用程序主更新方法 (Main application update method)
 // 每帧调用一次，处理应用程序的核心逻辑更新 (Called once per frame to handle core application logic updates)
 void App::Update() {
+    // 分析器组合键 (Profiler combos)
+    if (this->controller.PROFILER_TOGGLE) {
+        this->profiler.ToggleOverlay();
+    }
+    if (this->controller.PROFILER_DUMP) {
+        const bool dumped = this->profiler.DumpChromeTrace("sdmc:/config/Untitled/frame_trace.json");
+        const bool reported = this->frame_pacer.WriteReport("sdmc:/config/Untitled/frame_pacing.txt");
+        LOG("frame trace dump %s, pacing report %s\n", dumped ? "succeeded" : "failed", reported ? "succeeded" : "failed");
+        (void)dumped;
+        (void)reported;
+    }
+
+    // 推进图标图集的LRU帧计数 (Advance the icon atlas LRU frame counter)
+    this->icon_atlas.BeginFrame();
+
     // 每帧处理资源加载（如果启用） (Process resource loading per frame if enabled)
     // 这个机制用于分散资源加载的CPU负担，避免单帧卡顿 (This mechanism distributes CPU load of resource loading to avoid single frame stuttering)
     if (enable_frame_load_limit) { // 检查是否启用了帧限制资源加载 (Check if frame-limited resource loading is enabled)
+        FrameProfiler::Scope scope{this->profiler, ProfilePhase::FrameLoads};
         resource_manager.processFrameLoads(); // 处理当前帧允许的资源加载任务 (Process resource loading tasks allowed for current frame)
     }
+    // 上传后台解码完成的图标 (Upload icons decoded in the background)
+    {
+        FrameProfiler::Scope scope{this->profiler, ProfilePhase::IconUpload};
+        this->UploadDecodedIcons();
+    }
+    // 图标队列深度和本帧取消、浪费的任务 (Icon queue depth and the tasks cancelled or wasted this frame)
+    {
+        const auto stats = this->resource_manager.getStats();
+        this->profiler.AddCount(ProfileCounter::IconQueueDepth, static_cast<u32>(stats.depth[static_cast<std::size_t>(ResourceTaskType::ICON)]));
+        this->profiler.AddCount(ProfileCounter::IconTasksCancelled, static_cast<u32>(stats.cancelled - this->resource_stats.cancelled));
+        this->profiler.AddCount(ProfileCounter::IconTasksWasted, static_cast<u32>(stats.wasted - this->resource_stats.wasted));
+        this->resource_stats = stats;
+    }
+
+    // 批量移除已卸载的应用，取回最新的存储空间 (Remove uninstalled titles in one batch, pick up the latest storage space)
+    this->ApplyPendingRemovals();
+    // 后台写入方的修改每帧最多发布一次 (The background writers' changes are published at most once a frame)
+    this->FlushTitleList();
+    this->DrainDeleteProgress();
+    if (StorageSpace space{}; this->storage_stats.TakeUpdate(space)) {
+        this->ApplyStorageSpace(space);
+    }
     
     // 根据当前菜单模式执行相应的更新逻辑 (Execute corresponding update logic based on current menu mode)
     // 使用状态机模式管理不同的应用程序状态 (Use state machine pattern to manage different application states)
@@ -404,7 +495,10 @@ void App::Update() {
             this->UpdateLoad(); // 处理应用程序加载逻辑 (Handle application loading logic)
             break;
         case MenuMode::LIST: // 列表模式：显示应用程序列表的主界面 (List mode: main interface showing application list)
+            this->StartIncrementalRefresh(); // 处理待执行的增量刷新 (Handle a pending incremental refresh)
             this->UpdateList(); // 处理应用程序列表的交互和显示 (Handle application list interaction and display)
+            // 脉冲颜色每帧推进，与是否绘制无关 (The pulse colour advances every frame, whether or not it is drawn)
+            update_pulse_colour();
             // 确保当前屏幕图标始终加载，即使用户不移动光标 (Ensure current screen icons are always loaded, even if user doesn't move cursor)
             
             this->LoadVisibleAreaIcons();
@@ -412,6 +506,7 @@ void App::Update() {
             break;
         case MenuMode::CONFIRM: // 确认模式：用户确认操作的对话框状态 (Confirm mode: dialog state for user operation confirmation)
             this->UpdateConfirm(); // 处理确认对话框的逻辑 (Handle confirmation dialog logic)
+            update_pulse_colour();
             // 确保确认界面图标始终加载，即使用户不移动光标 (Ensure confirm interface icons are always loaded, even if user doesn't move cursor)
             this->LoadConfirmVisibleAreaIcons();
             break;
@@ -424,7 +519,14 @@ void App::Draw() {
     // GPU命令优化：准备下一个命令缓冲区 (GPU command optimization: Prepare next command buffer)
     // GPU command optimization: Prepare next command buffer
     // 双缓冲机制，避免GPU等待CPU准备命令 (Double buffering mechanism to avoid GPU waiting for CPU command preparation)
-    this->prepareNextCommandBuffer();
+    {
+        FrameProfiler::Scope scope{this->profiler, ProfilePhase::GpuWait};
+        this->prepareNextCommandBuffer();
+    }
+
+    // 提交本帧排队的纹理上传（图标等），在绑定帧缓冲区之前执行，不等待GPU
+    // Submit texture uploads queued this frame (icons etc.) ahead of the framebuffer binding, without waiting on the GPU
+    this->renderer->FlushUploads();
     
     // 从交换链获取可用的图像槽位 (Acquire available image slot from swapchain)
     // 这是Vulkan/deko3d渲染管线的标准流程 (This is standard Vulkan/deko3d rendering pipeline procedure)
@@ -445,6 +547,7 @@ void App::Draw() {
     // NanoVG渲染命令 (NanoVG rendering commands)
     // NanoVG rendering commands
     // 开始NanoVG帧渲染，设置屏幕尺寸和像素比 (Begin NanoVG frame rendering with screen size and pixel ratio)
+    const u64 record_begin = armGetSystemTick();
     nvgBeginFrame(this->vg, SCREEN_WIDTH, SCREEN_HEIGHT, 1.f);
     
     // 绘制背景元素（标题栏、分割线等） (Draw background elements - title bar, dividers, etc.)
@@ -464,8 +567,26 @@ void App::Draw() {
             break;
     }
 
+    // 记录本帧文本缓存省去的格式化和测量次数 (Record how many formats and measurements the text cache saved this frame)
+    const auto text_stats = gfx::getTextCache().TakeStats();
+    this->profiler.AddCount(ProfileCounter::TextCacheHits, text_stats.hits);
+    this->profiler.AddCount(ProfileCounter::TextCacheMisses, text_stats.misses);
+    const int glyphs_rasterized = nvgFontGlyphsRasterized(this->vg);
+    this->profiler.AddCount(ProfileCounter::GlyphRasterizations, static_cast<u32>(glyphs_rasterized - this->glyphs_rasterized));
+    this->glyphs_rasterized = glyphs_rasterized;
+
+    // 帧耗时图表绘制在最上层 (The frame graph draws on top of everything)
+    if (this->profiler.IsOverlayVisible()) {
+        this->profiler.DrawOverlay(this->vg);
+    }
+
     // 结束NanoVG帧渲染，提交所有绘制命令到GPU (End NanoVG frame rendering, submit all draw commands to GPU)
     nvgEndFrame(this->vg);
+    this->profiler.AddPhase(ProfilePhase::Record, record_begin, armGetSystemTick());
+
+    // 在命令列表结束前设置同步点，栅栏在本帧所有已提交的GPU工作完成后触发
+    // Signal the fence before the list is finished, so it fires once all GPU work submitted this frame completes
+    current_cmdbuf.signalFence(this->command_fences[this->current_cmdbuf_index]);
     
     // 完成动态命令列表记录 (Finish dynamic command list recording)
     // Finish dynamic command list recording
@@ -481,6 +602,7 @@ void App::Draw() {
     // Present image
     // 将渲染结果显示到屏幕上 (Display rendering result to screen)
     this->queue.presentImage(this->swapchain, slot);
+    this->frame_pacer.Presented();
 } // App::Draw()方法结束 (End of App::Draw() method)
 
 // App::DrawBackground() - 绘制应用程序背景界面 (Draw application background interface)
@@ -521,9 +643,7 @@ void App::DrawBackground() {
 // 显示应用程序扫描进度和加载状态信息 (Display application scanning progress and loading status information)
 void App::DrawLoad() {
     // 显示扫描进度 (Display scanning progress)
-    // 使用作用域锁保护共享数据，确保线程安全 (Use scoped lock to protect shared data for thread safety)
-    // 防止在读取loading_text时发生数据竞争 (Prevent data races when reading loading_text)
-    std::scoped_lock lock{entries_mutex};
+    // loading_text只在语言加载时写入，绘制时无需加锁 (loading_text is only written when the language loads, no lock needed to draw it)
     
     // 在屏幕中央显示加载文本 (Display loading text in screen center)
     // 使用黄色突出显示，36px字体大小，居中对齐 (Use yellow highlight, 36px font size, center alignment)
@@ -540,13 +660,29 @@ void App::DrawLoad() {
 // App::DrawList() - 绘制应用程序列表界面 (Draw application list interface)
 // 显示可删除的应用程序列表，包含图标、标题、大小信息和选择状态 (Display deletable application list with icons, titles, size info and selection status)
 void App::DrawList() {
-    std::scoped_lock lock{entries_mutex}; // 保护entries向量的读取操作 (Protect entries vector read operations)
+    // 读取已发布的应用列表视图，绘制期间不加锁 (Read the published title list view, no lock is held while drawing)
+    const auto view = this->title_list.Acquire();
+    const auto& rows = view->rows;
     
     
     // 如果没有应用，显示加载提示 (If no apps, show loading hint)
     // If no apps, show loading hint
     // 处理应用列表为空的边界情况 (Handle edge case when application list is empty)
-    if (this->entries.empty()) {
+    // 搜索过滤时在标题栏显示查询和结果数量 (While a search filters the list, show the query and result count in the title bar)
+    const bool searching = !this->search_query.empty();
+    if (searching) {
+        gfx::drawTextArgs(this->vg, 870.f, 45.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN, search_results.c_str(), this->search_query.c_str(), rows.size());
+    }
+
+    if (rows.empty()) {
+        if (searching) {
+            // 搜索没有结果：B清除搜索，X重新搜索 (No search results: B clears the search, X searches again)
+            gfx::drawButtons(this->vg,
+                gfx::Colour::WHITE,
+                gfx::pair{gfx::Button::B, button_clear.c_str()},
+                gfx::pair{gfx::Button::X, button_search.c_str()});
+            return;
+        }
         // 在屏幕中央显示加载提示文本 (Display loading hint text in screen center)
         gfx::drawTextBoxCentered(this->vg, 0.f, 0.f, 1280.f, 720.f, 35.f, 1.5f, no_app_found.c_str(), nullptr, gfx::Colour::SILVER);
         gfx::drawButtons(this->vg, 
@@ -605,16 +741,10 @@ void App::DrawList() {
     // 计算已选中应用在各存储设备上的总容量 (Calculate total capacity of selected apps on each storage device)
     // Calculate total capacity of selected apps on each storage device
     // 统计用户选择删除的应用程序占用的存储空间 (Count storage space occupied by applications selected for deletion)
-    std::size_t selected_nand_total = 0; // NAND内置存储的总占用量 (Total occupation of NAND internal storage)
-    std::size_t selected_sd_total = 0;   // SD卡存储的总占用量 (Total occupation of SD card storage)
-    
-    // 遍历所有应用条目，累计已选中应用的存储占用 (Iterate through all app entries, accumulate storage occupation of selected apps)
-    for (const auto& entry : this->entries) {
-        if (entry.selected) { // 如果当前应用被选中删除 (If current app is selected for deletion)
-            selected_nand_total += entry.size_nand; // 累加NAND存储占用 (Accumulate NAND storage occupation)
-            selected_sd_total += entry.size_sd;     // 累加SD卡存储占用 (Accumulate SD card storage occupation)
-        }
-    }
+    // 视图发布时已累计；大小计算完成前合计不完整，不显示 (Accumulated when the view was published; incomplete until the size pass finishes, so not shown)
+    const bool sizes_ready = !is_size_pass_running;
+    const std::size_t selected_nand_total = sizes_ready ? view->selected_nand : 0; // NAND内置存储的总占用量 (Total occupation of NAND internal storage)
+    const std::size_t selected_sd_total = sizes_ready ? view->selected_sd : 0;     // SD卡存储的总占用量 (Total occupation of SD card storage)
 
 
     /**
@@ -647,7 +777,7 @@ void App::DrawList() {
         // 绘制"可用空间"文本 (Draw "available space" text)
         gfx::drawText(this->vg, x, y + 60.f, 20.f, space_available.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE);
         // 绘制可用空间大小(GB) (Draw available space size in GB)
-        gfx::drawTextArgs(this->vg, x + 315.f, y + 60.f, 24.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::WHITE, "%.1f GB", static_cast<float>(storage_free) / static_cast<float>(0x40000000));
+        gfx::drawText(this->vg, x + 315.f, y + 60.f, 24.f, FreeSpaceText(storage_free), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::WHITE);
         
     };
     
@@ -664,26 +794,30 @@ void App::DrawList() {
     // 显示NAND选中应用的总容量 (Display total capacity of selected NAND apps)
     if (selected_nand_total > 0){
             gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 56.f + 85.f, 20.f, total_selected.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
-            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, (plus_sign + FormatStorageSize(selected_nand_total)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
+            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, PlusSizeText(selected_nand_total), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
         }
     
     // 显示SD卡选中应用的总容量 (Display total capacity of selected SD apps)
     if (selected_sd_total > 0){
             gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 235.f + 85.f, 20.f, total_selected.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
-            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, (plus_sign + FormatStorageSize(selected_sd_total)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
+            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, PlusSizeText(selected_sd_total), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
     }
     
     // 保存当前绘图状态并设置裁剪区域 (Save current drawing state and set clipping area)
     nvgSave(this->vg);
-    nvgScissor(this->vg, 30.f, 86.0f, 1220.f, 646.0f); // 裁剪区域 (Clipping area)
+    // 裁剪到4行视口及选中边框，滚动中部分可见的行在上下边缘被裁剪 (Clip to the 4-row viewport plus the cursor border, partially visible rows are cut at the edges while scrolling)
+    const float list_bottom = LIST_TOP + BOX_HEIGHT * LIST_ROWS;
+    nvgScissor(this->vg, 30.f, LIST_TOP - 5.f, 1220.f, list_bottom - LIST_TOP + 10.f);
 
     // 列表项绘制的X坐标常量 (X coordinate constant for list item drawing)
     static constexpr auto x = 90.f;
-    // 列表项绘制的Y坐标偏移量 (Y coordinate offset for list item drawing)
-    auto y = this->yoff;
+    // 从视口顶部第一个可见的行开始，按连续偏移定位 (Start from the first row visible at the viewport top, placed by the continuous offset)
+    const auto first_row = static_cast<std::size_t>(this->list_scroll.Offset() / BOX_HEIGHT);
+    auto y = LIST_TOP + this->list_scroll.RowTop(first_row);
+    const bool scrolling = this->list_scroll.IsMoving();
 
     // 遍历并绘制应用列表项 (Iterate and draw application list items)
-    for (size_t i = this->start; i < this->entries.size(); i++) {     
+    for (size_t i = first_row; i < rows.size(); i++) {     
         // 检查是否为当前光标选中的项 (Check if this is the currently cursor-selected item)
         if (i == this->index) {
             // 当前选中项：绘制彩色边框和黑色背景 (Current selected item: draw colored border and black background)
@@ -692,7 +826,6 @@ void App::DrawList() {
             col.g /= 255.f;        // 绿色通道归一化 (Normalize green channel)
             col.b /= 255.f;        // 蓝色通道归一化 (Normalize blue channel)
             col.a = 1.f;           // 设置不透明度为1(完全不透明) (Set alpha to 1 - fully opaque)
-            update_pulse_colour(); // 更新脉冲颜色(产生闪烁效果) (Update pulse color for blinking effect)
             // 绘制选中项的彩色边框 (Draw colored border for selected item)
             gfx::drawRect(this->vg, x - 5.f, y - 5.f, box_width + 10.f, box_height + 10.f, col);
             // 绘制选中项的黑色背景 (Draw black background for selected item)
@@ -700,7 +833,7 @@ void App::DrawList() {
         }
 
         // 检查是否为用户已选择删除的项 (Check if this item is selected for deletion by user)
-        if (this->entries[i].selected) {
+        if (rows[i].selected) {
             // 已选择项：绘制选择标记 (Selected item: draw selection marker)
             // 在列表项左侧绘制青色勾选图标 (Draw cyan checkmark icon on the left side of the list item)
             gfx::drawText(this->vg, x - 60.f, y + (box_height / 2.f) - (48.f / 2), 48.f, "\ue14b", nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
@@ -711,73 +844,49 @@ void App::DrawList() {
         gfx::drawRect(this->vg, x, y + box_height, box_width, 1.f, gfx::Colour::DARK_GREY);
 
         // 创建并绘制应用图标 (Create and draw application icon)
-        const auto icon_paint = nvgImagePattern(this->vg, x + icon_spacing, y + icon_spacing, 90.f, 90.f, 0.f, this->entries[i].image, 1.f);
+        // 图标在图集中时引用其槽位，否则使用默认图标 (Reference the atlas slot when resident, otherwise the default icon)
+        NVGpaint icon_paint;
+        const bool icon_resident = this->icon_atlas.GetPaint(this->vg, rows[i].id, x + icon_spacing, y + icon_spacing, 90.f, 90.f, icon_paint);
+        if (!icon_resident) {
+            icon_paint = nvgImagePattern(this->vg, x + icon_spacing, y + icon_spacing, 90.f, 90.f, 0.f, this->default_icon_image, 1.f);
+        }
+        // 统计滚动中缺少图标的行，衡量预取效果 (Count rows missing their icon while scrolling, measuring prefetch)
+        if (scrolling) {
+            this->fling_rows_drawn++;
+            this->fling_icon_misses += icon_resident ? 0 : 1;
+            this->profiler.AddCount(ProfileCounter::FlingRows, 1);
+            this->profiler.AddCount(ProfileCounter::FlingIconMisses, icon_resident ? 0 : 1);
+        }
         gfx::drawRect(this->vg, x + icon_spacing, y + icon_spacing, 90.f, 90.f, icon_paint);
 
         // 保存当前绘图状态并设置文本裁剪区域 (Save current drawing state and set text clipping area)
         nvgSave(this->vg);
         nvgScissor(this->vg, x + title_spacing_left, y, 585.f, box_height); // clip
         // 绘制应用名称，防止文本溢出 (Draw application name, preventing text overflow)
-        gfx::drawText(this->vg, x + title_spacing_left, y + title_spacing_top, 24.f, this->entries[i].name.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE);
+        gfx::drawText(this->vg, x + title_spacing_left, y + title_spacing_top, 24.f, rows[i].name.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE);
         // 恢复之前保存的绘图状态 (Restore previously saved drawing state)
         nvgRestore(this->vg);
 
         // 定义绘制存储大小信息的lambda函数 (Define lambda function to draw storage size information)
-        const auto draw_size = [&](float x_offset, size_t size, const char* name) {
-            if (size == 0) {
-                // 存储大小为0时显示"---" (Show "---" when storage size is 0)
-                gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: -----", name);
-            } else {
-                if (size >= 1024 * 1024 * 1024) {
-                    if (size >= 1024ULL * 1024ULL * 1024ULL * 100ULL) { // no decimal
-                        // 大于100GB时显示整数GB (Show integer GB when larger than 100GB)
-                        gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: %.0f %s", name, static_cast<float>(size) / static_cast<float>(1024*1024*1024), "GB");
-                    } else { // use decimal
-                        // 小于100GB时显示一位小数GB (Show one decimal place GB when less than 100GB)
-                        gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: %.1f %s", name, static_cast<float>(size) / static_cast<float>(1024*1024*1024), "GB");
-                    }
-                } else {
-                    if (size >= 1024 * 1024 * 100) { // no decimal
-                        // 大于100MB时显示整数MB (Show integer MB when larger than 100MB)
-                        gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: %.0f %s", name, static_cast<float>(size) / static_cast<float>(1024*1024), "MB");
-                    } else { // use decimal
-                        // 小于100MB时显示一位小数MB (Show one decimal place MB when less than 100MB)
-                        gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: %.1f %s", name, static_cast<float>(size) / static_cast<float>(1024*1024), "MB");
-                    }
-                }
-            }
+        const auto draw_size = [&](float x_offset, size_t size, SizeTextTag tag, const char* name) {
+            // 容量为0时显示"-----"，100以上不保留小数 (Shows "-----" for 0, no decimal from 100 up)
+            gfx::drawText(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, RowSizeText(tag, name, size), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER);
         };
 
         
         // 绘制NAND存储大小信息 (Draw NAND storage size information)
-        draw_size(0.f, this->entries[i].size_nand, storage_nand.c_str());
+        draw_size(0.f, rows[i].size_nand, SIZE_TEXT_NAND, storage_nand.c_str());
         // 绘制SD卡存储大小信息 (Draw SD card storage size information)
-        draw_size(200.f, this->entries[i].size_sd, storage_sd.c_str());
+        draw_size(200.f, rows[i].size_sd, SIZE_TEXT_SD, storage_sd.c_str());
 
         // 绘制应用总大小信息 (Draw application total size information)
-        if (this->entries[i].size_total >= 1024 * 1024 * 1024) {
-            if (this->entries[i].size_total >= 1024ULL * 1024ULL * 1024ULL * 100ULL) { // no decimal
-                // 大于100GB时显示整数GB (Show integer GB when larger than 100GB)
-                gfx::drawTextArgs(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN, "%.0f GB", static_cast<float>(this->entries[i].size_total) / static_cast<float>(1024*1024*1024));
-            } else { // use decimal
-                // 小于100GB时显示一位小数GB (Show one decimal place GB when less than 100GB)
-                gfx::drawTextArgs(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN, "%.1f GB", static_cast<float>(this->entries[i].size_total) / static_cast<float>(1024*1024*1024));
-            }
-        } else {
-            if (this->entries[i].size_total >= 1024 * 1024 * 100) { // no decimal
-                // 大于100MB时显示整数MB (Show integer MB when larger than 100MB)
-                gfx::drawTextArgs(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN, "%.0f MB", static_cast<float>(this->entries[i].size_total) / static_cast<float>(1024*1024));
-            } else { // use decimal
-                // 小于100MB时显示一位小数MB (Show one decimal place MB when less than 100MB)
-                gfx::drawTextArgs(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN, "%.1f MB", static_cast<float>(this->entries[i].size_total) / static_cast<float>(1024*1024));
-            }
-        }
+        gfx::drawText(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, TotalSizeText(rows[i].size_total), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
 
         // 更新Y坐标为下一项位置 (Update Y coordinate to next item position)
         y += box_height;
 
         // 超出可视区域时停止绘制 (Stop drawing when out of visible area)
-        if ((y + box_height) > 646.f) {
+        if (y >= list_bottom) {
             break;
         }
     }
@@ -804,23 +913,23 @@ void App::DrawList() {
           nvgTextAlign(this->vg, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP); // 设置文本对齐方式 (Set text alignment)
           float x = 1220.f; // 起始X坐标 (Starting X coordinate)
           const float y = 675.f; // 固定Y坐标 (Fixed Y coordinate)
-          float bounds[4]{};
 
           // 定义所有按钮数组 (Define all buttons array)
-          std::array<gfx::pair, 6> buttons = {
+          std::array<gfx::pair, 7> buttons = {
               gfx::pair{gfx::Button::A, button_select.c_str()},
               gfx::pair{gfx::Button::B, button_exit.c_str()},
               gfx::pair{gfx::Button::PLUS, button_delete_selected.c_str()},
               gfx::pair{gfx::Button::Y, this->GetSortStr()},
+              gfx::pair{gfx::Button::X, button_search.c_str()},
               gfx::pair{gfx::Button::ZR, button_invert_select.c_str()},
-              this->delete_count == this->entries.size() ? gfx::pair{gfx::Button::ZL, button_deselect_all.c_str()} : gfx::pair{gfx::Button::ZL, button_select_all.c_str()}
+              view->visible_selected == rows.size() ? gfx::pair{gfx::Button::ZL, button_deselect_all.c_str()} : gfx::pair{gfx::Button::ZL, button_select_all.c_str()}
           };
 
           // 遍历绘制所有按钮 (Iterate and draw all buttons)
           for (const auto& [button, text] : buttons) {
               // 根据按钮类型设置颜色 (Set color based on button type)
               gfx::Colour current_color;
-              if (button == gfx::Button::PLUS || button == gfx::Button::Y || button == gfx::Button::ZL || button == gfx::Button::ZR) {
+              if (button == gfx::Button::PLUS || button == gfx::Button::X || button == gfx::Button::ZL || button == gfx::Button::ZR) {
                   current_color = plus_zr_color;
               } else {
                   current_color = button_color;
@@ -829,8 +938,7 @@ void App::DrawList() {
 
               // 绘制按钮文本 (Draw button text)
               nvgFontSize(this->vg, 20.f);
-              nvgTextBounds(this->vg, x, y, text, nullptr, bounds);
-              auto text_len = bounds[2] - bounds[0];
+              auto text_len = gfx::getTextCache().TextWidth(this->vg, 20.f, text);
               nvgText(this->vg, x, y, text, nullptr);
 
               // 向左移动文本宽度 (Move left by text width)
@@ -838,8 +946,7 @@ void App::DrawList() {
 
               // 绘制按钮图标 (Draw button icon)
               nvgFontSize(this->vg, 30.f);
-              nvgTextBounds(this->vg, x, y - 7.f, gfx::getButton(button), nullptr, bounds);
-              auto icon_len = bounds[2] - bounds[0];
+              auto icon_len = gfx::getTextCache().TextWidth(this->vg, 30.f, gfx::getButton(button));
               nvgText(this->vg, x, y - 7.f, gfx::getButton(button), nullptr);
 
               // 向左移动图标宽度 (Move left by icon width)
@@ -851,11 +958,12 @@ void App::DrawList() {
         gfx::drawButtons(this->vg, 
             gfx::Colour::WHITE, 
             gfx::pair{gfx::Button::A, button_select.c_str()}, 
-            gfx::pair{gfx::Button::B, button_exit.c_str()}, 
+            gfx::pair{gfx::Button::B, searching ? button_clear.c_str() : button_exit.c_str()}, 
             gfx::pair{gfx::Button::PLUS, button_delete_selected.c_str()}, 
             gfx::pair{gfx::Button::Y, this->GetSortStr()}, 
+            gfx::pair{gfx::Button::X, button_search.c_str()}, 
             gfx::pair{gfx::Button::ZR, button_invert_select.c_str()}, 
-            this->delete_count == this->entries.size() ? gfx::pair{gfx::Button::ZL, button_deselect_all.c_str()} : gfx::pair{gfx::Button::ZL, button_select_all.c_str()});
+            view->visible_selected == rows.size() ? gfx::pair{gfx::Button::ZL, button_deselect_all.c_str()} : gfx::pair{gfx::Button::ZL, button_select_all.c_str()});
         
     }
 
@@ -863,15 +971,19 @@ void App::DrawList() {
 
 // 绘制卸载确认界面 / Draw uninstall confirmation interface
 void App::DrawConfirm() {
-    std::scoped_lock lock{entries_mutex}; // 保护entries向量的读取操作 (Protect entries vector read operations)
+    // 读取已发布的应用列表视图和本帧的删除进度，绘制期间不加锁
+    // Read the published title list view and this frame's deletion progress, no lock is held while drawing
+    const auto view = this->title_list.Acquire();
+    const auto& rows = view->rows;
+    const auto& progress = this->delete_progress;
 
     // 根据删除线程状态动态设置B键文本 / Dynamically set B key text based on deletion thread status
     // 删除进行中显示"停止"，否则显示"返回" / Show "Stop" during deletion, otherwise show "Back"
-    std::string b_button_text = (this->delete_thread.valid() && !this->finished_deleting) ? button_stop : button_back;
+    std::string b_button_text = (this->delete_thread.valid() && !progress.finished) ? button_stop : button_back;
     
     // 绘制确认界面的操作按钮 / Draw operation buttons for confirmation interface
     // 在删除进行时将RIGHT+A和X按钮设置为灰色 / Set RIGHT+A and X buttons to gray during deletion
-    bool is_deleting = this->delete_thread.valid() && !this->finished_deleting;
+    bool is_deleting = this->delete_thread.valid() && !progress.finished;
     
     gfx::drawButtons2Colored(this->vg, 
         gfx::make_pair2_colored(gfx::Button::RIGHT, gfx::Button::A, button_uninstalled.c_str(), is_deleting ? gfx::Colour::GREY : gfx::Colour::WHITE),
@@ -938,24 +1050,19 @@ void App::DrawConfirm() {
         // 绘制"可用空间"文本
         gfx::drawText(this->vg, x, y + 60.f, 20.f, space_available.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE);
         // 绘制可用空间大小(GB)
-        gfx::drawTextArgs(this->vg, x + 315.f, y + 60.f, 24.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::WHITE, "%.1f GB", static_cast<float>(storage_free) / static_cast<float>(0x40000000));
+        gfx::drawText(this->vg, x + 315.f, y + 60.f, 24.f, FreeSpaceText(storage_free), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::WHITE);
         
     };
     
 
     // 遍历并绘制要卸载的应用列表项（只显示已选择的）
-    // 首先更新selected_indices
-    this->selected_indices.clear();
-    std::size_t total_nand_size = 0;
-    std::size_t total_sd_size = 0;
-    for (size_t i = 0; i < this->entries.size(); i++) {
-        if (this->entries[i].selected) {
-            this->selected_indices.push_back(i);
-            // 计算待删除应用在各存储设备上的总占用大小 (Calculate total size on each storage device)
-            total_nand_size += this->entries[i].size_nand;
-            total_sd_size += this->entries[i].size_sd;
-        }
-    }
+    // 首先更新selected_indices，选中行和待删除总大小在视图发布时已计算
+    // Update selected_indices first, the selected rows and pending totals were computed when the view was published
+    this->selected_indices = view->selected_indices;
+    // 大小计算完成前合计不完整，不显示 (Totals are incomplete until the size pass finishes, so they are not shown)
+    const bool sizes_ready = !is_size_pass_running;
+    const std::size_t total_nand_size = sizes_ready ? view->selected_nand : 0;
+    const std::size_t total_sd_size = sizes_ready ? view->selected_sd : 0;
 
     // 绘制系统内存存储条 (Draw system memory storage bar)
     draw_size(system_memory.c_str(), sidebox_x + 30.f, sidebox_y + 56.f, this->nand_storage_size_total, this->nand_storage_size_free, this->nand_storage_size_used, total_nand_size);
@@ -968,13 +1075,13 @@ void App::DrawConfirm() {
     nvgScissor(this->vg, 30.f, 86.0f, 1220.f, 646.0f); // 裁剪区域
 
     static constexpr auto x = 90.f;
-    auto y = this->yoff; // 初始y坐标
+    auto y = LIST_TOP; // 初始y坐标
     
     
     for (size_t i = this->confirm_start; i < this->selected_indices.size(); i++) {
         const auto entry_index = this->selected_indices[i];
-        if (entry_index >= this->entries.size()) continue; // 安全检查
-        const auto& entry = this->entries[entry_index];
+        if (entry_index >= rows.size()) continue; // 安全检查
+        const auto& entry = rows[entry_index];
         
         if (i == this->confirm_index) {
             // 当前选中项：绘制彩色边框和黑色背景
@@ -983,7 +1090,6 @@ void App::DrawConfirm() {
             col.g /= 255.f;        // 绿色通道归一化
             col.b /= 255.f;        // 蓝色通道归一化
             col.a = 1.f;           // 设置不透明度为1(完全不透明)
-            update_pulse_colour(); // 更新脉冲颜色(产生闪烁效果)
             // 绘制选中项的彩色边框
             gfx::drawRect(this->vg, x - 5.f, y - 5.f, box_width + 10.f, box_height + 10.f, col);
             // 绘制选中项的黑色背景
@@ -995,7 +1101,11 @@ void App::DrawConfirm() {
         gfx::drawRect(this->vg, x, y + box_height, box_width, 1.f, gfx::Colour::DARK_GREY);
 
         // 创建并绘制应用图标 (Create and draw application icon)
-        const auto icon_paint = nvgImagePattern(this->vg, x + icon_spacing, y + icon_spacing, 90.f, 90.f, 0.f, entry.image, 1.f);
+        // 图标在图集中时引用其槽位，否则使用默认图标 (Reference the atlas slot when resident, otherwise the default icon)
+        NVGpaint icon_paint;
+        if (!this->icon_atlas.GetPaint(this->vg, entry.id, x + icon_spacing, y + icon_spacing, 90.f, 90.f, icon_paint)) {
+            icon_paint = nvgImagePattern(this->vg, x + icon_spacing, y + icon_spacing, 90.f, 90.f, 0.f, this->default_icon_image, 1.f);
+        }
         gfx::drawRect(this->vg, x + icon_spacing, y + icon_spacing, 90.f, 90.f, icon_paint);
 
         // 保存当前绘图状态并设置文本裁剪区域 (Save current drawing state and set text clipping area)
@@ -1007,56 +1117,20 @@ void App::DrawConfirm() {
         nvgRestore(this->vg);
 
         // 定义绘制存储大小信息的lambda函数 (Define lambda function to draw storage size information)
-        const auto draw_size = [&](float x_offset, size_t size, const char* name) {
-            if (size == 0) {
-                // 存储大小为0时显示"---" (Show "---" when storage size is 0)
-                gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: -----", name);
-            } else {
-                if (size >= 1024 * 1024 * 1024) {
-                    if (size >= 1024ULL * 1024ULL * 1024ULL * 100ULL) { // no decimal
-                        // 大于100GB时显示整数GB (Show integer GB when larger than 100GB)
-                        gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: %.0f %s", name, static_cast<float>(size) / static_cast<float>(1024*1024*1024), "GB");
-                    } else { // use decimal
-                        // 小于100GB时显示一位小数GB (Show one decimal place GB when less than 100GB)
-                        gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: %.1f %s", name, static_cast<float>(size) / static_cast<float>(1024*1024*1024), "GB");
-                    }
-                } else {
-                    if (size >= 1024 * 1024 * 100) { // no decimal
-                        // 大于100MB时显示整数MB (Show integer MB when larger than 100MB)
-                        gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: %.0f %s", name, static_cast<float>(size) / static_cast<float>(1024*1024), "MB");
-                    } else { // use decimal
-                        // 小于100MB时显示一位小数MB (Show one decimal place MB when less than 100MB)
-                        gfx::drawTextArgs(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, "%s: %.1f %s", name, static_cast<float>(size) / static_cast<float>(1024*1024), "MB");
-                    }
-                }
-            }
+        const auto draw_size = [&](float x_offset, size_t size, SizeTextTag tag, const char* name) {
+            // 容量为0时显示"-----"，100以上不保留小数 (Shows "-----" for 0, no decimal from 100 up)
+            gfx::drawText(this->vg, x + text_spacing_left + x_offset, y + text_spacing_top + 9.f, 22.f, RowSizeText(tag, name, size), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER);
         };
 
         // 绘制NAND存储大小信息 (Draw NAND storage size information)
-        draw_size(0.f, entry.size_nand, storage_nand.c_str());
+        draw_size(0.f, entry.size_nand, SIZE_TEXT_NAND, storage_nand.c_str());
         // 绘制SD卡存储大小信息 (Draw SD card storage size information)
-        draw_size(200.f, entry.size_sd, storage_sd.c_str());
+        draw_size(200.f, entry.size_sd, SIZE_TEXT_SD, storage_sd.c_str());
 
 
 
         // 绘制应用总大小信息 (Draw application total size information)
-        if (entry.size_total >= 1024 * 1024 * 1024) {
-            if (entry.size_total >= 1024ULL * 1024ULL * 1024ULL * 100ULL) { // no decimal
-                // 大于100GB时显示整数GB (Show integer GB when larger than 100GB)
-                gfx::drawTextArgs(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN, "%.0f GB", static_cast<float>(entry.size_total) / static_cast<float>(1024*1024*1024));
-            } else { // use decimal
-                // 小于100GB时显示一位小数GB (Show one decimal place GB when less than 100GB)
-                gfx::drawTextArgs(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN, "%.1f GB", static_cast<float>(entry.size_total) / static_cast<float>(1024*1024*1024));
-            }
-        } else {
-            if (entry.size_total >= 1024 * 1024 * 100) { // no decimal
-                // 大于100MB时显示整数MB (Show integer MB when larger than 100MB)
-                gfx::drawTextArgs(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN, "%.0f MB", static_cast<float>(entry.size_total) / static_cast<float>(1024*1024));
-            } else { // use decimal
-                // 小于100MB时显示一位小数MB (Show one decimal place MB when less than 100MB)
-                gfx::drawTextArgs(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN, "%.1f MB", static_cast<float>(entry.size_total) / static_cast<float>(1024*1024));
-            }
-        }
+        gfx::drawText(this->vg, x + 708.f, y + text_spacing_top + 2.f, 32.f, TotalSizeText(entry.size_total), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
 
         // 更新Y坐标为下一项位置 (Update Y coordinate to next item position)
         y += box_height;
@@ -1073,18 +1147,17 @@ void App::DrawConfirm() {
     gfx::drawTextArgs(this->vg, 55.f, 670.f, 24.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE, delete_selected_count.c_str(), this->delete_count);
 
     // 检查删除状态并显示相应信息 (Check deletion status and display corresponding information)
-    std::scoped_lock mutex_lock{this->mutex};
-    if (this->finished_deleting || this->selected_indices.size() == 0) { // 删除完成或已选择项为空 (Deletion completed or selected items empty)
+    if (progress.finished || this->selected_indices.size() == 0) { // 删除完成或已选择项为空 (Deletion completed or selected items empty)
 
         // 删除完成，在主列表区域显示完成信息 (Deletion completed, show completion message in main list area)
         gfx::drawTextBoxCentered(this->vg, 90.f, 130.f, 715.f, 516.f, 35.f, 1.5f, uninstalled_all_app.c_str(), nullptr, gfx::Colour::SILVER);
-        if (deleted_nand_bytes > 0){
+        if (progress.deleted_nand_bytes > 0){
             gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 56.f + 85.f, 20.f, cumulative_released.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
-            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, (plus_sign + FormatStorageSize(deleted_nand_bytes)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
+            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, PlusSizeText(progress.deleted_nand_bytes), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
         }
-        if (deleted_sd_bytes > 0){
+        if (progress.deleted_sd_bytes > 0){
             gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 235.f + 85.f, 20.f, cumulative_released.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
-            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, (plus_sign + FormatStorageSize(deleted_sd_bytes)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
+            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, PlusSizeText(progress.deleted_sd_bytes), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
         }
         
     } else if (this->delete_thread.valid() || this->deletion_interrupted) {// 正在删除中或删除被中断，显示删除进度 (Deleting in progress or interrupted, show deletion progress)
@@ -1092,39 +1165,43 @@ void App::DrawConfirm() {
         if (this->deletion_interrupted) {//删除中断(STOP Deleting)
             if (total_nand_size > 0){
                 gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 56.f + 85.f, 20.f, pending_total.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
-                gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, (plus_sign + FormatStorageSize(total_nand_size)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
+                gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, PlusSizeText(total_nand_size), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
             }
             if (total_sd_size > 0){
                 gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 235.f + 85.f, 20.f, pending_total.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
-                gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, (plus_sign + FormatStorageSize(total_sd_size)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
+                gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, PlusSizeText(total_sd_size), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
             }
         
         } else {//正在删除(Deleting)
 
             // 显示删除进度：当前删除索引+1 / 总删除数量 (Display deletion progress: current deletion index+1 / total deletion count)
-            gfx::drawTextArgs(this->vg, 70.f, 40.f, 28.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE, delete_title_loading.c_str(), software_title.c_str(), this->delete_index + 1, this->delete_entries.size());
+            gfx::drawTextArgs(this->vg, 70.f, 40.f, 28.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE, delete_title_loading.c_str(), software_title.c_str(), progress.index + 1, this->delete_entries.size());
             // 获取当前正在删除的应用的大小信息 (Get size info of currently deleting app)
             std::size_t current_nand_size = 0;
             std::size_t current_sd_size = 0;
-            if (this->delete_index < this->delete_entries.size()) {
-                u64 current_app_id = this->delete_entries[this->delete_index];
-                // 在entries中查找当前正在删除的应用 (Find currently deleting app in entries)
-                for (const auto& entry : this->entries) {
-                    if (entry.id == current_app_id) {
-                        current_nand_size = entry.size_nand;
-                        current_sd_size = entry.size_sd;
-                        break;
-                    }
+            if (progress.index < this->delete_entries.size()) {
+                u64 current_app_id = this->delete_entries[progress.index];
+                // 在视图中查找当前正在删除的应用 (Find currently deleting app in the view)
+                if (const std::size_t slot = view->index.Find(current_app_id); slot < rows.size()) {
+                    current_nand_size = rows[slot].size_nand;
+                    current_sd_size = rows[slot].size_sd;
                 }
             }
             
             if (current_nand_size > 0){
                 gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 56.f + 85.f, 20.f, space_releasing.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::RED);
-                gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, (plus_sign + FormatStorageSize(current_nand_size)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::RED);
+                gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, PlusSizeText(current_nand_size), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::RED);
             }
             if (current_sd_size > 0){
                 gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 235.f + 85.f, 20.f, space_releasing.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::RED);
-                gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, (plus_sign + FormatStorageSize(current_sd_size)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::RED);
+                gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, PlusSizeText(current_sd_size), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::RED);
+            }
+
+            // 按已删除应用的平均耗时估算剩余时间 (Estimate the remaining time from the average latency of deleted titles)
+            if (progress.latency_count > 0 && progress.index < this->delete_entries.size()) {
+                const auto remaining = this->delete_entries.size() - progress.index;
+                const auto eta_seconds = static_cast<int>(progress.latency_total.count() / progress.latency_count * remaining / 1000000);
+                gfx::drawTextArgs(this->vg, sidebox_x + 30.f, sidebox_y + 500.f, 20.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::SILVER, delete_eta.c_str(), eta_seconds / 60, eta_seconds % 60);
             }
         }
     
@@ -1132,11 +1209,11 @@ void App::DrawConfirm() {
         // 扫描完成，显示总容量 (Scanning complete, show total capacity)
         if (total_nand_size > 0){
             gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 56.f + 85.f, 20.f, pending_total.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
-            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, (plus_sign + FormatStorageSize(total_nand_size)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
+            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 56.f + 85.f, 24.f, PlusSizeText(total_nand_size), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
         }
         if (total_sd_size > 0){
             gfx::drawText(this->vg, sidebox_x + 30.f, sidebox_y + 235.f + 85.f, 20.f, pending_total.c_str(), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
-            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, (plus_sign + FormatStorageSize(total_sd_size)).c_str(), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
+            gfx::drawText(this->vg, sidebox_x + 30.f + 315.f, sidebox_y + 235.f + 85.f, 24.f, PlusSizeText(total_sd_size), nullptr, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP, gfx::Colour::CYAN);
         }
     }
 
@@ -1145,37 +1222,54 @@ void App::DrawConfirm() {
 }
 
 
+namespace {
+
+// 排序方式对应的字段、方向和按钮文字，按SortType的顺序排列
+// Field, direction and button label of every sort mode, in SortType order
+struct SortMode {
+    TitleTable::SortKey key;
+    bool descending;
+    const std::string* label;
+};
+
+const SortMode SORT_MODES[] = {
+    {TitleTable::SortKey::SIZE, true, &sort_size_bigsmall},
+    {TitleTable::SortKey::SIZE, false, &sort_size_smallbig},
+    {TitleTable::SortKey::NAME, false, &sort_alpha_az},
+    {TitleTable::SortKey::NAME, true, &sort_alpha_za},
+    {TitleTable::SortKey::NAND, true, &sort_nand_bigsmall},
+    {TitleTable::SortKey::NAND, false, &sort_nand_smallbig},
+    {TitleTable::SortKey::SD, true, &sort_sd_bigsmall},
+    {TitleTable::SortKey::SD, false, &sort_sd_smallbig},
+    {TitleTable::SortKey::AUTHOR, false, &sort_author_az},
+    {TitleTable::SortKey::AUTHOR, true, &sort_author_za},
+    {TitleTable::SortKey::ID, false, &sort_id_asc},
+    {TitleTable::SortKey::ID, true, &sort_id_desc},
+};
+
+// 按大小排序的方式，大小计算完成前切换排序时跳过 (Size-based sort modes, skipped when cycling the sort before the size pass finishes)
+bool IsSizeSort(std::size_t sort_type) {
+    const auto key = SORT_MODES[sort_type].key;
+    return key == TitleTable::SortKey::SIZE || key == TitleTable::SortKey::NAND || key == TitleTable::SortKey::SD;
+}
+
+} // namespace
+
+// 调用方须持有entries_mutex (The caller must hold entries_mutex)
 void App::Sort()
 {
-    // std::scoped_lock lock{entries_mutex}; // 保护entries向量的排序操作 (Protect entries vector sorting operation)
-    switch (static_cast<SortType>(this->sort_type)) {
-        case SortType::Size_BigSmall:
-            // 按容量从大到小排序
-            std::ranges::sort(this->entries, std::ranges::greater{}, &AppEntry::size_total);
-            break;
-        case SortType::Alphabetical:
-            // 按应用名称A-Z排序
-            std::ranges::sort(this->entries, {}, &AppEntry::name);
-            break;
-        default:
-            // 默认按容量从大到小排序
-            std::ranges::sort(this->entries, std::ranges::greater{}, &AppEntry::size_total);
-            break;
-    }
+    static_assert(std::size(SORT_MODES) == std::to_underlying(SortType::MAX));
+    // 排序键在存入时已生成，这里只比较整数和字节串 (Collation keys were built on store, this only compares integers and byte strings)
+    [[maybe_unused]] const auto sort_start = std::chrono::steady_clock::now(); // 用于调试计时 (For debug timing)
+    const auto& mode = SORT_MODES[this->sort_type < std::size(SORT_MODES) ? this->sort_type : 0];
+    this->entries.Sort(mode.key, mode.descending);
+    LOG("排序 (Sort) %s: %zu titles, %lld us\n", mode.label->c_str(), this->entries.Size(),
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sort_start).count()));
 }
 
 const char* App::GetSortStr() {
-    switch (static_cast<SortType>(this->sort_type)) {
-        case SortType::Size_BigSmall:
-            // 返回按容量从大到小排序的提示文本
-            return sort_size_bigsmall.c_str();
-        case SortType::Alphabetical:
-            // 返回按字母顺序排序的提示文本
-            return sort_alpha_az.c_str();
-        default:
-            // 默认返回按容量从大到小排序的提示文本
-            return sort_size_bigsmall.c_str();
-    }
+    // 返回当前排序方式的提示文本 (Return the label of the current sort mode)
+    return SORT_MODES[this->sort_type < std::size(SORT_MODES) ? this->sort_type : 0].label->c_str();
 }
 
 void App::UpdateLoad() {
@@ -1186,70 +1280,140 @@ void App::UpdateLoad() {
         return;
     }
 
-    {
+    // 等待期间每帧只检查计数，不锁定entries (While waiting each frame only checks the counters, entries stay unlocked)
+    if (scanned_count.load() == 0) {
         std::scoped_lock lock{this->mutex};
+        if (!finished_scanning) {
+            return;
+        }
+    }
+
+    {
+        std::scoped_lock lock{entries_mutex, this->mutex};
         // 只要有应用加载完成就立即显示列表，实现真正的立即显示
         // Show list immediately when any app is loaded, achieving true immediate display
-        if (scanned_count.load() > 0 || finished_scanning) {
-            if (finished_scanning) {
-                this->async_thread.get();
-            }
-            this->Sort();
-            
-            
-            this->menu_mode = MenuMode::LIST;
+        if (finished_scanning) {
+            this->async_thread.get();
         }
+        this->Sort();
+        this->PublishTitleList();
+        
+        this->menu_mode = MenuMode::LIST;
     }
 }
 
 void App::UpdateList() {
-    std::scoped_lock lock{entries_mutex}; // 保护entries向量的访问和修改 (Protect entries vector access and modification)
+    // 每帧只读取已发布的视图，不锁定entries；只有修改entries的按键才持有entries_mutex
+    // Every frame only reads the published view with entries unlocked; only keys that change entries hold entries_mutex
+    auto view = this->title_list.Acquire();
+
+    // 键盘打开时只处理搜索输入，每次文本变化重新过滤 (While the keyboard is open only search input is handled, refiltering on every change)
+    if (this->search_keyboard.IsOpen()) {
+        const auto event = this->search_keyboard.Update();
+        if (event != SearchKeyboard::Event::NONE) {
+            std::scoped_lock lock{entries_mutex};
+            this->ApplySearch(event == SearchKeyboard::Event::CANCELLED ? this->search_query_before : this->search_keyboard.Text());
+            view = this->title_list.Acquire();
+        }
+        this->cursor_id = this->index < view->rows.size() ? view->rows[this->index].id : 0;
+        return;
+    }
+
+    this->list_scroll.SetRowCount(view->rows.size());
+    this->FollowCursor();
     // 检查应用列表是否为空，避免数组越界访问 (Check if application list is empty to avoid array out-of-bounds access)
-    if (this->entries.empty()) {
-        // 如果应用列表为空，只处理退出操作 (If application list is empty, only handle exit operation)
+    if (view->rows.empty()) {
+        // 如果应用列表为空，只处理退出操作；搜索无结果时B清除搜索，X重新搜索
+        // If application list is empty, only handle exit operation; with no search results B clears the search and X searches again
         if (this->controller.B) {
             this->audio_manager.PlayKeySound(0.9);
-            this->quit = true;
+            if (view->filtered) {
+                std::scoped_lock lock{entries_mutex};
+                this->ApplySearch({});
+            } else {
+                this->quit = true;
+            }
+        } else if (this->controller.X && view->filtered) {
+            this->OpenSearch();
         }
         return; // 提前返回，避免后续操作 (Early return to avoid subsequent operations)
     }
+
+    // 触摸拖动和惯性滑动：在列表区域按下时开始跟随手指 (Touch drag and fling: the list follows a finger that lands on it)
+    const u64 now = armGetSystemTick();
+    bool tap_select = false;
+    if (this->controller.TOUCH) {
+        const float touch_y = this->controller.touch_y - LIST_TOP;
+        if (this->list_scroll.IsTouching()) {
+            this->list_scroll.TouchMove(touch_y, now);
+        } else if (this->controller.touch_x >= 30.f && this->controller.touch_x < 870.f &&
+                   this->controller.touch_y >= 86.f && this->controller.touch_y < 646.f) {
+            this->list_scroll.TouchDown(touch_y, now);
+        }
+    } else if (this->list_scroll.TouchUp(now)) {
+        // 点击光标所在行切换选中，点击其他行移动光标 (Tapping the cursor row toggles it, tapping another row moves the cursor)
+        const std::size_t row = this->list_scroll.RowAt(this->controller.touch_y - LIST_TOP);
+        if (row == this->index) {
+            tap_select = true;
+        } else if (row < view->rows.size()) {
+            this->audio_manager.PlayKeySound(0.9);
+            this->index = row;
+            this->list_scroll.EnsureVisible(row);
+        }
+    }
+    this->list_scroll.Update(now);
+    if (this->list_scroll.IsMoving()) {
+        this->MarkDirty();
+    }
     
-    // 扫描过程中禁用排序和删除功能
+    // 扫描过程中禁用删除功能，排序仍然可用
     if (this->controller.B) {
         this->audio_manager.PlayKeySound(0.9);
-        this->quit = true;
-    } else if (this->controller.A) { // 允许在扫描过程中选择列表项
+        // 有搜索过滤时B先清除过滤 (With a search filter, B clears it first)
+        if (view->filtered) {
+            std::scoped_lock lock{entries_mutex};
+            this->ApplySearch({});
+        } else {
+            this->quit = true;
+        }
+    } else if (!is_scan_running && this->search_ready && this->controller.X) { // 非扫描状态下才允许搜索
+        this->OpenSearch();
+    } else if (this->controller.A || tap_select) { // 允许在扫描过程中选择列表项
             // 原代码: } else if (!is_scan_running && this->controller.A) { // 非扫描状态下才允许选择
-        if (this->entries[this->index].selected) {
+        std::scoped_lock lock{entries_mutex};
+        this->CatchUpTitleList();
+        if (this->entries.IsSelected(this->index)) {
             this->audio_manager.PlayConfirmSound(0.7); 
-            this->entries[this->index].selected = false;
-            this->delete_count--;
+            this->entries.SetSelected(this->index, false);
         } else {
             this->audio_manager.PlayConfirmSound(0.9); 
-            this->entries[this->index].selected = true;
-            this->delete_count++;
+            this->entries.SetSelected(this->index, true);
         }
+        this->delete_count = this->entries.CountSelected();
+        this->PublishTitleList();
         // add to / remove from delete list
     } else if (!is_scan_running && this->controller.START) { // 非扫描状态下才允许删除
         this->audio_manager.PlayKeySound(0.9);
-        for (const auto&p : this->entries) {
-            if (p.selected) {
-                this->delete_entries.push_back(p.id);
+        std::scoped_lock lock{entries_mutex};
+        this->CatchUpTitleList();
+        // 被搜索隐藏的已选中应用也要删除，先恢复完整列表 (Selected titles hidden by the search are deleted too, restore the full list first)
+        if (this->entries.IsFiltered() && this->entries.CountSelected()) {
+            this->ApplySearch({});
+        }
+        for (std::size_t row = 0; row < this->entries.Size(); row++) {
+            if (this->entries.IsSelected(row)) {
+                this->delete_entries.push_back(this->entries.Id(row));
             }
         }
         if (this->delete_entries.size()) {
             // 保存列表界面的光标位置到确认界面变量
             this->confirm_index = 0;
             this->confirm_start = 0;
-            this->ypos = this->yoff = 130.f;
             
             // 重置删除相关状态，确保右侧信息窗口显示确认删除文本而不是进度条
             // Reset deletion-related states to ensure right info window shows confirmation text instead of progress bar
-            {
-                std::scoped_lock lock{this->mutex};
-                this->finished_deleting = false;
-                this->deletion_interrupted = false;
-            }
+            this->finished_deleting = false;
+            this->deletion_interrupted = false;
             
             // 如果之前的删除线程仍然有效，等待其完成并重置
             // If previous deletion thread is still valid, wait for completion and reset
@@ -1260,81 +1424,72 @@ void App::UpdateList() {
             this->menu_mode = MenuMode::CONFIRM;
         }
     } else if (this->controller.DOWN) { // move down
-        if (this->index < (this->entries.size() - 1)) {
+        if (this->index < (view->rows.size() - 1)) {
             this->audio_manager.PlayKeySound(0.9);
             this->index++;
-            this->ypos += this->BOX_HEIGHT;
-            if ((this->ypos + this->BOX_HEIGHT) > 646.f) {
-                LOG("moved down\n");
-                this->ypos -= this->BOX_HEIGHT;
-                this->yoff = this->ypos - ((this->index - this->start - 1) * this->BOX_HEIGHT);
-                this->start++;
-            }
+            // 光标超出视口底部时滚动一行 (Scroll one row when the cursor passes the bottom of the viewport)
+            this->list_scroll.EnsureVisible(this->index);
             // 光标移动后的图标加载由每帧调用自动处理
             // Icon loading after cursor movement is handled by per-frame calls
         }else this->audio_manager.PlayLimitSound(1.5); 
     } else if (this->controller.UP) { // move up
-        if (this->index != 0 && this->entries.size()) {
+        if (this->index != 0) {
             this->audio_manager.PlayKeySound(0.9);
             this->index--;
-            this->ypos -= this->BOX_HEIGHT;
-            if (this->ypos < 86.f) {
-                LOG("moved up\n");
-                this->ypos += this->BOX_HEIGHT;
-                this->yoff = this->ypos;
-                this->start--;
-            }// 播放按键音效 (Play key sound)
+            this->list_scroll.EnsureVisible(this->index);
             // 光标移动后触发视口感知图标加载
             // 光标移动后的图标加载由每帧调用自动处理
             // Icon loading after cursor movement is handled by per-frame calls
         }else this->audio_manager.PlayLimitSound(1.5); 
-    } else if (!is_scan_running && this->controller.Y) { // 非扫描状态下才允许排序
+    } else if (this->controller.Y) { // 扫描中也允许排序，之后到达的名称和大小按新顺序插入；大小计算中跳过按大小排序 (Sorting works during the scan too, names and sizes arriving later are placed in the new order; size sorts are skipped during the size pass)
         this->audio_manager.PlayKeySound(); // 播放按键音效 (Play key sound)
-        this->sort_type++;
+        std::scoped_lock lock{entries_mutex};
+        this->CatchUpTitleList();
+        do {
+            this->sort_type++;
 
-        if (this->sort_type == std::to_underlying(SortType::MAX)) {
-            this->sort_type = 0;
-        }
+            if (this->sort_type == std::to_underlying(SortType::MAX)) {
+                this->sort_type = 0;
+            }
+        } while (is_size_pass_running && IsSizeSort(this->sort_type));
 
         this->Sort();
+        this->PublishTitleList();
         
         // 强制重置可见区域缓存，确保排序后图标能重新加载 (Force reset visible range cache to ensure icons reload after sorting)
         this->last_loaded_range = {SIZE_MAX, SIZE_MAX};
         
-        // 重置选择索引，使选择框回到第一项
-        this->index = 0;
-        // 重置滚动位置
-        this->ypos = this->yoff = 130.f;
-        this->start = 0;
+        // 与FollowCursor相同：光标留在原来的应用上，并保持它在屏幕上的位置 (Same as FollowCursor: keep the cursor on its title, at the same place on screen)
+        const std::size_t row = this->entries.FindRow(this->cursor_id);
+        const float cursor_top = this->list_scroll.RowTop(this->index);
+        this->index = row == TitleTable::NPOS ? 0 : row;
+        if (!this->list_scroll.IsTouching()) {
+            this->list_scroll.SetOffset(static_cast<float>(this->index) * BOX_HEIGHT - cursor_top);
+        }
 
     } else if (!is_scan_running && this->controller.L2) { // 非扫描状态下才允许全选/取消全选
-        if (this->delete_count == this->entries.size()) {
+        // 过滤时只看可见行，隐藏的已选中应用不影响判断 (While filtered only visible rows count, hidden selected titles don't sway it)
+        std::scoped_lock lock{entries_mutex};
+        this->CatchUpTitleList();
+        if (this->entries.CountVisibleSelected() == this->entries.Size()) {
             this->audio_manager.PlayConfirmSound(0.7); 
-            for (auto& a : this->entries) {
-                a.selected = false;
-            }
-            this->delete_count = 0;
+            this->entries.SetAllSelected(false);
         } else {
             this->audio_manager.PlayConfirmSound(0.9); 
-            for (auto& a : this->entries) {
-                a.selected = true;
-            }
-            this->delete_count = this->entries.size();
+            this->entries.SetAllSelected(true);
         }
+        this->delete_count = this->entries.CountSelected();
+        this->PublishTitleList();
     } else if (!is_scan_running && this->controller.R2) { // 非扫描状态下才允许反选
         this->audio_manager.PlayConfirmSound(0.9); 
-        for (auto& a : this->entries) {
-            a.selected = !a.selected;
-        }
-        // 更新delete_count
-        this->delete_count = 0;
-        for (const auto& a : this->entries) {
-            if (a.selected) {
-                this->delete_count++;
-            }
-        }
+        std::scoped_lock lock{entries_mutex};
+        this->CatchUpTitleList();
+        this->entries.InvertSelection();
+        // 选中数量由位集合维护，无需重新遍历 (The bitset keeps the count, no recount pass needed)
+        this->delete_count = this->entries.CountSelected();
+        this->PublishTitleList();
     } else if (this->controller.L) { // L键向上翻页 (L key for page up)
-        if (this->entries.size() > 0) {
+        if (!view->rows.empty()) {
             // 直接更新index，向上翻页4个位置 (Directly update index, page up 4 positions)
             if (this->index >= 4) {
                 this->audio_manager.PlayKeySound(0.9); // 正常翻页音效 (Normal page flip sound)
@@ -1344,68 +1499,65 @@ void App::UpdateList() {
                 this->audio_manager.PlayLimitSound(1.5);
             }
             
-            // 直接更新start位置，确保翻页显示4个项目 (Directly update start position to ensure 4 items per page)
-            if (this->start >= 4) {
-                this->start -= 4;
-            } else {
-                this->start = 0;
-            }
-            
-            // 边界检查：确保index和start的一致性 (Boundary check: ensure consistency between index and start)
-            if (this->index < this->start) {
-                this->index = this->start;
-            }
-            
-            // 边界检查：确保index不会超出当前页面范围 (Boundary check: ensure index doesn't exceed current page range)
-            std::size_t max_index_in_page = this->start + 3; // 当前页面最大索引 (Maximum index in current page)
-            if (this->index > max_index_in_page && max_index_in_page < this->entries.size()) {
-                this->index = max_index_in_page;
-            }
-            
-            // 更新相关显示变量 (Update related display variables)
-            this->ypos = 130.f + (this->index - this->start) * this->BOX_HEIGHT;
-            this->yoff = 130.f;
+            // 视图同样上移4行，光标保持在完整可见的行内 (The view also moves up 4 rows, the cursor stays on a fully visible row)
+            this->list_scroll.ScrollRows(-static_cast<long>(LIST_ROWS));
+            this->index = this->list_scroll.ClampToVisible(this->index);
             
             // 翻页后的图标加载由每帧调用自动处理 (Icon loading after page change is handled by per-frame calls)
         }
     } else if (this->controller.R) { // R键向下翻页 (R key for page down)
-        if (this->entries.size() > 0) {
+        if (!view->rows.empty()) {
             // 直接更新index，向下翻页4个位置 (Directly update index, page down 4 positions)
             this->index += 4;
             
             // 边界检查：确保不超出列表范围 (Boundary check: ensure not exceeding list range)
-            if (this->index >= this->entries.size()) {
-                this->index = this->entries.size() - 1;
+            if (this->index >= view->rows.size()) {
+                this->index = view->rows.size() - 1;
                 this->audio_manager.PlayLimitSound(1.5);
             }else this->audio_manager.PlayKeySound(0.9);
             
-            // 直接更新start位置，确保翻页显示4个项目 (Directly update start position to ensure 4 items per page)
-            this->start += 4;
-            
-            // 边界检查：确保start不会超出合理范围 (Boundary check: ensure start doesn't exceed reasonable range)
-            if (this->entries.size() > 4) {
-                std::size_t max_start = this->entries.size() - 4;
-                if (this->start > max_start) {
-                    this->start = max_start;
-                    // 当到达末尾时，调整index到最后一个可见项 (When reaching end, adjust index to last visible item)
-                    this->index = this->entries.size() - 1;
-                }
-            } else {
-                this->start = 0;
+            // 视图同样下移4行，到达末尾时光标移到最后一项 (The view also moves down 4 rows, the cursor goes to the last item at the end)
+            if (this->list_scroll.ScrollRows(static_cast<long>(LIST_ROWS))) {
+                this->index = view->rows.size() - 1;
             }
-            
-            // 更新相关显示变量 (Update related display variables)
-            this->ypos = 130.f + (this->index - this->start) * this->BOX_HEIGHT;
-            this->yoff = 130.f;
+            this->index = this->list_scroll.ClampToVisible(this->index);
             
             // 翻页后的图标加载由每帧调用自动处理 (Icon loading after page change is handled by per-frame calls)
         }
     } 
 
+    // 记住光标所在的应用，后台插入或移动行后据此重新定位；按键修改entries后视图已重新发布
+    // (Remember the title under the cursor, used to re-anchor after background inserts or moves; keys that changed entries republished the view)
+    view = this->title_list.Acquire();
+    this->cursor_id = this->index < view->rows.size() ? view->rows[this->index].id : 0;
+    // 大小计算优先处理视口中间附近的应用 (The size pass favours titles around the middle of the viewport)
+    const auto [visible_first, visible_last] = this->GetVisibleRange();
+    this->size_focus_row = visible_first + (visible_last - visible_first) / 2;
     
     // handle direction keys
 }
 
+// 已发布的视图中后台扫描插入或移动了行，光标跟随原来的应用并保持其屏幕位置（渲染线程）
+// After the background scan inserted or moved rows in the published view, the cursor follows its title and keeps its screen position (render thread)
+void App::FollowCursor() {
+    const auto view = this->title_list.Acquire();
+    if (view->moves == this->cursor_moves) {
+        return;
+    }
+    this->cursor_moves = view->moves;
+    const std::size_t row = view->index.Find(this->cursor_id);
+    if (row == IdIndex::NPOS || row == this->index) {
+        return;
+    }
+    // 手指拖动时滚动位置跟随手指，只移动光标 (While a finger drags, the scroll position follows the finger and only the cursor moves)
+    if (!this->list_scroll.IsTouching()) {
+        const float cursor_top = this->list_scroll.RowTop(this->index);
+        this->list_scroll.SetOffset(static_cast<float>(row) * BOX_HEIGHT - cursor_top);
+    }
+    this->index = row;
+    this->MarkDirty();
+}
+
 void App::UpdateConfirm() {
     
     // 检查删除线程状态，防止并发删除操作 (Check deletion thread status to prevent concurrent deletion operations)
@@ -1417,7 +1569,6 @@ void App::UpdateConfirm() {
         this->confirm_start = 0;
         
         this->finished_deleting = false;
-        this->delete_index = 0;
         this->deletion_interrupted = false;
         
         // 计算准备删除的应用总占用容量 (Calculate total size of apps to be deleted)
@@ -1426,92 +1577,44 @@ void App::UpdateConfirm() {
         this->deleted_app_count = this->delete_entries.size();
         {
             std::scoped_lock lock{entries_mutex}; // 保护entries向量的读取操作 (Protect entries vector read operations)
-            for (const auto& app_id : this->delete_entries) {
-                for (const auto& entry : this->entries) {
-                    if (entry.id == app_id) {
-                        this->deleted_nand_bytes += static_cast<double>(entry.size_nand);
-                        this->deleted_sd_bytes += static_cast<double>(entry.size_sd);
-                        break;
-                    }
+            for (AppID app_id : this->delete_entries) {
+                if (const std::size_t row = this->entries.FindRow(app_id); row != TitleTable::NPOS) {
+                    this->deleted_nand_bytes += static_cast<double>(this->entries.SizeNand(row));
+                    this->deleted_sd_bytes += static_cast<double>(this->entries.SizeSd(row));
                 }
             }
         }
-        NsDeleteData data{
-            .entries = this->delete_entries,
-            .del_cb = [this](bool error){
-                    std::scoped_lock lock{this->mutex, entries_mutex}; // 同时锁定两个互斥锁避免竞态条件 (Lock both mutexes simultaneously to avoid race conditions)
-                    if (error) {
-                        LOG("error whilst deleting AppID %lX\n", this->delete_entries[this->delete_index]);
-                    } else {
-                        // 删除成功，从主应用列表中移除该应用 (Deletion successful, remove from main app list)
-                        const auto app_id = this->delete_entries[this->delete_index];
-                        for (size_t i = 0; i < this->entries.size(); i++) {
-                            if (this->entries[i].id == app_id) {
-                                // 不删除图标，依赖程序退出时自动释放 (Don't delete icon, rely on automatic release on program exit)
-                                this->entries.erase(this->entries.begin() + i);
-                                break;
-                            }
-                        }
-                        // 更新删除计数和应用总数 (Update delete count and total count)
-                        this->delete_count--;
-                        total_count.fetch_sub(1);
-                        
-                        // 立即刷新存储空间信息 (Immediately refresh storage space information)
-                        nsGetTotalSpaceSize(NcmStorageId_SdCard, (s64*)&this->sdcard_storage_size_total);
-                        nsGetFreeSpaceSize(NcmStorageId_SdCard, (s64*)&this->sdcard_storage_size_free);
-                        nsGetTotalSpaceSize(NcmStorageId_BuiltInUser, (s64*)&this->nand_storage_size_total);
-                        nsGetFreeSpaceSize(NcmStorageId_BuiltInUser, (s64*)&this->nand_storage_size_free);
-                        this->nand_storage_size_used = this->nand_storage_size_total - this->nand_storage_size_free;
-                        this->sdcard_storage_size_used = this->sdcard_storage_size_total - this->sdcard_storage_size_free;
-                    }
-                    this->delete_index++;
-                },
-            .done_cb = [this](){
-                std::scoped_lock lock{this->mutex};
-                LOG("finished deleting entries...\n");
-                this->finished_deleting = true;
-                
-                // 刷新存储空间信息 (Refresh storage space information)
-                nsGetTotalSpaceSize(NcmStorageId_SdCard, (s64*)&this->sdcard_storage_size_total);
-                nsGetFreeSpaceSize(NcmStorageId_SdCard, (s64*)&this->sdcard_storage_size_free);
-                nsGetTotalSpaceSize(NcmStorageId_BuiltInUser, (s64*)&this->nand_storage_size_total);
-                nsGetFreeSpaceSize(NcmStorageId_BuiltInUser, (s64*)&this->nand_storage_size_free);
-                this->nand_storage_size_used = this->nand_storage_size_total - this->nand_storage_size_free;
-                this->sdcard_storage_size_used = this->sdcard_storage_size_total - this->sdcard_storage_size_free;
-                
-                // 重置状态 (Reset state)
-                // delete_count已经在del_cb中逐个减少，这里直接设为0 (delete_count already decreased in del_cb, set to 0 here)
-                this->delete_count = 0;
-                this->ypos = this->yoff = 130.f;
-                this->index = 0;
-                this->start = 0;
-                this->delete_entries.clear();
-            }
+        this->delete_progress = DeleteProgress{
+            .finished = false,
+            .index = 0,
+            .deleted_nand_bytes = this->deleted_nand_bytes,
+            .deleted_sd_bytes = this->deleted_sd_bytes,
+            .latency_total = {},
+            .latency_count = 0,
         };
+        // 上一次删除的协程已关闭通道，此时没有生产者 (The previous deletion coroutine has closed the channel, so there is no producer now)
+        if (this->delete_thread.valid()) {
+            this->delete_thread.get();
+        }
+        this->delete_channel.reset();
         // 保持在CONFIRM界面进行删除，不跳转到PROGRESS界面 (Stay in CONFIRM interface for deletion, don't jump to PROGRESS)
-        this->delete_thread = util::async(NsDeleteAppsAsync, data);
+        this->delete_thread = util::spawn(this->job_pool, [this, entries = this->delete_entries](std::stop_token stop_token) {
+            return DeleteAppsTask(std::move(stop_token), entries, this->delete_channel, this->job_pool);
+        });
     } else if (this->controller.B) {
         // 播放取消音效 (Play cancel sound)
         // 检查删除状态来决定B键行为 (Check deletion status to determine B key behavior)
         if (this->delete_thread.valid() && !this->finished_deleting) {
             // 删除进行中，B键中断删除 (Deletion in progress, B key interrupts deletion)
             this->audio_manager.PlayCancelSound(); 
-            this->delete_thread.request_stop();
-            // 等待删除线程结束 (Wait for deletion thread to finish)
-            if (this->delete_thread.valid()) {
-                this->delete_thread.get();
-            }
+            this->StopDeleteTask();
             // 检查删除是否实际已完成 (Check if deletion actually completed)
-            {
-                std::scoped_lock lock{this->mutex};
-                if (this->finished_deleting) {
-                    // 删除实际已完成，不标记为中断 (Deletion actually completed, don't mark as interrupted)
-                    // finished_deleting保持true，让后续逻辑正确处理 (Keep finished_deleting true for proper handling)
-                } else {
-                    // 删除被真正中断 (Deletion was truly interrupted)
-                    this->finished_deleting = false;
-                    this->deletion_interrupted = true; // 标记发生了中断 (Mark that interruption occurred)
-                }
+            if (!this->finished_deleting) {
+                // 删除被真正中断 (Deletion was truly interrupted)
+                this->deletion_interrupted = true; // 标记发生了中断 (Mark that interruption occurred)
+                // 停止时可能有一条结果未发布，回到列表时增量刷新 (A result may be left unposted on stop, refresh incrementally back on the list)
+                this->snapshot_dirty = true;
+                this->refresh_requested = true;
             }
         } else {
             this->audio_manager.PlayKeySound(0.9); 
@@ -1525,13 +1628,13 @@ void App::UpdateConfirm() {
             if (this->deletion_interrupted || deletion_completed) {
                 // 发生过中断或删除已完成，重置应用列表的光标位置 (Interruption occurred or deletion completed, reset app list cursor position)
                 this->index = 0;
-                this->start = 0;
-                this->ypos = 130.f; // 重置到顶部位置 (Reset to top position)
-                this->yoff = 130.f; // 重置yoff
+                this->list_scroll.Reset(); // 重置到顶部位置 (Reset to top position)
                 
                 // 重置最开始应用列表的所有选中状态 (Reset all selection states in the original app list)
-                for (auto& entry : this->entries) {
-                    entry.selected = false;
+                {
+                    std::scoped_lock lock{entries_mutex};
+                    this->entries.SetAllSelected(false);
+                    this->PublishTitleList();
                 }
                 this->delete_count = 0; // 重置删除计数 (Reset delete count)
                 
@@ -1542,19 +1645,13 @@ void App::UpdateConfirm() {
                 // 强制重置可见区域缓存，确保返回LIST界面后图标能重新加载 (Force reset visible range cache to ensure icons reload after returning to LIST)
                 this->last_loaded_range = {SIZE_MAX, SIZE_MAX};
             } else {
-                // 直接按B返回，保持原有光标位置 (Direct B return, maintain original cursor position)
-                this->ypos = 130.f + (this->index - this->start) * this->BOX_HEIGHT; // 重新计算ypos
-                this->yoff = 130.f; // 重置yoff
-                
+                // 直接按B返回，保持原有光标位置和滚动位置 (Direct B return, maintain original cursor and scroll position)
                 // 强制重置可见区域缓存，确保返回LIST界面后图标能重新加载 (Force reset visible range cache to ensure icons reload after returning to LIST)
                 this->last_loaded_range = {SIZE_MAX, SIZE_MAX};
             }
             
             // 重置删除完成标志 (Reset deletion finished flag)
-            {
-                std::scoped_lock lock{this->mutex};
-                this->finished_deleting = false;
-            }
+            this->finished_deleting = false;
             
             
             this->menu_mode = MenuMode::LIST;
@@ -1669,16 +1766,18 @@ void App::UpdateConfirm() {
             size_t app_index = this->selected_indices[this->confirm_index];
             
             // 从主应用列表中取消选中状态 (Unselect from main app list)
-            if (app_index < this->entries.size()) {
-                this->entries[app_index].selected = false;
+            std::scoped_lock lock{entries_mutex};
+            if (app_index < this->entries.Size()) {
+                this->entries.SetSelected(app_index, false);
                 this->delete_count--;
                 
                 // 从待删除列表中移除该应用ID (Remove app ID from delete list)
-                u64 app_id = this->entries[app_index].id;
+                u64 app_id = this->entries.Id(app_index);
                 auto it = std::find(this->delete_entries.begin(), this->delete_entries.end(), app_id);
                 if (it != this->delete_entries.end()) {
                     this->delete_entries.erase(it);
                 }
+                this->PublishTitleList();
             }
             
             // 从选中索引列表中移除 (Remove from selected indices list)
@@ -1687,9 +1786,7 @@ void App::UpdateConfirm() {
             // 调整光标位置 (Adjust cursor position)
             if (this->selected_indices.empty()) {
                 this->index = 0;
-                this->start = 0;
-                this->ypos = 130.f; // 重置到顶部位置 (Reset to top position)
-                this->yoff = 130.f; // 重置yoff
+                this->list_scroll.Reset(); // 重置到顶部位置 (Reset to top position)
                 this->confirm_index = 0;
                 this->confirm_start = 0;
                 // 如果没有选中的应用了，返回主列表 (If no selected apps, return to main list)
@@ -1715,15 +1812,17 @@ void App::UpdateConfirm() {
 
 
 /**
- * @brief 获取所有应用程序ID
- * @param app_ids 存储应用程序ID的向量引用
+ * @brief 获取所有应用程序记录
+ * @param records 存储应用程序记录的向量引用
  * @return 成功返回0，失败返回错误码
  * 
- * 此函数通过分页调用nsListApplicationRecord获取所有应用程序ID，
+ * 此函数通过分页调用nsListApplicationRecord获取所有应用程序记录，
  * 支持任意数量的应用，不受缓冲区大小限制。
+ * 记录中除应用ID外还包含最后更新时间，用于检测应用变化。
  */
-Result App::GetAllApplicationIds(std::vector<u64>& app_ids) {
-    app_ids.clear();
+Result App::GetAllApplicationRecords(std::vector<NsApplicationRecord>& records) {
+    records.clear();
+    [[maybe_unused]] const auto list_start = std::chrono::steady_clock::now(); // 用于调试计时 (For debug timing)
 
     // 定义每页获取的应用记录数量
     constexpr size_t PAGE_SIZE = 30;
@@ -1735,7 +1834,7 @@ Result App::GetAllApplicationIds(std::vector<u64>& app_ids) {
     // 分页获取应用记录，直到获取不到新记录为止
     do {
         // 调用nsListApplicationRecord获取一页应用记录
-        result = nsListApplicationRecord(record_list.data(), static_cast<s32>(record_list.size()), offset, &record_count);
+        result = GetTitleService().ListApplicationRecords(record_list.data(), static_cast<s32>(record_list.size()), offset, &record_count);
 
         // 检查是否获取成功
         if (R_FAILED(result)) {
@@ -1750,15 +1849,15 @@ Result App::GetAllApplicationIds(std::vector<u64>& app_ids) {
         // 确保记录数量不超过缓冲区大小
         record_count = std::min(record_count, static_cast<s32>(record_list.size()));
 
-        // 将获取到的应用ID添加到向量中
-        for (s32 i = 0; i < record_count; i++) {
-            app_ids.push_back(record_list[i].application_id);
-        }
+        // 将获取到的应用记录添加到向量中
+        records.insert(records.end(), record_list.begin(), record_list.begin() + record_count);
 
         // 更新偏移量，准备获取下一页
         offset += record_count;
     } while (record_count > 0);
 
+    LOG("获取应用记录完成 (Listed application records): %zu titles, %lld ms\n", records.size(),
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - list_start).count()));
     return 0;
 }
 
@@ -1769,15 +1868,19 @@ bool App::TryGetAppBasicInfoWithIconCache(u64 application_id, AppEntry& entry) {
     
     // 1. 优先尝试从缓存获取应用名称
     // 1. Try to get application name from cache first
-    NxTitleCacheApplicationMetadata* cached_metadata = nxtcGetApplicationMetadataEntryById(application_id);
+    // 模拟后端不使用缓存，避免污染真实缓存文件
+    // Mock backends skip the cache so the real cache file is not polluted
+    const bool use_title_cache = GetTitleService().UsesTitleCache();
+    NxTitleCacheApplicationMetadata* cached_metadata = use_title_cache ? nxtcGetApplicationMetadataEntryById(application_id) : nullptr;
     if (cached_metadata != nullptr) {
         entry.name = cached_metadata->name;
+        // 发行商和版本用于搜索、排序和快照 (Publisher and version feed search, sorting and the snapshot)
+        entry.author = cached_metadata->publisher ? cached_metadata->publisher : "";
+        entry.display_version = cached_metadata->version ? cached_metadata->version : "";
         entry.id = cached_metadata->title_id;
         // 暂时设置默认值，稍后异步加载
         // Set default values temporarily, load asynchronously later
         entry.size_total = entry.size_nand = entry.size_sd = 0;
-        entry.image = this->default_icon_image;
-        entry.own_image = false;
         
         // 缓存图标数据到AppEntry中
         // Cache icon data in AppEntry
@@ -1785,6 +1888,7 @@ bool App::TryGetAppBasicInfoWithIconCache(u64 application_id, AppEntry& entry) {
             entry.cached_icon_data.resize(cached_metadata->icon_size);
             memcpy(entry.cached_icon_data.data(), cached_metadata->icon_data, cached_metadata->icon_size);
             entry.has_cached_icon = true;
+            entry.icon_hash = IconCache::HashIcon(entry.cached_icon_data.data(), entry.cached_icon_data.size());
         } else {
             entry.has_cached_icon = false;
         }
@@ -1799,32 +1903,17 @@ bool App::TryGetAppBasicInfoWithIconCache(u64 application_id, AppEntry& entry) {
     auto control_data = std::make_unique<NsApplicationControlData>();
     u64 jpeg_size{};
     
-    Result result = nsGetApplicationControlData(NsApplicationControlSource_Storage, application_id, control_data.get(), sizeof(NsApplicationControlData), &jpeg_size);
+    Result result = GetTitleService().GetApplicationControlData(application_id, control_data.get(), &jpeg_size);
     if (R_FAILED(result)) {
         return false;
     }
     
-    int systemlanguage = tj::LangManager::getInstance().getCurrentLanguage();
-    NacpLanguageEntry* language_entry = &control_data->nacp.lang[systemlanguage];
-    
-    // 如果当前语言条目为空，则遍历查找第一个非空条目
-    // If the current language entry is empty, iterate to find the first non-empty entry
-    if (language_entry->name[0] == '\0' && language_entry->author[0] == '\0') {
-        for (int i = 0; i < 16; i++) {
-            if (control_data->nacp.lang[i].name[0] != '\0' || control_data->nacp.lang[i].author[0] != '\0') {
-                language_entry = &control_data->nacp.lang[i];
-                break;
-            }
-        }
-    }
-    
-    entry.name = language_entry->name;
+    // 名称、发行商和版本，当前语言条目为空时使用第一个非空条目 (Name, publisher and version, falling back to the first non-empty language entry)
+    ReadNacpText(control_data->nacp, tj::LangManager::getInstance().getCurrentLanguage(), entry);
     entry.id = application_id;
     // 暂时设置默认值，稍后异步加载
     // Set default values temporarily, load asynchronously later
     entry.size_total = entry.size_nand = entry.size_sd = 0;
-    entry.image = this->default_icon_image;
-    entry.own_image = false;
     
     // 缓存图标数据到AppEntry中，避免后续重复读取
     // Cache icon data in AppEntry to avoid repeated reads later
@@ -1833,10 +1922,13 @@ bool App::TryGetAppBasicInfoWithIconCache(u64 application_id, AppEntry& entry) {
         entry.cached_icon_data.resize(icon_size);
         memcpy(entry.cached_icon_data.data(), control_data->icon, icon_size);
         entry.has_cached_icon = true;
+        entry.icon_hash = IconCache::HashIcon(entry.cached_icon_data.data(), entry.cached_icon_data.size());
         
         // 仍然添加到缓存系统以供其他用途
         // Still add to cache system for other uses
-        nxtcAddEntry(application_id, &control_data->nacp, icon_size, control_data->icon, true);
+        if (use_title_cache) {
+            nxtcAddEntry(application_id, &control_data->nacp, icon_size, control_data->icon, true);
+        }
     } else {
         entry.has_cached_icon = false;
     }
@@ -1851,7 +1943,7 @@ bool App::TryGetAppBasicInfoWithIconCache(u64 application_id, AppEntry& entry) {
 // Get application occupied size information
 void App::GetAppSizeInfo(u64 application_id, AppEntry& entry) {
     ApplicationOccupiedSize size{};
-    Result result = nsCalculateApplicationOccupiedSize(application_id, (NsApplicationOccupiedSize*)&size);
+    Result result = GetTitleService().CalculateApplicationOccupiedSize(application_id, &size);
     if (R_FAILED(result)) {
         LOG("获取应用占用空间失败，ID: %lX\n", application_id);
         entry.size_total = entry.size_nand = entry.size_sd = 0;
@@ -1887,8 +1979,25 @@ void App::GetAppSizeInfo(u64 application_id, AppEntry& entry) {
 
 
 
-// 分离式扫描：第一阶段快速扫描应用名称和大小
-// Separated scanning: Phase 1 - Fast scan application names
+// 获取应用元数据，完整扫描和快照校验共用
+// Get application metadata, shared by the full scan and snapshot revalidation
+bool App::FetchAppMetadata(u64 application_id, AppEntry& entry) {
+    // 快速获取应用名称和图标缓存 (Fast get application name and icon cache)
+    if (TryGetAppBasicInfoWithIconCache(application_id, entry)) {
+        return true;
+    }
+
+    // 损坏的安装处理 (Handle corrupted installation)
+    entry.name = corrupted_install.c_str();
+    entry.corrupted = true;
+    entry.id = application_id;
+    entry.has_cached_icon = false;
+    entry.size_total = entry.size_nand = entry.size_sd = 0;
+    return false;
+}
+
+// 分离式扫描：先扫描名称并立即显示列表，再在后台按视口优先计算大小
+// Separated scanning: names first so the list shows right away, then sizes in the background, viewport first
 void App::FastScanNames(std::stop_token stop_token) {
     // 标记扫描开始
     is_scan_running = true;
@@ -1905,16 +2014,26 @@ void App::FastScanNames(std::stop_token stop_token) {
         LOG("初始化libnxtc库失败\n");
     }
 
-    // 获取所有应用ID
+    // 获取所有应用记录
+    std::vector<NsApplicationRecord> records{};
     std::vector<u64> app_ids{};
-    result = GetAllApplicationIds(app_ids);
+    std::unordered_map<u64, u64> fingerprints{};
+    result = GetAllApplicationRecords(records);
     // 获取应用总数量
-    total_count.store(app_ids.size());
+    total_count.store(records.size());
     if (R_FAILED(result)) {
         LOG("获取应用ID失败\n");
         goto done;
     }
 
+    // 提取应用ID，并记录每个应用的记录指纹，写入快照用于下次启动时检测变化
+    // Extract the ids and each record's fingerprint, saved in the snapshot to detect changes on the next launch
+    app_ids.reserve(records.size());
+    for (const auto& record : records) {
+        app_ids.push_back(record.application_id);
+        fingerprints[record.application_id] = TitleSnapshot::RecordFingerprint(record);
+    }
+
 
     // 如果没有应用
     if (app_ids.empty()) {
@@ -1922,116 +2041,119 @@ void App::FastScanNames(std::stop_token stop_token) {
         goto done;
     }
 
-    // 快速遍历所有应用ID，仅获取名称
-    // Fast iterate through all application IDs, get names only
-    for (u64 application_id : app_ids) {
-        if (stop_token.stop_requested()) break;
-
-        // 应用条目，用于存储单个应用的信息
-        AppEntry entry;
-        bool is_corrupted = false;
-        
-        // 1. 快速获取应用名称和大小信息（不包含图标）
-        // 1. Fast get application name and size info (excluding icon)
-        if (!TryGetAppBasicInfoWithIconCache(application_id, entry)) {
-            is_corrupted = true;
-        } else {
-            // 2. 立即加载大小信息（因为需要支持按大小排序）
-            // 2. Immediately load size info (needed for size-based sorting)
-            GetAppSizeInfo(application_id, entry);
+    {
+        // 没有快照时entries为空；预留全部应用的容量，扫描中插入不会让各列整体重新分配
+        // Without a snapshot entries is empty; reserve room for every title so inserts during the scan never reallocate the columns
+        {
+            std::scoped_lock lock{entries_mutex};
+            this->entries.Reset(app_ids.size());
         }
 
-        // 标记是否存在损坏的安装
-        // Mark if there is a corrupted installation
-        if (is_corrupted) {
-            // 损坏的安装处理
-            // Handle corrupted installation
-            entry.name = corrupted_install.c_str();
-            entry.id = application_id;
-            entry.image = this->default_icon_image;
-            entry.own_image = false;
-            entry.size_total = entry.size_nand = entry.size_sd = 0;
-        }
+        // 并行扫描：元数据和大小计算在工作线程上进行，结果按批次合并到entries
+        // Parallel scan: metadata and size run on worker threads, results merged into entries in batches
+        AppScanner scanner{this->scan_config};
 
-        // 加锁保护entries列表
-        {
-            std::scoped_lock lock{entries_mutex};
-            // 将应用条目添加到列表
-            this->entries.emplace_back(std::move(entry));
-            // 更新扫描计数器
-            scanned_count++;
-            count++;
-        }
-
-        // 为首屏4个应用立即提交最高优先级图标加载任务
-        // Immediately submit highest priority icon loading tasks for first screen 4 apps
-        if (count <= BATCH_SIZE && !is_corrupted && entry.has_cached_icon) {
-            ResourceLoadTask icon_task;
-            icon_task.application_id = application_id;
-            icon_task.priority = 0; // 最高优先级 (Highest priority)
-            icon_task.submit_time = std::chrono::steady_clock::now();
-            icon_task.task_type = ResourceTaskType::ICON;
-            
-            icon_task.load_callback = [this, application_id]() {
-                std::vector<unsigned char> icon_data;
-                bool has_icon_data = false;
-                
-                // 获取缓存的图标数据
-                // Get cached icon data
-                {
-                    std::scoped_lock lock{entries_mutex};
-                    auto it = std::find_if(entries.begin(), entries.end(),
-                        [application_id](const AppEntry& entry) {
-                            return entry.id == application_id && entry.has_cached_icon;
-                        });
-                    
-                    if (it != entries.end()) {
-                        icon_data = it->cached_icon_data;
-                        has_icon_data = true;
-                    }
+        // 1. 快速获取应用名称和图标缓存，大小留给第二阶段 (1. Fast get application name and icon cache, sizes are left to phase 2)
+        // 工作线程只读访问fingerprints (Workers only read fingerprints)
+        auto metadata_fn = [this, &fingerprints](u64 application_id, AppEntry& entry) {
+            entry.record_fingerprint = fingerprints.at(application_id);
+            entry.size_pending = FetchAppMetadata(application_id, entry);
+            return entry.size_pending;
+        };
+
+        auto merge_fn = [this, &count](std::vector<AppEntry>&& batch) {
+            // 合并前记录首屏需要加载图标的应用 (Record first-screen titles needing icons before merging)
+            std::vector<u64> first_screen_ids;
+            for (std::size_t i = 0; i < batch.size() && count + i < BATCH_SIZE; i++) {
+                if (batch[i].has_cached_icon) {
+                    first_screen_ids.push_back(batch[i].id);
                 }
-                
-                // 验证并创建图像
-                // Validate and create image
-                if (has_icon_data && !icon_data.empty() && IsValidJpegData(icon_data)) {
-                    int image_id = nvgCreateImageMem(this->vg, 0, icon_data.data(), icon_data.size());
-                    if (image_id > 0) {
-                        std::scoped_lock lock{entries_mutex};
-                        auto it = std::find_if(entries.begin(), entries.end(),
-                            [application_id](const AppEntry& entry) {
-                                return entry.id == application_id;
-                            });
-                        
-                        if (it != entries.end()) {
-                            // 如果之前有自己的图像，先删除
-                            // If previously had own image, delete it first
-                            if (it->own_image && it->image != this->default_icon_image) {
-                                nvgDeleteImage(this->vg, it->image);
-                            }
-                            it->image = image_id;
-                            it->own_image = true;
-                        }
-                    }
+            }
+
+            // 加锁保护entries列表 (Lock entries list)
+            {
+                std::scoped_lock lock{entries_mutex};
+                for (auto& entry : batch) {
+                    this->entries.Append(std::move(entry));
                 }
-            };
-            
-            resource_manager.submitLoadTask(icon_task);
-        }
+                this->MarkTitleListChanged();
+                scanned_count += batch.size();
+                count += batch.size();
+            }
 
-        // 首批应用名称加载完成标记
-        // Mark first batch names loading complete
-        if (scanned_count.load() == BATCH_SIZE) {
-            initial_batch_loaded = true;
+            // 为首屏应用立即提交最高优先级图标加载任务
+            // Immediately submit highest priority icon loading tasks for first screen apps
+            for (u64 application_id : first_screen_ids) {
+                ResourceLoadTask icon_task;
+                icon_task.application_id = application_id;
+                icon_task.priority = 0; // 最高优先级 (Highest priority)
+                icon_task.submit_time = std::chrono::steady_clock::now();
+                icon_task.task_type = ResourceTaskType::ICON;
+                
+                icon_task.load_callback = [this, application_id]() {
+                    return this->LoadIconForApp(application_id);
+                };
+                
+                resource_manager.submitLoadTask(icon_task);
+            }
+
+            // 首批应用名称加载完成标记
+            // Mark first batch names loading complete
+            if (scanned_count.load() >= BATCH_SIZE) {
+                initial_batch_loaded = true;
+            }
+        };
+
+        const auto stats = scanner.Run(stop_token, app_ids, metadata_fn, [](u64, AppEntry&) {}, merge_fn);
+        LOG("名称扫描完成 (Name scan finished): %zu titles, %zu batches, %lld ms, %.1f titles/s\n",
+            stats.titles, stats.batches, static_cast<long long>(stats.elapsed.count() / 1000), stats.TitlesPerSecond());
+
+        // 名称全部到齐后一次性建立搜索索引 (Build the search index once, after every name has arrived)
+        {
+            [[maybe_unused]] const auto index_start = std::chrono::steady_clock::now(); // 用于调试计时 (For debug timing)
+            std::scoped_lock lock{entries_mutex};
+            this->search_index.Build(this->entries);
+            this->search_ready = true;
+            LOG("建立搜索索引 (Built search index): %zu titles, %lld us\n", this->search_index.Size(),
+                static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - index_start).count()));
         }
 
-        //线程休息1ms避免卡死（比原来更快）
-        svcSleepThread(1000000ULL);
+        // 名称阶段结束：搜索、选择和删除不依赖大小，只有按大小排序和容量合计要等大小计算完成
+        // The name phase is over: searching, selecting and deleting don't need sizes, only size sorts and space totals wait for the size pass
+        is_size_pass_running = true;
+        is_scan_running = false;
+
+        // 2. 计算大小：每次领取离视口最近的应用，结果就地更新并按当前排序调整位置
+        // 2. Compute sizes: each claim takes the title nearest the viewport, results are patched in and repositioned under the current sort
+        auto next_fn = [this](u64& application_id) {
+            std::scoped_lock lock{entries_mutex};
+            return this->entries.ClaimPendingSize(this->size_focus_row.load(), application_id);
+        };
+        auto size_fn = [this](u64 application_id, AppEntry& entry) {
+            GetAppSizeInfo(application_id, entry);
+        };
+        auto size_merge_fn = [this](std::vector<AppEntry>&& batch) {
+            std::scoped_lock lock{entries_mutex};
+            for (const auto& entry : batch) {
+                this->entries.SetSizes(entry.id, entry.size_nand, entry.size_sd);
+            }
+            this->MarkTitleListChanged();
+        };
+        const auto size_stats = scanner.RunSizePass(stop_token, next_fn, size_fn, size_merge_fn);
+        LOG("大小计算完成 (Size pass finished): %zu titles, %zu batches, %lld ms, %.1f titles/s\n",
+            size_stats.titles, size_stats.batches, static_cast<long long>(size_stats.elapsed.count() / 1000), size_stats.TitlesPerSecond());
+
+        // 完整扫描后写入快照，中途停止的扫描不完整 (Save the snapshot after a full scan, a stopped scan is incomplete)
+        if (!stop_token.stop_requested()) {
+            SaveTitleSnapshot();
+        }
     }
 
     // 结束标签
     done:
     // 标记扫描结束
     is_scan_running = false;
+    is_size_pass_running = false;
 
     // 刷新缓存文件
     nxtcFlushCacheFile();
@@ -2046,24 +2168,272 @@ void App::FastScanNames(std::stop_token stop_token) {
     this->finished_scanning = true;
 }
 
+// 处理刷新请求：扫描和删除都空闲时在后台启动增量刷新（仅在列表界面调用）
+// Handle refresh requests: start an incremental refresh in the background once scanning and deletion are idle (LIST screen only)
+void App::StartIncrementalRefresh() {
+    if (!this->refresh_requested.load() || is_scan_running) {
+        return;
+    }
+    // 刷新按行遍历entries，搜索过滤时只能看到部分应用，推迟到清除过滤后
+    // The refresh walks entries by row and would only see part of the list while a search filters it, so wait until it is cleared
+    if (this->search_keyboard.IsOpen() || !this->search_query.empty()) {
+        return;
+    }
+
+    {
+        std::scoped_lock lock{this->mutex};
+        if (!this->finished_scanning || (this->delete_thread.valid() && !this->finished_deleting)) {
+            return;
+        }
+        this->finished_scanning = false;
+    }
+
+    // 立即标记扫描中，避免刷新启动前的一帧内允许删除或排序
+    // Mark scanning right away, so deleting or sorting is not allowed in the frame before the refresh starts
+    is_scan_running = true;
+    this->refresh_requested = false;
+
+    if (this->async_thread.valid()) {
+        this->async_thread.get();
+    }
+    this->async_thread = util::async(this->job_pool, [this](std::stop_token stop_token){
+        this->RefreshTitles(stop_token);
+    });
+}
+
+// 从HOME菜单返回时请求增量刷新，期间可能安装或卸载了应用
+// Request an incremental refresh when returning from the HOME menu, titles may have been installed or removed meanwhile
+void App::OnAppletHook(AppletHookType hook, void* param) {
+    auto* app = static_cast<App*>(param);
+    if (hook != AppletHookType_OnFocusState) {
+        return;
+    }
+
+    // 启动时也会收到获得焦点的消息，只在失去焦点后重新获得时刷新
+    // Gaining focus is also reported at launch, only refresh when focus comes back after losing it
+    if (appletGetFocusState() != AppletFocusState_InFocus) {
+        app->lost_focus = true;
+    } else if (app->lost_focus) {
+        app->lost_focus = false;
+        app->refresh_requested = true;
+    }
+}
+
+// 从快照加载应用列表，在第一帧即可显示排序后的列表
+// Load the title list from the snapshot, so the sorted list shows in the first frame
+bool App::LoadTitleSnapshot() {
+    [[maybe_unused]] const auto load_start = std::chrono::steady_clock::now(); // 用于调试计时 (For debug timing)
+    if (!this->title_snapshot.Load(tj::LangManager::getInstance().getCurrentLanguage())) {
+        return false;
+    }
+
+    const auto& titles = this->title_snapshot.GetTitles();
+    {
+        std::scoped_lock lock{entries_mutex};
+        this->entries.Reset(titles.size());
+        for (const auto& title : titles) {
+            AppEntry entry{};
+            entry.name = title.corrupted ? corrupted_install : title.name;
+            entry.corrupted = title.corrupted;
+            entry.author = title.author;
+            entry.display_version = title.display_version;
+            entry.size_nand = title.size_nand;
+            entry.size_sd = title.size_sd;
+            entry.size_total = title.size_nand + title.size_sd;
+            entry.id = title.application_id;
+            entry.record_fingerprint = title.record_fingerprint;
+            // 没有JPEG数据，图标从RGBA缓存读取；缓存未命中的由后台校验补取
+            // No JPEG data, icons come from the RGBA cache; cache misses are refetched by the revalidation pass
+            entry.icon_hash = title.icon_hash;
+            entry.has_cached_icon = title.icon_hash != 0;
+            this->entries.Append(std::move(entry));
+        }
+        this->MarkTitleListChanged();
+    }
+
+    scanned_count = titles.size();
+    total_count = titles.size();
+    initial_batch_loaded = true;
+
+    LOG("加载快照完成 (Loaded title snapshot): %zu titles, %lld us\n", titles.size(),
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - load_start).count()));
+    return true;
+}
+
+// 将当前应用列表写入快照，在锁外写文件
+// Write the current title list to the snapshot, the file is written outside the lock
+void App::SaveTitleSnapshot() {
+    // 渲染线程尚未移除的已卸载应用不写入快照 (Uninstalled titles the render thread has not removed yet are left out)
+    std::unordered_set<AppID> removed;
+    {
+        std::scoped_lock lock{this->mutex};
+        removed.insert(this->pending_removals.begin(), this->pending_removals.end());
+    }
+
+    std::vector<SnapshotTitle> titles;
+    {
+        std::scoped_lock lock{entries_mutex};
+        titles.reserve(this->entries.Size());
+        for (std::size_t row = 0; row < this->entries.Size(); row++) {
+            if (removed.contains(this->entries.Id(row))) {
+                continue;
+            }
+            titles.push_back(SnapshotTitle{
+                .application_id = this->entries.Id(row),
+                .record_fingerprint = this->entries.RecordFingerprint(row),
+                .icon_hash = this->entries.HasIcon(row) ? this->entries.IconHash(row) : 0,
+                .size_nand = this->entries.SizeNand(row),
+                .size_sd = this->entries.SizeSd(row),
+                .corrupted = this->entries.IsCorrupted(row),
+                .name = this->entries.Name(row),
+                .author = this->entries.Author(row),
+                .display_version = this->entries.DisplayVersion(row),
+            });
+        }
+    }
+
+    if (!this->title_snapshot.Save(titles, tj::LangManager::getInstance().getCurrentLanguage())) {
+        LOG("写入快照失败 (Failed to save title snapshot)\n");
+    }
+}
+
+// 增量刷新：对比当前应用记录与已知状态，只重新查询变化的应用并原位更新entries
+// 启动时已知状态来自快照，之后来自当前列表；光标和选中状态保持在同一应用上
+// Incremental refresh: diff the current records against the known state, only re-query changed titles and patch entries in place
+// At launch the known state comes from the snapshot, later from the current list; the cursor and selection stay on the same titles
+void App::RefreshTitles(std::stop_token stop_token) {
+    [[maybe_unused]] const auto refresh_start = std::chrono::steady_clock::now(); // 用于调试计时 (For debug timing)
+    is_scan_running = true;
+
+    if (!nxtcInitialize()) {
+        LOG("初始化libnxtc库失败\n");
+    }
+
+    std::vector<NsApplicationRecord> records{};
+    const Result result = GetAllApplicationRecords(records);
+    if (R_FAILED(result)) {
+        LOG("获取应用ID失败\n");
+    } else {
+        std::vector<KnownTitle> known{};
+        {
+            std::scoped_lock lock{entries_mutex};
+            known.reserve(this->entries.Size());
+            for (std::size_t row = 0; row < this->entries.Size(); row++) {
+                known.push_back(KnownTitle{this->entries.Id(row), this->entries.RecordFingerprint(row), this->entries.IsCorrupted(row)});
+            }
+        }
+
+        const auto diff = TitleSnapshot::Diff(known, records);
+        total_count.store(records.size());
+        LOG("应用记录差异 (Record diff): %zu added, %zu updated, %zu removed, %zu unchanged\n",
+            diff.added.size(), diff.updated.size(), diff.removed.size(), diff.unchanged);
+
+        std::unordered_map<u64, u64> fingerprints{};
+        for (const auto& record : records) {
+            fingerprints[record.application_id] = TitleSnapshot::RecordFingerprint(record);
+        }
+
+        // 1. 已卸载的应用交给渲染线程批量移除，光标只由渲染线程修改
+        // 1. Uninstalled titles are handed to the render thread for batch removal, only the render thread moves the cursor
+        if (!diff.removed.empty()) {
+            std::scoped_lock lock{this->mutex};
+            this->pending_removals.insert(this->pending_removals.end(), diff.removed.begin(), diff.removed.end());
+        }
+        scanned_count = diff.unchanged + diff.updated.size();
+
+        // 2. 重新查询新增和更新的应用 (2. Re-query added and updated titles)
+        std::vector<u64> changed_ids{diff.added};
+        changed_ids.insert(changed_ids.end(), diff.updated.begin(), diff.updated.end());
+
+        // 3. 图标不在RGBA缓存中的未变化应用，只补取元数据中的图标
+        // 3. Unchanged titles whose icon is missing from the RGBA cache only refetch the icon from the metadata
+        std::vector<u64> icon_ids{};
+        {
+            const std::unordered_set<u64> changed(changed_ids.begin(), changed_ids.end());
+            std::scoped_lock lock{entries_mutex};
+            for (std::size_t row = 0; row < this->entries.Size(); row++) {
+                const u64 id = this->entries.Id(row);
+                if (!changed.contains(id) && this->entries.HasIcon(row) && !this->icon_cache.Contains(id, this->entries.IconHash(row))) {
+                    icon_ids.push_back(id);
+                }
+            }
+        }
+
+        AppScanner scanner{this->scan_config};
+        if (!changed_ids.empty()) {
+            auto metadata_fn = [this, &fingerprints](u64 application_id, AppEntry& entry) {
+                entry.record_fingerprint = fingerprints.at(application_id);
+                return FetchAppMetadata(application_id, entry);
+            };
+            auto size_fn = [this](u64 application_id, AppEntry& entry) {
+                GetAppSizeInfo(application_id, entry);
+            };
+            // 已存在的应用原位替换并保留选中状态，新应用追加到末尾
+            // Existing titles are replaced in place keeping their selection, new titles are appended
+            auto merge_fn = [this](std::vector<AppEntry>&& batch) {
+                std::scoped_lock lock{entries_mutex};
+                for (auto& entry : batch) {
+                    if (this->search_ready) {
+                        this->search_index.Upsert(entry.id, entry.name, entry.author);
+                    }
+                    if (!this->entries.Replace(std::move(entry))) {
+                        this->entries.Append(std::move(entry));
+                        scanned_count++;
+                    }
+                }
+                this->MarkTitleListChanged();
+            };
+            scanner.Run(stop_token, changed_ids, metadata_fn, size_fn, merge_fn);
+        }
+
+        if (!icon_ids.empty() && !stop_token.stop_requested()) {
+            auto metadata_fn = [this](u64 application_id, AppEntry& entry) {
+                return TryGetAppBasicInfoWithIconCache(application_id, entry);
+            };
+            auto merge_fn = [this](std::vector<AppEntry>&& batch) {
+                std::scoped_lock lock{entries_mutex};
+                for (auto& entry : batch) {
+                    if (entry.has_cached_icon) {
+                        this->entries.SetIconData(entry.id, std::move(entry.cached_icon_data), entry.icon_hash);
+                    }
+                }
+            };
+            scanner.Run(stop_token, icon_ids, metadata_fn, [](u64, AppEntry&) {}, merge_fn);
+        }
+
+        // 列表有变化或卸载后快照已过期时写回 (Write back when the list changed, or the snapshot went stale after uninstalling)
+        if ((!diff.Empty() || this->snapshot_dirty.exchange(false)) && !stop_token.stop_requested()) {
+            SaveTitleSnapshot();
+        }
+
+        LOG("增量刷新完成 (Incremental refresh finished): %zu re-queried, %zu icons refetched, %lld ms\n", changed_ids.size(), icon_ids.size(),
+            static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - refresh_start).count()));
+    }
+
+    // 从快照启动时没有完整扫描，首次刷新后建立搜索索引，之后的刷新原位更新
+    // Launching from the snapshot skips the full scan, so the search index is built after the first refresh and patched by later ones
+    {
+        std::scoped_lock lock{entries_mutex};
+        if (!this->search_ready) {
+            this->search_index.Build(this->entries);
+            this->search_ready = true;
+        }
+    }
+
+    is_scan_running = false;
+    nxtcFlushCacheFile();
+    nxtcExit();
+
+    std::scoped_lock lock{this->mutex};
+    this->finished_scanning = true;
+}
+
 
 // 计算当前可见区域的应用索引范围
 // Calculate the index range of applications in current visible area
 std::pair<size_t, size_t> App::GetVisibleRange() const {
-    std::scoped_lock lock{entries_mutex};
-    
-    if (entries.empty()) {
-        return {0, 0};
-    }
-    
-    // 屏幕上最多显示4个应用项
-    // Maximum 4 application items can be displayed on screen
-    constexpr size_t MAX_VISIBLE_ITEMS = 4;
-    
-    size_t visible_start = this->start;
-    size_t visible_end = std::min(visible_start + MAX_VISIBLE_ITEMS, entries.size());
-    
-    return {visible_start, visible_end};
+    // 包括滚动中部分可见的行 (Includes rows partially visible while scrolling)
+    return this->list_scroll.VisibleRange();
 }
 
 // 获取卸载界面的可见范围 (Get visible range for confirm interface)
@@ -2086,80 +2456,80 @@ std::pair<size_t, size_t> App::GetConfirmVisibleRange() const {
 // Viewport-aware smart icon loading: prioritize loading icons in visible area based on cursor position
 
 void App::LoadVisibleAreaIcons() {
+    // 每帧调用，读取已发布的视图而不锁定entries (Called every frame, reads the published view instead of locking entries)
+    const auto view = this->title_list.Acquire();
     // 如果应用列表为空，直接返回，避免没有应用的设备出现问题
     // If application list is empty, return directly to avoid issues on devices without apps
-    {
-        std::scoped_lock lock{entries_mutex};
-        if (entries.empty()) {
-            return;
-        }
+    if (view->rows.empty()) {
+        return;
     }
 
     auto now = std::chrono::steady_clock::now();
     
-    // 防抖：如果距离上次调用不足100ms，则跳过
-    // Debouncing: skip if less than 100ms since last call
+    // 防抖：静止时如果距离上次调用不足100ms，则跳过；滚动中每帧按预测范围加载
+    // Debouncing: skip if less than 100ms since last call while still; while scrolling, load the predicted range every frame
     constexpr auto DEBOUNCE_INTERVAL = std::chrono::milliseconds(100);
-    if (now - last_load_time < DEBOUNCE_INTERVAL) {
+    const bool scrolling = this->list_scroll.IsMoving();
+    if (!scrolling && now - last_load_time < DEBOUNCE_INTERVAL) {
         return;
     }
     last_load_time = now;
     
     auto [visible_start, visible_end] = GetVisibleRange();
-    
-    // 如果可见区域没有变化且不是强制重置状态，则跳过
-    // Skip if visible range hasn't changed and not in force reset state
-    if (last_loaded_range.first == visible_start && last_loaded_range.second == visible_end && 
-        last_loaded_range.first != SIZE_MAX) {
+
+    // 图标加载策略：按滚动速度和方向预测接下来会进入屏幕的行（包括向上），另在上方预加载1行、下方预加载2行
+    // Icon loading strategy: predict the rows about to scroll on screen from the scroll velocity and direction (upward too),
+    // plus 1 row above and 2 rows below
+    constexpr size_t PRELOAD_ABOVE = 1;
+    constexpr size_t PRELOAD_BELOW = 2;
+    // 单次预取的上限，避免一次快速滑动占满图集 (Cap on a single prefetch, so one fast fling cannot fill the atlas)
+    constexpr size_t MAX_PREFETCH_ROWS = 24;
+
+    auto [load_start, load_end] = this->list_scroll.PredictRange(PREFETCH_SECONDS);
+    load_start = std::max(load_start > PRELOAD_ABOVE ? load_start - PRELOAD_ABOVE : 0, visible_start > MAX_PREFETCH_ROWS ? visible_start - MAX_PREFETCH_ROWS : 0);
+    load_end = std::min(load_end + PRELOAD_BELOW, visible_end + MAX_PREFETCH_ROWS);
+    
+    // 如果加载范围没有变化且不是强制重置状态，则跳过
+    // Skip if the load range hasn't changed and not in force reset state
+    if (last_loaded_range.first == load_start && last_loaded_range.second == load_end) {
         return;
     }
-    last_loaded_range = {visible_start, visible_end};
-    
-    // 图标加载策略：加载当前屏幕4个应用和下方即将进入屏幕的应用
-    // Icon loading strategy: load current screen 4 apps and upcoming apps below
-    constexpr size_t PRELOAD_BUFFER = 2; // 下方预加载的应用数量
-    constexpr size_t FIRST_SCREEN_SIZE = 4; // 首屏应用数量
-    
-    size_t load_start = visible_start; // 从当前可见区域开始，不预加载上方
-    size_t load_end;
-    {
-        std::scoped_lock lock{entries_mutex};
-        load_end = std::min(visible_end + PRELOAD_BUFFER, entries.size());
-    }
+    last_loaded_range = {load_start, load_end};
     
     // 批量收集需要加载图标的应用信息，减少锁的使用
     // Batch collect applications that need icon loading to reduce lock usage
     struct LoadInfo {
         u64 application_id;
         int priority;
+        size_t distance; // 与可见区域的行距离 (Distance in rows from the visible area)
     };
     
     std::vector<LoadInfo> load_infos;
-    load_infos.reserve(load_end - load_start);
     
     {
-        std::scoped_lock lock{entries_mutex};
         // 确保索引范围有效
         // Ensure index range is valid
-        const size_t actual_end = std::min(load_end, entries.size());
+        const size_t actual_end = std::min(load_end, view->rows.size());
+        load_infos.reserve(actual_end > load_start ? actual_end - load_start : 0);
         
         for (size_t i = load_start; i < actual_end; ++i) {
-            const auto& entry = entries[i];
+            const u64 application_id = view->rows[i].id;
             
             // 优化：同时检查图标状态和损坏状态，减少后续处理
             // Optimization: check both icon status and corruption status to reduce subsequent processing
-            if (entry.image == this->default_icon_image && entry.name != corrupted_install) {
+            if (!this->icon_atlas.Contains(application_id) && !view->rows[i].corrupted) {
                 LoadInfo info;
-                info.application_id = entry.id;
+                info.application_id = application_id;
+                info.distance = i < visible_start ? visible_start - i : (i >= visible_end ? i - visible_end + 1 : 0);
                 
-                // 优先级策略：首屏4个应用最高优先级(0)，当前可见区域次高优先级(1)，其他为低优先级(2)
-                // Priority strategy: first screen 4 apps highest priority(0), current visible area medium priority(1), others low priority(2)
-                if (i < FIRST_SCREEN_SIZE) {
-                    info.priority = 0; // 首屏应用最高优先级
-                } else if (i >= visible_start && i < visible_end) {
-                    info.priority = 1; // 当前可见区域次高优先级
+                // 优先级策略：可见区域最高优先级(0)，一屏以内即将进入的行次高(1)，更远的预测行为低优先级(2)
+                // Priority strategy: visible rows highest (0), rows within a screen of entering next (1), further predicted rows low (2)
+                if (info.distance == 0) {
+                    info.priority = 0;
+                } else if (info.distance <= LIST_ROWS) {
+                    info.priority = 1;
                 } else {
-                    info.priority = 2; // 其他应用低优先级
+                    info.priority = 2;
                 }
                 
                 load_infos.push_back(std::move(info));
@@ -2167,11 +2537,21 @@ void App::LoadVisibleAreaIcons() {
         }
     }
     
+    // 视口移动后调整排队任务的优先级，取消已离开加载范围或已加载的图标 (After the viewport moves, re-prioritize queued tasks and cancel icons that left the load range or are already loaded)
+    this->resource_manager.reprioritize(ResourceTaskType::ICON, [&load_infos](u64 application_id) {
+        const auto it = std::ranges::find(load_infos, application_id, &LoadInfo::application_id);
+        return it != load_infos.end() ? it->priority : ResourceLoadManager::CANCEL_PRIORITY;
+    });
+    
     // 如果没有需要加载的图标，直接返回
     // Return early if no icons need loading
     if (load_infos.empty()) {
         return;
     }
+
+    // 已排队的应用在提交时合并，只有新进入范围的行入队 (Titles already queued merge on submit, only rows new to the range are enqueued)
+    // 同优先级按提交顺序处理，离可见区域近的行先提交 (Equal priorities run in submit order, so rows nearer the visible area go first)
+    std::ranges::stable_sort(load_infos, {}, &LoadInfo::distance);
     
     // 处理收集到的加载信息
     // Process collected loading information
@@ -2186,53 +2566,7 @@ void App::LoadVisibleAreaIcons() {
         icon_task.task_type = ResourceTaskType::ICON; // 标记为图标任务 (Mark as icon task)
         
         icon_task.load_callback = [this, application_id = info.application_id]() {
-            // 获取图标数据
-            // Get icon data
-            std::vector<unsigned char> icon_data;
-            bool has_icon_data = false;
-            
-            // 优先使用AppEntry中缓存的图标数据，避免重复的缓存读取
-            // Prioritize using cached icon data in AppEntry to avoid repeated cache reads
-            {
-                std::scoped_lock lock{entries_mutex};
-                auto it = std::find_if(entries.begin(), entries.end(),
-                    [application_id](const AppEntry& entry) {
-                        return entry.id == application_id && entry.has_cached_icon;
-                    });
-                
-                if (it != entries.end()) {
-                    icon_data = it->cached_icon_data;
-                    has_icon_data = true;
-                }
-            }
-            
-            
-             if (!has_icon_data) {
-                 return; // 没有可用的图标数据，直接返回
-             }
-            
-            // 验证并创建图像
-            // Validate and create image
-            if (has_icon_data && !icon_data.empty() && IsValidJpegData(icon_data)) {
-                int image_id = nvgCreateImageMem(this->vg, 0, icon_data.data(), icon_data.size());
-                if (image_id > 0) {
-                    std::scoped_lock lock{entries_mutex};
-                    auto it = std::find_if(entries.begin(), entries.end(),
-                        [application_id](const AppEntry& entry) {
-                            return entry.id == application_id;
-                        });
-                    
-                    if (it != entries.end()) {
-                        // 如果之前有自己的图像，先删除
-                        // If previously had own image, delete it first
-                        if (it->own_image && it->image != this->default_icon_image) {
-                            nvgDeleteImage(this->vg, it->image);
-                        }
-                        it->image = image_id;
-                        it->own_image = true;
-                    }
-                }
-            }
+            return this->LoadIconForApp(application_id);
         };
         
         this->resource_manager.submitLoadTask(icon_task);
@@ -2295,14 +2629,14 @@ void App::LoadConfirmVisibleAreaIcons() {
             if (i >= selected_indices.size()) break;
             
             const size_t entry_index = selected_indices[i];
-            if (entry_index >= entries.size()) continue;
+            if (entry_index >= this->entries.Size()) continue;
             
-            const auto& entry = entries[entry_index];
+            const u64 application_id = this->entries.Id(entry_index);
             
             // 如果图标未加载且应用未损坏，则添加到加载列表 (Add to load list if icon not loaded and app not corrupted)
-            if (entry.image == this->default_icon_image && entry.name != corrupted_install) {
+            if (!this->icon_atlas.Contains(application_id) && !this->entries.IsCorrupted(entry_index)) {
                 LoadInfo info;
-                info.application_id = entry.id;
+                info.application_id = application_id;
                 
                 // 设置优先级：当前屏幕内的应用优先级最高，预加载区域优先级较低
                 // Set priority: apps in current screen have highest priority, preload area has lower priority
@@ -2316,6 +2650,12 @@ void App::LoadConfirmVisibleAreaIcons() {
             }
         }
     }
+
+    // 取消已离开加载范围的图标任务 (Cancel icon tasks that left the load range)
+    this->resource_manager.reprioritize(ResourceTaskType::ICON, [&load_infos](u64 application_id) {
+        const auto it = std::ranges::find(load_infos, application_id, &LoadInfo::application_id);
+        return it != load_infos.end() ? it->priority : ResourceLoadManager::CANCEL_PRIORITY;
+    });
     
     // 如果没有需要加载的图标，直接返回 (Return early if no icons need loading)
     if (load_infos.empty()) {
@@ -2331,54 +2671,253 @@ void App::LoadConfirmVisibleAreaIcons() {
         icon_task.task_type = ResourceTaskType::ICON;
         
         icon_task.load_callback = [this, application_id = info.application_id]() {
-            // 获取图标数据 (Get icon data)
-            std::vector<unsigned char> icon_data;
-            bool has_icon_data = false;
-            
-            // 使用AppEntry中缓存的图标数据 (Use cached icon data in AppEntry)
-            {
-                std::scoped_lock lock{entries_mutex};
-                auto it = std::find_if(entries.begin(), entries.end(),
-                    [application_id](const AppEntry& entry) {
-                        return entry.id == application_id && entry.has_cached_icon;
-                    });
-                
-                if (it != entries.end()) {
-                    icon_data = it->cached_icon_data;
-                    has_icon_data = true;
-                }
-            }
-            
-            if (!has_icon_data) {
-                return; // 没有可用的图标数据，直接返回 (No available icon data, return early)
-            }
-            
-            // 验证并创建图像 (Validate and create image)
-            if (has_icon_data && !icon_data.empty() && IsValidJpegData(icon_data)) {
-                int image_id = nvgCreateImageMem(this->vg, 0, icon_data.data(), static_cast<int>(icon_data.size()));
-                if (image_id > 0) {
-                    std::scoped_lock lock{entries_mutex};
-                    auto it = std::find_if(entries.begin(), entries.end(),
-                        [application_id](const AppEntry& entry) {
-                            return entry.id == application_id;
-                        });
-                    
-                    if (it != entries.end()) {
-                        // 如果之前有自己的图像，先删除 (If previously had own image, delete it first)
-                        if (it->own_image && it->image != this->default_icon_image) {
-                            nvgDeleteImage(this->vg, it->image);
-                        }
-                        it->image = image_id;
-                        it->own_image = true;
-                    }
-                }
-            }
+            return this->LoadIconForApp(application_id);
         };
         
         this->resource_manager.submitLoadTask(icon_task);
     }
 }
 
+// 加载单个应用的图标，所有图标加载任务共用：只复制JPEG数据并交给后台解码池
+// Load one application's icon, shared by all icon loading tasks: only copies the JPEG and hands it to the decode pool
+bool App::LoadIconForApp(u64 application_id) {
+    IconDecodeRequest request{};
+    request.application_id = application_id;
+    {
+        std::scoped_lock lock{entries_mutex};
+        const std::size_t row = this->entries.FindRow(application_id);
+
+        // 没有可用的图标数据，或已经加载过 (No available icon data, or already loaded)
+        if (row == TitleTable::NPOS || !this->entries.HasIcon(row) || this->icon_atlas.Contains(application_id)) {
+            return false;
+        }
+        request.jpeg = this->entries.IconData(row);
+        request.icon_hash = this->entries.IconHash(row);
+    }
+
+    // 已在解码中的应用不算有效工作 (A title already decoding is not useful work)
+    return this->icon_decoder.Submit(std::move(request));
+}
+
+// 在时间预算内上传后台解码完成的图标（渲染线程）
+// Upload icons decoded in the background within the frame budget (render thread)
+void App::UploadDecodedIcons() {
+    this->icon_decoder.DrainDecoded(ICON_UPLOAD_BUDGET, [this](const DecodedIcon& icon) {
+        if (!this->icon_atlas.Insert(this->vg, icon.application_id, icon.rgba.data())) {
+            LOG("failed to insert icon %016lX into atlas\n", icon.application_id);
+        } else {
+            this->resource_manager.taskDisplayed(ResourceTaskType::ICON, icon.application_id);
+        }
+        this->MarkDirty();
+    });
+}
+
+// 批量移除已卸载的应用：由TitleTable通过ID索引标记后单次压缩，而不是每个应用线性查找并erase
+// Remove uninstalled titles in one batch: TitleTable marks them through the id index and compacts in a single pass,
+// instead of a linear find and erase per title
+void App::ApplyPendingRemovals() {
+    std::vector<AppID> removed;
+    {
+        std::scoped_lock lock{this->mutex};
+        if (this->pending_removals.empty()) {
+            return;
+        }
+        removed.swap(this->pending_removals);
+    }
+
+    {
+        std::scoped_lock lock{entries_mutex};
+        this->CatchUpTitleList();
+        // 记录光标所在的应用和屏幕行，删除后重新定位 (Remember the title and screen row under the cursor, re-anchor after erasing)
+        const std::size_t old_index = this->index;
+        const float cursor_top = this->list_scroll.RowTop(this->index);
+        const AppID anchor_id = old_index < this->entries.Size() ? this->entries.Id(old_index) : 0;
+
+        this->entries.Remove(removed);
+        this->search_index.Remove(removed);
+        this->delete_count = this->entries.CountSelected();
+
+        if (this->entries.Empty()) {
+            this->index = 0;
+        } else if (const std::size_t anchor_row = this->entries.FindRow(anchor_id); anchor_row != TitleTable::NPOS) {
+            this->index = anchor_row;
+        } else {
+            // 光标所在的应用被删除，停在原位置 (The title under the cursor was removed, stay at the same position)
+            this->index = std::min(old_index, this->entries.Size() - 1);
+        }
+        this->list_scroll.SetRowCount(this->entries.Size());
+        this->list_scroll.SetOffset(static_cast<float>(this->index) * BOX_HEIGHT - cursor_top);
+
+        this->PublishTitleList();
+    }
+
+    for (AppID app_id : removed) {
+        this->icon_atlas.Remove(app_id);
+    }
+    // 缓存文件的读写在解码线程上进行 (Cache file I/O stays on the decode workers)
+    this->icon_decoder.Invalidate(std::move(removed));
+}
+
+// 由entries构建渲染线程使用的只读视图，调用方须持有entries_mutex
+// Build the render thread's read-only view from entries, the caller must hold entries_mutex
+void App::PublishTitleList() {
+    // 视图包含到此为止的全部修改 (The view carries every change up to here)
+    this->title_list_dirty.store(false, std::memory_order_relaxed);
+    auto view = std::make_shared<TitleListView>();
+    view->version = ++this->title_list_version;
+    view->rows.reserve(this->entries.Size());
+    for (std::size_t row = 0; row < this->entries.Size(); row++) {
+        const bool selected = this->entries.IsSelected(row);
+        view->rows.push_back(TitleRow{this->entries.Id(row), this->entries.Name(row), this->entries.SizeNand(row),
+            this->entries.SizeSd(row), this->entries.SizeTotal(row), selected, this->entries.IsCorrupted(row)});
+        if (selected) {
+            view->selected_indices.push_back(row);
+        }
+    }
+    // 已选中容量由选中集合增量维护 (Selected totals are maintained incrementally by the selection set)
+    view->selected_nand = this->entries.SelectedNand();
+    view->selected_sd = this->entries.SelectedSd();
+    view->visible_selected = this->entries.CountVisibleSelected();
+    view->filtered = this->entries.IsFiltered();
+    view->moves = this->entries.MoveCount();
+    // TitleTable的索引指向存储槽，视图需要行号索引 (TitleTable's index maps to slots, the view needs one that maps to rows)
+    view->index.Rebuild(view->rows, [](const TitleRow& row) { return row.id; });
+    // 在锁内发布，保证视图的发布顺序与entries的修改顺序一致 (Publish under the lock so views go out in the order entries changed)
+    this->title_list.Publish(std::move(view));
+}
+
+// 扫描每批只花O(批大小)，整表复制留给每帧一次的FlushTitleList，而不是每批一次
+// Each scan batch only costs O(batch size), the whole-table copy is left to FlushTitleList once a frame instead of once a batch
+void App::MarkTitleListChanged() {
+    this->title_list_dirty.store(true, std::memory_order_release);
+}
+
+void App::FlushTitleList() {
+    if (!this->title_list_dirty.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::unique_lock lock{entries_mutex, std::try_to_lock};
+    if (!lock.owns_lock()) {
+        return;
+    }
+    this->PublishTitleList();
+}
+
+// 光标行是已发布视图中的行，entries可能已被后台修改；发布后再跟随光标，两者重新一致
+// The cursor row is a row of the published view and entries may have moved on in the background; publishing and following the cursor lines them up again
+void App::CatchUpTitleList() {
+    if (this->title_list_dirty.load(std::memory_order_relaxed)) {
+        this->PublishTitleList();
+    }
+    this->FollowCursor();
+}
+
+// 打开搜索键盘，模态键盘直接返回结果 (Open the search keyboard, the modal fallback returns its result right away)
+void App::OpenSearch() {
+    this->audio_manager.PlayKeySound(0.9);
+    this->search_query_before = this->search_query;
+    if (this->search_keyboard.Open(this->search_query, search_guide.c_str()) == SearchKeyboard::Event::DECIDED) {
+        std::scoped_lock lock{entries_mutex};
+        this->ApplySearch(this->search_keyboard.Text());
+    }
+    this->MarkDirty();
+}
+
+// 按查询过滤entries，结果按匹配等级排列；光标和滚动回到顶部
+// Filter entries by the query, results are ordered by match rank; the cursor and scroll go back to the top
+void App::ApplySearch(const std::string& query) {
+    [[maybe_unused]] const auto search_start = std::chrono::steady_clock::now(); // 用于调试计时 (For debug timing)
+    if (TitleSearchIndex::Normalize(query).empty()) {
+        if (!this->entries.IsFiltered()) {
+            return;
+        }
+        this->search_query.clear();
+        this->entries.ClearFilter();
+    } else {
+        this->search_query = query;
+        this->entries.SetFilter(this->search_index.Search(query));
+    }
+    LOG("搜索 (Search) \"%s\": %zu results, %lld us\n", this->search_query.c_str(), this->entries.Size(),
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - search_start).count()));
+
+    this->index = 0;
+    this->list_scroll.Reset();
+    this->list_scroll.SetRowCount(this->entries.Size());
+    // 强制重新加载可见区域的图标 (Force icons of the visible area to reload)
+    this->last_loaded_range = {SIZE_MAX, SIZE_MAX};
+    this->PublishTitleList();
+    this->MarkDirty();
+}
+
+// 取出删除协程发布的结果：卸载成功的应用交给ApplyPendingRemovals批量移除，删除完成后重置光标和待删除列表
+// Drain the results posted by the deletion coroutine: uninstalled titles go to ApplyPendingRemovals for batch removal,
+// and once deletion finishes the cursor and delete list are reset
+void App::DrainDeleteProgress() {
+    // 先读取关闭标志，保证关闭前发布的结果都在这次取出 (Read the closed flag first, so every result posted before closing is drained now)
+    const bool closed = this->delete_channel.is_closed();
+    std::vector<AppID> removed;
+    const std::size_t drained = this->delete_channel.drain([this, &removed](const DeleteResult& result) {
+        if (result.error) {
+            LOG("error whilst deleting AppID %lX\n", result.app_id);
+        } else {
+            removed.push_back(result.app_id);
+        }
+        this->delete_progress.latency_total += result.latency;
+        this->delete_progress.latency_count++;
+        this->delete_progress.index++;
+    });
+
+    // 整批只加一次锁 (One lock for the whole batch)
+    if (!removed.empty()) {
+        {
+            std::scoped_lock lock{this->mutex};
+            this->pending_removals.insert(this->pending_removals.end(), removed.begin(), removed.end());
+        }
+        total_count.fetch_sub(removed.size());
+        this->storage_stats.RequestRefresh();
+    }
+    if (drained) {
+        this->MarkDirty();
+    }
+
+    if (!closed || this->finished_deleting || !this->delete_channel.is_completed()) {
+        return;
+    }
+    LOG("finished deleting entries...\n");
+    this->finished_deleting = true;
+    this->delete_progress.finished = true;
+
+    // 卸载后快照已过期，回到列表时增量刷新 (The snapshot is stale after uninstalling, refresh incrementally back on the list)
+    this->snapshot_dirty = true;
+    this->refresh_requested = true;
+
+    // 所有选中的应用都已删除，这里直接设为0 (All selected apps are deleted, set to 0 here)
+    this->delete_count = 0;
+    this->index = 0;
+    this->list_scroll.Reset();
+    this->delete_entries.clear();
+}
+
+// 请求删除协程停止并等待其结束，等待期间持续取出结果，协程不会卡在已满的通道上
+// Ask the deletion coroutine to stop and wait for it, draining results meanwhile so it never sits on a full channel
+void App::StopDeleteTask() {
+    // 停止请求会唤醒等待通道空间的协程，协程关闭通道后结束并兑现future，直接等待即可
+    // The stop request wakes a coroutine waiting for channel space, it closes the channel and finishes, fulfilling the future, so just wait on it
+    this->delete_thread.request_stop();
+    this->delete_thread.get();
+    this->DrainDeleteProgress();
+}
+
+void App::ApplyStorageSpace(const StorageSpace& space) {
+    this->nand_storage_size_total = space.nand_total;
+    this->nand_storage_size_free = space.nand_free;
+    this->sdcard_storage_size_total = space.sd_total;
+    this->sdcard_storage_size_free = space.sd_free;
+    this->nand_storage_size_used = this->nand_storage_size_total - this->nand_storage_size_free;
+    this->sdcard_storage_size_used = this->sdcard_storage_size_total - this->sdcard_storage_size_free;
+    this->MarkDirty();
+}
+
 // 加载卸载界面的图标 (Load icons for uninstall interface)
 // 为卸载确认界面中的应用加载图标，确保独立于列表界面 (Load icons for apps in uninstall confirmation interface, independent of list interface)
 
@@ -2386,12 +2925,8 @@ void App::LoadConfirmVisibleAreaIcons() {
 App::App() {
     
 
-    nsGetTotalSpaceSize(NcmStorageId_SdCard, (s64*)&this->sdcard_storage_size_total);
-    nsGetFreeSpaceSize(NcmStorageId_SdCard, (s64*)&this->sdcard_storage_size_free);
-    nsGetTotalSpaceSize(NcmStorageId_BuiltInUser, (s64*)&this->nand_storage_size_total);
-    nsGetFreeSpaceSize(NcmStorageId_BuiltInUser, (s64*)&this->nand_storage_size_free);
-    this->nand_storage_size_used = this->nand_storage_size_total - this->nand_storage_size_free;
-    this->sdcard_storage_size_used = this->sdcard_storage_size_total - this->sdcard_storage_size_free;
+    // 启动时同步查询一次，之后由统计线程刷新 (Query once synchronously at startup, the stats thread refreshes afterwards)
+    this->ApplyStorageSpace(StorageStats::Query());
 
     LOG("nand total: %lu free: %lu used: %lu\n", this->nand_storage_size_total, this->nand_storage_size_free, this->nand_storage_size_used);
     LOG("sdcard total: %lu free: %lu used: %lu\n", this->sdcard_storage_size_total, this->sdcard_storage_size_free, this->sdcard_storage_size_used);
@@ -2428,6 +2963,11 @@ App::App() {
     const CMemPool::Handle cmdmem = this->pool_data->allocate(this->StaticCmdSize);
     this->cmdbuf.addMemory(cmdmem.getMemBlock(), cmdmem.getOffset(), cmdmem.getSize());
 
+    // 读取帧节奏配置，交换链深度在创建帧缓冲区前确定 (Read the pacing config, the swapchain depth is needed before the framebuffers are created)
+    const auto pacing_config = PacingConfig::Load("sdmc:/config/Untitled/display.ini");
+    this->framebuffer_count = pacing_config.swapchain_depth;
+    this->frame_pacer.Initialize(pacing_config);
+
     // Create the framebuffer resources
     this->createFramebufferResources();
     
@@ -2451,6 +2991,8 @@ App::App() {
     auto standard_font = nvgCreateFontMem(this->vg, "Standard", (unsigned char*)font_standard.address, font_standard.size, 0);
     auto extended_font = nvgCreateFontMem(this->vg, "Extended", (unsigned char*)font_extended.address, font_extended.size, 0);
     nvgAddFallbackFontId(this->vg, standard_font, extended_font);
+    this->font_atlas_cache.AddFont(font_standard);
+    this->font_atlas_cache.AddFont(font_extended);
     
 
     constexpr PlSharedFontType lang_font[] = {
@@ -2467,27 +3009,55 @@ App::App() {
             snprintf(name, sizeof(name), "Lang_%u", font_lang.type);
             auto lang_font = nvgCreateFontMem(this->vg, name, (unsigned char*)font_lang.address, font_lang.size, 0);
             nvgAddFallbackFontId(this->vg, standard_font, lang_font);
+            this->font_atlas_cache.AddFont(font_lang);
         } else {
             LOG("failed to load lang font %d\n", type);
         }
     }
+    // 语言文本和字体已确定，清空之前缓存的文本 (Language strings and fonts are settled, drop any text cached before)
+    gfx::getTextCache().Clear();
+
+    // 字体注册完成后恢复上次的字形图集，共享字体变化时缓存失效 (Restore the last glyph atlas once the fonts are registered, a changed shared font invalidates it)
+    if (!this->font_atlas_cache.Load(this->vg)) {
+        LOG("no usable font atlas cache\n");
+    }
+    this->glyphs_rasterized = nvgFontGlyphsRasterized(this->vg);
     
     
     
     
     this->default_icon_image = nvgCreateImage(this->vg, "romfs:/default_icon.jpg", NVG_IMAGE_NEAREST);
 
+    // 打开图标RGBA缓存，失败时退回到每次解码 (Open the icon RGBA cache, falls back to decoding every time on failure)
+    if (!this->icon_cache.Open()) {
+        LOG("failed to open icon cache\n");
+    }
+
+    // 有快照时立即显示列表，后台只校验变化的应用；否则完整扫描
+    // With a snapshot the list shows immediately and only changed titles are revalidated; otherwise do a full scan
+    // 排序键按界面语言生成，必须在加入任何应用之前设置 (Collation keys follow the UI language, set before any title is added)
+    this->entries.SetCollation(CollationLocaleFor(tj::LangManager::getInstance().getCurrentLanguage()));
+    this->snapshot_loaded = this->LoadTitleSnapshot();
+
     // 启动快速信息扫描
     // Start fast info scanning
-    this->async_thread = util::async([this](std::stop_token stop_token){
-            this->FastScanNames(stop_token);
+    this->async_thread = util::async(this->job_pool, [this](std::stop_token stop_token){
+            if (this->snapshot_loaded) {
+                this->RefreshTitles(stop_token);
+            } else {
+                this->FastScanNames(stop_token);
+            }
             // 名称扫描完成后，初始视口加载由每帧调用自动处理
             // After name scanning is complete, initial viewport loading is handled by per-frame calls
         }
     );
 
+    // 监听焦点变化，从HOME菜单返回时增量刷新 (Watch focus changes, refresh incrementally when returning from HOME)
+    appletHook(&this->applet_hook_cookie, App::OnAppletHook, this);
+
     padConfigureInput(1, HidNpadStyleSet_NpadStandard);
     padInitializeDefault(&this->pad);
+    hidInitializeTouchScreen();
     
     // 初始化音效管理器 (Initialize audio manager)
     this->audio_manager.Initialize();
@@ -2498,6 +3068,23 @@ App::App() {
  * 负责清理应用程序使用的所有资源，确保没有内存泄漏
  */
 App::~App() {
+    // 停止监听焦点变化 (Stop watching focus changes)
+    appletUnhook(&this->applet_hook_cookie);
+    LOG("skipped %lu idle frames\n", this->skipped_frames);
+    LOG("fling icon misses %lu/%lu rows\n", this->fling_icon_misses, this->fling_rows_drawn);
+    {
+        const auto stats = this->resource_manager.getStats();
+        LOG("icon tasks: submitted %lu merged %lu reprioritized %lu cancelled %lu executed %lu wasted %lu peak depth %zu\n",
+            stats.submitted, stats.merged, stats.reprioritized, stats.cancelled, stats.executed, stats.wasted, stats.peak_depth);
+        LOG("icon latency to display: %lu icons mean %.2fms max %.2fms\n", stats.displayed,
+            stats.displayed ? stats.latency_sum_us / 1000.0 / stats.displayed : 0.0, stats.latency_max_us / 1000.0);
+        (void)stats;
+    }
+#ifndef NDEBUG
+    this->frame_pacer.WriteReport("sdmc:/config/Untitled/frame_pacing.txt");
+#endif
+    this->frame_pacer.Exit();
+
     // 清理音效管理器 (Cleanup audio manager)
     this->audio_manager.Cleanup();
     
@@ -2507,17 +3094,15 @@ App::~App() {
         this->async_thread.get(); // 等待线程完成
     }
     
-    // 检查删除线程是否有效，如果有效则等待其完成
+    // 检查删除线程是否有效，如果有效则停止并等待其完成，未取出的结果直接丢弃
+    // If the deletion coroutine is running, stop it and wait, discarding the results nobody will draw
     if (this->delete_thread.valid()) {
-        this->delete_thread.get(); // 等待删除线程完成
+        this->delete_thread.request_stop();
+        this->delete_thread.get(); // 停止请求会唤醒等待通道空间的协程 (The stop request wakes a coroutine waiting for channel space)
     }
 
-    // 遍历所有应用条目，释放自行管理的图像资源
-    for (auto&p : this->entries) {
-        if (p.own_image) { // 仅释放由应用自己创建的图像
-            nvgDeleteImage(this->vg, p.image); // 删除nanovg图像
-        }
-    }
+    // 释放图标图集的页面纹理
+    this->icon_atlas.Destroy(this->vg);
 
     // 释放默认图标图像资源
     nvgDeleteImage(this->vg, default_icon_image);
@@ -2527,6 +3112,11 @@ App::~App() {
     for (unsigned i = 0; i < NumCommandBuffers; ++i) {
         this->waitForCommandCompletion(i);
     }
+
+    // 保存本次新增的字形 (Save the glyphs rasterized this session)
+    if (!this->font_atlas_cache.Save(this->vg)) {
+        LOG("failed to save font atlas cache\n");
+    }
     
     // 销毁帧缓冲区相关资源
     this->destroyFramebufferResources();
@@ -2568,10 +3158,10 @@ void App::createFramebufferResources() {
         .initialize(layout_framebuffer);
 
     // Create the framebuffers
-    std::array<DkImage const*, NumFramebuffers> fb_array;
+    std::array<DkImage const*, MaxFramebuffers> fb_array{};
     const uint64_t fb_size  = layout_framebuffer.getSize();
     const uint32_t fb_align = layout_framebuffer.getAlignment();
-    for (unsigned i = 0; i < fb_array.size(); i++) {
+    for (unsigned i = 0; i < this->framebuffer_count; i++) {
         // Allocate a framebuffer
         this->framebuffers_mem[i] = pool_images->allocate(fb_size, fb_align);
         this->framebuffers[i].initialize(layout_framebuffer, framebuffers_mem[i].getMemBlock(), framebuffers_mem[i].getOffset());
@@ -2589,7 +3179,7 @@ void App::createFramebufferResources() {
     // 启用垂直同步以避免画面撕裂
     NWindow* nwin = nwindowGetDefault();
     nwindowSetSwapInterval(nwin, 1); // 设置交换间隔为1，启用垂直同步
-    this->swapchain = dk::SwapchainMaker{device, nwin, fb_array}.create();
+    this->swapchain = dk::SwapchainMaker{device, nwin, fb_array.data(), this->framebuffer_count}.create();
 
     // Generate the main rendering cmdlist
     this->recordStaticCommands();
@@ -2606,7 +3196,7 @@ void App::destroyFramebufferResources() {
     swapchain.destroy();
 
     // Destroy the framebuffers
-    for (unsigned i = 0; i < NumFramebuffers; i++) {
+    for (unsigned i = 0; i < this->framebuffer_count; i++) {
         framebuffers_mem[i].destroy();
     }
 
@@ -2640,30 +3230,27 @@ void App::recordStaticCommands() {
 // GPU命令优化：准备下一个命令缓冲区
 // GPU command optimization: Prepare next command buffer
 void App::prepareNextCommandBuffer() {
-    // 等待当前命令缓冲区完成（如果已提交）
-    // Wait for current command buffer completion (if submitted)
+    // 切换到下一个命令缓冲区，上一帧的命令继续在GPU上执行
+    // Switch to the next command buffer, the previous frame's commands keep running on the GPU
+    this->current_cmdbuf_index = (this->current_cmdbuf_index + 1) % NumCommandBuffers;
+
+    // 只等待即将重用的缓冲区（两帧前提交）完成
+    // Only wait for the buffer about to be reused (submitted two frames ago) to complete
     if (this->command_submitted[this->current_cmdbuf_index]) {
         this->waitForCommandCompletion(this->current_cmdbuf_index);
         this->command_submitted[this->current_cmdbuf_index] = false;
     }
-    
-    // 切换到下一个命令缓冲区
-    // Switch to next command buffer
-    this->current_cmdbuf_index = (this->current_cmdbuf_index + 1) % NumCommandBuffers;
 }
 
 // GPU命令优化：提交当前命令缓冲区
 // GPU command optimization: Submit current command buffer
 void App::submitCurrentCommandBuffer() {
     if (this->dynamic_cmdlists[this->current_cmdbuf_index]) {
-        // 设置同步点
-        // Set synchronization point
-        this->dynamic_cmdbufs[this->current_cmdbuf_index].signalFence(this->command_fences[this->current_cmdbuf_index]);
-        
-        // 提交命令列表
-        // Submit command list
+        // 提交命令列表（同步点已在Draw中录制）
+        // Submit command list (the synchronization point is recorded in Draw)
         this->queue.submitCommands(this->dynamic_cmdlists[this->current_cmdbuf_index]);
         this->command_submitted[this->current_cmdbuf_index] = true;
+        this->profiler.GpuSubmitted(this->current_cmdbuf_index);
     }
 }
 
@@ -2674,6 +3261,17 @@ void App::waitForCommandCompletion(unsigned buffer_index) {
         // 等待fence信号
         // Wait for fence signal
         this->command_fences[buffer_index].wait();
+        this->profiler.GpuCompleted(buffer_index);
+    }
+}
+
+// 非阻塞查询已提交的栅栏，记录GPU完成时间
+// Poll submitted fences without blocking, recording GPU completion times
+void App::pollCommandFences() {
+    for (unsigned i = 0; i < NumCommandBuffers; i++) {
+        if (this->command_submitted[i] && this->profiler.IsGpuPending(i) && this->command_fences[i].wait(0) == DkResult_Success) {
+            this->profiler.GpuCompleted(i);
+        }
     }
 }
 
@@ -3,7 +3,24 @@
 #include "nanovg/nanovg.h"
 #include "nanovg/deko3d/dk_renderer.hpp"
 #include "async.hpp"
+#include "coro.hpp"
 #include "audio_manager.hpp"
+#include "app_scanner.hpp"
+#include "icon_cache.hpp"
+#include "font_atlas_cache.hpp"
+#include "icon_decoder.hpp"
+#include "icon_atlas.hpp"
+#include "title_snapshot.hpp"
+#include "storage_stats.hpp"
+#include "frame_profiler.hpp"
+#include "title_list_view.hpp"
+#include "title_table.hpp"
+#include "frame_pacer.hpp"
+#include "list_scroller.hpp"
+#include "resource_load_manager.hpp"
+#include "title_search.hpp"
+#include "search_keyboard.hpp"
+#include "app_entry.hpp"
 
 #include <switch.h>
 #include <cstdint>
@@ -11,17 +28,15 @@
 #include <string>
 #include <future>
 #include <mutex>
+#include <atomic>
 #include <optional>
 #include <functional>
 #include <stop_token>
 #include <utility>
-#include <queue>
 #include <chrono>
 
 namespace tj {
 
-using AppID = std::uint64_t;
-
 enum class MenuMode { LOAD, LIST, CONFIRM };
 
 struct Controller final {
@@ -44,6 +59,13 @@ struct Controller final {
     // RIGHT+A组合键相关变量 (RIGHT+A combination key related variables)
     // 简单检测：只要两个键都按下就触发，避免重复触发 (Simple detection: trigger when both keys are pressed, avoid repeated triggering)
     bool RIGHT_AND_A = false; // RIGHT+A组合键状态 (RIGHT+A combination key state)
+    // 分析器组合键：L3+R3切换帧耗时图表，-+R3导出trace (Profiler combos: L3+R3 toggles the frame graph, -+R3 dumps a trace)
+    bool PROFILER_TOGGLE = false;
+    bool PROFILER_DUMP = false;
+    // 触摸屏第一个触点，坐标为屏幕像素 (First touch point, in screen pixels)
+    bool TOUCH = false;
+    float touch_x{};
+    float touch_y{};
 
     static constexpr int MAX = 1000;
     static constexpr int MAX_STEP = 250;
@@ -53,69 +75,15 @@ struct Controller final {
     void UpdateButtonHeld(bool& down, bool held);
 };
 
-struct AppEntry final {
-    std::string name;
-    std::string author;
-    std::string display_version;
-    std::size_t size_nand;
-    std::size_t size_sd;
-    std::size_t size_total;
-    AppID id;
-    int image;
-    bool selected{false};
-    bool own_image{false};
-    
-    // 缓存的原始图标数据，避免重复从缓存读取
-    // Cached raw icon data to avoid repeated cache reads
-    std::vector<unsigned char> cached_icon_data;
-    bool has_cached_icon{false};
-};
-
-struct NsDeleteData final {
-    std::vector<AppID> entries;
-    std::function<void(bool)> del_cb; // called when deleted an entry
-    std::function<void(void)> done_cb; // called when finished
-};
-
-// 资源加载任务结构体
-// Resource loading task structure
-enum class ResourceTaskType {
-    ICON     // 图标加载任务 (Icon loading task)
-};
-
-struct ResourceLoadTask {
-    u64 application_id;
-    std::function<void()> load_callback;
-    std::chrono::steady_clock::time_point submit_time;
-    int priority; // 优先级，数值越小优先级越高 (Priority, lower value = higher priority)
-    ResourceTaskType task_type; // 任务类型 (Task type)
+// 删除协程每卸载一个应用发布一条结果 (The deletion coroutine posts one result per uninstalled title)
+struct DeleteResult final {
+    AppID app_id;
+    bool error;
+    std::chrono::microseconds latency;
 };
 
-// 资源加载管理器
-// Resource loading manager
-class ResourceLoadManager {
-private:
-    // 优先级队列比较器：优先级数值越小，优先级越高
-    // Priority queue comparator: lower priority value = higher priority
-    struct TaskComparator {
-        bool operator()(const ResourceLoadTask& a, const ResourceLoadTask& b) const {
-            if (a.priority != b.priority) {
-                return a.priority > b.priority; // 优先级高的在前 (Higher priority first)
-            }
-            return a.submit_time > b.submit_time; // 相同优先级按提交时间排序 (Same priority sorted by submit time)
-        }
-    };
-    
-    std::priority_queue<ResourceLoadTask, std::vector<ResourceLoadTask>, TaskComparator> pending_tasks;
-    mutable std::mutex task_mutex;
-    static constexpr int MAX_ICON_LOADS_PER_FRAME = 2;  // 每帧最大图标加载数量 (Max icon loads per frame)
-    
-public:
-    void submitLoadTask(const ResourceLoadTask& task);
-    void processFrameLoads(); // 在每帧调用 (Called every frame)
-    bool hasPendingTasks() const;
-    size_t getPendingTaskCount() const;
-};
+// 删除协程到渲染线程的进度通道，最多积压64条结果 (Progress channel from the deletion coroutine to the render thread, up to 64 results in flight)
+using DeleteChannel = util::SpscChannel<DeleteResult, 64>;
 
 class App final {
 public:
@@ -134,9 +102,28 @@ private:
     // Get application size information
     void GetAppSizeInfo(u64 application_id, AppEntry& entry);
     
+    // 获取应用元数据，失败时标记为损坏的安装 (Get application metadata, marks a corrupted install on failure)
+    bool FetchAppMetadata(u64 application_id, AppEntry& entry);
+
     // 分离式扫描：第一阶段快速扫描应用名称
     // Separated scanning: Phase 1 - Fast scan application names
     void FastScanNames(std::stop_token stop_token);
+
+    // 从快照加载应用列表，启动时立即显示 (Load the title list from the snapshot, shown immediately at launch)
+    bool LoadTitleSnapshot();
+
+    // 将当前应用列表写入快照 (Write the current title list to the snapshot)
+    void SaveTitleSnapshot();
+
+    // 增量刷新：只重新查询新增、更新和删除的应用，原位更新entries
+    // Incremental refresh: only re-query added, updated and removed titles, patching entries in place
+    void RefreshTitles(std::stop_token stop_token);
+
+    // 扫描和删除空闲时启动待执行的增量刷新 (Start a pending incremental refresh once scanning and deletion are idle)
+    void StartIncrementalRefresh();
+
+    // 焦点变化回调，从HOME菜单返回时请求刷新 (Focus change hook, requests a refresh when returning from HOME)
+    static void OnAppletHook(AppletHookType hook, void* param);
     
 
     
@@ -145,6 +132,52 @@ private:
     void LoadVisibleAreaIcons();
 
     void LoadConfirmVisibleAreaIcons(); // 卸载界面的可见区域图标加载 (Visible area icon loading for uninstall interface)
+
+    // 加载单个应用的图标：提交到后台解码池 (Load one application's icon: submit it to the background decode pool)
+    bool LoadIconForApp(u64 application_id);
+
+    // 在每帧时间预算内上传已解码的图标 (Upload decoded icons within the per-frame time budget)
+    void UploadDecodedIcons();
+
+    // 批量移除已卸载的应用（渲染线程） (Remove uninstalled titles in one batch, render thread)
+    void ApplyPendingRemovals();
+
+    // 已发布的视图插入或移动行后让光标跟随原来的应用（渲染线程）
+    // Keep the cursor on its title after a published view inserted or moved rows (render thread)
+    void FollowCursor();
+
+    // 由entries构建并立即发布渲染线程使用的视图，调用方须持有entries_mutex
+    // Build the render thread's view from entries and publish it right away, the caller must hold entries_mutex
+    void PublishTitleList();
+
+    // 后台写入方修改entries后调用，只做标记，由渲染线程每帧最多发布一次；调用方须持有entries_mutex
+    // Called by background writers after changing entries, only marks the list, the render thread publishes it at most once a frame;
+    // the caller must hold entries_mutex
+    void MarkTitleListChanged();
+
+    // 每帧调用，发布后台写入方的修改；写入方持有锁时留到下一帧，不等待
+    // Called every frame, publishes the background writers' changes; left for the next frame while a writer holds the lock, never waits
+    void FlushTitleList();
+
+    // 渲染线程修改entries前调用：先发布后台的修改，使光标行与entries一致，调用方须持有entries_mutex
+    // Called before the render thread changes entries: publishes the background changes first so the cursor row matches entries,
+    // the caller must hold entries_mutex
+    void CatchUpTitleList();
+
+    // 打开搜索键盘，需要时自行锁定entries_mutex (Open the search keyboard, locks entries_mutex itself when needed)
+    void OpenSearch();
+
+    // 按查询过滤entries，空查询恢复完整列表，调用方须持有entries_mutex
+    // Filter entries by the query, an empty query restores the full list, the caller must hold entries_mutex
+    void ApplySearch(const std::string& query);
+
+    // 复制删除进度供本帧绘制使用 (Copy the deletion progress for this frame's drawing)
+    void DrainDeleteProgress();
+    // 停止删除协程并取出剩余结果 (Stop the deletion coroutine and drain the remaining results)
+    void StopDeleteTask();
+
+    // 更新存储空间信息 (Update the storage space information)
+    void ApplyStorageSpace(const StorageSpace& space);
     std::pair<size_t, size_t> GetConfirmVisibleRange() const; // 获取卸载界面可见范围 (Get visible range for confirm interface)
     
     // 计算当前可见区域的应用索引范围
@@ -165,7 +198,7 @@ private:
     static constexpr auto LOAD_DEBOUNCE_MS = std::chrono::milliseconds(100); // 防抖延迟100ms (100ms debounce delay)
 
     NVGcontext* vg{nullptr};
-    std::vector<AppEntry> entries;
+    TitleTable entries; // entries_mutex locked
     std::vector<AppID> delete_entries;
     PadState pad{};
     Controller controller{};
@@ -178,27 +211,81 @@ private:
     std::size_t sdcard_storage_size_used{};
     std::size_t sdcard_storage_size_free{};
 
+    // 扫描、刷新和删除会长时间阻塞在系统服务上，放在专用线程池而不是共享线程池，图标解码不会排在它们后面；
+    // 扫描或刷新可能与删除同时运行，各占一个工作线程。必须在async_thread和delete_thread之前声明
+    // Scans, refreshes and deletions block on system services for a long time, so they run on a dedicated pool instead of the
+    // shared one and icon decodes never queue behind them; a scan or refresh may run alongside a deletion, one worker each.
+    // Must be declared before async_thread and delete_thread
+    util::ThreadPool job_pool{util::ThreadPoolConfig{.worker_count = 2}};
     util::AsyncFurture<void> async_thread;
-    util::AsyncFurture<void> delete_thread; // 专门用于删除操作的线程 (Thread specifically for deletion operations)
+    util::AsyncFurture<void> delete_thread; // 专用线程池上运行的删除协程 (Deletion coroutine running on the job pool)
+    DeleteChannel delete_channel{}; // 删除结果，渲染线程每帧取出 (Deletion results, drained by the render thread every frame)
     std::mutex mutex{};
     static std::mutex entries_mutex;
-    std::size_t delete_index{}; // mutex locked
     bool finished_scanning{false}; // mutex locked
-    bool finished_deleting{false}; // mutex locked
+    bool finished_deleting{false}; // 渲染线程，删除通道关闭时置位 (Render thread, set once the deletion channel closes)
     bool deletion_interrupted{false}; // 标记是否发生过删除中断 (Flag to mark if deletion was interrupted)
     double deleted_nand_bytes{0.0}; // 已删除应用在NAND上的总字节数 (Total bytes of deleted applications on NAND)
     double deleted_sd_bytes{0.0}; // 已删除应用在SD卡上的总字节数 (Total bytes of deleted applications on SD card)
     std::size_t deleted_app_count{0}; // 已删除应用的数量 (Number of deleted applications)
     std::size_t selected_nand_total_bytes{0}; // 已选中应用在NAND上的总容量 (Total capacity of selected applications on NAND)
     std::size_t selected_sd_total_bytes{0}; // 已选中应用在SD卡上的总容量 (Total capacity of selected applications on SD card)
+    std::vector<AppID> pending_removals; // mutex locked, 已卸载但尚未从entries移除的应用 (Uninstalled titles not yet removed from entries)
+    TitleListPublisher title_list{}; // 渲染线程读取的应用列表视图 (Title list view read by the render thread)
+    TitleSearchIndex search_index{}; // entries_mutex locked, 名称和发行商的搜索索引 (Search index over names and publishers)
+    std::atomic<bool> search_ready{false}; // 名称扫描完成后建立索引，渲染线程不加锁读取 (Set once the index is built after the name scan, read by the render thread without locking)
+    SearchKeyboard search_keyboard{}; // 搜索输入 (Search input)
+    std::string search_query; // 当前过滤的查询，为空时显示完整列表 (Query of the current filter, the full list shows when empty)
+    std::string search_query_before; // 打开键盘前的查询，取消时恢复 (Query before opening the keyboard, restored on cancel)
+    u64 title_list_version{}; // entries_mutex locked
+    std::atomic<bool> title_list_dirty{false}; // 写入方在entries_mutex内置位，有尚未发布的修改 (Set by writers under entries_mutex, there are unpublished changes)
+
+    // 渲染线程每帧从删除通道累积的进度，绘制时无需加锁 (Deletion progress accumulated from the channel by the render thread each frame, so drawing takes no lock)
+    struct DeleteProgress {
+        bool finished;
+        std::size_t index;
+        double deleted_nand_bytes;
+        double deleted_sd_bytes;
+        std::chrono::microseconds latency_total; // 每个应用删除耗时的总和，用于估算剩余时间 (Summed per-title deletion latency, for the ETA)
+        std::size_t latency_count;
+    };
+    DeleteProgress delete_progress{};
+    StorageStats storage_stats{}; // 存储空间统计线程 (Storage stats thread)
     static std::atomic<bool> initial_batch_loaded;
     static std::atomic<size_t> scanned_count;
     static std::atomic<size_t> total_count;
     static std::atomic<bool> is_scan_running;
+    static std::atomic<bool> is_size_pass_running; // 名称已到齐，大小仍在计算 (Names are in, sizes are still being computed)
+    ScanConfig scan_config{}; // 并行扫描配置 (Parallel scan configuration)
 
     // 资源加载管理器
     // Resource loading manager
     ResourceLoadManager resource_manager;
+    ResourceLoadManager::Stats resource_stats{}; // 上一帧的调度统计，用于计算每帧增量 (Scheduler stats at the previous frame, for per-frame deltas)
+
+    // 已解码图标的持久化缓存，约48MB (Persistent cache of decoded icons, about 48MB)
+    IconCache icon_cache{"sdmc:/config/Untitled/icon_cache.bin", 48 * 1024 * 1024};
+
+    // 字形图集缓存，热启动时跳过CJK字形的光栅化 (Glyph atlas cache, warm launches skip rasterizing CJK glyphs)
+    FontAtlasCache font_atlas_cache{"sdmc:/config/Untitled/font_atlas.bin"};
+    int glyphs_rasterized{}; // 上一帧结束时的光栅化计数 (Rasterization count at the end of the last frame)
+
+    // 后台图标解码池，必须在icon_cache之后声明 (Background icon decode pool, must be declared after icon_cache)
+    IconDecodePool icon_decoder{icon_cache};
+    static constexpr auto ICON_UPLOAD_BUDGET = std::chrono::microseconds(4000); // 每帧图标上传预算4ms (4ms icon upload budget per frame)
+
+    // 图标纹理图集，所有已加载的图标共享少量纹理 (Icon texture atlas, all loaded icons share a few textures)
+    IconAtlas icon_atlas{};
+
+    // 应用列表快照，存在时跳过完整扫描 (Title list snapshot, skips the full scan when present)
+    TitleSnapshot title_snapshot{"sdmc:/config/Untitled/title_snapshot.bin"};
+    bool snapshot_loaded{false};
+    std::atomic<bool> snapshot_dirty{false}; // 卸载后快照已过期 (Snapshot is stale after uninstalling)
+
+    // 增量刷新请求，来自焦点恢复或卸载完成 (Incremental refresh request, from regaining focus or finishing an uninstall)
+    std::atomic<bool> refresh_requested{false};
+    AppletHookCookie applet_hook_cookie{};
+    bool lost_focus{false}; // 焦点回调在主线程中调用 (The focus hook runs on the main thread)
     
     // 每帧资源加载控制
     // Per-frame resource loading control
@@ -207,26 +294,75 @@ private:
 
     // this is just bad code, ignore it
     static constexpr float BOX_HEIGHT{120.f};
-    float yoff{130.f};
-    float ypos{130.f};
+    static constexpr float LIST_TOP{130.f}; // 第一行的顶部 (Top of the first row)
+    static constexpr std::size_t LIST_ROWS{4}; // 完整显示的行数 (Rows shown in full)
+    // 列表的连续滚动位置，取代按行步进 (Continuous scroll position of the list, replaces row stepping)
+    ListScroller list_scroll{BOX_HEIGHT, BOX_HEIGHT * LIST_ROWS};
+    // 图标预取按滑动速度预测的时长，约30帧 (How far ahead icon prefetch predicts the scroll, about 30 frames)
+    static constexpr float PREFETCH_SECONDS{0.5f};
+    u64 fling_rows_drawn{}; // 滚动中绘制的行数 (Rows drawn while scrolling)
+    u64 fling_icon_misses{}; // 其中缺少图标的行数 (Of those, rows missing their icon)
     std::size_t confirm_start{0};
-    std::size_t start{0};
     std::size_t delete_count{0};
     std::size_t index{}; // where i am in the array
+    AppID cursor_id{}; // 上一帧结束时光标所在的应用 (Title under the cursor at the end of the last frame)
+    u64 cursor_moves{}; // 上次跟随光标时视图的moves (The view's moves when the cursor last followed)
+    std::atomic<std::size_t> size_focus_row{0}; // 大小计算优先处理的行，渲染线程每帧更新 (Row the size pass favours, updated by the render thread every frame)
     std::size_t confirm_index{}; // 确认界面中选中的索引 (Selected index in confirm menu)
     std::vector<std::size_t> selected_indices; // 确认界面中已选中应用的索引列表 (List of indices of selected applications in confirm menu)
     MenuMode menu_mode{MenuMode::LOAD};
 
     bool quit{false};
 
+    // Y键按此顺序循环切换排序方式 (Y cycles through the sort modes in this order)
     enum class SortType {
         Size_BigSmall,
+        Size_SmallBig,
         Alphabetical,
+        Alphabetical_ZA,
+        Nand_BigSmall,
+        Nand_SmallBig,
+        Sd_BigSmall,
+        Sd_SmallBig,
+        Author_AZ,
+        Author_ZA,
+        TitleId_Asc,
+        TitleId_Desc,
         MAX,
     };
 
     uint8_t sort_type{std::to_underlying(SortType::Size_BigSmall)};
     float FPS{0.0f}; // 当前帧率 (Current frame rate)
+    FrameProfiler profiler{}; // 帧耗时分析器 (Frame profiler)
+    FramePacer frame_pacer{}; // 按垂直同步推进主循环 (Paces the main loop on vsync)
+
+    // 画面内容来源的快照，与上次绘制时不同则需要重绘 (Snapshot of what the frame shows, a redraw is needed when it differs from the last draw)
+    struct FrameSources {
+        MenuMode menu_mode;
+        u64 title_list_version;
+        std::size_t scanned_count;
+        std::size_t total_count;
+        bool scan_running;
+        bool size_pass_running;
+        bool delete_running;
+        bool delete_finished;
+        std::size_t delete_index;
+        double deleted_nand_bytes;
+        double deleted_sd_bytes;
+
+        bool operator==(const FrameSources&) const = default;
+    };
+    FrameSources drawn_sources{}; // 上次绘制时的来源 (Sources at the last draw)
+    bool frame_dirty{true}; // 输入、图标到达或存储空间变化后置位 (Set by input, icon arrivals and storage changes)
+    u32 frames_since_draw{}; // 距上次绘制经过的帧数 (Frames since the last draw)
+    u64 skipped_frames{}; // 累计跳过的帧数 (Total frames skipped)
+    // 空闲时脉冲边框和帧耗时图表的刷新间隔，约10Hz (Refresh interval of the pulse border and frame graph while idle, about 10Hz)
+    static constexpr u32 IDLE_REDRAW_FRAMES{6};
+
+    // 标记画面需要重绘 (Mark the frame as needing a redraw)
+    void MarkDirty() { this->frame_dirty = true; }
+    FrameSources CurrentFrameSources() const;
+    bool ShouldDraw() const;
     
     AudioManager audio_manager; // 音效管理器 (Audio manager)
 
@@ -234,6 +370,7 @@ private:
     void Update();
     void Poll();
 
+    // 按当前排序方式排序entries，调用方须持有entries_mutex (Sort entries by the current sort mode, the caller must hold entries_mutex)
     void Sort();
     const char* GetSortStr();
 
@@ -247,10 +384,11 @@ private:
     void DrawList();
     void DrawConfirm();
 
-    Result GetAllApplicationIds(std::vector<u64>& app_ids);
+    Result GetAllApplicationRecords(std::vector<NsApplicationRecord>& records);
 
 private: // from nanovg decko3d example by adubbz
-    static constexpr unsigned NumFramebuffers = 2;
+    static constexpr unsigned MaxFramebuffers = PacingConfig::MAX_SWAPCHAIN_DEPTH;
+    unsigned framebuffer_count{PacingConfig::MIN_SWAPCHAIN_DEPTH}; // 交换链深度，启动时从配置读取 (Swapchain depth, read from the config at startup)
     static constexpr unsigned StaticCmdSize = 0x1000;
     dk::UniqueDevice device;
     dk::UniqueQueue queue;
@@ -259,10 +397,10 @@ private: // from nanovg decko3d example by adubbz
     std::optional<CMemPool> pool_data;
     dk::UniqueCmdBuf cmdbuf;
     CMemPool::Handle depthBuffer_mem;
-    CMemPool::Handle framebuffers_mem[NumFramebuffers];
+    CMemPool::Handle framebuffers_mem[MaxFramebuffers];
     dk::Image depthBuffer;
-    dk::Image framebuffers[NumFramebuffers];
-    DkCmdList framebuffer_cmdlists[NumFramebuffers];
+    dk::Image framebuffers[MaxFramebuffers];
+    DkCmdList framebuffer_cmdlists[MaxFramebuffers];
     dk::UniqueSwapchain swapchain;
     DkCmdList render_cmdlist;
     std::optional<nvg::DkRenderer> renderer;
@@ -287,6 +425,7 @@ private: // from nanovg decko3d example by adubbz
     void prepareNextCommandBuffer();
     void submitCurrentCommandBuffer();
     void waitForCommandCompletion(unsigned buffer_index);
+    void pollCommandFences();
 };
 
 } // namespace tj
@@ -0,0 +1,38 @@
+// 应用记录的辅助函数 (Helpers for title records)
+#include "app_entry.hpp"
+
+#include <cstring>
+
+namespace tj {
+
+namespace {
+
+// NACP字符串不保证以0结尾 (NACP strings are not guaranteed to be NUL terminated)
+template<std::size_t N>
+void AssignField(std::string& out, const char (&field)[N]) {
+    out.assign(field, strnlen(field, N));
+}
+
+} // namespace
+
+void ReadNacpText(const NacpStruct& nacp, int language, AppEntry& entry) {
+    constexpr int LANGUAGE_COUNT = static_cast<int>(sizeof(nacp.lang) / sizeof(nacp.lang[0]));
+    const NacpLanguageEntry* language_entry = &nacp.lang[language >= 0 && language < LANGUAGE_COUNT ? language : 0];
+
+    // 如果当前语言条目为空，则遍历查找第一个非空条目
+    // If the current language entry is empty, iterate to find the first non-empty entry
+    if (language_entry->name[0] == '\0' && language_entry->author[0] == '\0') {
+        for (const auto& lang : nacp.lang) {
+            if (lang.name[0] != '\0' || lang.author[0] != '\0') {
+                language_entry = &lang;
+                break;
+            }
+        }
+    }
+
+    AssignField(entry.name, language_entry->name);
+    AssignField(entry.author, language_entry->author);
+    AssignField(entry.display_version, nacp.display_version);
+}
+
+} // namespace tj
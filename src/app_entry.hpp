@@ -0,0 +1,38 @@
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace tj {
+
+using AppID = std::uint64_t;
+
+// 扫描结果的暂存记录，合并后按列存入TitleTable (Staging record for scan results, stored column-wise in TitleTable once merged)
+struct AppEntry final {
+    std::string name;
+    std::string author;
+    std::string display_version;
+    std::size_t size_nand;
+    std::size_t size_sd;
+    std::size_t size_total;
+    AppID id;
+    bool selected{false};
+    bool corrupted{false}; // 损坏的安装 (Corrupted install)
+    bool size_pending{false}; // 大小由后台另行计算 (Sizes are computed later by the background pass)
+    
+    // 缓存的原始图标数据，避免重复从缓存读取
+    // Cached raw icon data to avoid repeated cache reads
+    std::vector<unsigned char> cached_icon_data;
+    bool has_cached_icon{false};
+    u64 icon_hash{}; // 图标JPEG数据的哈希，用于图标缓存 (Hash of the icon JPEG, keys the icon cache)
+    u64 record_fingerprint{}; // 应用记录的指纹，用于检测应用更新 (Application record fingerprint, detects updates)
+};
+
+// 从NACP读取名称、发行商和显示版本，language条目为空时使用第一个非空的语言条目
+// Read the name, publisher and display version from the NACP, using the first non-empty language entry when language's is empty
+void ReadNacpText(const NacpStruct& nacp, int language, AppEntry& entry);
+
+} // namespace tj
@@ -0,0 +1,240 @@
+// 并行应用扫描器 (Parallel application scanner)
+#include "app_scanner.hpp"
+#include "app_entry.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <condition_variable>
+#include <bit>
+
+namespace tj {
+
+namespace {
+
+// 将当前工作线程绑定到核心掩码中的第n个可用核心
+// Pin the current worker thread to the n-th available core in the mask
+void PinWorkerToCore(u32 core_mask, std::size_t worker_index) {
+    const int available = std::popcount(core_mask);
+    if (available <= 0) {
+        return;
+    }
+
+    int nth = static_cast<int>(worker_index % static_cast<std::size_t>(available));
+    for (int core = 0; core < 32; core++) {
+        if (!(core_mask & BIT(core))) {
+            continue;
+        }
+        if (nth-- == 0) {
+            svcSetThreadCoreMask(CUR_THREAD_HANDLE, core, BIT(core));
+            return;
+        }
+    }
+}
+
+// 按配置的策略让出CPU (Yield the CPU according to the configured policy)
+void MaybeYield(const ScanConfig& config, std::size_t& processed) {
+    if (config.yield_policy == ScanYieldPolicy::NONE || config.yield_every == 0) {
+        return;
+    }
+    if (++processed % config.yield_every != 0) {
+        return;
+    }
+
+    if (config.yield_policy == ScanYieldPolicy::SLEEP) {
+        svcSleepThread(std::chrono::duration_cast<std::chrono::nanoseconds>(config.yield_duration).count());
+    } else {
+        // 0表示仅让给同优先级线程，不迁移核心 (0 yields to same-priority threads without core migration)
+        svcSleepThread(0);
+    }
+}
+
+// 合并缓冲区：结果攒够一批或等待过久时交给合并回调，回调串行执行
+// Merge buffer: results go to the merge callback once a batch fills or has waited too long, callbacks run serialized
+class MergeBuffer {
+public:
+    MergeBuffer(const ScanConfig& config, const AppScanner::MergeFn& merge_fn, ScanStats& stats)
+        : config{config}, merge_fn{merge_fn}, stats{stats} {
+        pending.reserve(config.merge_batch_size);
+    }
+
+    void Push(AppEntry&& entry) {
+        std::scoped_lock lock{mutex};
+        const auto now = std::chrono::steady_clock::now();
+        if (pending.empty()) {
+            pending_since = now;
+        }
+        pending.emplace_back(std::move(entry));
+        if (pending.size() >= config.merge_batch_size || now - pending_since >= config.merge_max_latency) {
+            FlushLocked();
+        }
+    }
+
+    void Flush() {
+        std::scoped_lock lock{mutex};
+        FlushLocked();
+    }
+
+private:
+    // 持有mutex时调用 (Called with mutex held)
+    void FlushLocked() {
+        if (pending.empty()) {
+            return;
+        }
+        stats.titles += pending.size();
+        stats.batches++;
+        std::vector<AppEntry> batch;
+        batch.swap(pending);
+        pending.reserve(config.merge_batch_size);
+        merge_fn(std::move(batch));
+    }
+
+    const ScanConfig& config;
+    const AppScanner::MergeFn& merge_fn;
+    ScanStats& stats;
+    std::mutex mutex;
+    std::vector<AppEntry> pending;
+    std::chrono::steady_clock::time_point pending_since{};
+};
+
+} // namespace
+
+AppScanner::AppScanner(const ScanConfig& config) : config{config} {
+    if (this->config.metadata_workers == 0) {
+        this->config.metadata_workers = 1;
+    }
+    if (this->config.size_workers == 0) {
+        this->config.size_workers = 1;
+    }
+    if (this->config.merge_batch_size == 0) {
+        this->config.merge_batch_size = 1;
+    }
+}
+
+ScanStats AppScanner::Run(std::stop_token stop_token, const std::vector<u64>& app_ids, const MetadataFn& metadata_fn, const SizeFn& size_fn, const MergeFn& merge_fn) {
+    ScanStats stats{};
+    const auto scan_start = std::chrono::steady_clock::now();
+
+    // 元数据队列：按索引原子领取 (Metadata queue: claimed by atomic index)
+    std::atomic<std::size_t> next_index{0};
+    std::atomic<std::size_t> metadata_workers_left{this->config.metadata_workers};
+
+    // 大小队列：元数据完成的应用等待计算大小 (Size queue: titles waiting for size calculation)
+    std::mutex size_mutex;
+    std::condition_variable_any size_cv;
+    std::deque<AppEntry> size_queue;
+
+    // 合并缓冲区 (Merge buffer)
+    MergeBuffer merger{this->config, merge_fn, stats};
+
+    auto metadata_worker = [&](std::size_t worker_index) {
+        PinWorkerToCore(this->config.core_mask, worker_index);
+        std::size_t processed{};
+
+        while (!stop_token.stop_requested()) {
+            const auto i = next_index.fetch_add(1, std::memory_order_relaxed);
+            if (i >= app_ids.size()) {
+                break;
+            }
+
+            AppEntry entry{};
+            if (metadata_fn(app_ids[i], entry)) {
+                {
+                    std::scoped_lock lock{size_mutex};
+                    size_queue.emplace_back(std::move(entry));
+                }
+                size_cv.notify_one();
+            } else {
+                // 损坏的应用无需计算大小，直接合并 (Corrupted titles skip the size stage)
+                merger.Push(std::move(entry));
+            }
+
+            MaybeYield(this->config, processed);
+        }
+
+        // 最后一个元数据线程退出时唤醒所有大小线程 (Last metadata worker wakes all size workers on exit)
+        if (metadata_workers_left.fetch_sub(1) == 1) {
+            std::scoped_lock lock{size_mutex};
+            size_cv.notify_all();
+        }
+    };
+
+    auto size_worker = [&](std::size_t worker_index) {
+        PinWorkerToCore(this->config.core_mask, worker_index);
+        std::size_t processed{};
+
+        while (true) {
+            AppEntry entry;
+            {
+                std::unique_lock lock{size_mutex};
+                const bool has_work = size_cv.wait(lock, stop_token, [&]() {
+                    return !size_queue.empty() || metadata_workers_left.load() == 0;
+                });
+                if (!has_work || size_queue.empty()) {
+                    break;
+                }
+                entry = std::move(size_queue.front());
+                size_queue.pop_front();
+            }
+
+            size_fn(entry.id, entry);
+            merger.Push(std::move(entry));
+
+            MaybeYield(this->config, processed);
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(this->config.metadata_workers + this->config.size_workers);
+        for (std::size_t i = 0; i < this->config.metadata_workers; i++) {
+            workers.emplace_back(metadata_worker, i);
+        }
+        for (std::size_t i = 0; i < this->config.size_workers; i++) {
+            workers.emplace_back(size_worker, this->config.metadata_workers + i);
+        }
+        // jthread析构时自动join (jthread joins on destruction)
+    }
+
+    merger.Flush();
+
+    stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - scan_start);
+    return stats;
+}
+
+ScanStats AppScanner::RunSizePass(std::stop_token stop_token, const NextFn& next_fn, const SizeFn& size_fn, const MergeFn& merge_fn) {
+    ScanStats stats{};
+    const auto scan_start = std::chrono::steady_clock::now();
+    MergeBuffer merger{this->config, merge_fn, stats};
+
+    auto size_worker = [&](std::size_t worker_index) {
+        PinWorkerToCore(this->config.core_mask, worker_index);
+        std::size_t processed{};
+
+        u64 application_id{};
+        while (!stop_token.stop_requested() && next_fn(application_id)) {
+            AppEntry entry{};
+            entry.id = application_id;
+            size_fn(application_id, entry);
+            merger.Push(std::move(entry));
+
+            MaybeYield(this->config, processed);
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(this->config.size_workers);
+        for (std::size_t i = 0; i < this->config.size_workers; i++) {
+            workers.emplace_back(size_worker, i);
+        }
+    }
+
+    merger.Flush();
+
+    stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - scan_start);
+    return stats;
+}
+
+} // namespace tj
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <functional>
+#include <stop_token>
+#include <chrono>
+
+namespace tj {
+
+struct AppEntry;
+
+// 工作线程让出CPU的策略 (Per-worker yield policy)
+enum class ScanYieldPolicy {
+    NONE,       // 从不让出，尽可能快地扫描 (Never yield, scan as fast as possible)
+    YIELD,      // 每处理yield_every个应用调用一次svcSleepThread(0) (svcSleepThread(0) every yield_every titles)
+    SLEEP,      // 每处理yield_every个应用休眠yield_duration (Sleep yield_duration every yield_every titles)
+};
+
+// 扫描器配置 (Scanner configuration)
+struct ScanConfig {
+    // 元数据工作线程数量（名称/图标，走nxtc缓存或NS） (Metadata worker count - name/icon via nxtc cache or NS)
+    std::size_t metadata_workers{2};
+    // 大小计算工作线程数量（nsCalculateApplicationOccupiedSize） (Size worker count)
+    std::size_t size_workers{2};
+    // 每批合并到entries的最大应用数量 (Max titles merged into entries per batch)
+    std::size_t merge_batch_size{8};
+    // 批次未满时的最长等待时间，避免首屏等待 (Max wait before flushing a partial batch, keeps first screen responsive)
+    std::chrono::milliseconds merge_max_latency{50};
+    // 工作线程让出策略 (Worker yield policy)
+    ScanYieldPolicy yield_policy{ScanYieldPolicy::YIELD};
+    std::size_t yield_every{4};
+    std::chrono::microseconds yield_duration{500};
+    // 工作线程可用的CPU核心掩码，核心0留给渲染线程，与线程池一致 (Core mask for workers, core 0 is left to the render thread like the thread pool)
+    u32 core_mask{BIT(1) | BIT(2)};
+};
+
+// 扫描统计信息 (Scan statistics)
+struct ScanStats {
+    std::size_t titles{};
+    std::size_t batches{};
+    std::chrono::microseconds elapsed{};
+
+    double TitlesPerSecond() const {
+        if (elapsed.count() <= 0) {
+            return 0.0;
+        }
+        return static_cast<double>(titles) * 1000000.0 / static_cast<double>(elapsed.count());
+    }
+};
+
+// 并行应用扫描器：元数据和大小计算分别在独立的工作队列上运行，结果按批次合并
+// Parallel application scanner: metadata and size calculation run on separate worker queues, results are merged in batches
+// 扫描不改写为协程：nsGetApplicationControlData和nsCalculateApplicationOccupiedSize是同步IPC，libnx没有异步版本，
+// 协程无法在调用中途挂起，每个进行中的调用仍要占用一个线程；工作线程加批量合并本身就是流水线。删除写成协程是因为它只有
+// 一个顺序的生产者，需要渲染线程的背压
+// Scanning is not a coroutine: nsGetApplicationControlData and nsCalculateApplicationOccupiedSize are synchronous IPC with
+// no async variant in libnx, so a coroutine cannot suspend across them and every call in flight still holds a thread; the
+// worker threads plus the batched merge already are the pipeline. Deletion is a coroutine because it is a single
+// sequential producer that needs backpressure from the render thread
+class AppScanner {
+public:
+    // 返回false表示应用已损坏，跳过大小计算阶段 (Return false to mark the title corrupted and skip the size stage)
+    using MetadataFn = std::function<bool(u64 application_id, AppEntry& entry)>;
+    using SizeFn = std::function<void(u64 application_id, AppEntry& entry)>;
+    using MergeFn = std::function<void(std::vector<AppEntry>&& batch)>;
+    // 领取下一个要计算大小的应用，返回false表示没有剩余 (Claim the next title to size, return false when none are left)
+    using NextFn = std::function<bool(u64& application_id)>;
+
+    explicit AppScanner(const ScanConfig& config);
+
+    // 阻塞直到所有应用扫描完成或请求停止 (Blocks until all titles are scanned or stop is requested)
+    ScanStats Run(std::stop_token stop_token, const std::vector<u64>& app_ids, const MetadataFn& metadata_fn, const SizeFn& size_fn, const MergeFn& merge_fn);
+
+    // 只计算大小：size_workers个线程每次通过next_fn领取一个应用，调用方可以按当前视口决定顺序
+    // Size pass only: size_workers threads claim one title at a time through next_fn, so the caller picks the order from the current viewport
+    // 合并的应用只填写id和大小 (Merged entries only carry the id and sizes)
+    ScanStats RunSizePass(std::stop_token stop_token, const NextFn& next_fn, const SizeFn& size_fn, const MergeFn& merge_fn);
+
+private:
+    ScanConfig config;
+};
+
+} // namespace tj
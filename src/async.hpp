@@ -1,12 +1,16 @@
 #pragma once
 
+#include "thread_pool.hpp"
+
 #include <future>
 #include <stop_token>
+#include <functional>
+#include <concepts>
+#include <type_traits>
 
 namespace util {
 
 // simple wrapper for future + stop token.
-// todo: write my own std::async with token source added, like jthread.
 template<typename T>
 class AsyncFurture {
 public:
@@ -86,22 +90,42 @@ template<typename Fn, typename... Args>
 using AsyncResult = typename std::invoke_result<
     typename std::decay<Fn>::type, typename std::decay<Args>::type...>::type;
 
+// runs fn on the pool, arguments are decay-copied like std::async.
+template<typename R, typename Fn, typename... Args>
+auto submit_task(ThreadPool& pool, Fn&& fn, Args&&... args) -> std::future<R> {
+    std::packaged_task<R()> task{[fn = std::forward<Fn>(fn), ...args = std::forward<Args>(args)]() mutable -> R {
+        return std::invoke(std::move(fn), std::move(args)...);
+    }};
+    auto future = task.get_future();
+    pool.submit(std::move(task));
+    return future;
+}
+
 // enabled if function DOES start with std::stop_token
 template<typename Fn, typename... Args, typename = std::enable_if<std::is_invocable_v<std::decay_t<Fn>, std::stop_token, std::decay_t<Args>...>>>
-auto async(Fn&& fn, Args&&... args) -> AsyncFurture<AsyncResult<Fn, std::stop_token, Args...>> {
+auto async(ThreadPool& pool, Fn&& fn, Args&&... args) -> AsyncFurture<AsyncResult<Fn, std::stop_token, Args...>> {
     std::stop_source source_token;
     return AsyncFurture{
-        std::async(std::launch::async, std::forward<Fn>(fn), source_token.get_token(), std::forward<Args>(args)...),
+        submit_task<AsyncResult<Fn, std::stop_token, Args...>>(pool, std::forward<Fn>(fn), source_token.get_token(), std::forward<Args>(args)...),
         std::move(source_token)
     };
 }
 
 // enabled if function does NOT start with std::stop_token
 template<typename Fn, typename... Args, typename = std::enable_if<!std::is_invocable_v<std::decay_t<Fn>, std::stop_token, std::decay_t<Args>...>>>
-auto async(Fn&& fn, Args&&... args) -> AsyncFurture<AsyncResult<Fn, Args...>> {
+auto async(ThreadPool& pool, Fn&& fn, Args&&... args) -> AsyncFurture<AsyncResult<Fn, Args...>> {
     return AsyncFurture{
-        std::async(std::launch::async, std::forward<Fn>(fn), std::forward<Args>(args)...)
+        submit_task<AsyncResult<Fn, Args...>>(pool, std::forward<Fn>(fn), std::forward<Args>(args)...)
     };
 }
 
+// same as above, on the shared pool instead of a fresh thread per call.
+// meant for short tasks, long blocking jobs should pass a pool of their own.
+// a pool passed as fn would resolve back to this overload and recurse forever, so it is excluded.
+template<typename Fn, typename... Args>
+requires (!std::same_as<std::remove_cvref_t<Fn>, ThreadPool>)
+auto async(Fn&& fn, Args&&... args) {
+    return async(ThreadPool::shared(), std::forward<Fn>(fn), std::forward<Args>(args)...);
+}
+
 } // namespace util
@@ -0,0 +1,219 @@
+/**
+ * @file collation.cpp
+ * @brief 排序键的实现
+ */
+#include "collation.hpp"
+#include "text_fold.hpp"
+
+#include <algorithm>
+
+namespace tj {
+
+namespace {
+
+// 各文字的第一级权重起点，数值越小越靠前 (Primary weight bases per script, lower sorts first)
+constexpr u16 W_SEPARATOR = 0x0001;
+constexpr u16 W_NUMBER = 0x0100;        ///< 数字串：先是长度，再是每一位 (Digit run: the length, then every digit)
+constexpr u16 W_CYRILLIC_FIRST = 0x0F00;
+constexpr u16 W_LATIN = 0x1000;
+constexpr u16 W_GREEK = 0x1100;
+constexpr u16 W_CYRILLIC = 0x1200;
+constexpr u16 W_HANGUL_JAMO = 0x2000;
+constexpr u16 W_HANGUL_COMPAT = 0x2100;
+constexpr u16 W_HANGUL = 0x2200;
+constexpr u16 W_PROLONGED = 0x4FFF;     ///< 长音符ー排在所有假名之前 (The prolonged sound mark sorts before every kana)
+constexpr u16 W_KANA = 0x5000;
+constexpr u16 W_HAN = 0x6000;
+constexpr u16 W_HAN_EXT_A = 0xB200;
+constexpr u16 W_OTHER = 0xFFFF;         ///< 其他字符：后跟码位的高低16位 (Anything else: followed by the high and low halves of the code point)
+
+// ñ在西班牙语中的占位码位（私用区） (Placeholder code point for the Spanish ñ, private use area)
+constexpr char32_t SPANISH_ENYE = 0xE000;
+
+enum KanaVariant : u8 {
+    KANA_PLAIN,
+    KANA_SMALL,
+    KANA_VOICED,
+    KANA_SEMI_VOICED,
+};
+
+/**
+ * @brief 片假名的基本字和变体：小写、浊音和半浊音与基本字共用第一级权重
+ */
+char32_t KanaBase(char32_t c, u8& variant) {
+    variant = KANA_PLAIN;
+    // ァ..オ：奇数为小写 (ァ..オ: odd code points are small)
+    if (c <= 0x30AA) {
+        if (c & 1) {
+            variant = KANA_SMALL;
+            return c + 1;
+        }
+        return c;
+    }
+    // カ..ヂ：偶数为浊音 (カ..ヂ: even code points are voiced)
+    if (c <= 0x30C2) {
+        if (!(c & 1)) {
+            variant = KANA_VOICED;
+            return c - 1;
+        }
+        return c;
+    }
+    if (c == 0x30C3) { // ッ
+        variant = KANA_SMALL;
+        return 0x30C4;
+    }
+    // ツ..ド：奇数为浊音 (ツ..ド: odd code points are voiced)
+    if (c <= 0x30C9) {
+        if (c & 1) {
+            variant = KANA_VOICED;
+            return c - 1;
+        }
+        return c;
+    }
+    if (c <= 0x30CE) { // ナ..ノ
+        return c;
+    }
+    // ハ..ポ：每三个一组，依次为清音、浊音、半浊音 (ハ..ポ: groups of three, plain, voiced and semi-voiced)
+    if (c <= 0x30DD) {
+        const u32 r = (c - 0x30CF) % 3;
+        variant = r == 0 ? KANA_PLAIN : r == 1 ? KANA_VOICED : KANA_SEMI_VOICED;
+        return c - r;
+    }
+    if (c <= 0x30E2) { // マ..モ
+        return c;
+    }
+    // ャ..ヨ：奇数为小写 (ャ..ヨ: odd code points are small)
+    if (c <= 0x30E8) {
+        if (c & 1) {
+            variant = KANA_SMALL;
+            return c + 1;
+        }
+        return c;
+    }
+    switch (c) {
+        case 0x30EE: variant = KANA_SMALL; return 0x30EF;   // ヮ
+        case 0x30F4: variant = KANA_VOICED; return 0x30A6;  // ヴ
+        case 0x30F5: variant = KANA_SMALL; return 0x30AB;   // ヵ
+        case 0x30F6: variant = KANA_SMALL; return 0x30B1;   // ヶ
+        case 0x30F7: case 0x30F8: case 0x30F9: case 0x30FA: // ヷ..ヺ
+            variant = KANA_VOICED;
+            return c - 8;
+        default:
+            return c;
+    }
+}
+
+void PushWeight(std::string& key, u16 weight) {
+    key.push_back(static_cast<char>(weight >> 8));
+    key.push_back(static_cast<char>(weight & 0xFF));
+}
+
+} // namespace
+
+CollationLocale CollationLocaleFor(int language) {
+    // 取值为NACP语言序号 (Values are NACP language indices)
+    switch (language) {
+        case 5:  // 拉丁美洲西班牙语 (Latin American Spanish)
+        case 6:  // 西班牙语 (Spanish)
+            return CollationLocale::SPANISH;
+        case 11: // 俄语 (Russian)
+            return CollationLocale::RUSSIAN;
+        default:
+            return CollationLocale::ROOT;
+    }
+}
+
+std::string MakeCollationKey(std::string_view text, CollationLocale locale) {
+    // 先折叠为码位序列，合并连续的分隔符 (Fold into code points first, collapsing runs of separators)
+    std::u32string folded;
+    folded.reserve(text.size());
+    for (std::size_t i = 0; i < text.size();) {
+        const char32_t raw = DecodeUtf8(text, i);
+        char32_t c = (locale == CollationLocale::SPANISH && (raw == U'ñ' || raw == U'Ñ')) ? SPANISH_ENYE : FoldCodePoint(raw);
+        if (c == FOLD_SEPARATOR && (folded.empty() || folded.back() == FOLD_SEPARATOR)) {
+            continue;
+        }
+        folded.push_back(c);
+    }
+    if (!folded.empty() && folded.back() == FOLD_SEPARATOR) {
+        folded.pop_back();
+    }
+
+    std::string key;
+    key.reserve(folded.size() * 2 + 8);
+    std::string secondary;
+    for (std::size_t i = 0; i < folded.size(); i++) {
+        char32_t c = folded[i];
+        if (c == FOLD_SEPARATOR) {
+            PushWeight(key, W_SEPARATOR);
+        } else if (c >= U'0' && c <= U'9') {
+            // 数字串按数值比较：去掉前导0，位数少的在前 (Digit runs compare by value: leading zeros dropped, fewer digits first)
+            std::size_t end = i;
+            while (end < folded.size() && folded[end] >= U'0' && folded[end] <= U'9') {
+                end++;
+            }
+            while (i + 1 < end && folded[i] == U'0') {
+                i++;
+            }
+            PushWeight(key, static_cast<u16>(W_NUMBER + std::min<std::size_t>(end - i, 0xFF)));
+            for (; i < end; i++) {
+                PushWeight(key, static_cast<u16>(W_NUMBER + (folded[i] - U'0')));
+            }
+            i--;
+        } else if (c >= U'a' && c <= U'z') {
+            PushWeight(key, static_cast<u16>(W_LATIN + (c - U'a') * 2));
+        } else if (c == SPANISH_ENYE) {
+            PushWeight(key, static_cast<u16>(W_LATIN + (U'n' - U'a') * 2 + 1));
+        } else if (c >= 0x391 && c <= 0x3C9) {
+            // 希腊字母转小写，词尾σ与σ相同 (Greek to lower case, final sigma equals sigma)
+            if (c <= 0x3A9) {
+                c += 0x20;
+            }
+            if (c == 0x3C2) {
+                c = 0x3C3;
+            }
+            PushWeight(key, static_cast<u16>(W_GREEK + (c - 0x391)));
+        } else if (c >= 0x430 && c <= 0x45F) {
+            // ё紧跟在е之后 (ё follows е directly)
+            const u16 offset = c == 0x451 ? (0x435 - 0x430) * 2 + 1 : (c - 0x430) * 2;
+            PushWeight(key, static_cast<u16>((locale == CollationLocale::RUSSIAN ? W_CYRILLIC_FIRST : W_CYRILLIC) + offset));
+        } else if (c >= 0x1100 && c <= 0x11FF) {
+            PushWeight(key, static_cast<u16>(W_HANGUL_JAMO + (c - 0x1100)));
+        } else if (c >= 0x3131 && c <= 0x318E) {
+            PushWeight(key, static_cast<u16>(W_HANGUL_COMPAT + (c - 0x3131)));
+        } else if (c >= 0xAC00 && c <= 0xD7A3) {
+            PushWeight(key, static_cast<u16>(W_HANGUL + (c - 0xAC00)));
+        } else if (c == 0x30FC) {
+            PushWeight(key, W_PROLONGED);
+        } else if (c >= 0x30A1 && c <= 0x30FA) {
+            u8 variant;
+            const char32_t base = KanaBase(c, variant);
+            PushWeight(key, static_cast<u16>(W_KANA + (base - 0x30A0)));
+            secondary.push_back(static_cast<char>(variant + 1));
+        } else if (c >= 0x4E00 && c <= 0x9FFF) {
+            PushWeight(key, static_cast<u16>(W_HAN + (c - 0x4E00)));
+        } else if (c >= 0x3400 && c <= 0x4DBF) {
+            PushWeight(key, static_cast<u16>(W_HAN_EXT_A + (c - 0x3400)));
+        } else {
+            PushWeight(key, W_OTHER);
+            PushWeight(key, static_cast<u16>(c >> 16));
+            PushWeight(key, static_cast<u16>(c & 0xFFFF));
+        }
+    }
+
+    if (!secondary.empty()) {
+        key.append(2, '\0');
+        key += secondary;
+    }
+    return key;
+}
+
+u64 CollationPrefix(std::string_view key) {
+    u64 prefix = 0;
+    for (std::size_t i = 0; i < 8; i++) {
+        prefix = (prefix << 8) | (i < key.size() ? static_cast<unsigned char>(key[i]) : 0);
+    }
+    return prefix;
+}
+
+} // namespace tj
@@ -0,0 +1,51 @@
+/**
+ * @file collation.hpp
+ * @brief 按界面语言生成排序键，排序时只需比较整数和字节串
+ *        (Collation keys for the UI language, so sorting only compares integers and byte strings)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tj {
+
+/**
+ * @brief 排序规则
+ *
+ * 默认顺序为数字、拉丁、希腊、西里尔、韩文、假名、汉字。汉字按码位（部首笔画）排列，没有拼音或读音表。
+ * The default order is digits, Latin, Greek, Cyrillic, Hangul, kana, then Han. Han characters are ordered by code
+ * point (radical and stroke), there is no pinyin or reading table.
+ */
+enum class CollationLocale : u8 {
+    ROOT,       ///< 默认顺序 (Default order)
+    SPANISH,    ///< ñ是n之后的独立字母 (ñ is a letter of its own after n)
+    RUSSIAN,    ///< 西里尔字母排在拉丁字母之前 (Cyrillic before Latin)
+};
+
+/**
+ * @brief 按LangManager::getCurrentLanguage返回的语言选择排序规则
+ */
+CollationLocale CollationLocaleFor(int language);
+
+/**
+ * @brief 生成排序键，按字节比较的顺序即排序顺序
+ *
+ * 第一级为每个字符的16位权重（大端）：大小写、全角半角、重音和平假名片假名不区分，标点只作为词间隔，
+ * 连续的数字按数值比较。第二级在两个0字节之后，区分假名的清音、浊音、半浊音和小写。
+ *
+ * The primary level holds a 16-bit big-endian weight per character: case, width, accents and hiragana versus
+ * katakana are ignored, punctuation only separates words, and runs of digits compare by value. The secondary
+ * level follows two zero bytes and tells apart plain, voiced, semi-voiced and small kana.
+ */
+std::string MakeCollationKey(std::string_view text, CollationLocale locale);
+
+/**
+ * @brief 排序键的前8字节（大端，不足补0），前缀不同时即可决定顺序
+ *        (First 8 bytes of a key, big-endian and zero padded, which decide the order whenever they differ)
+ */
+u64 CollationPrefix(std::string_view key);
+
+} // namespace tj
@@ -0,0 +1,341 @@
+#pragma once
+
+#include "async.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
+#include <optional>
+#include <utility>
+#include <coroutine>
+#include <stop_token>
+#include <type_traits>
+
+namespace util {
+
+// lazily started generator, resumed by the loop that iterates it.
+// the body runs on whichever thread pulls the next value.
+template<typename T>
+class Generator {
+public:
+    struct promise_type {
+        std::optional<T> value{};
+
+        Generator get_return_object() noexcept {
+            return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T v) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            this->value = std::move(v);
+            return {};
+        }
+        void return_void() noexcept {}
+        // built without exceptions, nothing can be thrown.
+        void unhandled_exception() noexcept { std::abort(); }
+    };
+
+    struct sentinel {};
+
+    class iterator {
+    public:
+        explicit iterator(std::coroutine_handle<promise_type> h) : handle{h} {}
+        T& operator*() const { return *this->handle.promise().value; }
+        iterator& operator++() {
+            this->handle.resume();
+            return *this;
+        }
+        bool operator==(sentinel) const noexcept { return this->handle.done(); }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    Generator(Generator&& g) noexcept : handle{std::exchange(g.handle, {})} {}
+    ~Generator() {
+        if (this->handle) {
+            this->handle.destroy();
+        }
+    }
+
+    // disable copying
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    iterator begin() {
+        this->handle.resume();
+        return iterator{this->handle};
+    }
+    sentinel end() const noexcept { return {}; }
+
+private:
+    explicit Generator(std::coroutine_handle<promise_type> h) : handle{h} {}
+    std::coroutine_handle<promise_type> handle{};
+};
+
+template<typename T>
+class Task;
+
+namespace detail {
+
+template<typename T>
+struct TaskResult {
+    std::optional<T> result{};
+    void return_value(T v) { this->result = std::move(v); }
+    T take() { return std::move(*this->result); }
+};
+
+template<>
+struct TaskResult<void> {
+    void return_void() noexcept {}
+    void take() noexcept {}
+};
+
+} // namespace detail
+
+// lazily started coroutine, runs when awaited and resumes its awaiter when done.
+template<typename T = void>
+class Task {
+public:
+    using value_type = T;
+
+    struct promise_type : detail::TaskResult<T> {
+        std::coroutine_handle<> continuation{std::noop_coroutine()};
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            // hand the thread straight to the awaiter instead of returning up the stack.
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                return h.promise().continuation;
+            }
+            void await_resume() const noexcept {}
+        };
+
+        Task get_return_object() noexcept {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() noexcept { std::abort(); }
+    };
+
+    Task(Task&& t) noexcept : handle{std::exchange(t.handle, {})} {}
+    ~Task() {
+        if (this->handle) {
+            this->handle.destroy();
+        }
+    }
+
+    // disable copying
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+        this->handle.promise().continuation = awaiter;
+        return this->handle;
+    }
+    T await_resume() {
+        return this->handle.promise().take();
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) : handle{h} {}
+    std::coroutine_handle<promise_type> handle{};
+};
+
+// suspends the coroutine and resumes it on a worker of the pool.
+// co_await yields true, or false when the token was stopped meanwhile.
+class ResumeOn {
+public:
+    ResumeOn(ThreadPool& p, std::stop_token t = {}) : pool{p}, token{std::move(t)} {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) {
+        this->pool.submit([h] { h.resume(); });
+    }
+    bool await_resume() const noexcept {
+        return !this->token.stop_requested();
+    }
+
+private:
+    ThreadPool& pool;
+    std::stop_token token;
+};
+
+[[nodiscard]]
+inline auto resume_on(ThreadPool& pool, std::stop_token token = {}) {
+    return ResumeOn{pool, std::move(token)};
+}
+
+// single producer, single consumer ring for progress results.
+// the producer and consumer never take a lock, the consumer drains whole runs at once.
+// a producer coroutine that finds the ring full suspends on wait_for_space, the drain that frees a slot
+// hands it back to its pool, so nobody spins while the ring stays full.
+template<typename T, std::size_t N>
+class SpscChannel {
+    static_assert((N & (N - 1)) == 0, "capacity must be a power of two");
+
+    // resumes the suspended producer on its pool, if there is one.
+    void wake() {
+        if (void* address = this->waiter.exchange(nullptr, std::memory_order_acq_rel)) {
+            this->waiter_pool->submit([h = std::coroutine_handle<>::from_address(address)] { h.resume(); });
+        }
+    }
+
+    [[nodiscard]]
+    bool full() const noexcept {
+        return this->tail.load(std::memory_order_relaxed) - this->head.load(std::memory_order_acquire) == N;
+    }
+
+public:
+    // co_await yields true once there is space, or false when the token was stopped meanwhile.
+    // the producer is resumed on the pool, never on the draining or stopping thread.
+    class SpaceAwaiter {
+    public:
+        SpaceAwaiter(SpscChannel& c, ThreadPool& p, std::stop_token t) : channel{c}, pool{p}, token{std::move(t)} {}
+
+        bool await_ready() const noexcept {
+            return !this->channel.full() || this->token.stop_requested();
+        }
+        bool await_suspend(std::coroutine_handle<> h) {
+            // register before publishing the handle, a callback run by the constructor finds nothing to wake.
+            if (this->token.stop_possible()) {
+                this->on_stop.emplace(this->token, Wake{&this->channel});
+            }
+            this->channel.waiter_pool = &this->pool;
+            this->channel.waiter.store(h.address(), std::memory_order_seq_cst);
+            // pairs with the fence in drain: either the consumer sees the handle or this sees the freed slot.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!this->channel.full() || this->token.stop_requested()) {
+                // taking the handle back means nobody else will resume it, so carry on right away.
+                return this->channel.waiter.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+            }
+            return true;
+        }
+        bool await_resume() const noexcept {
+            return !this->token.stop_requested();
+        }
+
+    private:
+        struct Wake {
+            SpscChannel* channel;
+            void operator()() const { this->channel->wake(); }
+        };
+
+        SpscChannel& channel;
+        ThreadPool& pool;
+        std::stop_token token;
+        std::optional<std::stop_callback<Wake>> on_stop{};
+    };
+
+    // producer side. returns false when full.
+    bool try_push(const T& value) {
+        const auto tail = this->tail.load(std::memory_order_relaxed);
+        if (tail - this->head.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        this->slots[tail & (N - 1)] = value;
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // producer side, from a coroutine. suspends until the consumer frees a slot or the token is stopped.
+    [[nodiscard]]
+    auto wait_for_space(ThreadPool& pool, std::stop_token token = {}) {
+        return SpaceAwaiter{*this, pool, std::move(token)};
+    }
+
+    // producer side, after the last push. completed tells the consumer whether the job ran to the end.
+    void close(bool completed) {
+        this->completed.store(completed, std::memory_order_relaxed);
+        this->closed.store(true, std::memory_order_release);
+    }
+
+    // consumer side. returns the number of values handed to fn.
+    template<typename Fn>
+    std::size_t drain(Fn&& fn) {
+        const auto head = this->head.load(std::memory_order_relaxed);
+        const auto tail = this->tail.load(std::memory_order_acquire);
+        for (auto i = head; i != tail; i++) {
+            fn(this->slots[i & (N - 1)]);
+        }
+        this->head.store(tail, std::memory_order_release);
+        if (tail != head) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            this->wake();
+        }
+        return tail - head;
+    }
+
+    // consumer side. read before the final drain, so every value pushed before close is seen.
+    [[nodiscard]]
+    bool is_closed() const noexcept {
+        return this->closed.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]]
+    bool is_completed() const noexcept {
+        return this->completed.load(std::memory_order_relaxed);
+    }
+
+    // only while there is no producer.
+    void reset() noexcept {
+        this->head.store(0, std::memory_order_relaxed);
+        this->tail.store(0, std::memory_order_relaxed);
+        this->closed.store(false, std::memory_order_relaxed);
+        this->completed.store(false, std::memory_order_relaxed);
+        this->waiter.store(nullptr, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<T, N> slots{};
+    alignas(64) std::atomic<std::size_t> head{};
+    alignas(64) std::atomic<std::size_t> tail{};
+    std::atomic<bool> closed{};
+    std::atomic<bool> completed{};
+    // the producer suspended on a full ring and the pool it resumes on, published by SpaceAwaiter.
+    std::atomic<void*> waiter{};
+    ThreadPool* waiter_pool{};
+};
+
+namespace detail {
+
+// fire and forget driver, owns the function so lambda captures outlive the task it returns.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::abort(); }
+    };
+};
+
+template<typename T, typename Fn>
+Detached drive(ThreadPool& pool, Fn fn, std::stop_token token, std::promise<T> promise) {
+    co_await resume_on(pool);
+    if constexpr (std::is_void_v<T>) {
+        co_await fn(std::move(token));
+        promise.set_value();
+    } else {
+        promise.set_value(co_await fn(std::move(token)));
+    }
+}
+
+} // namespace detail
+
+// starts fn(stop_token) -> Task<T> on the pool, with the same future + stop token as util::async.
+template<typename Fn>
+auto spawn(ThreadPool& pool, Fn&& fn) -> AsyncFurture<typename std::invoke_result_t<std::decay_t<Fn>, std::stop_token>::value_type> {
+    using T = typename std::invoke_result_t<std::decay_t<Fn>, std::stop_token>::value_type;
+    std::stop_source source_token;
+    std::promise<T> promise;
+    auto future = promise.get_future();
+    detail::drive<T>(pool, std::forward<Fn>(fn), source_token.get_token(), std::move(promise));
+    return AsyncFurture{std::move(future), std::move(source_token)};
+}
+
+} // namespace util
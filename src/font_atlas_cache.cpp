@@ -0,0 +1,138 @@
+/**
+ * @file font_atlas_cache.cpp
+ * @brief 字形图集缓存的实现
+ */
+#include "font_atlas_cache.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace tj {
+
+namespace {
+
+constexpr u64 FNV_OFFSET = 0xCBF29CE484222325ULL;
+constexpr u64 FNV_PRIME = 0x100000001B3ULL;
+
+u64 Fnv1a(const void* data, std::size_t size, u64 hash = FNV_OFFSET) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+u32 ReadBe32(const unsigned char* p) {
+    return (u32{p[0]} << 24) | (u32{p[1]} << 16) | (u32{p[2]} << 8) | u32{p[3]};
+}
+
+// TrueType表目录记录每张表的校验和与长度，哈希目录即可识别字体版本，无需读取整个字体
+// The TrueType table directory records every table's checksum and length, hashing it identifies the font version without reading the whole font
+u64 FontFingerprint(const PlFontData& font, u64 hash) {
+    hash = Fnv1a(&font.type, sizeof(font.type), hash);
+    hash = Fnv1a(&font.size, sizeof(font.size), hash);
+
+    const auto* data = static_cast<const unsigned char*>(font.address);
+    constexpr std::size_t OFFSET_TABLE = 12;
+    constexpr std::size_t TABLE_RECORD = 16;
+    if (!data || font.size < OFFSET_TABLE) {
+        return hash;
+    }
+    const std::size_t num_tables = (std::size_t{data[4]} << 8) | data[5];
+    const std::size_t directory = OFFSET_TABLE + num_tables * TABLE_RECORD;
+    if (directory > font.size) {
+        return Fnv1a(data, OFFSET_TABLE, hash);
+    }
+    hash = Fnv1a(data, directory, hash);
+
+    // head表的fontRevision和checkSumAdjustment (fontRevision and checkSumAdjustment of the head table)
+    for (std::size_t i = 0; i < num_tables; i++) {
+        const auto* record = data + OFFSET_TABLE + i * TABLE_RECORD;
+        if (ReadBe32(record) == 0x68656164) { // "head"
+            const std::size_t offset = ReadBe32(record + 8);
+            if (offset + 12 <= font.size) {
+                hash = Fnv1a(data + offset, 12, hash);
+            }
+            break;
+        }
+    }
+    return hash;
+}
+
+} // namespace
+
+FontAtlasCache::FontAtlasCache(const char* path) : m_path(path), m_font_fingerprint(FNV_OFFSET) {
+}
+
+void FontAtlasCache::AddFont(const PlFontData& font) {
+    m_font_fingerprint = FontFingerprint(font, m_font_fingerprint);
+}
+
+bool FontAtlasCache::Load(NVGcontext* vg) {
+    m_rasterized_at_load = nvgFontGlyphsRasterized(vg);
+
+    std::FILE* file = std::fopen(m_path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    Header header{};
+    std::vector<unsigned char> state;
+    bool read = std::fread(&header, sizeof(header), 1, file) == 1 &&
+        header.magic == MAGIC && header.version == VERSION && header.font_fingerprint == m_font_fingerprint;
+    if (read) {
+        state.resize(header.state_bytes);
+        read = std::fread(state.data(), 1, state.size(), file) == state.size() && std::fgetc(file) == EOF;
+    }
+    std::fclose(file);
+
+    if (!read || Fnv1a(state.data(), state.size()) != header.checksum) {
+        return false;
+    }
+    return nvgLoadFontAtlas(vg, state.data(), static_cast<int>(state.size())) != 0;
+}
+
+bool FontAtlasCache::Save(NVGcontext* vg) {
+    const int rasterized = nvgFontGlyphsRasterized(vg);
+    if (rasterized == m_rasterized_at_load) {
+        return true;
+    }
+
+    std::vector<unsigned char> state(static_cast<std::size_t>(nvgFontAtlasStateSize(vg)));
+    if (!nvgSaveFontAtlas(vg, state.data(), static_cast<int>(state.size()))) {
+        return false;
+    }
+
+    Header header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.font_fingerprint = m_font_fingerprint;
+    header.state_bytes = static_cast<u32>(state.size());
+    header.checksum = Fnv1a(state.data(), state.size());
+
+    // 先写临时文件，完整写入后再替换旧缓存 (Write a temporary file first, replace the old cache once complete)
+    const std::string temp_path = std::string{m_path} + ".tmp";
+    std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+        std::fwrite(state.data(), 1, state.size(), file) == state.size();
+    std::fclose(file);
+
+    if (!written) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    std::remove(m_path);
+    if (std::rename(temp_path.c_str(), m_path) != 0) {
+        return false;
+    }
+    m_rasterized_at_load = rasterized;
+    return true;
+}
+
+} // namespace tj
@@ -0,0 +1,74 @@
+/**
+ * @file font_atlas_cache.hpp
+ * @brief fontstash字形图集的持久化缓存，热启动时跳过CJK字形的光栅化
+ *        (Persistent cache of the fontstash glyph atlas, warm launches skip rasterizing CJK glyphs)
+ */
+#pragma once
+
+#include "nanovg/nanovg.h"
+
+#include <switch.h>
+#include <cstdint>
+
+namespace tj {
+
+/**
+ * @brief 字形图集缓存
+ *
+ * 文件由头部和nvgSaveFontAtlas输出的图集状态组成：图集纹理、天际线分配器和每种字体按字体/字号/码位索引的字形表。
+ * 头部记录所有共享字体的指纹（字体类型、大小和TrueType表目录的校验和），系统更新共享字体后指纹不同，缓存即失效。
+ * 字体必须在加载前按相同顺序注册，且尚未绘制任何文本。
+ *
+ * The file holds a header followed by the atlas state from nvgSaveFontAtlas: the atlas texture, the skyline
+ * allocator and each font's glyph table keyed by font/size/codepoint. The header records a fingerprint of every
+ * shared font (type, size and the checksums in its TrueType table directory), so a system update that changes
+ * a shared font invalidates the cache. Fonts must be registered in the same order before loading, with no text
+ * drawn yet.
+ */
+class FontAtlasCache {
+public:
+    /**
+     * @brief 构造函数
+     * @param path 缓存文件路径
+     */
+    explicit FontAtlasCache(const char* path);
+
+    FontAtlasCache(const FontAtlasCache&) = delete;
+    FontAtlasCache& operator=(const FontAtlasCache&) = delete;
+
+    /**
+     * @brief 将已注册到NVG的共享字体加入指纹，按注册顺序调用
+     */
+    void AddFont(const PlFontData& font);
+
+    /**
+     * @brief 读取并校验缓存，恢复字形图集
+     * @return 成功返回true，文件不存在、损坏或字体指纹不同返回false
+     */
+    bool Load(NVGcontext* vg);
+
+    /**
+     * @brief 写入缓存，加载后没有新光栅化的字形时跳过
+     * @return 写入或无需写入返回true
+     */
+    bool Save(NVGcontext* vg);
+
+private:
+    struct Header {
+        u32 magic;
+        u32 version;
+        u64 font_fingerprint;
+        u32 state_bytes;
+        u32 reserved;
+        u64 checksum;
+    };
+
+    static constexpr u32 MAGIC = 0x53414655; // "UFAS"
+    static constexpr u32 VERSION = 1;
+
+    const char* m_path;
+    u64 m_font_fingerprint;
+    int m_rasterized_at_load{};     ///< 加载完成时的光栅化计数 (Rasterization count once loaded)
+};
+
+} // namespace tj
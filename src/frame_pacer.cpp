@@ -0,0 +1,180 @@
+/**
+ * @file frame_pacer.cpp
+ * @brief 帧节奏控制的实现
+ */
+#include "frame_pacer.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#ifndef NDEBUG
+    #define LOG(...) std::printf(__VA_ARGS__)
+#else
+    #define LOG(...)
+#endif
+
+namespace tj {
+
+namespace {
+
+constexpr u64 FRAME_NS = 16666667;
+
+// 等待垂直同步的超时，显示器暂停时（如进入HOME）不会永久阻塞 (Vsync wait timeout, so a paused display such as HOME never blocks forever)
+constexpr u64 VSYNC_TIMEOUT_NS = FRAME_NS * 4;
+
+double TicksToMs(u64 ticks) {
+    return static_cast<double>(armTicksToNs(ticks)) / 1000000.0;
+}
+
+} // namespace
+
+PacingConfig PacingConfig::Load(const char* path) {
+    PacingConfig config{};
+    std::FILE* file = std::fopen(path, "r");
+    if (!file) {
+        return config;
+    }
+
+    char line[64];
+    while (std::fgets(line, sizeof(line), file)) {
+        unsigned depth{};
+        char mode[16]{};
+        if (std::sscanf(line, "swapchain_depth=%u", &depth) == 1) {
+            config.swapchain_depth = std::clamp(depth, MIN_SWAPCHAIN_DEPTH, MAX_SWAPCHAIN_DEPTH);
+        } else if (std::sscanf(line, "pacing=%15s", mode) == 1) {
+            config.mode = std::strcmp(mode, "sleep") == 0 ? PacingMode::Sleep : PacingMode::Vsync;
+        }
+    }
+    std::fclose(file);
+    return config;
+}
+
+FramePacer::~FramePacer() {
+    Exit();
+}
+
+void FramePacer::Initialize(const PacingConfig& config) {
+    m_config = config;
+    if (m_config.mode != PacingMode::Vsync) {
+        return;
+    }
+
+    // 默认窗口已初始化vi服务，这里再打开一次默认显示器取得垂直同步事件
+    // The default window already initialized the vi service, open the default display again for its vsync event
+    if (R_FAILED(viOpenDefaultDisplay(&m_display))) {
+        LOG("failed to open display, falling back to sleep pacing\n");
+        m_config.mode = PacingMode::Sleep;
+        return;
+    }
+    if (R_FAILED(viGetDisplayVsyncEvent(&m_display, &m_vsync_event))) {
+        LOG("failed to get vsync event, falling back to sleep pacing\n");
+        viCloseDisplay(&m_display);
+        m_config.mode = PacingMode::Sleep;
+        return;
+    }
+    m_vsync_open = true;
+}
+
+void FramePacer::Exit() {
+    if (!m_vsync_open) {
+        return;
+    }
+    eventClose(&m_vsync_event);
+    viCloseDisplay(&m_display);
+    m_vsync_open = false;
+}
+
+void FramePacer::InputSampled(bool new_press) {
+    m_input_tick = new_press ? armGetSystemTick() : 0;
+}
+
+void FramePacer::Presented() {
+    if (m_input_tick) {
+        m_current.present_latency = armGetSystemTick() - m_input_tick;
+    }
+}
+
+void FramePacer::WaitNextFrame(u64 frame_begin_tick) {
+    if (m_config.mode == PacingMode::Vsync) {
+        // 本帧期间错过的垂直同步不算数：下一个缓冲区要等本帧显示才空闲，立即返回只会让之后每帧都阻塞在acquireImage，晚一个周期
+        // (A vsync missed during this frame does not count: the next buffer is only free once this frame shows, and returning
+        // on the stale signal would leave every later frame blocking in acquireImage, a period behind)
+        eventClear(&m_vsync_event);
+        eventWait(&m_vsync_event, VSYNC_TIMEOUT_NS);
+    } else {
+        const u64 elapsed_ns = armTicksToNs(armGetSystemTick() - frame_begin_tick);
+        if (elapsed_ns < FRAME_NS) {
+            svcSleepThread(FRAME_NS - elapsed_ns);
+        }
+    }
+
+    // 提交过的新按键在这次垂直同步后显示 (A presented new press reaches the screen on this vsync)
+    const u64 now = armGetSystemTick();
+    if (m_current.present_latency) {
+        m_current.vsync_latency = now - m_input_tick;
+    }
+    if (m_last_frame_tick) {
+        m_current.interval_ticks = now - m_last_frame_tick;
+        m_samples[m_count % HISTORY] = m_current;
+        m_count++;
+    }
+    m_last_frame_tick = now;
+    m_current = {};
+    m_input_tick = 0;
+}
+
+bool FramePacer::WriteReport(const char* path) const {
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    const std::size_t count = std::min(m_count, HISTORY);
+    std::vector<double> intervals;
+    intervals.reserve(count);
+    double latency_sum = 0.0, vsync_latency_sum = 0.0, latency_max = 0.0;
+    std::size_t latency_count = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        const auto& sample = m_samples[i];
+        intervals.push_back(TicksToMs(sample.interval_ticks));
+        if (sample.present_latency) {
+            const double latency = TicksToMs(sample.present_latency);
+            latency_sum += latency;
+            vsync_latency_sum += TicksToMs(sample.vsync_latency);
+            latency_max = std::max(latency_max, latency);
+            latency_count++;
+        }
+    }
+
+    // 帧间隔的均值、方差和分位数 (Mean, variance and percentiles of the frame interval)
+    double mean = 0.0, variance = 0.0;
+    for (double ms : intervals) {
+        mean += ms;
+    }
+    mean = count ? mean / count : 0.0;
+    for (double ms : intervals) {
+        variance += (ms - mean) * (ms - mean);
+    }
+    variance = count ? variance / count : 0.0;
+    std::ranges::sort(intervals);
+    const auto percentile = [&intervals](double p) {
+        return intervals.empty() ? 0.0 : intervals[std::min(intervals.size() - 1, static_cast<std::size_t>(p * intervals.size()))];
+    };
+
+    std::fprintf(file, "pacing=%s swapchain_depth=%u frames=%zu\n",
+        m_config.mode == PacingMode::Vsync ? "vsync" : "sleep", m_config.swapchain_depth, count);
+    std::fprintf(file, "frame_ms mean=%.3f variance=%.4f stddev=%.3f min=%.3f p50=%.3f p99=%.3f max=%.3f\n",
+        mean, variance, std::sqrt(variance), percentile(0.0), percentile(0.5), percentile(0.99), percentile(1.0));
+    std::fprintf(file, "input_to_present_ms frames=%zu mean=%.3f max=%.3f\n",
+        latency_count, latency_count ? latency_sum / latency_count : 0.0, latency_max);
+    std::fprintf(file, "input_to_vsync_ms mean=%.3f\n", latency_count ? vsync_latency_sum / latency_count : 0.0);
+
+    const bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    return ok;
+}
+
+} // namespace tj
@@ -0,0 +1,122 @@
+/**
+ * @file frame_pacer.hpp
+ * @brief 帧节奏控制：按显示器垂直同步推进主循环，记录帧间隔和输入到显示的延迟
+ *        (Frame pacing: drives the main loop from the display's vsync and records frame intervals and input-to-display latency)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace tj {
+
+/**
+ * @brief 主循环的节奏方式
+ */
+enum class PacingMode : u8 {
+    Vsync,  ///< 等待显示器的垂直同步事件 (Wait on the display's vsync event)
+    Sleep,  ///< 旧方式：按墙钟时间休眠到16.667ms (Legacy: sleep on wall time up to 16.667ms)
+};
+
+/**
+ * @brief 帧节奏配置，启动时从配置文件读取
+ *
+ * 配置文件每行一个key=value，不存在或无法识别的项使用默认值：
+ *   swapchain_depth=2|3    交换链的帧缓冲区数量 (Number of swapchain framebuffers)
+ *   pacing=vsync|sleep     主循环的节奏方式 (How the main loop is paced)
+ */
+struct PacingConfig {
+    static constexpr unsigned MIN_SWAPCHAIN_DEPTH = 2;
+    static constexpr unsigned MAX_SWAPCHAIN_DEPTH = 3;
+
+    PacingMode mode{PacingMode::Vsync};
+    unsigned swapchain_depth{MIN_SWAPCHAIN_DEPTH};
+
+    /**
+     * @brief 读取配置文件，文件不存在时返回默认配置
+     */
+    static PacingConfig Load(const char* path);
+};
+
+/**
+ * @brief 帧节奏控制
+ *
+ * Vsync模式下每次循环结束时等待显示器的垂直同步事件：输入在垂直同步后立即采样，绘制完成后交换链通常已有空闲的缓冲区，
+ * acquireImage不再阻塞，避免休眠和交换链各等一次。超时的帧清除错过的垂直同步，等待显示它的那一次，主循环始终与显示器对齐。
+ * 打开显示器失败时退回Sleep模式。
+ * 每帧记录循环间隔；有新按键的帧记录从采样到提交显示以及到下一次垂直同步的时间。只能在主线程使用。
+ *
+ * In Vsync mode every loop iteration ends by waiting on the display's vsync event: input is sampled right after
+ * vsync and by the time the frame is drawn the swapchain usually has a free buffer, so acquireImage no longer
+ * blocks and the loop never waits twice (sleep and swapchain). A frame that runs past a vsync clears the missed
+ * signal and waits for the vsync that shows it, so the loop stays aligned with the display. Falls back to Sleep mode if the display cannot be
+ * opened. Each iteration's interval is recorded; frames with a new button press also record the time from the pad
+ * sample to present and to the following vsync. Main thread only.
+ */
+class FramePacer {
+public:
+    static constexpr std::size_t HISTORY = 600;     ///< 保留最近10秒的记录 (Keeps the last 10 seconds)
+
+    FramePacer() = default;
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    /**
+     * @brief 应用配置，Vsync模式下打开默认显示器的垂直同步事件
+     */
+    void Initialize(const PacingConfig& config);
+
+    /**
+     * @brief 关闭垂直同步事件和显示器
+     */
+    void Exit();
+
+    const PacingConfig& Config() const { return m_config; }
+
+    /**
+     * @brief 手柄采样后调用
+     * @param new_press 本帧是否有新按下的按键
+     */
+    void InputSampled(bool new_press);
+
+    /**
+     * @brief 提交显示后调用
+     */
+    void Presented();
+
+    /**
+     * @brief 等待下一帧开始，在每次循环结束时调用
+     * @param frame_begin_tick 本次循环开始的时间，Sleep模式使用
+     */
+    void WaitNextFrame(u64 frame_begin_tick);
+
+    /**
+     * @brief 写入帧间隔和延迟的统计报告
+     * @return 成功返回true
+     */
+    bool WriteReport(const char* path) const;
+
+private:
+    struct Sample {
+        u64 interval_ticks;     ///< 与上一帧开始的间隔 (Interval since the previous frame began)
+        u64 present_latency;    ///< 采样到提交显示，0表示本帧没有新按键或没有绘制 (Sample to present, 0 without a new press or draw)
+        u64 vsync_latency;      ///< 采样到提交后的下一次垂直同步 (Sample to the vsync after present)
+    };
+
+    PacingConfig m_config{};
+    ViDisplay m_display{};
+    Event m_vsync_event{};
+    bool m_vsync_open{};
+
+    std::array<Sample, HISTORY> m_samples{};    ///< 环形缓冲区 (Ring buffer)
+    std::size_t m_count{};                      ///< 已记录的帧数 (Frames recorded)
+    Sample m_current{};                         ///< 本帧记录 (This frame's record)
+    u64 m_last_frame_tick{};                    ///< 上一帧开始的时间 (When the previous frame began)
+    u64 m_input_tick{};                         ///< 本帧新按键的采样时间，0表示没有 (Sample time of this frame's new press, 0 when none)
+};
+
+} // namespace tj
@@ -0,0 +1,233 @@
+/**
+ * @file frame_profiler.cpp
+ * @brief 帧耗时分析器的实现
+ */
+#include "frame_profiler.hpp"
+// NanoVG工具函数 (NanoVG utility functions)
+#include "nvg_util.hpp"
+
+#include <cstdio>
+#include <algorithm>
+
+namespace tj {
+
+namespace {
+
+constexpr const char* PHASE_NAMES[FrameProfiler::PHASE_COUNT] = {
+    "Poll", "Update", "FrameLoads", "IconUpload", "Draw", "GpuWait", "Record", "Sleep",
+};
+
+// 嵌套阶段的父阶段，顶层阶段为自身 (Parent of each nested phase, top-level phases map to themselves)
+constexpr ProfilePhase PHASE_PARENTS[FrameProfiler::PHASE_COUNT] = {
+    ProfilePhase::Poll, ProfilePhase::Update, ProfilePhase::Update, ProfilePhase::Update,
+    ProfilePhase::Draw, ProfilePhase::Draw, ProfilePhase::Draw, ProfilePhase::Sleep,
+};
+
+const NVGcolor PHASE_COLOURS[FrameProfiler::PHASE_COUNT] = {
+    nvgRGB(0x4F, 0xC3, 0xF7), nvgRGB(0x81, 0xC7, 0x84), nvgRGB(0xFF, 0xD5, 0x4F), nvgRGB(0xFF, 0x8A, 0x65),
+    nvgRGB(0xBA, 0x68, 0xC8), nvgRGB(0xE5, 0x73, 0x73), nvgRGB(0x90, 0xA4, 0xAE), nvgRGBA(0x60, 0x60, 0x60, 0x80),
+};
+
+constexpr const char* COUNTER_NAMES[FrameProfiler::COUNTER_COUNT] = {
+    "TextCacheHits", "TextCacheMisses", "SkippedFrames", "GlyphRasterizations",
+    "FlingRows", "FlingIconMisses", "IconQueueDepth", "IconTasksCancelled", "IconTasksWasted",
+};
+
+constexpr float FRAME_BUDGET_MS = 1000.f / 60.f;
+
+double TicksToMs(u64 ticks) {
+    return static_cast<double>(armTicksToNs(ticks)) / 1000000.0;
+}
+
+double TicksToUs(u64 ticks) {
+    return static_cast<double>(armTicksToNs(ticks)) / 1000.0;
+}
+
+} // namespace
+
+FrameProfiler::Scope::Scope(FrameProfiler& profiler, ProfilePhase phase)
+    : m_profiler(profiler)
+    , m_phase(phase)
+    , m_begin(armGetSystemTick()) {
+}
+
+FrameProfiler::Scope::~Scope() {
+    m_profiler.AddPhase(m_phase, m_begin, armGetSystemTick());
+}
+
+void FrameProfiler::BeginFrame() {
+    m_current = FrameSample{};
+    m_current.serial = m_next_serial++;
+    m_current.begin_tick = armGetSystemTick();
+}
+
+void FrameProfiler::EndFrame() {
+    m_current.end_tick = armGetSystemTick();
+    m_frames[m_current.serial % HISTORY] = m_current;
+    m_count = std::min(m_count + 1, HISTORY);
+}
+
+void FrameProfiler::AddPhase(ProfilePhase phase, u64 begin_tick, u64 end_tick) {
+    const auto index = static_cast<std::size_t>(phase);
+    if (m_current.phase_ticks[index] == 0) {
+        m_current.phase_begin[index] = begin_tick;
+    }
+    m_current.phase_ticks[index] += end_tick - begin_tick;
+}
+
+void FrameProfiler::AddCount(ProfileCounter counter, u32 count) {
+    m_current.counters[static_cast<std::size_t>(counter)] += count;
+}
+
+void FrameProfiler::GpuSubmitted(unsigned slot) {
+    if (slot >= MAX_GPU_SLOTS) {
+        return;
+    }
+    m_current.gpu_submit_tick = armGetSystemTick();
+    m_gpu[slot] = GpuSlot{m_current.serial, m_current.gpu_submit_tick, true};
+}
+
+bool FrameProfiler::IsGpuPending(unsigned slot) const {
+    return slot < MAX_GPU_SLOTS && m_gpu[slot].pending;
+}
+
+void FrameProfiler::GpuCompleted(unsigned slot) {
+    if (!IsGpuPending(slot)) {
+        return;
+    }
+    auto& gpu = m_gpu[slot];
+    gpu.pending = false;
+
+    const u64 ticks = armGetSystemTick() - gpu.submit_tick;
+    if (gpu.serial == m_current.serial) {
+        m_current.gpu_ticks = ticks;
+    } else if (auto* frame = FindFrame(gpu.serial)) {
+        frame->gpu_ticks = ticks;
+    }
+}
+
+FrameProfiler::FrameSample* FrameProfiler::FindFrame(u64 serial) {
+    // 只在环形缓冲区仍保留该帧时返回 (Only while the ring buffer still holds that frame)
+    if (m_count == 0 || serial + m_count < m_next_serial - 1 || serial >= m_next_serial) {
+        return nullptr;
+    }
+    auto& frame = m_frames[serial % HISTORY];
+    return frame.serial == serial ? &frame : nullptr;
+}
+
+u64 FrameProfiler::ExclusiveTicks(const FrameSample& frame, std::size_t phase) const {
+    u64 ticks = frame.phase_ticks[phase];
+    for (std::size_t child = 0; child < PHASE_COUNT; child++) {
+        if (child != phase && static_cast<std::size_t>(PHASE_PARENTS[child]) == phase) {
+            ticks -= std::min(ticks, frame.phase_ticks[child]);
+        }
+    }
+    return ticks;
+}
+
+void FrameProfiler::DrawOverlay(NVGcontext* vg) const {
+    constexpr float bar_width = 2.f;
+    constexpr float graph_h = 160.f;
+    constexpr float px_per_ms = graph_h / (FRAME_BUDGET_MS * 2.f);
+    constexpr float graph_w = HISTORY * bar_width;
+    constexpr float x = 1250.f - graph_w - 210.f;
+    constexpr float y = 440.f;
+
+    nvgSave(vg);
+    gfx::drawRect(vg, x - 10.f, y - 10.f, graph_w + 230.f, graph_h + 20.f + COUNTER_COUNT * 18.f, nvgRGBA(0, 0, 0, 200));
+
+    // 按帧从旧到新绘制各阶段独占耗时的堆叠柱 (Stacked bars of exclusive phase time, oldest frame first)
+    std::array<double, PHASE_COUNT> totals{};
+    std::array<double, COUNTER_COUNT> counter_totals{};
+    double gpu_total = 0.0;
+    std::size_t gpu_frames = 0;
+    const u64 first = m_next_serial - m_count;
+    for (std::size_t i = 0; i < m_count; i++) {
+        const auto& frame = m_frames[(first + i) % HISTORY];
+        const float bx = x + (HISTORY - m_count + i) * bar_width;
+        for (std::size_t counter = 0; counter < COUNTER_COUNT; counter++) {
+            counter_totals[counter] += frame.counters[counter];
+        }
+        float by = y + graph_h;
+        for (std::size_t phase = 0; phase < PHASE_COUNT; phase++) {
+            const double ms = TicksToMs(ExclusiveTicks(frame, phase));
+            totals[phase] += ms;
+            const float h = std::min(static_cast<float>(ms) * px_per_ms, by - y);
+            if (h > 0.f) {
+                by -= h;
+                gfx::drawRect(vg, bx, by, bar_width, h, PHASE_COLOURS[phase]);
+            }
+        }
+        if (frame.gpu_ticks) {
+            const double gpu_ms = TicksToMs(frame.gpu_ticks);
+            gpu_total += gpu_ms;
+            gpu_frames++;
+            const float gy = y + graph_h - std::min(static_cast<float>(gpu_ms) * px_per_ms, graph_h);
+            gfx::drawRect(vg, bx, gy, bar_width, 1.f, gfx::Colour::WHITE);
+        }
+    }
+
+    // 16.7ms帧预算线 (16.7ms frame budget line)
+    gfx::drawRect(vg, x, y + graph_h - FRAME_BUDGET_MS * px_per_ms, graph_w, 1.f, gfx::Colour::RED);
+
+    // 各阶段平均值图例 (Legend with per-phase averages)
+    const double frames = m_count ? static_cast<double>(m_count) : 1.0;
+    float ly = y;
+    for (std::size_t phase = 0; phase < PHASE_COUNT; phase++) {
+        gfx::drawRect(vg, x + graph_w + 10.f, ly + 4.f, 10.f, 10.f, PHASE_COLOURS[phase]);
+        gfx::drawTextArgs(vg, x + graph_w + 26.f, ly, 16.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE, "%s %.2f ms", PHASE_NAMES[phase], totals[phase] / frames);
+        ly += 18.f;
+    }
+    gfx::drawTextArgs(vg, x + graph_w + 26.f, ly, 16.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE, "GPU %.2f ms", gpu_frames ? gpu_total / gpu_frames : 0.0);
+    for (std::size_t counter = 0; counter < COUNTER_COUNT; counter++) {
+        ly += 18.f;
+        gfx::drawTextArgs(vg, x + graph_w + 26.f, ly, 16.f, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, gfx::Colour::WHITE, "%s %.1f/f", COUNTER_NAMES[counter], counter_totals[counter] / frames);
+    }
+    nvgRestore(vg);
+}
+
+bool FrameProfiler::DumpChromeTrace(const char* path) const {
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    // 时间戳以第一帧开始为零点，单位微秒；CPU阶段在tid 1，GPU在tid 2
+    // Timestamps in microseconds relative to the first frame; CPU phases on tid 1, GPU on tid 2
+    const u64 first = m_next_serial - m_count;
+    const u64 origin = m_count ? m_frames[first % HISTORY].begin_tick : 0;
+    bool first_event = true;
+    auto write_event = [&](const char* name, const char* category, int tid, u64 begin_tick, u64 ticks) {
+        std::fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+            first_event ? "" : ",\n", name, category, tid, TicksToUs(begin_tick - origin), TicksToUs(ticks));
+        first_event = false;
+    };
+
+    std::fputs("{\"traceEvents\":[\n", file);
+    std::fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n", file);
+    std::fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}},\n", file);
+    for (std::size_t i = 0; i < m_count; i++) {
+        const auto& frame = m_frames[(first + i) % HISTORY];
+        write_event("Frame", "frame", 1, frame.begin_tick, frame.end_tick - frame.begin_tick);
+        for (std::size_t phase = 0; phase < PHASE_COUNT; phase++) {
+            if (frame.phase_ticks[phase]) {
+                write_event(PHASE_NAMES[phase], "cpu", 1, frame.phase_begin[phase], frame.phase_ticks[phase]);
+            }
+        }
+        if (frame.gpu_ticks) {
+            write_event("GpuFrame", "gpu", 2, frame.gpu_submit_tick, frame.gpu_ticks);
+        }
+        // 计数器写为Chrome trace的计数事件 (Counters go out as Chrome trace counter events)
+        for (std::size_t counter = 0; counter < COUNTER_COUNT; counter++) {
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"count\":%u}}",
+                COUNTER_NAMES[counter], TicksToUs(frame.begin_tick - origin), static_cast<unsigned>(frame.counters[counter]));
+        }
+    }
+    std::fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+
+    const bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    return ok;
+}
+
+} // namespace tj
@@ -0,0 +1,163 @@
+/**
+ * @file frame_profiler.hpp
+ * @brief 帧耗时分析器：分阶段CPU计时、GPU栅栏计时、屏幕图表和Chrome trace导出
+ *        (Frame profiler: per-phase CPU timing, GPU fence timing, on-screen graph and Chrome trace export)
+ */
+#pragma once
+
+#include "nanovg/nanovg.h"
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace tj {
+
+/**
+ * @brief 帧内的计时阶段，FrameLoads和IconUpload属于Update，GpuWait和Record属于Draw
+ *        (Timed phases of a frame; FrameLoads and IconUpload nest in Update, GpuWait and Record nest in Draw)
+ */
+enum class ProfilePhase : u8 {
+    Poll,           ///< 输入处理 (Input handling)
+    Update,         ///< 逻辑更新 (Logic update)
+    FrameLoads,     ///< 每帧资源加载任务 (Per-frame resource load tasks)
+    IconUpload,     ///< 图标上传 (Icon uploads)
+    Draw,           ///< 渲染 (Rendering)
+    GpuWait,        ///< 等待上一帧的GPU栅栏 (Waiting on the previous frame's GPU fence)
+    Record,         ///< NanoVG细分和命令录制 (NanoVG tessellation and command recording)
+    Sleep,          ///< 帧率限制休眠 (Frame limiter sleep)
+    COUNT,
+};
+
+/**
+ * @brief 每帧累计的计数器 (Counters accumulated per frame)
+ */
+enum class ProfileCounter : u8 {
+    TextCacheHits,      ///< 文本缓存省去的格式化和测量次数 (Formats and measurements saved by the text cache)
+    TextCacheMisses,    ///< 文本缓存未命中次数 (Text cache misses)
+    SkippedFrames,      ///< 画面未变化而跳过绘制的帧 (Frames whose draw was skipped because nothing changed)
+    GlyphRasterizations, ///< fontstash光栅化的字形数 (Glyphs rasterized by fontstash)
+    FlingRows,          ///< 滚动中绘制的行数 (Rows drawn while scrolling)
+    FlingIconMisses,    ///< 滚动中图标尚未加载的行数 (Rows drawn while scrolling whose icon was not loaded yet)
+    IconQueueDepth,     ///< 排队中的图标任务 (Icon tasks queued)
+    IconTasksCancelled, ///< 执行前取消的图标任务 (Icon tasks cancelled before running)
+    IconTasksWasted,    ///< 执行了但没有做有效工作的图标任务 (Icon tasks run that did no useful work)
+    COUNT,
+};
+
+/**
+ * @brief 帧耗时分析器
+ *
+ * 用Scope包围各阶段记录开始时间和耗时，每帧结束时写入最近HISTORY帧的环形缓冲区。
+ * GPU耗时通过每帧命令列表末尾的栅栏测量：从提交到CPU观察到栅栏触发的时间，精度取决于查询栅栏的频率。
+ * 只能在渲染线程使用。
+ *
+ * Scopes around each phase record its start and duration; at the end of every frame the sample goes into a ring
+ * buffer of the last HISTORY frames. GPU time is measured with the fence at the end of each frame's command list:
+ * the time from submission until the CPU sees the fence signaled, so its precision depends on how often the fence
+ * is polled. Render thread only.
+ */
+class FrameProfiler {
+public:
+    static constexpr std::size_t HISTORY = 240;                                 ///< 保留的帧数 (Frames kept)
+    static constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(ProfilePhase::COUNT);
+    static constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(ProfileCounter::COUNT);
+    static constexpr std::size_t MAX_GPU_SLOTS = 4;                             ///< 最多跟踪的命令缓冲区数量 (Command buffers tracked)
+
+    /**
+     * @brief 作用域计时器，析构时记录阶段耗时
+     */
+    class Scope {
+    public:
+        Scope(FrameProfiler& profiler, ProfilePhase phase);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameProfiler& m_profiler;
+        ProfilePhase m_phase;
+        u64 m_begin;
+    };
+
+    /**
+     * @brief 开始新的一帧
+     */
+    void BeginFrame();
+
+    /**
+     * @brief 结束当前帧，写入环形缓冲区
+     */
+    void EndFrame();
+
+    /**
+     * @brief 记录阶段耗时，同一帧内多次出现的阶段累加
+     */
+    void AddPhase(ProfilePhase phase, u64 begin_tick, u64 end_tick);
+
+    /**
+     * @brief 累加当前帧的计数器
+     */
+    void AddCount(ProfileCounter counter, u32 count);
+
+    /**
+     * @brief 记录命令缓冲区提交时间（带栅栏）
+     */
+    void GpuSubmitted(unsigned slot);
+
+    /**
+     * @brief 是否有尚未观察到完成的提交
+     */
+    bool IsGpuPending(unsigned slot) const;
+
+    /**
+     * @brief 记录观察到栅栏触发的时间，计入提交该命令的那一帧
+     */
+    void GpuCompleted(unsigned slot);
+
+    void ToggleOverlay() { m_overlay_visible = !m_overlay_visible; }
+    bool IsOverlayVisible() const { return m_overlay_visible; }
+
+    /**
+     * @brief 绘制分阶段堆叠的帧耗时图表、各阶段平均值和计数器平均值
+     */
+    void DrawOverlay(NVGcontext* vg) const;
+
+    /**
+     * @brief 导出Chrome trace格式的JSON，可用chrome://tracing或Perfetto打开
+     * @return 成功返回true
+     */
+    bool DumpChromeTrace(const char* path) const;
+
+private:
+    struct FrameSample {
+        u64 serial;                                 ///< 帧序号 (Frame serial)
+        u64 begin_tick;
+        u64 end_tick;
+        std::array<u64, PHASE_COUNT> phase_begin;   ///< 阶段首次开始的时间 (First start of each phase)
+        std::array<u64, PHASE_COUNT> phase_ticks;   ///< 阶段累计耗时 (Accumulated phase time)
+        std::array<u32, COUNTER_COUNT> counters;    ///< 计数器 (Counters)
+        u64 gpu_submit_tick;
+        u64 gpu_ticks;                              ///< 0表示尚未完成 (0 while not yet observed complete)
+    };
+
+    struct GpuSlot {
+        u64 serial;
+        u64 submit_tick;
+        bool pending;
+    };
+
+    FrameSample* FindFrame(u64 serial);
+    u64 ExclusiveTicks(const FrameSample& frame, std::size_t phase) const;
+
+    std::array<FrameSample, HISTORY> m_frames{};    ///< 环形缓冲区 (Ring buffer)
+    std::size_t m_count{};                          ///< 已记录的帧数，最多HISTORY
+    FrameSample m_current{};                        ///< 正在记录的帧
+    u64 m_next_serial{};                            ///< 下一帧的序号
+    std::array<GpuSlot, MAX_GPU_SLOTS> m_gpu{};     ///< 每个命令缓冲区的提交记录
+    bool m_overlay_visible{};                       ///< 是否显示图表
+};
+
+} // namespace tj
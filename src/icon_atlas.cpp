@@ -0,0 +1,131 @@
+/**
+ * @file icon_atlas.cpp
+ * @brief 图标纹理图集的实现
+ */
+#include "icon_atlas.hpp"
+// 区域纹理上传 (Region texture upload)
+#include "nanovg/deko3d/dk_renderer.hpp"
+
+namespace tj {
+
+IconAtlas::IconAtlas(std::size_t max_pages) : m_max_pages(max_pages ? max_pages : 1) {
+}
+
+void IconAtlas::Destroy(NVGcontext* vg) {
+    for (int page : m_pages) {
+        nvgDeleteImage(vg, page);
+    }
+    m_pages.clear();
+    m_slots.clear();
+    m_slot_by_id.clear();
+}
+
+void IconAtlas::BeginFrame() {
+    m_frame++;
+}
+
+bool IconAtlas::Contains(u64 application_id) const {
+    return m_slot_by_id.contains(application_id);
+}
+
+int IconAtlas::AllocateSlot(NVGcontext* vg) {
+    // 1. 已有页面中的空闲槽位 (1. A free slot in an existing page)
+    for (std::size_t i = 0; i < m_slots.size(); i++) {
+        if (!m_slots[i].used) {
+            return static_cast<int>(i);
+        }
+    }
+
+    // 2. 分配新页面 (2. Allocate a new page)
+    if (m_pages.size() < m_max_pages) {
+        const int page = nvgCreateImageRGBA(vg, PAGE_SIZE, PAGE_SIZE, 0, nullptr);
+        if (page > 0) {
+            m_pages.push_back(page);
+            const auto first = m_slots.size();
+            m_slots.resize(first + SLOTS_PER_PAGE, Slot{});
+            return static_cast<int>(first);
+        }
+    }
+
+    // 3. 淘汰最久未绘制的槽位，跳过当前帧和上一帧绘制过的，GPU可能仍在读取
+    // 3. Evict the least recently drawn slot, skipping those drawn this frame or last, the GPU may still read them
+    int victim = -1;
+    for (std::size_t i = 0; i < m_slots.size(); i++) {
+        const auto& slot = m_slots[i];
+        if (slot.last_used + 1 >= m_frame) {
+            continue;
+        }
+        if (victim < 0 || slot.last_used < m_slots[victim].last_used) {
+            victim = static_cast<int>(i);
+        }
+    }
+
+    if (victim >= 0) {
+        m_slot_by_id.erase(m_slots[victim].application_id);
+        m_slots[victim].used = false;
+    }
+    return victim;
+}
+
+bool IconAtlas::Insert(NVGcontext* vg, u64 application_id, const unsigned char* rgba) {
+    int slot_index;
+    if (const auto it = m_slot_by_id.find(application_id); it != m_slot_by_id.end()) {
+        slot_index = it->second;
+    } else {
+        slot_index = AllocateSlot(vg);
+        if (slot_index < 0) {
+            return false;
+        }
+    }
+
+    const int page = m_pages[slot_index / SLOTS_PER_PAGE];
+    const int local = slot_index % SLOTS_PER_PAGE;
+    const int x = (local % SLOTS_PER_ROW) * SLOT_SIZE;
+    const int y = (local / SLOTS_PER_ROW) * SLOT_SIZE;
+    if (!nvgDkUpdateImageRegion(vg, page, x, y, SLOT_SIZE, SLOT_SIZE, rgba)) {
+        return false;
+    }
+
+    auto& slot = m_slots[slot_index];
+    slot.application_id = application_id;
+    slot.last_used = m_frame;
+    slot.used = true;
+    m_slot_by_id[application_id] = slot_index;
+    return true;
+}
+
+void IconAtlas::Remove(u64 application_id) {
+    const auto it = m_slot_by_id.find(application_id);
+    if (it == m_slot_by_id.end()) {
+        return;
+    }
+    m_slots[it->second].used = false;
+    m_slot_by_id.erase(it);
+}
+
+bool IconAtlas::GetPaint(NVGcontext* vg, u64 application_id, float x, float y, float w, float h, NVGpaint& out_paint) {
+    const auto it = m_slot_by_id.find(application_id);
+    if (it == m_slot_by_id.end()) {
+        return false;
+    }
+
+    auto& slot = m_slots[it->second];
+    slot.last_used = m_frame;
+
+    const int page = m_pages[it->second / SLOTS_PER_PAGE];
+    const int local = it->second % SLOTS_PER_PAGE;
+    const float slot_x = static_cast<float>((local % SLOTS_PER_ROW) * SLOT_SIZE);
+    const float slot_y = static_cast<float>((local / SLOTS_PER_ROW) * SLOT_SIZE);
+
+    // 将整页图案缩放平移，使槽位内缩半个像素的区域正好覆盖目标矩形，线性过滤不会采样到相邻槽位
+    // Scale and offset the whole-page pattern so the slot, inset by half a texel, covers the target rect;
+    // linear filtering then never samples the neighbouring slots
+    const float scale_x = w / static_cast<float>(SLOT_SIZE - 1);
+    const float scale_y = h / static_cast<float>(SLOT_SIZE - 1);
+    const float origin_x = x - (slot_x + 0.5f) * scale_x;
+    const float origin_y = y - (slot_y + 0.5f) * scale_y;
+    out_paint = nvgImagePattern(vg, origin_x, origin_y, PAGE_SIZE * scale_x, PAGE_SIZE * scale_y, 0.f, page, 1.f);
+    return true;
+}
+
+} // namespace tj
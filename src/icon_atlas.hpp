@@ -0,0 +1,104 @@
+/**
+ * @file icon_atlas.hpp
+ * @brief 图标纹理图集：少量大纹理划分为固定大小的槽位，所有图标共享同一纹理绘制
+ *        (Icon texture atlas: a few large textures split into fixed slots, icons draw from a shared texture)
+ */
+#pragma once
+
+#include "nanovg/nanovg.h"
+#include "icon_cache.hpp"
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+namespace tj {
+
+/**
+ * @brief 图标图集
+ *
+ * 每页为一个PAGE_SIZE见方的RGBA纹理，划分为SLOT_SIZE见方的槽位，按需分配页面。
+ * 槽位用尽时淘汰最久未绘制的图标（当前帧和上一帧绘制过的除外）。
+ * 绘制时返回引用槽位子矩形的NVGpaint，一屏图标只绑定同一张纹理，不再受每图标一个纹理的MaxImages限制。
+ * 只能在渲染线程使用。
+ *
+ * Each page is a PAGE_SIZE square RGBA texture split into SLOT_SIZE square slots, pages are allocated on demand.
+ * When full, the least recently drawn icon is evicted (except icons drawn this frame or the previous one).
+ * Drawing returns an NVGpaint referencing the slot's sub-rectangle, so a screen of icons binds a single texture
+ * and the per-icon texture MaxImages ceiling no longer applies. Render thread only.
+ */
+class IconAtlas {
+public:
+    static constexpr int SLOT_SIZE = IconCache::ICON_SIZE;          ///< 槽位边长 (Slot edge)
+    static constexpr int PAGE_SIZE = 1024;                          ///< 页面边长 (Page edge)
+    static constexpr int SLOTS_PER_ROW = PAGE_SIZE / SLOT_SIZE;     ///< 每行槽位数
+    static constexpr int SLOTS_PER_PAGE = SLOTS_PER_ROW * SLOTS_PER_ROW; ///< 每页槽位数
+
+    /**
+     * @brief 构造函数
+     * @param max_pages 最多分配的页面数，每页4MB显存
+     */
+    explicit IconAtlas(std::size_t max_pages = 2);
+
+    /**
+     * @brief 析构前必须调用Destroy释放纹理
+     */
+    ~IconAtlas() = default;
+
+    IconAtlas(const IconAtlas&) = delete;
+    IconAtlas& operator=(const IconAtlas&) = delete;
+
+    /**
+     * @brief 释放所有页面纹理
+     */
+    void Destroy(NVGcontext* vg);
+
+    /**
+     * @brief 每帧开始时调用，推进LRU帧计数
+     */
+    void BeginFrame();
+
+    /**
+     * @brief 应用图标是否已在图集中
+     */
+    bool Contains(u64 application_id) const;
+
+    /**
+     * @brief 将SLOT_SIZE见方的RGBA图标上传到槽位
+     * @return 成功返回true；没有可淘汰的槽位或上传失败返回false
+     */
+    bool Insert(NVGcontext* vg, u64 application_id, const unsigned char* rgba);
+
+    /**
+     * @brief 移除应用图标，释放其槽位
+     */
+    void Remove(u64 application_id);
+
+    /**
+     * @brief 获取将图标绘制到(x, y, w, h)的图案，并标记为本帧已使用
+     * @return 图标不在图集中时返回false
+     */
+    bool GetPaint(NVGcontext* vg, u64 application_id, float x, float y, float w, float h, NVGpaint& out_paint);
+
+    std::size_t GetResidentCount() const { return m_slot_by_id.size(); }
+    std::size_t GetPageCount() const { return m_pages.size(); }
+
+private:
+    struct Slot {
+        u64 application_id;
+        u32 last_used;
+        bool used;
+    };
+
+    int AllocateSlot(NVGcontext* vg);
+
+    std::size_t m_max_pages;                        ///< 页面数量上限
+    std::vector<int> m_pages;                       ///< 页面的NVG图像ID
+    std::vector<Slot> m_slots;                      ///< 所有页面的槽位
+    std::unordered_map<u64, int> m_slot_by_id;      ///< 应用ID到槽位的映射
+    u32 m_frame{1};                                 ///< LRU帧计数
+};
+
+} // namespace tj
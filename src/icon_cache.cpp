@@ -0,0 +1,266 @@
+/**
+ * @file icon_cache.cpp
+ * @brief 图标RGBA缓存的实现
+ */
+#include "icon_cache.hpp"
+
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <sys/stat.h>
+
+namespace tj {
+
+namespace {
+
+// 逐级创建缓存文件所在目录 (Create the parent directories of the cache file)
+void CreateParentDirectories(const char* path) {
+    const std::string full{path};
+    // 跳过设备前缀，例如"sdmc:/" (Skip the device prefix, e.g. "sdmc:/")
+    auto pos = full.find(":/");
+    pos = pos == std::string::npos ? 0 : pos + 2;
+    while ((pos = full.find('/', pos)) != std::string::npos) {
+        mkdir(full.substr(0, pos).c_str(), 0777);
+        pos++;
+    }
+}
+
+} // namespace
+
+IconCache::IconCache(const char* path, std::size_t max_bytes)
+    : m_path(path)
+    , m_slot_count(static_cast<u32>(std::max<std::size_t>(1, max_bytes / ICON_BYTES))) {
+}
+
+IconCache::~IconCache() {
+    Flush();
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+long IconCache::IndexOffset(u32 slot) const {
+    return static_cast<long>(sizeof(Header) + slot * sizeof(IndexEntry));
+}
+
+long IconCache::DataOffset(u32 slot) const {
+    return static_cast<long>(sizeof(Header) + m_slot_count * sizeof(IndexEntry) + slot * ICON_BYTES);
+}
+
+bool IconCache::Open() {
+    std::scoped_lock lock{m_mutex};
+    if (m_file) {
+        return true;
+    }
+
+    m_file = std::fopen(m_path, "r+b");
+    if (!m_file) {
+        return Reset();
+    }
+
+    Header header{};
+    if (std::fread(&header, sizeof(header), 1, m_file) != 1 ||
+        header.magic != MAGIC || header.version != VERSION ||
+        header.icon_size != ICON_SIZE || header.slot_count != m_slot_count) {
+        return Reset();
+    }
+
+    // 启动时只读取索引表 (Only the index table is read at startup)
+    m_index.resize(m_slot_count);
+    if (std::fread(m_index.data(), sizeof(IndexEntry), m_index.size(), m_file) != m_index.size()) {
+        return Reset();
+    }
+
+    for (u32 slot = 0; slot < m_slot_count; slot++) {
+        const auto& entry = m_index[slot];
+        if (entry.valid) {
+            m_slot_by_id[entry.application_id] = slot;
+            m_clock = std::max(m_clock, entry.last_used);
+        }
+    }
+    return true;
+}
+
+bool IconCache::Reset() {
+    if (m_file) {
+        std::fclose(m_file);
+    }
+
+    CreateParentDirectories(m_path);
+    m_file = std::fopen(m_path, "w+b");
+    m_index.assign(m_slot_count, IndexEntry{});
+    m_slot_by_id.clear();
+    m_clock = 0;
+    m_dirty = false;
+    if (!m_file) {
+        return false;
+    }
+
+    const Header header{MAGIC, VERSION, ICON_SIZE, m_slot_count};
+    if (std::fwrite(&header, sizeof(header), 1, m_file) != 1 ||
+        std::fwrite(m_index.data(), sizeof(IndexEntry), m_index.size(), m_file) != m_index.size()) {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    std::fflush(m_file);
+    return true;
+}
+
+bool IconCache::Lookup(u64 application_id, u64 icon_hash, unsigned char* out_rgba) {
+    std::scoped_lock lock{m_mutex};
+    if (!m_file) {
+        return false;
+    }
+
+    const auto it = m_slot_by_id.find(application_id);
+    if (it == m_slot_by_id.end()) {
+        return false;
+    }
+
+    const u32 slot = it->second;
+    auto& entry = m_index[slot];
+    // 图标已变化，旧数据失效 (Icon changed, the old data is stale)
+    if (entry.icon_hash != icon_hash) {
+        entry.valid = 0;
+        m_slot_by_id.erase(it);
+        WriteIndexEntry(slot);
+        return false;
+    }
+
+    if (std::fseek(m_file, DataOffset(slot), SEEK_SET) != 0 ||
+        std::fread(out_rgba, 1, ICON_BYTES, m_file) != ICON_BYTES) {
+        return false;
+    }
+
+    entry.last_used = ++m_clock;
+    m_dirty = true;
+    return true;
+}
+
+bool IconCache::Contains(u64 application_id, u64 icon_hash) {
+    std::scoped_lock lock{m_mutex};
+    const auto it = m_slot_by_id.find(application_id);
+    return m_file && it != m_slot_by_id.end() && m_index[it->second].icon_hash == icon_hash;
+}
+
+u32 IconCache::FindVictimSlot() {
+    u32 victim = 0;
+    for (u32 slot = 0; slot < m_slot_count; slot++) {
+        if (!m_index[slot].valid) {
+            return slot;
+        }
+        if (m_index[slot].last_used < m_index[victim].last_used) {
+            victim = slot;
+        }
+    }
+    return victim;
+}
+
+void IconCache::Store(u64 application_id, u64 icon_hash, const unsigned char* rgba) {
+    std::scoped_lock lock{m_mutex};
+    if (!m_file) {
+        return;
+    }
+
+    u32 slot;
+    if (const auto it = m_slot_by_id.find(application_id); it != m_slot_by_id.end()) {
+        slot = it->second;
+    } else {
+        slot = FindVictimSlot();
+        if (m_index[slot].valid) {
+            m_slot_by_id.erase(m_index[slot].application_id);
+        }
+    }
+
+    // 先在磁盘上标记无效，数据写完后再标记有效，中途退出也不会读到错误的图标
+    // Mark invalid on disk first and valid only after the data is written, so an interrupted write never yields a wrong icon
+    auto& entry = m_index[slot];
+    entry.valid = 0;
+    WriteIndexEntry(slot);
+
+    if (std::fseek(m_file, DataOffset(slot), SEEK_SET) != 0 ||
+        std::fwrite(rgba, 1, ICON_BYTES, m_file) != ICON_BYTES) {
+        // 槽位已标记无效，去掉映射后FindVictimSlot会优先复用它 (The slot is already invalid, dropping the mapping lets FindVictimSlot reuse it first)
+        m_slot_by_id.erase(application_id);
+        return;
+    }
+
+    entry.application_id = application_id;
+    entry.icon_hash = icon_hash;
+    entry.last_used = ++m_clock;
+    entry.valid = 1;
+    WriteIndexEntry(slot);
+    m_slot_by_id[application_id] = slot;
+}
+
+void IconCache::Invalidate(u64 application_id) {
+    std::scoped_lock lock{m_mutex};
+    const auto it = m_slot_by_id.find(application_id);
+    if (it == m_slot_by_id.end()) {
+        return;
+    }
+    m_index[it->second].valid = 0;
+    WriteIndexEntry(it->second);
+    m_slot_by_id.erase(it);
+}
+
+void IconCache::WriteIndexEntry(u32 slot) {
+    if (std::fseek(m_file, IndexOffset(slot), SEEK_SET) == 0) {
+        std::fwrite(&m_index[slot], sizeof(IndexEntry), 1, m_file);
+    }
+}
+
+void IconCache::Flush() {
+    std::scoped_lock lock{m_mutex};
+    if (!m_file) {
+        return;
+    }
+
+    if (m_dirty && std::fseek(m_file, IndexOffset(0), SEEK_SET) == 0) {
+        std::fwrite(m_index.data(), sizeof(IndexEntry), m_index.size(), m_file);
+        m_dirty = false;
+    }
+    std::fflush(m_file);
+}
+
+u64 IconCache::HashIcon(const void* data, std::size_t size) {
+    auto bytes = static_cast<const unsigned char*>(data);
+    u64 hash = 0xCBF29CE484222325ULL;
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+void IconCache::Downscale(const unsigned char* src, int src_width, int src_height, unsigned char* dst) {
+    for (int y = 0; y < ICON_SIZE; y++) {
+        const int y0 = y * src_height / ICON_SIZE;
+        const int y1 = std::max(y0 + 1, (y + 1) * src_height / ICON_SIZE);
+        for (int x = 0; x < ICON_SIZE; x++) {
+            const int x0 = x * src_width / ICON_SIZE;
+            const int x1 = std::max(x0 + 1, (x + 1) * src_width / ICON_SIZE);
+
+            u32 sum[4]{};
+            for (int sy = y0; sy < y1; sy++) {
+                const unsigned char* row = src + (static_cast<std::size_t>(sy) * src_width + x0) * 4;
+                for (int sx = x0; sx < x1; sx++, row += 4) {
+                    sum[0] += row[0];
+                    sum[1] += row[1];
+                    sum[2] += row[2];
+                    sum[3] += row[3];
+                }
+            }
+
+            const u32 count = static_cast<u32>((y1 - y0) * (x1 - x0));
+            unsigned char* out = dst + (static_cast<std::size_t>(y) * ICON_SIZE + x) * 4;
+            for (int c = 0; c < 4; c++) {
+                out[c] = static_cast<unsigned char>((sum[c] + count / 2) / count);
+            }
+        }
+    }
+}
+
+} // namespace tj
@@ -0,0 +1,142 @@
+/**
+ * @file icon_cache.hpp
+ * @brief 已解码图标的持久化RGBA缓存，热启动时跳过JPEG解码
+ *        (Persistent RGBA cache of decoded icons, warm launches skip JPEG decoding)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+
+namespace tj {
+
+/**
+ * @brief 图标RGBA缓存
+ *
+ * 缓存文件由头部、固定大小的索引表和固定大小的数据槽组成。启动时只读取头部和索引，
+ * 命中时按槽偏移直接读取RGBA数据，可直接传给nvgCreateImageRGBA。
+ * 以应用ID和图标哈希为键，图标变化时哈希不同即自动失效；槽位用尽时按LRU淘汰。
+ *
+ * The cache file holds a header, a fixed-size index table and fixed-size data slots. Only the header and
+ * index are read at startup; a hit reads the RGBA data straight from the slot offset, ready for nvgCreateImageRGBA.
+ * Keyed by application id and icon hash, so a changed icon misses automatically; slots are evicted LRU when full.
+ *
+ * 线程安全：Open、Lookup、Contains、Store、Invalidate和Flush都在内部持有m_mutex，解码线程和主线程可以同时调用。
+ * 持锁期间会读写文件，渲染线程不应直接调用它们，删除应用时经IconDecodePool::Invalidate在线程池上失效。
+ * IsOpen不加锁，只在Open返回后使用。
+ *
+ * Thread safety: Open, Lookup, Contains, Store, Invalidate and Flush all hold m_mutex internally, so decode workers
+ * and the main thread may call them concurrently. The lock is held across file I/O, so the render thread should not
+ * call them directly; removed titles are invalidated on the pool through IconDecodePool::Invalidate. IsOpen takes
+ * no lock and is only meaningful once Open has returned.
+ */
+class IconCache {
+public:
+    static constexpr int ICON_SIZE = 128;                                       ///< 缓存图标边长 (Cached icon edge)
+    static constexpr std::size_t ICON_BYTES = ICON_SIZE * ICON_SIZE * 4;        ///< 每个图标的RGBA字节数 (RGBA bytes per icon)
+
+    /**
+     * @brief 构造函数
+     * @param path 缓存文件路径
+     * @param max_bytes 图标数据的容量上限
+     */
+    IconCache(const char* path, std::size_t max_bytes);
+
+    /**
+     * @brief 析构函数，写回索引并关闭文件
+     */
+    ~IconCache();
+
+    IconCache(const IconCache&) = delete;
+    IconCache& operator=(const IconCache&) = delete;
+
+    /**
+     * @brief 打开或创建缓存文件，格式不匹配时重建
+     * @return 成功返回true，失败返回false（缓存被禁用）
+     */
+    bool Open();
+
+    /**
+     * @brief 查找图标
+     * @param application_id 应用ID
+     * @param icon_hash 图标JPEG数据的哈希
+     * @param out_rgba 命中时写入ICON_BYTES字节的RGBA数据
+     * @return 命中返回true
+     */
+    bool Lookup(u64 application_id, u64 icon_hash, unsigned char* out_rgba);
+
+    /**
+     * @brief 图标是否已缓存，不读取数据也不更新LRU
+     */
+    bool Contains(u64 application_id, u64 icon_hash);
+
+    /**
+     * @brief 写入图标，必要时淘汰最久未使用的槽位
+     * @param application_id 应用ID
+     * @param icon_hash 图标JPEG数据的哈希
+     * @param rgba ICON_BYTES字节的RGBA数据
+     */
+    void Store(u64 application_id, u64 icon_hash, const unsigned char* rgba);
+
+    /**
+     * @brief 使某个应用的缓存失效（例如应用被删除）
+     */
+    void Invalidate(u64 application_id);
+
+    /**
+     * @brief 写回索引表（LRU时间戳）
+     */
+    void Flush();
+
+    /**
+     * @brief 计算图标数据的64位FNV-1a哈希
+     */
+    static u64 HashIcon(const void* data, std::size_t size);
+
+    /**
+     * @brief 按区域平均将RGBA图像缩放到ICON_SIZE x ICON_SIZE
+     */
+    static void Downscale(const unsigned char* src, int src_width, int src_height, unsigned char* dst);
+
+    bool IsOpen() const { return m_file != nullptr; }
+
+private:
+    struct Header {
+        u32 magic;
+        u32 version;
+        u32 icon_size;
+        u32 slot_count;
+    };
+
+    struct IndexEntry {
+        u64 application_id;
+        u64 icon_hash;
+        u32 last_used;
+        u32 valid;
+    };
+
+    static constexpr u32 MAGIC = 0x4E434955; // "UICN"
+    static constexpr u32 VERSION = 1;
+
+    bool Reset();
+    long IndexOffset(u32 slot) const;
+    long DataOffset(u32 slot) const;
+    void WriteIndexEntry(u32 slot);
+    u32 FindVictimSlot();
+
+    const char* m_path;                             ///< 缓存文件路径
+    u32 m_slot_count;                               ///< 数据槽数量
+    std::FILE* m_file{};                            ///< 缓存文件句柄
+    std::vector<IndexEntry> m_index;                ///< 内存中的索引表
+    std::unordered_map<u64, u32> m_slot_by_id;      ///< 应用ID到槽位的映射
+    u32 m_clock{};                                  ///< LRU逻辑时钟
+    bool m_dirty{};                                 ///< 索引是否需要写回
+    std::mutex m_mutex;                             ///< 保护文件、索引和LRU时钟
+};
+
+} // namespace tj
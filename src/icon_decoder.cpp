@@ -0,0 +1,172 @@
+/**
+ * @file icon_decoder.cpp
+ * @brief 后台图标解码池的实现
+ */
+#include "icon_decoder.hpp"
+// STB图像库 (STB image library)
+#include "nanovg/stb_image.h"
+
+namespace tj {
+
+namespace {
+
+// 验证JPEG数据完整性的辅助函数
+// Helper function to validate JPEG data integrity
+bool IsValidJpegData(const std::vector<unsigned char>& data) {
+    if (data.size() < 4) return false;
+
+    // 检查JPEG文件头和文件尾
+    // Check JPEG file header and trailer
+    bool has_jpeg_header = (data[0] == 0xFF && data[1] == 0xD8);
+    bool has_jpeg_trailer = (data[data.size()-2] == 0xFF && data[data.size()-1] == 0xD9);
+    return has_jpeg_header && has_jpeg_trailer;
+}
+
+} // namespace
+
+IconDecodePool::IconDecodePool(IconCache& cache, util::ThreadPool& pool) : m_cache(cache), m_pool(pool) {
+}
+
+IconDecodePool::~IconDecodePool() {
+    // 线程池的任务引用this，必须等它们全部结束 (Pool tasks reference this, so all of them must finish first)
+    std::unique_lock lock{m_mutex};
+    m_stopping = true;
+    m_idle.wait(lock, [this]() { return m_outstanding == 0; });
+}
+
+bool IconDecodePool::Submit(IconDecodeRequest&& request) {
+    {
+        std::scoped_lock lock{m_mutex};
+        if (!m_in_flight.insert(request.application_id).second) {
+            return false;
+        }
+        m_requests.emplace_back(std::move(request));
+        m_outstanding++;
+    }
+    // 每个任务解码队首的一个请求，先提交的先解码 (Each task decodes the request at the front, so earlier submissions decode first)
+    m_pool.submit([this]() { this->DecodeNext(); });
+    return true;
+}
+
+bool IconDecodePool::HasPending() const {
+    std::scoped_lock lock{m_mutex};
+    return !m_in_flight.empty();
+}
+
+std::vector<unsigned char> IconDecodePool::AcquireBuffer() {
+    {
+        std::scoped_lock lock{m_mutex};
+        if (!m_free_buffers.empty()) {
+            auto buffer = std::move(m_free_buffers.back());
+            m_free_buffers.pop_back();
+            return buffer;
+        }
+    }
+    return std::vector<unsigned char>(IconCache::ICON_BYTES);
+}
+
+void IconDecodePool::ReleaseBuffer(std::vector<unsigned char>&& buffer) {
+    std::scoped_lock lock{m_mutex};
+    if (m_free_buffers.size() < MAX_POOLED_BUFFERS) {
+        m_free_buffers.emplace_back(std::move(buffer));
+    }
+}
+
+void IconDecodePool::Invalidate(std::vector<u64>&& application_ids) {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_outstanding++;
+    }
+    m_pool.submit([this, application_ids = std::move(application_ids)]() {
+        for (u64 application_id : application_ids) {
+            m_cache.Invalidate(application_id);
+        }
+        std::scoped_lock lock{m_mutex};
+        if (--m_outstanding == 0) {
+            m_idle.notify_all();
+        }
+    });
+}
+
+void IconDecodePool::Finish(u64 application_id) {
+    std::scoped_lock lock{m_mutex};
+    m_in_flight.erase(application_id);
+}
+
+bool IconDecodePool::Decode(const IconDecodeRequest& request, std::vector<unsigned char>& rgba) {
+    // 1. 优先从RGBA缓存读取，跳过JPEG解码
+    // 1. Read from the RGBA cache first, skipping JPEG decoding
+    if (m_cache.Lookup(request.application_id, request.icon_hash, rgba.data())) {
+        return true;
+    }
+
+    // 2. 缓存未命中：解码JPEG，缩放后写入缓存
+    // 2. Cache miss: decode the JPEG, downscale and store it
+    if (!IsValidJpegData(request.jpeg)) {
+        return false;
+    }
+
+    int width{}, height{}, channels{};
+    unsigned char* decoded = stbi_load_from_memory(request.jpeg.data(), static_cast<int>(request.jpeg.size()), &width, &height, &channels, 4);
+    if (!decoded) {
+        return false;
+    }
+    IconCache::Downscale(decoded, width, height, rgba.data());
+    stbi_image_free(decoded);
+
+    m_cache.Store(request.application_id, request.icon_hash, rgba.data());
+    return true;
+}
+
+void IconDecodePool::DecodeNext() {
+    IconDecodeRequest request;
+    bool stopping;
+    {
+        std::scoped_lock lock{m_mutex};
+        request = std::move(m_requests.front());
+        m_requests.pop_front();
+        stopping = m_stopping;
+    }
+
+    auto rgba = AcquireBuffer();
+    if (stopping || !Decode(request, rgba)) {
+        ReleaseBuffer(std::move(rgba));
+        Finish(request.application_id);
+    } else {
+        std::scoped_lock lock{m_mutex};
+        m_decoded.emplace_back(DecodedIcon{request.application_id, std::move(rgba)});
+    }
+
+    std::scoped_lock lock{m_mutex};
+    if (--m_outstanding == 0) {
+        m_idle.notify_all();
+    }
+}
+
+std::size_t IconDecodePool::DrainDecoded(std::chrono::microseconds budget, const std::function<void(const DecodedIcon&)>& upload) {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    std::size_t uploaded = 0;
+
+    // 每帧至少上传一个，保证在预算很紧时也能推进 (Always upload at least one per frame so progress is made under a tight budget)
+    do {
+        DecodedIcon icon;
+        {
+            std::scoped_lock lock{m_mutex};
+            if (m_decoded.empty()) {
+                break;
+            }
+            icon = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        upload(icon);
+        uploaded++;
+
+        ReleaseBuffer(std::move(icon.rgba));
+        Finish(icon.application_id);
+    } while (std::chrono::steady_clock::now() < deadline);
+
+    return uploaded;
+}
+
+} // namespace tj
@@ -0,0 +1,112 @@
+/**
+ * @file icon_decoder.hpp
+ * @brief 后台图标解码池：工作线程将JPEG解码为RGBA，渲染线程只负责上传
+ *        (Background icon decode pool: workers decode JPEG to RGBA, the render thread only uploads)
+ */
+#pragma once
+
+#include "icon_cache.hpp"
+#include "thread_pool.hpp"
+
+#include <switch.h>
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+#include <unordered_set>
+
+namespace tj {
+
+/**
+ * @brief 解码请求
+ */
+struct IconDecodeRequest {
+    u64 application_id;
+    u64 icon_hash;
+    std::vector<unsigned char> jpeg; ///< 图标JPEG数据
+};
+
+/**
+ * @brief 已解码的图标，rgba为IconCache::ICON_SIZE见方的RGBA数据
+ */
+struct DecodedIcon {
+    u64 application_id;
+    std::vector<unsigned char> rgba;
+};
+
+/**
+ * @brief 图标解码池
+ *
+ * 每个请求在共享线程池上解码：先查询RGBA缓存，未命中时用stb_image解码并缩放，结果放入池化缓冲区。
+ * 渲染线程每帧在时间预算内取出结果并调用nvgCreateImageRGBA上传。
+ * Each request is decoded on the shared thread pool: the RGBA cache is checked first, with stb_image decoding and
+ * downscaling on a miss, into pooled buffers. The render thread drains results within a per-frame time budget and
+ * uploads them with nvgCreateImageRGBA.
+ */
+class IconDecodePool {
+public:
+    /**
+     * @brief 构造函数
+     * @param cache 图标RGBA缓存
+     * @param pool 执行解码的线程池
+     */
+    explicit IconDecodePool(IconCache& cache, util::ThreadPool& pool = util::ThreadPool::shared());
+
+    /**
+     * @brief 析构函数，丢弃未开始的请求并等待已提交的解码任务
+     */
+    ~IconDecodePool();
+
+    IconDecodePool(const IconDecodePool&) = delete;
+    IconDecodePool& operator=(const IconDecodePool&) = delete;
+
+    /**
+     * @brief 提交解码请求
+     * @return 已在处理中的应用返回false
+     */
+    bool Submit(IconDecodeRequest&& request);
+
+    /**
+     * @brief 在时间预算内取出已解码的图标并上传（仅在渲染线程调用）
+     * @param budget 本帧可用的时间
+     * @param upload 上传回调
+     * @return 本次上传的图标数量
+     */
+    std::size_t DrainDecoded(std::chrono::microseconds budget, const std::function<void(const DecodedIcon&)>& upload);
+
+    /**
+     * @brief 是否还有未完成的解码或上传
+     */
+    bool HasPending() const;
+
+    /**
+     * @brief 在线程池上使应用的缓存图标失效，渲染线程不必等待解码线程释放缓存锁
+     *        (Invalidate cached icons on the pool, so the render thread never waits for a decode worker to release the cache lock)
+     */
+    void Invalidate(std::vector<u64>&& application_ids);
+
+private:
+    void DecodeNext();
+    bool Decode(const IconDecodeRequest& request, std::vector<unsigned char>& rgba);
+    std::vector<unsigned char> AcquireBuffer();
+    void ReleaseBuffer(std::vector<unsigned char>&& buffer);
+    void Finish(u64 application_id);
+
+    static constexpr std::size_t MAX_POOLED_BUFFERS = 32; ///< 缓冲池最多保留的缓冲区数量
+
+    IconCache& m_cache;                                  ///< 图标RGBA缓存
+    util::ThreadPool& m_pool;                            ///< 执行解码的线程池
+    mutable std::mutex m_mutex;                          ///< 保护以下所有队列
+    std::condition_variable m_idle;                      ///< 通知析构函数解码任务已全部结束
+    std::size_t m_outstanding{};                         ///< 已提交到线程池尚未结束的任务
+    bool m_stopping{};                                   ///< 析构中，不再解码新请求
+    std::deque<IconDecodeRequest> m_requests;            ///< 待解码队列
+    std::deque<DecodedIcon> m_decoded;                   ///< 待上传队列
+    std::unordered_set<u64> m_in_flight;                 ///< 解码或上传中的应用ID，用于去重
+    std::vector<std::vector<unsigned char>> m_free_buffers; ///< 可复用的RGBA缓冲区
+};
+
+} // namespace tj
@@ -0,0 +1,84 @@
+/**
+ * @file id_index.cpp
+ * @brief 应用ID索引的实现
+ */
+#include "id_index.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace tj {
+
+namespace {
+
+constexpr std::size_t MIN_CAPACITY = 16;
+
+} // namespace
+
+u64 IdIndex::Hash(u64 id) {
+    // 应用ID的高位大多相同，用splitmix64的混合步骤打散 (Application ids mostly share their high bits, scramble with the splitmix64 mixer)
+    id ^= id >> 30;
+    id *= 0xBF58476D1CE4E5B9ULL;
+    id ^= id >> 27;
+    id *= 0x94D049BB133111EBULL;
+    id ^= id >> 31;
+    return id;
+}
+
+void IdIndex::Reset(std::size_t expected) {
+    const std::size_t capacity = std::bit_ceil(std::max(MIN_CAPACITY, expected * 2));
+    m_keys.assign(capacity, 0);
+    m_slots.assign(capacity, 0);
+    m_size = 0;
+    m_mask = capacity - 1;
+}
+
+void IdIndex::Grow() {
+    auto keys = std::move(m_keys);
+    auto slots = std::move(m_slots);
+    Reset(keys.size());
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        if (keys[i]) {
+            Insert(keys[i], slots[i]);
+        }
+    }
+}
+
+void IdIndex::Insert(u64 id, std::size_t slot) {
+    if (id == 0) {
+        return;
+    }
+    if (m_keys.empty() || (m_size + 1) * 2 > m_keys.size()) {
+        m_keys.empty() ? Reset() : Grow();
+    }
+
+    for (std::size_t i = Hash(id) & m_mask;; i = (i + 1) & m_mask) {
+        if (m_keys[i] == id) {
+            m_slots[i] = static_cast<u32>(slot);
+            return;
+        }
+        if (m_keys[i] == 0) {
+            m_keys[i] = id;
+            m_slots[i] = static_cast<u32>(slot);
+            m_size++;
+            return;
+        }
+    }
+}
+
+std::size_t IdIndex::Find(u64 id) const {
+    if (m_keys.empty() || id == 0) {
+        return NPOS;
+    }
+    for (std::size_t i = Hash(id) & m_mask;; i = (i + 1) & m_mask) {
+        if (m_keys[i] == id) {
+            return m_slots[i];
+        }
+        if (m_keys[i] == 0) {
+            return NPOS;
+        }
+    }
+}
+
+} // namespace tj
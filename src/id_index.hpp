@@ -0,0 +1,71 @@
+/**
+ * @file id_index.hpp
+ * @brief 应用ID到列表下标的开放寻址哈希索引 (Open-addressing hash index from application id to list slot)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace tj {
+
+/**
+ * @brief 应用ID索引
+ *
+ * 键和值存放在连续数组中，线性探测，负载因子不超过1/2，查找只访问少数相邻槽位。
+ * 应用ID不会为0，0用作空槽标记。删除应用或排序会移动下标，此时整体重建，开销与应用数量成线性关系。
+ *
+ * Keys and values live in flat arrays with linear probing and a load factor of at most 1/2, so a lookup only
+ * touches a few neighbouring slots. Application ids are never 0, which marks an empty slot. Removing titles or
+ * sorting moves slots, in which case the index is rebuilt in one pass, linear in the number of titles.
+ */
+class IdIndex {
+public:
+    static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief 清空并按给定顺序重建，下标即在序列中的位置
+     * @param items 元素序列
+     * @param id_of 从元素取得应用ID的函数
+     */
+    template <typename Range, typename Proj>
+    void Rebuild(const Range& items, Proj id_of) {
+        Reset(items.size());
+        std::size_t slot = 0;
+        for (const auto& item : items) {
+            Insert(id_of(item), slot++);
+        }
+    }
+
+    /**
+     * @brief 插入或更新应用ID对应的下标
+     */
+    void Insert(u64 id, std::size_t slot);
+
+    /**
+     * @brief 查找应用ID对应的下标
+     * @return 不存在时返回NPOS
+     */
+    std::size_t Find(u64 id) const;
+
+    bool Contains(u64 id) const { return Find(id) != NPOS; }
+    std::size_t Size() const { return m_size; }
+
+    /**
+     * @brief 清空索引，保留容量用于至少expected个应用
+     */
+    void Reset(std::size_t expected = 0);
+
+private:
+    static u64 Hash(u64 id);
+    void Grow();
+
+    std::vector<u64> m_keys;        ///< 0表示空槽 (0 marks an empty slot)
+    std::vector<u32> m_slots;       ///< 对应的列表下标 (Matching list slots)
+    std::size_t m_size{};           ///< 已存入的应用数量
+    std::size_t m_mask{};           ///< 容量减一，容量为2的幂
+};
+
+} // namespace tj
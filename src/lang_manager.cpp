@@ -34,9 +34,24 @@ std::string button_select_all = "Select All";
 std::string button_invert_select = "Invert";
 std::string sort_alpha_az = "Sort: Name";
 std::string sort_size_bigsmall = "Sort: Size";
+std::string sort_size_smallbig = "Sort: Smallest";
+std::string sort_alpha_za = "Sort: Name Z-A";
+std::string sort_nand_bigsmall = "Sort: NAND size";
+std::string sort_nand_smallbig = "Sort: NAND smallest";
+std::string sort_sd_bigsmall = "Sort: SD size";
+std::string sort_sd_smallbig = "Sort: SD smallest";
+std::string sort_author_az = "Sort: Publisher";
+std::string sort_author_za = "Sort: Publisher Z-A";
+std::string sort_id_asc = "Sort: Title ID";
+std::string sort_id_desc = "Sort: Title ID desc";
 std::string corrupted_install = "Corrupted";
 std::string system_memory = "System memory";
 std::string micro_sd_card = "microSD card";
+std::string delete_eta = "About %d:%02d left";
+std::string button_search = "Search";
+std::string button_clear = "Clear";
+std::string search_results = "\"%s\": %lu found";
+std::string search_guide = "Search names and publishers";
 
 namespace tj {
 
@@ -240,9 +255,24 @@ bool LangManager::loadLanguage(const std::string& langCode) {
             {"button_invert_select", std::ref(button_invert_select)},
             {"sort_alpha_az", std::ref(sort_alpha_az)},
             {"sort_size_bigsmall", std::ref(sort_size_bigsmall)},
+            {"sort_size_smallbig", std::ref(sort_size_smallbig)},
+            {"sort_alpha_za", std::ref(sort_alpha_za)},
+            {"sort_nand_bigsmall", std::ref(sort_nand_bigsmall)},
+            {"sort_nand_smallbig", std::ref(sort_nand_smallbig)},
+            {"sort_sd_bigsmall", std::ref(sort_sd_bigsmall)},
+            {"sort_sd_smallbig", std::ref(sort_sd_smallbig)},
+            {"sort_author_az", std::ref(sort_author_az)},
+            {"sort_author_za", std::ref(sort_author_za)},
+            {"sort_id_asc", std::ref(sort_id_asc)},
+            {"sort_id_desc", std::ref(sort_id_desc)},
             {"corrupted_install", std::ref(corrupted_install)},
             {"system_memory", std::ref(system_memory)},
-            {"micro_sd_card", std::ref(micro_sd_card)}
+            {"micro_sd_card", std::ref(micro_sd_card)},
+            {"delete_eta", std::ref(delete_eta)},
+            {"button_search", std::ref(button_search)},
+            {"button_clear", std::ref(button_clear)},
+            {"search_results", std::ref(search_results)},
+            {"search_guide", std::ref(search_guide)}
         };
 
         // 遍历映射表进行赋值 - 修改为更兼容的遍历方式
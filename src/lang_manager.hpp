@@ -35,9 +35,24 @@ extern std::string button_select_all;
 extern std::string button_invert_select;
 extern std::string sort_alpha_az;
 extern std::string sort_size_bigsmall;
+extern std::string sort_size_smallbig;
+extern std::string sort_alpha_za;
+extern std::string sort_nand_bigsmall;
+extern std::string sort_nand_smallbig;
+extern std::string sort_sd_bigsmall;
+extern std::string sort_sd_smallbig;
+extern std::string sort_author_az;
+extern std::string sort_author_za;
+extern std::string sort_id_asc;
+extern std::string sort_id_desc;
 extern std::string corrupted_install;
 extern std::string system_memory;
 extern std::string micro_sd_card;
+extern std::string delete_eta;
+extern std::string button_search;
+extern std::string button_clear;
+extern std::string search_results;
+extern std::string search_guide;
 
 namespace tj {
 
@@ -0,0 +1,178 @@
+/**
+ * @file list_scroller.cpp
+ * @brief 列表滚动的实现
+ */
+#include "list_scroller.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tj {
+
+namespace {
+
+float TicksToSeconds(u64 ticks) {
+    return static_cast<float>(armTicksToNs(ticks)) / 1e9f;
+}
+
+} // namespace
+
+ListScroller::ListScroller(float row_height, float viewport_height)
+    : m_row_height(row_height), m_viewport_height(viewport_height) {
+}
+
+float ListScroller::MaxOffset() const {
+    return std::max(0.f, static_cast<float>(m_rows) * m_row_height - m_viewport_height);
+}
+
+void ListScroller::SetRowCount(std::size_t rows) {
+    m_rows = rows;
+    if (m_offset > MaxOffset()) {
+        m_offset = MaxOffset();
+        m_velocity = 0.f;
+    }
+}
+
+void ListScroller::Reset() {
+    m_offset = 0.f;
+    m_velocity = 0.f;
+    m_touching = false;
+    m_dragging = false;
+}
+
+void ListScroller::TouchDown(float y, u64 tick) {
+    // 触摸立即停止惯性滑动 (A touch stops any fling immediately)
+    m_velocity = 0.f;
+    m_touching = true;
+    m_dragging = false;
+    m_touch_start_y = y;
+    m_touch_start_offset = m_offset;
+    m_touch_last_y = y;
+    m_touch_last_tick = tick;
+    m_touch_velocity = 0.f;
+}
+
+void ListScroller::TouchMove(float y, u64 tick) {
+    if (!m_touching) {
+        return;
+    }
+    if (!m_dragging && std::fabs(y - m_touch_start_y) < TAP_SLOP) {
+        return;
+    }
+    m_dragging = true;
+
+    // 手指速度取相邻采样的加权平均，减少触摸采样抖动 (Weight recent samples to smooth out touch sampling jitter)
+    const float dt = TicksToSeconds(tick - m_touch_last_tick);
+    if (dt > 0.f) {
+        const float instant = (m_touch_last_y - y) / dt;
+        m_touch_velocity = m_touch_velocity * 0.2f + instant * 0.8f;
+    }
+    m_touch_last_y = y;
+    m_touch_last_tick = tick;
+
+    SetOffset(m_touch_start_offset + (m_touch_start_y - y));
+}
+
+bool ListScroller::TouchUp(u64 tick) {
+    if (!m_touching) {
+        return false;
+    }
+    m_touching = false;
+    if (!m_dragging) {
+        return true;
+    }
+    m_dragging = false;
+
+    // 松开前停顿过的手指不滑动 (A finger that rested before lifting does not fling)
+    if (TicksToSeconds(tick - m_touch_last_tick) < STALE_SECONDS && std::fabs(m_touch_velocity) >= MIN_FLING_VELOCITY) {
+        m_velocity = std::clamp(m_touch_velocity, -MAX_VELOCITY, MAX_VELOCITY);
+        m_last_tick = tick;
+    }
+    return false;
+}
+
+void ListScroller::Update(u64 tick) {
+    if (m_velocity == 0.f || m_dragging) {
+        return;
+    }
+
+    const float dt = std::min(TicksToSeconds(tick - m_last_tick), 0.1f);
+    m_last_tick = tick;
+
+    // 指数衰减的精确积分：位移 = v/k * (1 - e^(-k*dt)) (Exact integral of the exponential decay)
+    const float decay = std::exp(-FRICTION * dt);
+    const float offset = m_offset + m_velocity / FRICTION * (1.f - decay);
+    m_velocity *= decay;
+
+    const float max_offset = MaxOffset();
+    if (offset <= 0.f || offset >= max_offset) {
+        m_offset = std::clamp(offset, 0.f, max_offset);
+        m_velocity = 0.f;
+    } else {
+        m_offset = offset;
+    }
+    if (std::fabs(m_velocity) < MIN_VELOCITY) {
+        m_velocity = 0.f;
+    }
+}
+
+void ListScroller::EnsureVisible(std::size_t row) {
+    m_velocity = 0.f;
+    const float top = static_cast<float>(row) * m_row_height;
+    if (top < m_offset) {
+        SetOffset(top);
+    } else if (top + m_row_height > m_offset + m_viewport_height) {
+        SetOffset(top + m_row_height - m_viewport_height);
+    }
+}
+
+bool ListScroller::ScrollRows(long rows) {
+    m_velocity = 0.f;
+    const float target = m_offset + static_cast<float>(rows) * m_row_height;
+    SetOffset(target);
+    return rows > 0 ? target > MaxOffset() : target < 0.f;
+}
+
+void ListScroller::SetOffset(float offset) {
+    m_offset = std::clamp(offset, 0.f, MaxOffset());
+}
+
+std::size_t ListScroller::RowAt(float y) const {
+    const float content_y = m_offset + y;
+    if (content_y < 0.f) {
+        return m_rows;
+    }
+    return std::min(static_cast<std::size_t>(content_y / m_row_height), m_rows);
+}
+
+std::pair<std::size_t, std::size_t> ListScroller::RangeFor(float top, float bottom) const {
+    const auto first = static_cast<std::size_t>(std::max(0.f, top) / m_row_height);
+    const auto last = static_cast<std::size_t>(std::ceil(std::max(0.f, bottom) / m_row_height));
+    return {std::min(first, m_rows), std::min(last, m_rows)};
+}
+
+std::pair<std::size_t, std::size_t> ListScroller::VisibleRange() const {
+    return RangeFor(m_offset, m_offset + m_viewport_height);
+}
+
+std::size_t ListScroller::ClampToVisible(std::size_t row) const {
+    if (!m_rows) {
+        return 0;
+    }
+    // 容差避免浮点误差把恰好对齐的行算作部分可见 (The tolerance keeps exactly aligned rows from counting as partial)
+    constexpr float EPSILON = 1e-3f;
+    const auto first = std::min(static_cast<std::size_t>(std::ceil(m_offset / m_row_height - EPSILON)), m_rows - 1);
+    const auto end = static_cast<std::size_t>((m_offset + m_viewport_height) / m_row_height + EPSILON);
+    const auto last = std::clamp(end > 0 ? end - 1 : std::size_t{0}, first, m_rows - 1);
+    return std::clamp(row, first, last);
+}
+
+std::pair<std::size_t, std::size_t> ListScroller::PredictRange(float seconds) const {
+    // 惯性滑动在这段时间内的位移，拖动时按手指速度外推 (Fling travel over the period, extrapolated from the finger while dragging)
+    const float velocity = m_dragging ? m_touch_velocity : m_velocity;
+    const float travel = velocity / FRICTION * (1.f - std::exp(-FRICTION * seconds));
+    const float predicted = std::clamp(m_offset + travel, 0.f, MaxOffset());
+    return RangeFor(std::min(m_offset, predicted), std::max(m_offset, predicted) + m_viewport_height);
+}
+
+} // namespace tj
@@ -0,0 +1,142 @@
+/**
+ * @file list_scroller.hpp
+ * @brief 应用列表的连续滚动：触摸拖动、惯性滑动和按键定位，并预测即将可见的行
+ *        (Continuous scrolling for the title list: touch drag, inertial fling and key navigation, with prediction of rows about to become visible)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace tj {
+
+/**
+ * @brief 列表滚动状态
+ *
+ * 滚动位置是以像素为单位的连续偏移，行可以部分可见。拖动时内容跟随手指，松开时按最近的手指速度开始惯性滑动，
+ * 速度按指数衰减，到达列表两端时停止。按键导航直接设置偏移，使光标行完整可见并停止惯性滑动。
+ * 惯性滑动的位移有解析解，因此可以预测接下来一段时间内会经过的行，提前加载它们的图标。只能在主线程使用。
+ *
+ * The scroll position is a continuous offset in pixels, so rows can be partially visible. While dragging the
+ * content follows the finger; on release a fling starts at the finger's recent velocity and decays exponentially,
+ * stopping at either end of the list. Key navigation sets the offset directly so the cursor row is fully visible,
+ * cancelling any fling. A fling's travel has a closed form, which lets callers predict the rows it will pass over
+ * in the next moments and load their icons ahead. Main thread only.
+ */
+class ListScroller {
+public:
+    /**
+     * @brief 构造函数
+     * @param row_height 行高（像素）
+     * @param viewport_height 完整显示的行所占的高度
+     */
+    ListScroller(float row_height, float viewport_height);
+
+    /**
+     * @brief 更新行数，偏移超出新范围时收回
+     */
+    void SetRowCount(std::size_t rows);
+
+    /**
+     * @brief 回到顶部并停止滑动
+     */
+    void Reset();
+
+    // 触摸输入，y为视口内的坐标 (Touch input, y is relative to the viewport top)
+    void TouchDown(float y, u64 tick);
+    void TouchMove(float y, u64 tick);
+
+    /**
+     * @brief 手指离开屏幕
+     * @return 没有发生拖动（点击）时返回true
+     */
+    bool TouchUp(u64 tick);
+
+    bool IsTouching() const { return m_touching; }
+
+    /**
+     * @brief 推进惯性滑动，每帧调用一次
+     */
+    void Update(u64 tick);
+
+    /**
+     * @brief 正在拖动或惯性滑动
+     */
+    bool IsMoving() const { return m_dragging || m_velocity != 0.f; }
+
+    /**
+     * @brief 滚动到使某行完整可见，停止惯性滑动
+     */
+    void EnsureVisible(std::size_t row);
+
+    /**
+     * @brief 按行数滚动，停止惯性滑动
+     * @return 目标越过列表末端（向下时）或顶端（向上时）而被截断时返回true
+     */
+    bool ScrollRows(long rows);
+
+    /**
+     * @brief 设置偏移，保持在有效范围内
+     */
+    void SetOffset(float offset);
+
+    float Offset() const { return m_offset; }
+    float Velocity() const { return m_velocity; }   ///< 像素/秒，正值向下滚动 (Pixels per second, positive scrolls down)
+
+    /**
+     * @brief 某行顶部在视口中的位置
+     */
+    float RowTop(std::size_t row) const { return static_cast<float>(row) * m_row_height - m_offset; }
+
+    /**
+     * @brief 视口内某位置所在的行，超出列表时返回行数
+     */
+    std::size_t RowAt(float y) const;
+
+    /**
+     * @brief 当前可见的行范围 [first, last)，包括部分可见的行
+     */
+    std::pair<std::size_t, std::size_t> VisibleRange() const;
+
+    /**
+     * @brief 把行号限制在完整可见的行之间
+     */
+    std::size_t ClampToVisible(std::size_t row) const;
+
+    /**
+     * @brief 预测接下来一段时间内会进入视口的行范围 [first, last)，包含当前可见的行
+     * @param seconds 预测时长
+     */
+    std::pair<std::size_t, std::size_t> PredictRange(float seconds) const;
+
+private:
+    static constexpr float FRICTION = 3.5f;            ///< 惯性速度的衰减率（每秒） (Fling decay rate per second)
+    static constexpr float MIN_VELOCITY = 30.f;        ///< 低于此速度时停止 (Stops below this speed)
+    static constexpr float MIN_FLING_VELOCITY = 150.f; ///< 松开时低于此速度不开始惯性滑动 (No fling below this release speed)
+    static constexpr float MAX_VELOCITY = 6000.f;      ///< 惯性速度上限 (Fling speed cap)
+    static constexpr float TAP_SLOP = 12.f;            ///< 移动超过此距离视为拖动 (Movement past this is a drag)
+    static constexpr float STALE_SECONDS = 0.06f;      ///< 松开前停顿超过此时长时不滑动 (No fling if the finger rested this long before release)
+
+    float MaxOffset() const;
+    std::pair<std::size_t, std::size_t> RangeFor(float top, float bottom) const;
+
+    float m_row_height;
+    float m_viewport_height;
+    std::size_t m_rows{};
+
+    float m_offset{};               ///< 像素偏移 (Offset in pixels)
+    float m_velocity{};             ///< 惯性速度 (Fling velocity)
+    u64 m_last_tick{};              ///< 上次推进惯性滑动的时间 (When the fling last advanced)
+
+    bool m_touching{};
+    bool m_dragging{};
+    float m_touch_start_y{};
+    float m_touch_start_offset{};
+    float m_touch_last_y{};
+    u64 m_touch_last_tick{};
+    float m_touch_velocity{};       ///< 手指速度的平滑值 (Smoothed finger velocity)
+};
+
+} // namespace tj
@@ -25,6 +25,7 @@ namespace nvg {
             glm::vec2 size;
         };
 
+        /* Blocking upload, only used for data too large for a staging slice. */
         void UpdateImage(dk::Image &image, CMemPool &scratchPool, dk::Device device, dk::Queue transferQueue, int type, int x, int y, int w, int h, const u8 *data) {
             /* Do not proceed if no data is provided upfront. */
             if (data == nullptr) {
@@ -147,9 +148,18 @@ namespace nvg {
 
         init_cmd_mem.destroy();
         init_cmd_buf.destroy();
+
+        /* Create the upload command buffer and the staging ring. */
+        m_upload_cmd_buf = dk::CmdBufMaker{m_device}.create();
+        m_upload_cmd_mem.allocate(m_data_mem_pool, UploadCmdSize);
+        m_upload_staging = m_data_mem_pool.allocate(UploadStagingSize, DK_IMAGE_LINEAR_STRIDE_ALIGNMENT);
     }
 
     DkRenderer::~DkRenderer() {
+        /* Uploads may still be reading from the staging ring. */
+        m_queue.waitIdle();
+        m_upload_staging.destroy();
+
         if (m_vertex_buffer) {
             m_vertex_buffer->destroy();
         }
@@ -423,10 +433,64 @@ namespace nvg {
         return nullptr;
     }
 
+    void DkRenderer::QueueUpload(dk::Image &image, int type, int x, int y, int w, int h, const u8 *data) {
+        /* Do not proceed if no data is provided upfront. */
+        if (data == nullptr) {
+            return;
+        }
+
+        const u32 slice_size = UploadStagingSize / NumUploadBatches;
+        const u32 size = type == NVG_TEXTURE_RGBA ? w * h * 4 : w * h;
+        const u32 aligned_size = (size + DK_IMAGE_LINEAR_STRIDE_ALIGNMENT - 1) & ~(DK_IMAGE_LINEAR_STRIDE_ALIGNMENT - 1);
+
+        /* Too large for a staging slice, fall back to a blocking upload after anything already queued. */
+        if (aligned_size > slice_size) {
+            this->FlushUploads();
+            UpdateImage(image, m_data_mem_pool, m_device, m_queue, type, x, y, w, h, data);
+            return;
+        }
+
+        /* The current slice is full, submit it and continue in the next one. */
+        if (m_upload_recording && (m_staging_offset + aligned_size > slice_size || m_upload_count >= MaxUploadsPerBatch)) {
+            this->FlushUploads();
+        }
+
+        if (!m_upload_recording) {
+            /* Waits on the fence of the batch that last used this slice, freeing its command and staging memory. */
+            m_upload_cmd_mem.begin(m_upload_cmd_buf);
+            m_staging_offset = 0;
+            m_upload_count = 0;
+            m_upload_recording = true;
+        }
+
+        const u32 offset = m_upload_slice * slice_size + m_staging_offset;
+        memcpy(static_cast<u8 *>(m_upload_staging.getCpuAddr()) + offset, data, size);
+        m_staging_offset += aligned_size;
+        m_upload_count++;
+
+        dk::ImageView image_view{image};
+        m_upload_cmd_buf.copyBufferToImage({ m_upload_staging.getGpuAddr() + offset }, image_view, { static_cast<uint32_t>(x), static_cast<uint32_t>(y), 0, static_cast<uint32_t>(w), static_cast<uint32_t>(h), 1 });
+    }
+
+    void DkRenderer::FlushUploads() {
+        if (!m_upload_recording) {
+            return;
+        }
+
+        /* Make the copied texels visible to later draws on the same queue. */
+        m_upload_cmd_buf.barrier(DkBarrier_Full, DkInvalidateFlags_Image | DkInvalidateFlags_L2Cache);
+        m_queue.submitCommands(m_upload_cmd_mem.end(m_upload_cmd_buf));
+
+        /* CCmdMemRing advances its slice in lockstep, so the staging slice shares its fence. */
+        m_upload_slice = (m_upload_slice + 1) % NumUploadBatches;
+        m_upload_recording = false;
+    }
+
     int DkRenderer::CreateTexture(const DKNVGcontext &ctx, int type, int w, int h, int image_flags, const unsigned char* data) {
         const auto texture_id = m_next_texture_id++;
         auto texture = std::make_shared<Texture>(texture_id);
-        texture->Initialize(m_image_mem_pool, m_data_mem_pool, m_device, m_queue, type, w, h, image_flags, data);
+        texture->Initialize(m_image_mem_pool, m_data_mem_pool, m_device, m_queue, type, w, h, image_flags, nullptr);
+        this->QueueUpload(texture->GetImage(), type, 0, 0, w, h, data);
         m_textures.push_back(texture);
         return texture->GetId();
     }
@@ -434,6 +498,9 @@ namespace nvg {
     int DkRenderer::DeleteTexture(const DKNVGcontext &ctx, int image) {
         bool found = false;
 
+        /* Submit pending copies first, so they are queued before anything that reuses the image memory. */
+        this->FlushUploads();
+
         for (auto it = m_textures.begin(); it != m_textures.end();) {
             /* Remove textures with the given id. */
             if ((*it)->GetId() == image) {
@@ -466,7 +533,25 @@ namespace nvg {
         x = 0;
         w = tex_desc.width;
 
-        UpdateImage(texture->GetImage(), m_data_mem_pool, m_device, m_queue, tex_desc.type, x, y, w, h, data);
+        this->QueueUpload(texture->GetImage(), tex_desc.type, x, y, w, h, data);
+        return 1;
+    }
+
+    int DkRenderer::UpdateTextureRegion(const DKNVGcontext &ctx, int image, int x, int y, int w, int h, const unsigned char *data) {
+        const std::shared_ptr<Texture> texture = this->FindTexture(image);
+
+        /* Could not find a texture. */
+        if (texture == nullptr) {
+            return 0;
+        }
+
+        /* Unlike UpdateTexture, data only holds the w*h region, so it can be copied as is. */
+        const DKNVGtextureDescriptor &tex_desc = texture->GetDescriptor();
+        if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > tex_desc.width || y + h > tex_desc.height) {
+            return 0;
+        }
+
+        this->QueueUpload(texture->GetImage(), tex_desc.type, x, y, w, h, data);
         return 1;
     }
 
@@ -492,6 +577,9 @@ namespace nvg {
     }
 
     void DkRenderer::Flush(DKNVGcontext &ctx) {
+        /* Texture updates made while recording this frame (e.g. the font atlas) must land before its draws. */
+        this->FlushUploads();
+
         if (ctx.ncalls > 0) {
             /* Prepare dynamic command buffer. */
             m_dyn_cmd_mem.begin(m_dyn_cmd_buf);
@@ -153,6 +153,11 @@ namespace nvg {
             static constexpr size_t DynamicCmdSize = 0x20000;
             static constexpr size_t FragmentUniformSize = sizeof(DKNVGfragUniforms) + 4 - sizeof(DKNVGfragUniforms) % 4;
             static constexpr size_t MaxImages = 0x1000;
+            /* The staging ring is split into one slice per upload batch, a slice is reused once its batch fence signals. */
+            static constexpr size_t UploadStagingSize = 0x400000;
+            static constexpr size_t UploadCmdSize = 0x4000;
+            static constexpr unsigned NumUploadBatches = 4;
+            static constexpr unsigned MaxUploadsPerBatch = 128;
 
             /* From the application. */
             u32 m_view_width;
@@ -179,6 +184,15 @@ namespace nvg {
             std::array<int, MaxImages> m_image_descriptor_mappings;
             int m_last_image_descriptor = 0;
 
+            /* Texture uploads. */
+            CMemPool::Handle m_upload_staging;
+            dk::UniqueCmdBuf m_upload_cmd_buf;
+            CCmdMemRing<NumUploadBatches> m_upload_cmd_mem;
+            unsigned m_upload_slice = 0;
+            u32 m_staging_offset = 0;
+            unsigned m_upload_count = 0;
+            bool m_upload_recording = false;
+
             int AcquireImageDescriptor(std::shared_ptr<Texture> texture, int image);
             void FreeImageDescriptor(int image);
             void SetUniforms(const DKNVGcontext &ctx, int offset, int image);
@@ -191,6 +205,8 @@ namespace nvg {
             void DrawTriangles(const DKNVGcontext &ctx, const DKNVGcall &call);
 
             std::shared_ptr<Texture> FindTexture(int id);
+
+            void QueueUpload(dk::Image &image, int type, int x, int y, int w, int h, const u8 *data);
         public:
             DkRenderer(unsigned int view_width, unsigned int view_height, dk::Device device, dk::Queue queue, CMemPool &image_mem_pool, CMemPool &code_mem_pool, CMemPool &data_mem_pool);
             ~DkRenderer();
@@ -199,10 +215,17 @@ namespace nvg {
             int CreateTexture(const DKNVGcontext &ctx, int type, int w, int h, int image_flags, const u8 *data);
             int DeleteTexture(const DKNVGcontext &ctx, int id);
             int UpdateTexture(const DKNVGcontext &ctx, int id, int x, int y, int w, int h, const u8 *data);
+            int UpdateTextureRegion(const DKNVGcontext &ctx, int id, int x, int y, int w, int h, const u8 *data);
             int GetTextureSize(const DKNVGcontext &ctx, int id, int *w, int *h);
             const DKNVGtextureDescriptor *GetTextureDescriptor(const DKNVGcontext &ctx, int id);
 
+            /* Submits all queued texture uploads as one command list, without waiting for the GPU. */
+            void FlushUploads();
+
             void Flush(DKNVGcontext &ctx);
     };
 
-}
\ No newline at end of file
+}
+
+/* Uploads a tightly packed w*h sub-rectangle of pixels into an existing image, defined in nanovg_dk.h. */
+extern "C" int nvgDkUpdateImageRegion(NVGcontext* ctx, int image, int x, int y, int w, int h, const unsigned char* data);
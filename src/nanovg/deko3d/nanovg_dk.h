@@ -515,6 +515,12 @@ void nvgDeleteDk(NVGcontext* ctx)
     nvgDeleteInternal(ctx);
 }
 
+int nvgDkUpdateImageRegion(NVGcontext* ctx, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+    DKNVGcontext* dk = (DKNVGcontext*)nvgInternalParams(ctx)->userPtr;
+    return dk->renderer->UpdateTextureRegion(*dk, image, x, y, w, h, data);
+}
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
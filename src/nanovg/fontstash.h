@@ -135,6 +135,14 @@ int fonsTextIterNext(FONScontext* stash, FONStextIter* iter, struct FONSquad* qu
 const unsigned char* fonsGetTextureData(FONScontext* stash, int* width, int* height);
 int fonsValidateTexture(FONScontext* s, int* dirty);
 
+// Atlas persistence. The state holds the atlas texture, its skyline and every font's glyph table, and
+// only loads back into a stash with the same fonts (name and data size) registered in the same order.
+int fonsAtlasStateSize(FONScontext* s);
+int fonsSaveAtlasState(FONScontext* s, unsigned char* data, int size);
+int fonsLoadAtlasState(FONScontext* s, const unsigned char* data, int size);
+// Returns the number of glyph bitmaps rasterized since the stash was created.
+int fonsGetRasterizedCount(FONScontext* s);
+
 // Draws the stash texture for debugging
 void fonsDrawDebug(FONScontext* s, float x, float y);
 
@@ -451,6 +459,7 @@ struct FONScontext
 	int nstates;
 	void (*handleError)(void* uptr, int error, int val);
 	void* errorUptr;
+	int nrasterized;
 };
 
 #ifdef STB_TRUETYPE_IMPLEMENTATION
@@ -1164,6 +1173,7 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	}
 
 	// Rasterize
+	stash->nrasterized++;
 	dst = &stash->texData[(glyph->x0+pad) + (glyph->y0+pad) * stash->params.width];
 	fons__tt_renderGlyphBitmap(&renderFont->font, dst, gw-pad*2,gh-pad*2, stash->params.width, scale, scale, g);
 
@@ -1782,4 +1792,187 @@ int fonsResetAtlas(FONScontext* stash, int width, int height)
 }
 
 
+#define FONS_ATLAS_STATE_MAGIC 0x414e4f46 // "FONA"
+#define FONS_ATLAS_STATE_VERSION 1
+
+struct FONSatlasStateHeader {
+	int magic;
+	int version;
+	int width, height;
+	int nnodes;
+	int nfonts;
+};
+typedef struct FONSatlasStateHeader FONSatlasStateHeader;
+
+struct FONSfontStateHeader {
+	char name[64];
+	int dataSize;
+	int nglyphs;
+	int lut[FONS_HASH_LUT_SIZE];
+};
+typedef struct FONSfontStateHeader FONSfontStateHeader;
+
+int fonsAtlasStateSize(FONScontext* stash)
+{
+	int i, size;
+	if (stash == NULL) return 0;
+	size = (int)sizeof(FONSatlasStateHeader);
+	size += (int)sizeof(FONSatlasNode) * stash->atlas->nnodes;
+	size += stash->params.width * stash->params.height;
+	for (i = 0; i < stash->nfonts; i++)
+		size += (int)sizeof(FONSfontStateHeader) + (int)sizeof(FONSglyph) * stash->fonts[i]->nglyphs;
+	return size;
+}
+
+int fonsSaveAtlasState(FONScontext* stash, unsigned char* data, int size)
+{
+	FONSatlasStateHeader header;
+	FONSfontStateHeader fontHeader;
+	int i;
+	if (stash == NULL || data == NULL || size < fonsAtlasStateSize(stash)) return 0;
+
+	memset(&header, 0, sizeof(header));
+	header.magic = FONS_ATLAS_STATE_MAGIC;
+	header.version = FONS_ATLAS_STATE_VERSION;
+	header.width = stash->params.width;
+	header.height = stash->params.height;
+	header.nnodes = stash->atlas->nnodes;
+	header.nfonts = stash->nfonts;
+	memcpy(data, &header, sizeof(header));
+	data += sizeof(header);
+
+	memcpy(data, stash->atlas->nodes, sizeof(FONSatlasNode) * header.nnodes);
+	data += sizeof(FONSatlasNode) * header.nnodes;
+	memcpy(data, stash->texData, header.width * header.height);
+	data += header.width * header.height;
+
+	for (i = 0; i < stash->nfonts; i++) {
+		FONSfont* font = stash->fonts[i];
+		memset(&fontHeader, 0, sizeof(fontHeader));
+		memcpy(fontHeader.name, font->name, sizeof(fontHeader.name));
+		fontHeader.dataSize = font->dataSize;
+		fontHeader.nglyphs = font->nglyphs;
+		memcpy(fontHeader.lut, font->lut, sizeof(fontHeader.lut));
+		memcpy(data, &fontHeader, sizeof(fontHeader));
+		data += sizeof(fontHeader);
+		memcpy(data, font->glyphs, sizeof(FONSglyph) * font->nglyphs);
+		data += sizeof(FONSglyph) * font->nglyphs;
+	}
+	return 1;
+}
+
+static int fons__validGlyphIndex(int i, int nglyphs)
+{
+	return i >= -1 && i < nglyphs;
+}
+
+int fonsLoadAtlasState(FONScontext* stash, const unsigned char* data, int size)
+{
+	FONSatlasStateHeader header;
+	FONSfontStateHeader fontHeader;
+	const unsigned char* ptr;
+	size_t offset, texSize;
+	int i, j;
+
+	if (stash == NULL || data == NULL || size < (int)sizeof(header)) return 0;
+	memcpy(&header, data, sizeof(header));
+	if (header.magic != FONS_ATLAS_STATE_MAGIC || header.version != FONS_ATLAS_STATE_VERSION) return 0;
+	if (header.nfonts != stash->nfonts) return 0;
+	if (header.width <= 0 || header.height <= 0 || header.width > 0x7fff || header.height > 0x7fff) return 0;
+	if (header.nnodes <= 0 || header.nnodes > header.width) return 0;
+	texSize = (size_t)header.width * header.height;
+
+	// Validate the whole state before touching the stash, so a rejected state leaves it as it was.
+	offset = sizeof(header) + sizeof(FONSatlasNode) * header.nnodes + texSize;
+	if (offset > (size_t)size) return 0;
+	for (i = 0; i < header.nfonts; i++) {
+		FONSfont* font = stash->fonts[i];
+		const FONSglyph* glyphs;
+		if (offset + sizeof(fontHeader) > (size_t)size) return 0;
+		memcpy(&fontHeader, data + offset, sizeof(fontHeader));
+		offset += sizeof(fontHeader);
+		if (strncmp(fontHeader.name, font->name, sizeof(fontHeader.name)) != 0) return 0;
+		if (fontHeader.dataSize != font->dataSize) return 0;
+		if (fontHeader.nglyphs < 0 || offset + sizeof(FONSglyph) * fontHeader.nglyphs > (size_t)size) return 0;
+		for (j = 0; j < FONS_HASH_LUT_SIZE; j++)
+			if (!fons__validGlyphIndex(fontHeader.lut[j], fontHeader.nglyphs)) return 0;
+		glyphs = (const FONSglyph*)(data + offset);
+		for (j = 0; j < fontHeader.nglyphs; j++) {
+			FONSglyph glyph;
+			memcpy(&glyph, &glyphs[j], sizeof(glyph));
+			if (!fons__validGlyphIndex(glyph.next, fontHeader.nglyphs)) return 0;
+			if (glyph.x0 >= 0 && (glyph.x1 > header.width || glyph.y1 > header.height)) return 0;
+		}
+		offset += sizeof(FONSglyph) * fontHeader.nglyphs;
+	}
+	if (offset != (size_t)size) return 0;
+
+	// Resize the texture data and skyline storage if needed.
+	if (header.width != stash->params.width || header.height != stash->params.height) {
+		unsigned char* texData;
+		if (stash->params.renderResize != NULL) {
+			if (stash->params.renderResize(stash->params.userPtr, header.width, header.height) == 0)
+				return 0;
+		}
+		texData = (unsigned char*)realloc(stash->texData, texSize);
+		if (texData == NULL) return 0;
+		stash->texData = texData;
+	}
+	if (header.nnodes > stash->atlas->cnodes) {
+		FONSatlasNode* nodes = (FONSatlasNode*)realloc(stash->atlas->nodes, sizeof(FONSatlasNode) * header.nnodes);
+		if (nodes == NULL) return 0;
+		stash->atlas->nodes = nodes;
+		stash->atlas->cnodes = header.nnodes;
+	}
+
+	ptr = data + sizeof(header);
+	memcpy(stash->atlas->nodes, ptr, sizeof(FONSatlasNode) * header.nnodes);
+	ptr += sizeof(FONSatlasNode) * header.nnodes;
+	stash->atlas->nnodes = header.nnodes;
+	stash->atlas->width = header.width;
+	stash->atlas->height = header.height;
+	memcpy(stash->texData, ptr, texSize);
+	ptr += texSize;
+
+	for (i = 0; i < header.nfonts; i++) {
+		FONSfont* font = stash->fonts[i];
+		memcpy(&fontHeader, ptr, sizeof(fontHeader));
+		ptr += sizeof(fontHeader);
+		if (fontHeader.nglyphs > font->cglyphs) {
+			FONSglyph* glyphs = (FONSglyph*)realloc(font->glyphs, sizeof(FONSglyph) * fontHeader.nglyphs);
+			if (glyphs == NULL) {
+				// Drop what was loaded so far rather than leave a partial atlas behind.
+				fonsResetAtlas(stash, header.width, header.height);
+				return 0;
+			}
+			font->glyphs = glyphs;
+			font->cglyphs = fontHeader.nglyphs;
+		}
+		memcpy(font->glyphs, ptr, sizeof(FONSglyph) * fontHeader.nglyphs);
+		ptr += sizeof(FONSglyph) * fontHeader.nglyphs;
+		font->nglyphs = fontHeader.nglyphs;
+		memcpy(font->lut, fontHeader.lut, sizeof(font->lut));
+	}
+
+	stash->params.width = header.width;
+	stash->params.height = header.height;
+	stash->itw = 1.0f/stash->params.width;
+	stash->ith = 1.0f/stash->params.height;
+
+	// The whole texture needs uploading.
+	stash->dirtyRect[0] = 0;
+	stash->dirtyRect[1] = 0;
+	stash->dirtyRect[2] = header.width;
+	stash->dirtyRect[3] = header.height;
+
+	return 1;
+}
+
+int fonsGetRasterizedCount(FONScontext* stash)
+{
+	if (stash == NULL) return 0;
+	return stash->nrasterized;
+}
+
+
 #endif
@@ -2340,6 +2340,42 @@ void nvgResetFallbackFonts(NVGcontext* ctx, const char* baseFont)
 	nvgResetFallbackFontsId(ctx, nvgFindFont(ctx, baseFont));
 }
 
+int nvgFontAtlasStateSize(NVGcontext* ctx)
+{
+	return fonsAtlasStateSize(ctx->fs);
+}
+
+int nvgSaveFontAtlas(NVGcontext* ctx, unsigned char* data, int size)
+{
+	return fonsSaveAtlasState(ctx->fs, data, size);
+}
+
+int nvgLoadFontAtlas(NVGcontext* ctx, const unsigned char* data, int size)
+{
+	int iw, ih, w, h, image;
+	if (ctx->fontImageIdx != 0 || ctx->fontImages[0] == 0) return 0;
+	nvgImageSize(ctx, ctx->fontImages[0], &iw, &ih);
+	if (!fonsLoadAtlasState(ctx->fs, data, size)) return 0;
+
+	// A saved atlas that grew past the initial size needs a matching texture.
+	fonsGetAtlasSize(ctx->fs, &w, &h);
+	if (w != iw || h != ih) {
+		image = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, w, h, 0, NULL);
+		if (image == 0) {
+			fonsResetAtlas(ctx->fs, iw, ih);
+			return 0;
+		}
+		nvgDeleteImage(ctx, ctx->fontImages[0]);
+		ctx->fontImages[0] = image;
+	}
+	return 1;
+}
+
+int nvgFontGlyphsRasterized(NVGcontext* ctx)
+{
+	return fonsGetRasterizedCount(ctx->fs);
+}
+
 // State setting
 void nvgFontSize(NVGcontext* ctx, float size)
 {
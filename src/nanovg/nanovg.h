@@ -571,6 +571,20 @@ void nvgResetFallbackFontsId(NVGcontext* ctx, int baseFont);
 // Resets fallback fonts by name.
 void nvgResetFallbackFonts(NVGcontext* ctx, const char* baseFont);
 
+// Returns the size in bytes of the glyph atlas state, see nvgSaveFontAtlas().
+int nvgFontAtlasStateSize(NVGcontext* ctx);
+
+// Copies the glyph atlas (texture and cached glyphs of every font) into data, which must hold nvgFontAtlasStateSize() bytes.
+// Call outside of a frame. Returns 1 on success.
+int nvgSaveFontAtlas(NVGcontext* ctx, unsigned char* data, int size);
+
+// Restores a glyph atlas saved by nvgSaveFontAtlas(). The same fonts must have been created in the same order
+// and no text drawn yet; otherwise the state is rejected and the atlas is left untouched. Returns 1 on success.
+int nvgLoadFontAtlas(NVGcontext* ctx, const unsigned char* data, int size);
+
+// Returns the number of glyph bitmaps rasterized since the context was created.
+int nvgFontGlyphsRasterized(NVGcontext* ctx);
+
 // Sets the font size of current text style.
 void nvgFontSize(NVGcontext* ctx, float size);
 
@@ -1,7 +1,9 @@
 #include "nvg_util.hpp"
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <array>
+#include <bit>
 #include <utility>
 #include <algorithm>
 
@@ -229,4 +231,54 @@ void drawButton(NVGcontext* vg, float x, float y, float size, Button button) {
     drawText(vg, x, y, size, getButton(button), nullptr, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE, getColour(Colour::WHITE));
 }
 
+float TextCache::TextWidth(NVGcontext* vg, float size, const char* text, int font) {
+    // FNV-1a哈希文本内容、字号和字体 (FNV-1a over the text, size and font)
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    const auto mix = [&hash](std::uint64_t value) {
+        hash ^= value;
+        hash *= 0x100000001B3ULL;
+    };
+    for (const char* c = text; *c; c++) {
+        mix(static_cast<unsigned char>(*c));
+    }
+    mix(std::bit_cast<std::uint32_t>(size));
+    mix(static_cast<std::uint32_t>(font));
+
+    // 哈希相同时比较内容，冲突的条目被覆盖 (Compare contents on a hash match, a colliding entry is overwritten)
+    if (const auto it = m_widths.find(hash); it != m_widths.end()) {
+        const auto& measured = it->second;
+        if (measured.size == size && measured.font == font && std::strcmp(measured.text.c_str(), text) == 0) {
+            m_stats.hits++;
+            return measured.width;
+        }
+    }
+
+    m_stats.misses++;
+    if (m_widths.size() >= MAX_ENTRIES) {
+        m_widths.clear();
+    }
+    float bounds[4]{};
+    nvgFontSize(vg, size);
+    nvgTextBounds(vg, 0.f, 0.f, text, nullptr, bounds);
+    const float width = bounds[2] - bounds[0];
+    m_widths.insert_or_assign(hash, Measured{text, size, font, width});
+    return width;
+}
+
+void TextCache::Clear() {
+    m_formatted.clear();
+    m_widths.clear();
+}
+
+TextCache::Stats TextCache::TakeStats() {
+    const Stats stats = m_stats;
+    m_stats = {};
+    return stats;
+}
+
+TextCache& getTextCache() {
+    static TextCache cache;
+    return cache;
+}
+
 } // namespace tj::gfx
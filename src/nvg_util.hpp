@@ -5,6 +5,9 @@
 #include <array>
 #include <variant>
 #include <cstdio>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 
 namespace tj::gfx {
 
@@ -72,6 +75,89 @@ void drawTextArgs(NVGcontext*, float x, float y, float size, int align, Colour c
 
 void drawButton(NVGcontext* vg, float x, float y, float size, Button button);
 
+/**
+ * @brief 跨帧复用的文本缓存
+ *
+ * 缓存格式化后的字符串和测量得到的文本宽度，每帧绘制相同的文本时不再调用snprintf和nvgTextBounds。
+ * 格式化结果按调用方给出的键缓存，键须包含参与格式化的所有值，因此应用容量变化后自然使用新的条目；
+ * 宽度按文本内容、字体和字号缓存。语言或字体改变后须调用Clear，条目超过MAX_ENTRIES时整体清空。
+ * 只能在渲染线程使用。
+ *
+ * Caches formatted strings and measured text widths, so text drawn unchanged every frame no longer goes through
+ * snprintf and nvgTextBounds. Formatted strings are cached under a caller-built key that must cover every value
+ * that goes into the string, so a changed title size simply lands on a new entry; widths are keyed by content,
+ * font and size. Call Clear after the language or fonts change; the cache also empties itself once it holds more
+ * than MAX_ENTRIES entries. Render thread only.
+ */
+class TextCache {
+public:
+    static constexpr std::size_t MAX_ENTRIES = 4096;
+
+    /**
+     * @brief 命中和未命中次数，命中即省去的一次格式化或测量
+     */
+    struct Stats {
+        std::uint32_t hits;
+        std::uint32_t misses;
+    };
+
+    /**
+     * @brief 由标签和数值组成格式化键，数值只使用低56位
+     */
+    static constexpr std::uint64_t Key(std::uint8_t tag, std::uint64_t value) {
+        return (static_cast<std::uint64_t>(tag) << 56) | (value & ((std::uint64_t{1} << 56) - 1));
+    }
+
+    /**
+     * @brief 取得键对应的格式化文本，未命中时调用format生成
+     * @param format 返回std::string的函数
+     * @return 在下一次Clear之前有效
+     */
+    template <typename Fn>
+    const char* Format(std::uint64_t key, Fn&& format) {
+        if (const auto it = m_formatted.find(key); it != m_formatted.end()) {
+            m_stats.hits++;
+            return it->second.c_str();
+        }
+        m_stats.misses++;
+        if (m_formatted.size() >= MAX_ENTRIES) {
+            m_formatted.clear();
+        }
+        return m_formatted.emplace(key, format()).first->second.c_str();
+    }
+
+    /**
+     * @brief 取得文本在给定字号下的宽度，未命中时设置字号并调用nvgTextBounds
+     * @param font 调用方当前设置的NanoVG字体ID，只用于区分条目，默认0为Standard字体 (The face the caller has set, only used to tell entries apart)
+     */
+    float TextWidth(NVGcontext* vg, float size, const char* text, int font = 0);
+
+    /**
+     * @brief 清空所有条目
+     */
+    void Clear();
+
+    /**
+     * @brief 返回自上次调用以来的命中和未命中次数并清零
+     */
+    Stats TakeStats();
+
+private:
+    struct Measured {
+        std::string text;
+        float size;
+        int font;
+        float width;
+    };
+
+    std::unordered_map<std::uint64_t, std::string> m_formatted;     ///< 格式化文本 (Formatted strings)
+    std::unordered_map<std::uint64_t, Measured> m_widths;           ///< 按内容哈希的文本宽度 (Text widths by content hash)
+    Stats m_stats{};                                                ///< 本帧统计 (This frame's counts)
+};
+
+// 渲染线程共用的文本缓存 (Text cache shared by the render thread)
+TextCache& getTextCache();
+
 const char* getButton(Button button);
 
 // 定义支持组合按钮的新pair类型
@@ -117,12 +203,10 @@ void drawButtons2(NVGcontext* vg, Colour color = Colour::WHITE, std::same_as<pai
 
     float x = 1220.f;
     const float y = 675.f;
-    float bounds[4]{};
 
     for (const auto& [button, text] : list) {
         nvgFontSize(vg, 20.f);
-        nvgTextBounds(vg, x, y, text, nullptr, bounds);
-        auto len = bounds[2] - bounds[0];
+        auto len = getTextCache().TextWidth(vg, 20.f, text);
         nvgText(vg, x, y, text, nullptr);
 
         x -= len + 10.f;
@@ -132,26 +216,22 @@ void drawButtons2(NVGcontext* vg, Colour color = Colour::WHITE, std::same_as<pai
         if (std::holds_alternative<Button>(button)) {
             // 单个按钮
             const Button single_button = std::get<Button>(button);
-            nvgTextBounds(vg, x, y - 7.f, getButton(single_button), nullptr, bounds);
-            len = bounds[2] - bounds[0];
+            len = getTextCache().TextWidth(vg, 30.f, getButton(single_button));
             nvgText(vg, x, y - 7.f, getButton(single_button), nullptr);
             x -= len + 34.f;
         } else {
             // 组合按钮
             const auto& [first_button, second_button] = std::get<std::pair<Button, Button>>(button);
             // 绘制第二个按钮
-            nvgTextBounds(vg, x, y - 7.f, getButton(second_button), nullptr, bounds);
-            len = bounds[2] - bounds[0];
+            len = getTextCache().TextWidth(vg, 30.f, getButton(second_button));
             nvgText(vg, x, y - 7.f, getButton(second_button), nullptr);
             x -= len + 10.f;
             // 绘制"+"号
-            nvgTextBounds(vg, x, y - 7.f, "+", nullptr, bounds);
-            len = bounds[2] - bounds[0];
+            len = getTextCache().TextWidth(vg, 30.f, "+");
             nvgText(vg, x, y - 7.f, "+", nullptr);
             x -= len + 10.f;
             // 绘制第一个按钮
-            nvgTextBounds(vg, x, y - 7.f, getButton(first_button), nullptr, bounds);
-            len = bounds[2] - bounds[0];
+            len = getTextCache().TextWidth(vg, 30.f, getButton(first_button));
             nvgText(vg, x, y - 7.f, getButton(first_button), nullptr);
             x -= len + 34.f;
         }
@@ -167,15 +247,13 @@ void drawButtons2Colored(NVGcontext* vg, std::same_as<pair2_colored> auto ...arg
 
     float x = 1220.f;
     const float y = 675.f;
-    float bounds[4]{};
 
     for (const auto& [button, text, color] : list) {
         // 设置当前按钮的颜色
         nvgFillColor(vg, getColour(color));
         
         nvgFontSize(vg, 20.f);
-        nvgTextBounds(vg, x, y, text, nullptr, bounds);
-        auto len = bounds[2] - bounds[0];
+        auto len = getTextCache().TextWidth(vg, 20.f, text);
         nvgText(vg, x, y, text, nullptr);
 
         x -= len + 10.f;
@@ -185,26 +263,22 @@ void drawButtons2Colored(NVGcontext* vg, std::same_as<pair2_colored> auto ...arg
         if (std::holds_alternative<Button>(button)) {
             // 单个按钮
             const Button single_button = std::get<Button>(button);
-            nvgTextBounds(vg, x, y - 7.f, getButton(single_button), nullptr, bounds);
-            len = bounds[2] - bounds[0];
+            len = getTextCache().TextWidth(vg, 30.f, getButton(single_button));
             nvgText(vg, x, y - 7.f, getButton(single_button), nullptr);
             x -= len + 34.f;
         } else {
             // 组合按钮
             const auto& [first_button, second_button] = std::get<std::pair<Button, Button>>(button);
             // 绘制第二个按钮
-            nvgTextBounds(vg, x, y - 7.f, getButton(second_button), nullptr, bounds);
-            len = bounds[2] - bounds[0];
+            len = getTextCache().TextWidth(vg, 30.f, getButton(second_button));
             nvgText(vg, x, y - 7.f, getButton(second_button), nullptr);
             x -= len + 10.f;
             // 绘制"+"号
-            nvgTextBounds(vg, x, y - 7.f, "+", nullptr, bounds);
-            len = bounds[2] - bounds[0];
+            len = getTextCache().TextWidth(vg, 30.f, "+");
             nvgText(vg, x, y - 7.f, "+", nullptr);
             x -= len + 10.f;
             // 绘制第一个按钮
-            nvgTextBounds(vg, x, y - 7.f, getButton(first_button), nullptr, bounds);
-            len = bounds[2] - bounds[0];
+            len = getTextCache().TextWidth(vg, 30.f, getButton(first_button));
             nvgText(vg, x, y - 7.f, getButton(first_button), nullptr);
             x -= len + 34.f;
         }
@@ -221,18 +295,15 @@ void drawButtons(NVGcontext* vg, Colour color = Colour::WHITE, std::same_as<pair
 
     float x = 1220.f;
     const float y = 675.f;
-    float bounds[4]{};
 
     for (const auto& [button, text] : list) {
         nvgFontSize(vg, 20.f);
-        nvgTextBounds(vg, x, y, text, nullptr, bounds);
-        auto len = bounds[2] - bounds[0];
+        auto len = getTextCache().TextWidth(vg, 20.f, text);
         nvgText(vg, x, y, text, nullptr);
 
         x -= len + 10.f;
         nvgFontSize(vg, 30.f);
-        nvgTextBounds(vg, x, y - 7.f, getButton(button), nullptr, bounds);
-        len = bounds[2] - bounds[0];
+        len = getTextCache().TextWidth(vg, 30.f, getButton(button));
         nvgText(vg, x, y - 7.f, getButton(button), nullptr);
         x -= len + 34.f;
     }
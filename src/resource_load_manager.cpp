@@ -0,0 +1,214 @@
+/**
+ * @file resource_load_manager.cpp
+ * @brief 资源加载调度器的实现
+ */
+#include "resource_load_manager.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace tj {
+
+bool ResourceLoadManager::Lane::Before(std::size_t a, std::size_t b) const {
+    if (heap[a].priority != heap[b].priority) {
+        return heap[a].priority < heap[b].priority; // 优先级高的在前 (Higher priority first)
+    }
+    return heap[a].sequence < heap[b].sequence; // 相同优先级按提交顺序 (Same priority in submission order)
+}
+
+void ResourceLoadManager::Lane::Swap(std::size_t a, std::size_t b) {
+    std::swap(heap[a], heap[b]);
+    positions[heap[a].key] = a;
+    positions[heap[b].key] = b;
+}
+
+void ResourceLoadManager::Lane::SiftUp(std::size_t i) {
+    while (i > 0) {
+        const std::size_t parent = (i - 1) / 2;
+        if (!Before(i, parent)) {
+            break;
+        }
+        Swap(i, parent);
+        i = parent;
+    }
+}
+
+void ResourceLoadManager::Lane::SiftDown(std::size_t i) {
+    for (;;) {
+        const std::size_t left = i * 2 + 1;
+        const std::size_t right = left + 1;
+        std::size_t best = i;
+        if (left < heap.size() && Before(left, best)) {
+            best = left;
+        }
+        if (right < heap.size() && Before(right, best)) {
+            best = right;
+        }
+        if (best == i) {
+            break;
+        }
+        Swap(i, best);
+        i = best;
+    }
+}
+
+ResourceLoadManager::Entry ResourceLoadManager::Lane::RemoveAt(std::size_t i) {
+    const std::size_t last = heap.size() - 1;
+    if (i != last) {
+        Swap(i, last);
+    }
+    Entry entry = std::move(heap.back());
+    heap.pop_back();
+    positions.erase(entry.key);
+    if (i < heap.size()) {
+        SiftDown(i);
+        SiftUp(i);
+    }
+    return entry;
+}
+
+// 提交加载任务 (Submit loading task)
+void ResourceLoadManager::submitLoadTask(const ResourceLoadTask& task) {
+    std::scoped_lock lock{task_mutex};
+    auto& l = lane(task.task_type);
+    stats.submitted++;
+
+    // 已排队的应用只更新优先级和回调，保留首次提交的顺序和时间 (A queued title only updates priority and callback, keeping its first submission order and time)
+    if (const auto it = l.positions.find(task.application_id); it != l.positions.end()) {
+        auto& entry = l.heap[it->second];
+        entry.callback = task.load_callback;
+        stats.merged++;
+        if (entry.priority != task.priority) {
+            entry.priority = task.priority;
+            l.SiftUp(it->second);
+            l.SiftDown(l.positions[task.application_id]);
+        }
+        return;
+    }
+
+    l.heap.push_back({task.application_id, task.priority, next_sequence++, task.submit_time, task.load_callback});
+    l.positions[task.application_id] = l.heap.size() - 1;
+    l.SiftUp(l.heap.size() - 1);
+    stats.peak_depth = std::max(stats.peak_depth, l.heap.size());
+}
+
+std::size_t ResourceLoadManager::reprioritize(ResourceTaskType type, const std::function<int(u64)>& priority_of) {
+    std::scoped_lock lock{task_mutex};
+    auto& l = lane(type);
+
+    // 先原地改写优先级并移除取消的任务，再整体重建一次堆 (Rewrite priorities and drop cancelled tasks in place, then rebuild the heap once)
+    std::size_t kept = 0;
+    std::size_t cancelled = 0;
+    for (std::size_t i = 0; i < l.heap.size(); i++) {
+        const int priority = priority_of(l.heap[i].key);
+        if (priority == CANCEL_PRIORITY) {
+            cancelled++;
+            continue;
+        }
+        if (l.heap[i].priority != priority) {
+            l.heap[i].priority = priority;
+            stats.reprioritized++;
+        }
+        if (kept != i) {
+            l.heap[kept] = std::move(l.heap[i]);
+        }
+        kept++;
+    }
+    l.heap.resize(kept);
+
+    l.positions.clear();
+    for (std::size_t i = 0; i < l.heap.size(); i++) {
+        l.positions[l.heap[i].key] = i;
+    }
+    for (std::size_t i = l.heap.size() / 2; i-- > 0;) {
+        l.SiftDown(i);
+    }
+
+    stats.cancelled += cancelled;
+    return cancelled;
+}
+
+bool ResourceLoadManager::cancel(ResourceTaskType type, u64 application_id) {
+    std::scoped_lock lock{task_mutex};
+    auto& l = lane(type);
+    const auto it = l.positions.find(application_id);
+    if (it == l.positions.end()) {
+        return false;
+    }
+    l.RemoveAt(it->second);
+    stats.cancelled++;
+    return true;
+}
+
+// 处理每帧的加载任务 (Process loading tasks per frame)
+void ResourceLoadManager::processFrameLoads() {
+    // 在锁内按每条通道的预算出队，在锁外执行，避免回调阻塞提交 (Dequeue up to each lane's budget under the lock, run outside it so callbacks never block submitters)
+    std::vector<std::pair<ResourceTaskType, Entry>> batch;
+    {
+        std::scoped_lock lock{task_mutex};
+        for (std::size_t i = 0; i < LANE_COUNT; i++) {
+            auto& l = lanes[i];
+            for (int n = 0; n < LANE_BUDGETS[i] && !l.heap.empty(); n++) {
+                batch.emplace_back(static_cast<ResourceTaskType>(i), l.RemoveAt(0));
+            }
+        }
+    }
+
+    for (auto& [type, entry] : batch) {
+        const bool useful = entry.callback && entry.callback();
+
+        std::scoped_lock lock{task_mutex};
+        stats.executed++;
+        if (!useful) {
+            stats.wasted++;
+            continue;
+        }
+        auto& awaiting = lane(type).awaiting_display;
+        if (awaiting.size() < MAX_AWAITING_DISPLAY) {
+            awaiting.emplace(entry.key, entry.submit_time);
+        }
+    }
+}
+
+void ResourceLoadManager::taskDisplayed(ResourceTaskType type, u64 application_id) {
+    std::scoped_lock lock{task_mutex};
+    auto& awaiting = lane(type).awaiting_display;
+    const auto it = awaiting.find(application_id);
+    if (it == awaiting.end()) {
+        return;
+    }
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - it->second);
+    awaiting.erase(it);
+    stats.displayed++;
+    stats.latency_sum_us += latency.count();
+    stats.latency_max_us = std::max<u64>(stats.latency_max_us, latency.count());
+}
+
+bool ResourceLoadManager::hasPendingTasks() const { // 检查是否有待处理任务 (Check if there are pending tasks)
+    return getPendingTaskCount() != 0;
+}
+
+size_t ResourceLoadManager::getPendingTaskCount() const { // 获取待处理任务数量 (Get pending task count)
+    std::scoped_lock lock{task_mutex};
+    std::size_t count = 0;
+    for (const auto& l : lanes) {
+        count += l.heap.size();
+    }
+    return count;
+}
+
+size_t ResourceLoadManager::getPendingTaskCount(ResourceTaskType type) const {
+    std::scoped_lock lock{task_mutex};
+    return lanes[static_cast<std::size_t>(type)].heap.size();
+}
+
+ResourceLoadManager::Stats ResourceLoadManager::getStats() const {
+    std::scoped_lock lock{task_mutex};
+    Stats result = stats;
+    for (std::size_t i = 0; i < LANE_COUNT; i++) {
+        result.depth[i] = lanes[i].heap.size();
+    }
+    return result;
+}
+
+} // namespace tj
@@ -0,0 +1,137 @@
+/**
+ * @file resource_load_manager.hpp
+ * @brief 按键去重的资源加载调度器：每种任务类型一条通道，支持原地调整优先级和取消
+ *        (Keyed resource load scheduler: one lane per task type, with in-place re-prioritization and cancellation)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <limits>
+#include <functional>
+#include <unordered_map>
+
+namespace tj {
+
+// 资源加载任务结构体
+// Resource loading task structure
+enum class ResourceTaskType : u8 {
+    ICON,    // 图标加载任务 (Icon loading task)
+    COUNT,
+};
+
+struct ResourceLoadTask {
+    u64 application_id; // 任务的键，同一通道内唯一 (The task key, unique within a lane)
+    std::function<bool()> load_callback; // 返回false表示没有做有效工作 (Returns false when it did no useful work)
+    std::chrono::steady_clock::time_point submit_time;
+    int priority; // 优先级，数值越小优先级越高 (Priority, lower value = higher priority)
+    ResourceTaskType task_type; // 任务类型 (Task type)
+};
+
+/**
+ * @brief 资源加载管理器
+ *
+ * 每个通道是一个按应用ID索引的二叉堆：重复提交同一个应用只更新优先级和回调，不会入队两次；
+ * 视口移动后可以原地调整整条通道的优先级，并取消不再需要的任务。每帧每条通道按各自的预算出队，
+ * 不同类型的任务互不阻塞。回调在锁外执行，扫描线程可以同时提交任务。
+ *
+ * Each lane is a binary heap indexed by application id: submitting the same title again only updates its
+ * priority and callback instead of queueing it twice, and after the viewport moves a whole lane can be
+ * re-prioritized in place, cancelling tasks that are no longer wanted. Every frame each lane dequeues up to its
+ * own budget, so task types never block each other. Callbacks run outside the lock, so the scan thread can
+ * submit concurrently.
+ */
+class ResourceLoadManager {
+public:
+    /// 由reprioritize的回调返回，表示取消该任务 (Returned by the reprioritize callback to cancel the task)
+    static constexpr int CANCEL_PRIORITY = std::numeric_limits<int>::max();
+
+    /**
+     * @brief 累计统计
+     */
+    struct Stats {
+        std::size_t depth[static_cast<std::size_t>(ResourceTaskType::COUNT)]; ///< 当前队列深度 (Current queue depth)
+        std::size_t peak_depth;     ///< 最大队列深度 (Peak queue depth)
+        u64 submitted;              ///< 提交次数 (Submissions)
+        u64 merged;                 ///< 合并到已排队任务的提交 (Submissions merged into a queued task)
+        u64 reprioritized;          ///< 原地调整优先级的任务 (Tasks re-prioritized in place)
+        u64 cancelled;              ///< 执行前取消的任务 (Tasks cancelled before running)
+        u64 executed;               ///< 执行的任务 (Tasks run)
+        u64 wasted;                 ///< 执行了但没有做有效工作的任务 (Tasks run that did no useful work)
+        u64 displayed;              ///< 结果已显示的任务 (Tasks whose result reached the screen)
+        u64 latency_sum_us;         ///< 从提交到显示的延迟总和 (Sum of submit-to-display latency)
+        u64 latency_max_us;         ///< 从提交到显示的最大延迟 (Maximum submit-to-display latency)
+    };
+
+    /**
+     * @brief 提交任务，同一通道内已排队的同一应用只更新优先级和回调
+     */
+    void submitLoadTask(const ResourceLoadTask& task);
+
+    /**
+     * @brief 原地调整一条通道中所有任务的优先级
+     * @param priority_of 返回应用的新优先级，返回CANCEL_PRIORITY取消该任务
+     * @return 取消的任务数量
+     */
+    std::size_t reprioritize(ResourceTaskType type, const std::function<int(u64)>& priority_of);
+
+    /**
+     * @brief 取消一个排队中的任务
+     * @return 任务在队列中时返回true
+     */
+    bool cancel(ResourceTaskType type, u64 application_id);
+
+    void processFrameLoads(); // 在每帧调用 (Called every frame)
+
+    /**
+     * @brief 任务的结果已显示，记录从提交到显示的延迟（仅在渲染线程调用）
+     */
+    void taskDisplayed(ResourceTaskType type, u64 application_id);
+
+    bool hasPendingTasks() const;
+    size_t getPendingTaskCount() const;
+    size_t getPendingTaskCount(ResourceTaskType type) const;
+    Stats getStats() const;
+
+private:
+    static constexpr std::size_t LANE_COUNT = static_cast<std::size_t>(ResourceTaskType::COUNT);
+    // 每帧每条通道的最大出队数量，图标解码已移到后台 (Max dequeues per lane per frame, icon decoding now runs in the background)
+    static constexpr std::array<int, LANE_COUNT> LANE_BUDGETS{16};
+    // 等待显示的已执行任务上限，结果没有显示的任务不会无限累积 (Cap on run tasks awaiting display, so results that never show cannot pile up)
+    static constexpr std::size_t MAX_AWAITING_DISPLAY = 256;
+
+    struct Entry {
+        u64 key;
+        int priority;
+        u64 sequence;               ///< 首次提交的序号，同优先级先提交先执行 (First submission order, FIFO within a priority)
+        std::chrono::steady_clock::time_point submit_time;
+        std::function<bool()> callback;
+    };
+
+    // 按键索引的二叉堆 (Binary heap indexed by key)
+    struct Lane {
+        std::vector<Entry> heap;
+        std::unordered_map<u64, std::size_t> positions;
+        std::unordered_map<u64, std::chrono::steady_clock::time_point> awaiting_display;
+
+        bool Before(std::size_t a, std::size_t b) const;
+        void Swap(std::size_t a, std::size_t b);
+        void SiftUp(std::size_t i);
+        void SiftDown(std::size_t i);
+        Entry RemoveAt(std::size_t i);
+    };
+
+    Lane& lane(ResourceTaskType type) { return lanes[static_cast<std::size_t>(type)]; }
+
+    std::array<Lane, LANE_COUNT> lanes;
+    u64 next_sequence{};
+    Stats stats{};
+    mutable std::mutex task_mutex;
+};
+
+} // namespace tj
@@ -0,0 +1,128 @@
+/**
+ * @file search_keyboard.cpp
+ * @brief 搜索键盘的实现
+ */
+#include "search_keyboard.hpp"
+
+#include <cstddef>
+
+namespace tj {
+
+namespace {
+
+constexpr std::size_t MAX_TEXT_SIZE = 0x100; ///< 模态键盘的输出缓冲区大小 (Output buffer size of the modal keyboard)
+
+} // namespace
+
+SearchKeyboard::~SearchKeyboard() {
+    if (m_launched) {
+        swkbdInlineClose(&m_inline);
+    }
+    if (s_active == this) {
+        s_active = nullptr;
+    }
+}
+
+SearchKeyboard::Event SearchKeyboard::Open(const std::string& text, const char* guide) {
+    m_text = text;
+    m_changed = false;
+    m_result = Event::NONE;
+
+    // 内联键盘在首次打开时启动，之后保持后台运行 (The inline keyboard launches on first use and stays resident)
+    if (!m_launched) {
+        if (R_FAILED(swkbdInlineCreate(&m_inline))) {
+            return ShowModal(guide);
+        }
+        if (R_FAILED(swkbdInlineLaunchForLibraryApplet(&m_inline, LibAppletMode_AllForegroundInitiallyHidden, 0))) {
+            swkbdInlineClose(&m_inline);
+            return ShowModal(guide);
+        }
+        swkbdInlineSetChangedStringCallback(&m_inline, OnChanged);
+        swkbdInlineSetDecidedEnterCallback(&m_inline, OnDecided);
+        swkbdInlineSetDecidedCancelCallback(&m_inline, OnCancelled);
+        m_launched = true;
+    }
+
+    s_active = this;
+    SwkbdAppearArg arg;
+    swkbdInlineMakeAppearArg(&arg, SwkbdType_Normal);
+    swkbdInlineSetInputText(&m_inline, m_text.c_str());
+    swkbdInlineSetCursorPos(&m_inline, static_cast<s32>(m_text.size()));
+    swkbdInlineAppear(&m_inline, &arg);
+    m_open = true;
+    return Event::NONE;
+}
+
+SearchKeyboard::Event SearchKeyboard::ShowModal(const char* guide) {
+    SwkbdConfig config;
+    if (R_FAILED(swkbdCreate(&config, 0))) {
+        return Event::CANCELLED;
+    }
+    swkbdConfigMakePresetDefault(&config);
+    swkbdConfigSetGuideText(&config, guide);
+    swkbdConfigSetInitialText(&config, m_text.c_str());
+
+    char out[MAX_TEXT_SIZE]{};
+    const Result rc = swkbdShow(&config, out, sizeof(out));
+    swkbdClose(&config);
+    if (R_FAILED(rc)) {
+        return Event::CANCELLED;
+    }
+    m_text = out;
+    return Event::DECIDED;
+}
+
+SearchKeyboard::Event SearchKeyboard::Update() {
+    if (!m_launched) {
+        return Event::NONE;
+    }
+    // 回调在这里同步触发 (Callbacks fire synchronously in here)
+    SwkbdState state;
+    swkbdInlineUpdate(&m_inline, &state);
+    if (!m_open) {
+        return Event::NONE;
+    }
+
+    if (m_result != Event::NONE) {
+        const Event result = m_result;
+        m_result = Event::NONE;
+        m_changed = false;
+        Hide();
+        return result;
+    }
+    if (m_changed) {
+        m_changed = false;
+        return Event::CHANGED;
+    }
+    return Event::NONE;
+}
+
+void SearchKeyboard::Hide() {
+    swkbdInlineDisappear(&m_inline);
+    m_open = false;
+    if (s_active == this) {
+        s_active = nullptr;
+    }
+}
+
+void SearchKeyboard::OnChanged(const char* str, SwkbdChangedStringArg*) {
+    if (s_active) {
+        s_active->m_text = str;
+        s_active->m_changed = true;
+    }
+}
+
+void SearchKeyboard::OnDecided(const char* str, SwkbdDecidedEnterArg*) {
+    if (s_active) {
+        s_active->m_text = str;
+        s_active->m_result = Event::DECIDED;
+    }
+}
+
+void SearchKeyboard::OnCancelled() {
+    if (s_active) {
+        s_active->m_result = Event::CANCELLED;
+    }
+}
+
+} // namespace tj
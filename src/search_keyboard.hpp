@@ -0,0 +1,72 @@
+/**
+ * @file search_keyboard.hpp
+ * @brief 搜索输入：内联软件键盘随输入回报文本，不可用时退回模态键盘
+ *        (Search input: the inline software keyboard reports text as it is typed, falling back to the modal keyboard)
+ */
+#pragma once
+
+#include <switch.h>
+#include <string>
+
+namespace tj {
+
+/**
+ * @brief 搜索键盘
+ *
+ * 优先使用内联键盘：系统在应用画面上叠加键盘，每次文本变化通过回调报告，应用可以边输入边过滤列表。
+ * 内联键盘启动失败时使用模态键盘，此时只在确认后得到一次结果。回调在Update中触发，只能在主线程使用。
+ *
+ * The inline keyboard is preferred: the system overlays it on the application and reports every text change
+ * through callbacks, so the list can be filtered while typing. If the inline keyboard fails to launch, the modal
+ * keyboard is used and the text only arrives once on confirm. Callbacks fire inside Update, main thread only.
+ */
+class SearchKeyboard {
+public:
+    enum class Event {
+        NONE,       ///< 无变化 (Nothing happened)
+        CHANGED,    ///< 文本改变 (Text changed)
+        DECIDED,    ///< 确认输入，键盘已关闭 (Input confirmed, keyboard closed)
+        CANCELLED,  ///< 取消输入，键盘已关闭 (Input cancelled, keyboard closed)
+    };
+
+    SearchKeyboard() = default;
+    ~SearchKeyboard();
+
+    SearchKeyboard(const SearchKeyboard&) = delete;
+    SearchKeyboard& operator=(const SearchKeyboard&) = delete;
+
+    /**
+     * @brief 打开键盘
+     * @param text 初始文本
+     * @param guide 输入框为空时显示的提示
+     * @return 模态键盘已返回结果时为DECIDED或CANCELLED，内联键盘打开时为NONE
+     */
+    Event Open(const std::string& text, const char* guide);
+
+    /**
+     * @brief 每帧调用，驱动内联键盘并返回本帧的事件
+     */
+    Event Update();
+
+    bool IsOpen() const { return m_open; }
+    const std::string& Text() const { return m_text; }
+
+private:
+    static void OnChanged(const char* str, SwkbdChangedStringArg* arg);
+    static void OnDecided(const char* str, SwkbdDecidedEnterArg* arg);
+    static void OnCancelled();
+
+    Event ShowModal(const char* guide);
+    void Hide();
+
+    static inline SearchKeyboard* s_active{};   ///< 接收回调的实例 (Instance receiving callbacks)
+
+    SwkbdInline m_inline{};
+    bool m_launched{};                          ///< 内联键盘小程序已启动 (Inline keyboard applet launched)
+    bool m_open{};
+    bool m_changed{};
+    Event m_result{Event::NONE};
+    std::string m_text;
+};
+
+} // namespace tj
@@ -0,0 +1,102 @@
+/**
+ * @file selection_set.cpp
+ * @brief 选中集合的实现
+ */
+#include "selection_set.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace tj {
+
+void SelectionSet::Reset(std::size_t slots) {
+    m_words.assign((slots + WORD_BITS - 1) / WORD_BITS, 0);
+    m_slots = slots;
+    m_count = 0;
+    m_selected_nand = 0;
+    m_selected_sd = 0;
+}
+
+void SelectionSet::PushBack() {
+    if (m_slots % WORD_BITS == 0) {
+        m_words.push_back(0);
+    }
+    m_slots++;
+}
+
+bool SelectionSet::Set(std::size_t slot, bool selected, std::size_t size_nand, std::size_t size_sd) {
+    if (Test(slot) == selected) {
+        return false;
+    }
+    m_words[slot / WORD_BITS] ^= u64{1} << (slot % WORD_BITS);
+    if (selected) {
+        m_count++;
+        m_selected_nand += size_nand;
+        m_selected_sd += size_sd;
+    } else {
+        m_count--;
+        m_selected_nand -= size_nand;
+        m_selected_sd -= size_sd;
+    }
+    return true;
+}
+
+void SelectionSet::UpdateSizes(std::size_t slot, std::size_t old_nand, std::size_t old_sd, std::size_t new_nand, std::size_t new_sd) {
+    if (!Test(slot)) {
+        return;
+    }
+    m_selected_nand = m_selected_nand - old_nand + new_nand;
+    m_selected_sd = m_selected_sd - old_sd + new_sd;
+}
+
+void SelectionSet::SetAll(bool selected, std::size_t total_nand, std::size_t total_sd) {
+    std::ranges::fill(m_words, selected ? ~u64{0} : u64{0});
+    ClearTail();
+    m_count = selected ? m_slots : 0;
+    m_selected_nand = selected ? total_nand : 0;
+    m_selected_sd = selected ? total_sd : 0;
+}
+
+void SelectionSet::Invert(std::size_t total_nand, std::size_t total_sd) {
+    for (auto& word : m_words) {
+        word = ~word;
+    }
+    ClearTail();
+    // 反选后的集合是原集合的补集 (The inverted set is the complement of the old one)
+    m_count = m_slots - m_count;
+    m_selected_nand = total_nand - m_selected_nand;
+    m_selected_sd = total_sd - m_selected_sd;
+}
+
+void SelectionSet::Compact(const std::vector<bool>& erase) {
+    std::vector<u64> words((m_slots + WORD_BITS - 1) / WORD_BITS, 0);
+    std::size_t out = 0;
+    for (std::size_t slot = 0; slot < m_slots; slot++) {
+        if (erase[slot]) {
+            continue;
+        }
+        if (Test(slot)) {
+            words[out / WORD_BITS] |= u64{1} << (out % WORD_BITS);
+        }
+        out++;
+    }
+    words.resize((out + WORD_BITS - 1) / WORD_BITS);
+    m_words = std::move(words);
+    m_slots = out;
+    Recount();
+}
+
+void SelectionSet::ClearTail() {
+    if (const std::size_t used = m_slots % WORD_BITS; used && !m_words.empty()) {
+        m_words.back() &= (u64{1} << used) - 1;
+    }
+}
+
+void SelectionSet::Recount() {
+    m_count = 0;
+    for (u64 word : m_words) {
+        m_count += static_cast<std::size_t>(std::popcount(word));
+    }
+}
+
+} // namespace tj
@@ -0,0 +1,91 @@
+/**
+ * @file selection_set.hpp
+ * @brief 按存储槽记录选中状态的位集合，同时维护选中数量和各存储位置的总容量
+ *        (Bitset of selected storage slots that also keeps the selected count and per-storage byte totals)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace tj {
+
+/**
+ * @brief 选中集合
+ *
+ * 每个存储槽占一位，64个槽打包成一个字，全选和反选逐字处理。选中数量和NAND/SD总容量在每次修改时增量更新，
+ * 查询为O(1)。集合按存储槽而不是行号索引，排序不影响集合，无需重建。
+ * 修改单个槽时由调用方传入该应用的容量；全选和反选需要所有应用的容量总和。
+ *
+ * One bit per storage slot, 64 slots packed per word, so select-all and invert work a word at a time. The
+ * selected count and NAND/SD byte totals are updated incrementally on every change and read in O(1). The set is
+ * keyed by slot rather than row, so sorting leaves it untouched and nothing has to be rebuilt.
+ * Callers pass the title's sizes when changing a single slot; select-all and invert take the sums over all titles.
+ */
+class SelectionSet {
+public:
+    std::size_t Count() const { return m_count; }
+    std::size_t SelectedNand() const { return m_selected_nand; }
+    std::size_t SelectedSd() const { return m_selected_sd; }
+
+    bool Test(std::size_t slot) const {
+        return (m_words[slot / WORD_BITS] >> (slot % WORD_BITS)) & 1;
+    }
+
+    /**
+     * @brief 清空并设置存储槽数量
+     */
+    void Reset(std::size_t slots = 0);
+
+    /**
+     * @brief 末尾增加一个未选中的存储槽
+     */
+    void PushBack();
+
+    /**
+     * @brief 设置单个存储槽的选中状态
+     * @return 状态是否改变
+     */
+    bool Set(std::size_t slot, bool selected, std::size_t size_nand, std::size_t size_sd);
+
+    /**
+     * @brief 已选中的应用容量改变时更新总容量，未选中时不做任何事
+     */
+    void UpdateSizes(std::size_t slot, std::size_t old_nand, std::size_t old_sd, std::size_t new_nand, std::size_t new_sd);
+
+    /**
+     * @brief 全选或全部取消
+     * @param total_nand 所有应用在NAND上的总容量
+     * @param total_sd 所有应用在SD卡上的总容量
+     */
+    void SetAll(bool selected, std::size_t total_nand, std::size_t total_sd);
+
+    /**
+     * @brief 反选所有存储槽
+     * @param total_nand 所有应用在NAND上的总容量
+     * @param total_sd 所有应用在SD卡上的总容量
+     */
+    void Invert(std::size_t total_nand, std::size_t total_sd);
+
+    /**
+     * @brief 去掉标记的存储槽，其余槽向前移动并保持顺序
+     * @param erase 按存储槽标记要去掉的槽，被去掉的槽须已取消选中
+     */
+    void Compact(const std::vector<bool>& erase);
+
+private:
+    static constexpr std::size_t WORD_BITS = 64;
+
+    void ClearTail();
+    void Recount();
+
+    std::vector<u64> m_words;           ///< 选中位，末尾多余的位保持为0 (Selection bits, unused tail bits stay 0)
+    std::size_t m_slots{};              ///< 存储槽数量 (Number of slots)
+    std::size_t m_count{};              ///< 已选中数量 (Selected count)
+    std::size_t m_selected_nand{};      ///< 已选中应用在NAND上的总容量 (Total NAND size of selected titles)
+    std::size_t m_selected_sd{};        ///< 已选中应用在SD卡上的总容量 (Total SD size of selected titles)
+};
+
+} // namespace tj
@@ -0,0 +1,73 @@
+/**
+ * @file storage_stats.cpp
+ * @brief 存储空间统计线程的实现
+ */
+#include "storage_stats.hpp"
+// 应用信息服务 (Title service)
+#include "title_service.hpp"
+
+namespace tj {
+
+StorageStats::StorageStats(std::chrono::milliseconds min_interval)
+    : m_min_interval(min_interval)
+    , m_thread([this](std::stop_token stop_token) { this->ThreadLoop(stop_token); }) {
+}
+
+StorageStats::~StorageStats() {
+    m_thread.request_stop();
+    m_cv.notify_all();
+}
+
+StorageSpace StorageStats::Query() {
+    StorageSpace space{};
+    GetTitleService().GetTotalSpaceSize(NcmStorageId_BuiltInUser, &space.nand_total);
+    GetTitleService().GetFreeSpaceSize(NcmStorageId_BuiltInUser, &space.nand_free);
+    GetTitleService().GetTotalSpaceSize(NcmStorageId_SdCard, &space.sd_total);
+    GetTitleService().GetFreeSpaceSize(NcmStorageId_SdCard, &space.sd_free);
+    return space;
+}
+
+void StorageStats::RequestRefresh() {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_requested = true;
+    }
+    m_cv.notify_one();
+}
+
+bool StorageStats::TakeUpdate(StorageSpace& out) {
+    std::scoped_lock lock{m_mutex};
+    if (!m_updated) {
+        return false;
+    }
+    out = m_space;
+    m_updated = false;
+    return true;
+}
+
+void StorageStats::ThreadLoop(std::stop_token stop_token) {
+    while (!stop_token.stop_requested()) {
+        {
+            std::unique_lock lock{m_mutex};
+            if (!m_cv.wait(lock, stop_token, [this]() { return m_requested; })) {
+                return;
+            }
+            m_requested = false;
+        }
+
+        // 在锁外发起IPC (Issue the IPCs outside the lock)
+        const auto space = Query();
+        {
+            std::scoped_lock lock{m_mutex};
+            m_space = space;
+            m_updated = true;
+        }
+
+        // 限制刷新频率，期间到达的请求合并为下一次刷新
+        // Cap the refresh rate, requests arriving meanwhile are merged into the next refresh
+        std::unique_lock lock{m_mutex};
+        m_cv.wait_for(lock, stop_token, m_min_interval, [] { return false; });
+    }
+}
+
+} // namespace tj
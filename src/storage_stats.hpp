@@ -0,0 +1,82 @@
+/**
+ * @file storage_stats.hpp
+ * @brief 存储空间统计线程：以限定频率在后台刷新NAND和SD卡的容量
+ *        (Storage stats thread: refreshes NAND and SD card space in the background at a capped rate)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <stop_token>
+#include <condition_variable>
+
+namespace tj {
+
+/**
+ * @brief 存储空间快照
+ */
+struct StorageSpace {
+    s64 nand_total;
+    s64 nand_free;
+    s64 sd_total;
+    s64 sd_free;
+};
+
+/**
+ * @brief 存储空间统计
+ *
+ * 任意线程都可以请求刷新，请求在后台线程中合并执行，两次刷新之间至少间隔min_interval，
+ * 批量卸载时不会每删除一个应用就发起四次IPC。渲染线程每帧取回最新结果。
+ *
+ * Any thread may request a refresh; requests are coalesced on a background thread with at least min_interval
+ * between refreshes, so a batch uninstall does not issue four IPCs per deleted title. The render thread picks up
+ * the latest result each frame.
+ */
+class StorageStats {
+public:
+    /**
+     * @brief 构造函数，启动统计线程
+     * @param min_interval 两次刷新之间的最小间隔
+     */
+    explicit StorageStats(std::chrono::milliseconds min_interval = std::chrono::milliseconds(250));
+
+    /**
+     * @brief 析构函数，停止并等待统计线程
+     */
+    ~StorageStats();
+
+    StorageStats(const StorageStats&) = delete;
+    StorageStats& operator=(const StorageStats&) = delete;
+
+    /**
+     * @brief 请求刷新（任意线程，不阻塞）
+     */
+    void RequestRefresh();
+
+    /**
+     * @brief 取回上次调用后的新结果
+     * @return 有新结果返回true
+     */
+    bool TakeUpdate(StorageSpace& out);
+
+    /**
+     * @brief 在调用线程中同步查询存储空间
+     */
+    static StorageSpace Query();
+
+private:
+    void ThreadLoop(std::stop_token stop_token);
+
+    const std::chrono::milliseconds m_min_interval;     ///< 刷新频率上限
+    std::mutex m_mutex;                                 ///< 保护以下状态
+    std::condition_variable_any m_cv;                   ///< 通知统计线程有刷新请求
+    bool m_requested{};                                 ///< 是否有待处理的刷新请求
+    bool m_updated{};                                   ///< 是否有未取回的结果
+    StorageSpace m_space{};                             ///< 最新结果
+    std::jthread m_thread;                              ///< 统计线程，最后声明以便最先析构
+};
+
+} // namespace tj
@@ -0,0 +1,100 @@
+/**
+ * @file text_fold.cpp
+ * @brief UTF-8解码与码位折叠的实现
+ */
+#include "text_fold.hpp"
+
+namespace tj {
+
+namespace {
+
+// Latin-1补充区字母去掉重音后的基本字母，0表示作为分隔符 (Base letters of the Latin-1 Supplement letters, 0 marks a separator)
+constexpr char LATIN1_BASE[64] = {
+    'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',  // U+00C0
+    'd', 'n', 'o', 'o', 'o', 'o', 'o', 0,   'o', 'u', 'u', 'u', 'u', 'y', 't', 's',  // U+00D0
+    'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',  // U+00E0
+    'd', 'n', 'o', 'o', 'o', 'o', 'o', 0,   'o', 'u', 'u', 'u', 'u', 'y', 't', 'y',  // U+00F0
+};
+
+} // namespace
+
+char32_t DecodeUtf8(std::string_view text, std::size_t& i) {
+    const auto lead = static_cast<unsigned char>(text[i++]);
+    if (lead < 0x80) {
+        return lead;
+    }
+    std::size_t extra = 0;
+    char32_t c = 0;
+    if ((lead & 0xE0) == 0xC0) {
+        extra = 1;
+        c = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        extra = 2;
+        c = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        extra = 3;
+        c = lead & 0x07;
+    } else {
+        return 0xFFFD;
+    }
+    if (i + extra > text.size()) {
+        i = text.size();
+        return 0xFFFD;
+    }
+    for (std::size_t k = 0; k < extra; k++) {
+        const auto cont = static_cast<unsigned char>(text[i + k]);
+        if ((cont & 0xC0) != 0x80) {
+            i += k;
+            return 0xFFFD;
+        }
+        c = (c << 6) | (cont & 0x3F);
+    }
+    i += extra;
+    return c;
+}
+
+char32_t FoldCodePoint(char32_t c) {
+    // 全角ASCII转半角，表意空格转空格 (Full-width ASCII to half-width, ideographic space to space)
+    if (c >= 0xFF01 && c <= 0xFF5E) {
+        c -= 0xFEE0;
+    } else if (c == 0x3000) {
+        return FOLD_SEPARATOR;
+    }
+
+    if (c < 0x80) {
+        if (c >= 'A' && c <= 'Z') {
+            return c + ('a' - 'A');
+        }
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            return c;
+        }
+        return FOLD_SEPARATOR;
+    }
+    if (c < 0xC0) {
+        // Latin-1标点和符号，包括©和® (Latin-1 punctuation and symbols, including © and ®)
+        return FOLD_SEPARATOR;
+    }
+    if (c < 0x100) {
+        const char base = LATIN1_BASE[c - 0xC0];
+        return base ? static_cast<char32_t>(base) : FOLD_SEPARATOR;
+    }
+    // 西里尔字母转小写 (Cyrillic to lower case)
+    if (c >= 0x400 && c <= 0x40F) {
+        return c + 0x50;
+    }
+    if (c >= 0x410 && c <= 0x42F) {
+        return c + 0x20;
+    }
+    // 通用标点、™等字母式符号、CJK标点 (General punctuation, letterlike symbols such as ™, CJK punctuation)
+    if ((c >= 0x2000 && c <= 0x206F) || (c >= 0x2100 && c <= 0x214F) || (c >= 0x3001 && c <= 0x3003) ||
+        (c >= 0x3008 && c <= 0x3011) || c == 0x30FB) {
+        return FOLD_SEPARATOR;
+    }
+    // 平假名转片假名 (Hiragana to katakana)
+    if (c >= 0x3041 && c <= 0x3096) {
+        return c + 0x60;
+    }
+    return c;
+}
+
+} // namespace tj
@@ -0,0 +1,27 @@
+/**
+ * @file text_fold.hpp
+ * @brief 搜索和排序共用的UTF-8解码与码位折叠 (UTF-8 decoding and code point folding shared by search and sorting)
+ */
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace tj {
+
+/// 折叠后的分隔符，标点和空白都折叠为它 (Folded separator, punctuation and whitespace all fold to it)
+inline constexpr char32_t FOLD_SEPARATOR = U' ';
+
+/**
+ * @brief 解码一个UTF-8码位，非法字节按单字节的U+FFFD处理
+ * @param text UTF-8文本
+ * @param i 当前位置，返回时指向下一个码位
+ */
+char32_t DecodeUtf8(std::string_view text, std::size_t& i);
+
+/**
+ * @brief 折叠单个码位：大小写、全角半角、平假名片假名、拉丁字母重音，标点返回FOLD_SEPARATOR
+ */
+char32_t FoldCodePoint(char32_t c);
+
+} // namespace tj
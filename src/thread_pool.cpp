@@ -0,0 +1,122 @@
+#include "thread_pool.hpp"
+
+#include <bit>
+#include <utility>
+
+namespace util {
+namespace {
+
+// index of the worker running on this thread, or npos on any other thread.
+constexpr auto NOT_A_WORKER = static_cast<std::size_t>(-1);
+thread_local const ThreadPool* current_pool{};
+thread_local std::size_t current_index{NOT_A_WORKER};
+
+// the n-th set bit of the mask, so workers start spread over the allowed cores.
+int nth_core(u32 mask, std::size_t n) {
+    n %= std::popcount(mask);
+    for (; n; n--) {
+        mask &= mask - 1;
+    }
+    return std::countr_zero(mask);
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(const ThreadPoolConfig& config)
+: core_mask{config.core_mask ? config.core_mask : BIT(0) | BIT(1) | BIT(2)} {
+    const auto count = config.worker_count ? config.worker_count : 1;
+    this->queues.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        this->queues.emplace_back(std::make_unique<Queue>());
+    }
+    // queues must all exist before the first worker starts stealing.
+    this->threads.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        this->threads.emplace_back([this, i, core = nth_core(this->core_mask, i)](std::stop_token stop_token) {
+            this->run(stop_token, i, core);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    for (auto& thread : this->threads) {
+        thread.request_stop();
+    }
+    this->threads.clear();
+}
+
+void ThreadPool::submit(Task&& task) {
+    const auto index = current_pool == this
+        ? current_index
+        : this->next_queue.fetch_add(1, std::memory_order_relaxed) % this->queues.size();
+    {
+        std::scoped_lock lock{this->queues[index]->mutex};
+        this->queues[index]->tasks.emplace_back(std::move(task));
+    }
+    // increment under the sleep mutex so a worker about to wait can't miss it.
+    {
+        std::scoped_lock lock{this->sleep_mutex};
+        this->pending.fetch_add(1, std::memory_order_release);
+    }
+    this->sleep_cv.notify_one();
+}
+
+bool ThreadPool::try_pop(std::size_t index, Task& task) {
+    // own deque first, newest task while it is still hot in the cache.
+    {
+        auto& own = *this->queues[index];
+        std::scoped_lock lock{own.mutex};
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    // then steal the oldest task of the next workers along.
+    for (std::size_t i = 1; i < this->queues.size(); i++) {
+        auto& victim = *this->queues[(index + i) % this->queues.size()];
+        std::scoped_lock lock{victim.mutex};
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(std::stop_token stop_token, std::size_t index, int core) {
+    // prefer one core, but let the kernel move the worker within the mask.
+    svcSetThreadCoreMask(CUR_THREAD_HANDLE, core, this->core_mask);
+    current_pool = this;
+    current_index = index;
+
+    Task task;
+    for (;;) {
+        if (this->try_pop(index, task)) {
+            this->pending.fetch_sub(1, std::memory_order_acq_rel);
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock lock{this->sleep_mutex};
+        if (!this->sleep_cv.wait(lock, stop_token, [this] { return this->pending.load(std::memory_order_acquire) != 0; })) {
+            break;
+        }
+    }
+
+    // stopping: finish whatever is still queued so every future gets its value.
+    while (this->try_pop(index, task)) {
+        this->pending.fetch_sub(1, std::memory_order_acq_rel);
+        task();
+        task = nullptr;
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool{};
+    return pool;
+}
+
+} // namespace util
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <switch.h>
+#include <cstddef>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <stop_token>
+#include <condition_variable>
+
+namespace util {
+
+struct ThreadPoolConfig {
+    std::size_t worker_count{4};
+    // cores the workers may run on, core 0 is left to the render thread by default.
+    u32 core_mask{BIT(1) | BIT(2)};
+};
+
+// work-stealing executor: every worker owns a deque, takes its own newest task first and
+// steals the oldest task from the other workers when it runs dry.
+// tasks submitted from a worker go to that worker's deque, others are spread round-robin.
+// the destructor runs every queued task before joining, so no future is left without a value.
+// a task must not block waiting on another task of the same pool, it may be queued behind it.
+class ThreadPool {
+public:
+    using Task = std::move_only_function<void()>;
+
+    explicit ThreadPool(const ThreadPoolConfig& config = {});
+    ~ThreadPool();
+
+    // disable copying
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task&& task);
+
+    [[nodiscard]]
+    auto worker_count() const noexcept {
+        return this->threads.size();
+    }
+
+    // the pool shared by util::async, icon decoding and other short background work.
+    // jobs that block for seconds (scans, uninstalls) get a pool of their own so they don't starve it.
+    [[nodiscard]]
+    static ThreadPool& shared();
+
+private:
+    struct Queue {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+    };
+
+    void run(std::stop_token stop_token, std::size_t index, int core);
+    bool try_pop(std::size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues{};
+    std::atomic<std::size_t> next_queue{};
+    std::atomic<std::size_t> pending{};
+    std::mutex sleep_mutex{};
+    std::condition_variable_any sleep_cv{};
+    u32 core_mask{};
+    std::vector<std::jthread> threads{};
+};
+
+} // namespace util
@@ -0,0 +1,22 @@
+/**
+ * @file title_list_view.cpp
+ * @brief 应用列表视图发布点的实现
+ */
+#include "title_list_view.hpp"
+
+#include <utility>
+
+namespace tj {
+
+TitleListPublisher::TitleListPublisher() : m_current(std::make_shared<const TitleListView>()) {
+}
+
+void TitleListPublisher::Publish(std::shared_ptr<const TitleListView> view) {
+    m_current.store(std::move(view), std::memory_order_release);
+}
+
+std::shared_ptr<const TitleListView> TitleListPublisher::Acquire() const {
+    return m_current.load(std::memory_order_acquire);
+}
+
+} // namespace tj
@@ -0,0 +1,76 @@
+/**
+ * @file title_list_view.hpp
+ * @brief 渲染线程使用的不可变应用列表视图，由写入方原子发布
+ *        (Immutable title list view for the render thread, published atomically by the writers)
+ */
+#pragma once
+
+#include "id_index.hpp"
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+
+namespace tj {
+
+/**
+ * @brief 绘制一行应用所需的数据
+ */
+struct TitleRow {
+    u64 id;
+    std::string name;
+    std::size_t size_nand;
+    std::size_t size_sd;
+    std::size_t size_total;
+    bool selected;
+    bool corrupted{};   ///< 损坏的安装没有图标可加载 (Corrupted installs have no icon to load)
+};
+
+/**
+ * @brief 某一时刻应用列表的只读副本
+ */
+struct TitleListView {
+    u64 version;                                ///< 发布序号，每次发布递增 (Publish serial, increases on every publish)
+    std::vector<TitleRow> rows;                 ///< 与entries顺序相同 (Same order as entries)
+    std::vector<std::size_t> selected_indices;  ///< 已选中行的下标 (Indices of the selected rows)
+    std::size_t selected_nand{};                ///< 已选中应用在NAND上的总容量 (Total NAND size of selected titles)
+    std::size_t selected_sd{};                  ///< 已选中应用在SD卡上的总容量 (Total SD size of selected titles)
+    std::size_t visible_selected{};             ///< rows中已选中的行数，决定ZL是全选还是取消全选 (Selected rows in rows, decides whether ZL selects or deselects all)
+    bool filtered{};                            ///< rows是搜索结果 (rows are search results)
+    u64 moves{};                                ///< entries的MoveCount，变化时光标跟随原来的应用 (entries' MoveCount, the cursor follows its title when it changes)
+    IdIndex index;                              ///< 应用ID到行下标的索引 (Application id to row index)
+};
+
+/**
+ * @brief 应用列表视图的发布点
+ *
+ * 写入方在修改entries后构建新视图并发布，渲染线程每帧取得当前视图的引用后直接读取，无需加锁。
+ * 旧视图在最后一个读取方释放引用后销毁，因此写入方不会等待渲染线程，渲染线程也不会被写入方阻塞。
+ *
+ * Writers build and publish a new view after changing entries; the render thread takes a reference to the
+ * current view each frame and reads it without locking. An old view is destroyed once its last reader lets
+ * go, so writers never wait on the render thread and the render thread is never blocked by a writer.
+ */
+class TitleListPublisher {
+public:
+    TitleListPublisher();
+
+    /**
+     * @brief 发布新视图，替换当前视图
+     */
+    void Publish(std::shared_ptr<const TitleListView> view);
+
+    /**
+     * @brief 取得当前视图，返回的视图在持有期间不会改变
+     */
+    std::shared_ptr<const TitleListView> Acquire() const;
+
+private:
+    std::atomic<std::shared_ptr<const TitleListView>> m_current;   ///< 当前视图 (Current view)
+};
+
+} // namespace tj
@@ -0,0 +1,368 @@
+/**
+ * @file title_search.cpp
+ * @brief 应用搜索索引的实现
+ */
+#include "title_search.hpp"
+#include "title_table.hpp"
+#include "text_fold.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace tj {
+
+namespace {
+
+constexpr char32_t SPACE = FOLD_SEPARATOR;
+
+constexpr u64 TrigramKey(char32_t a, char32_t b, char32_t c) {
+    // 每个码位不超过21位 (Every code point fits in 21 bits)
+    return (static_cast<u64>(a) << 42) | (static_cast<u64>(b) << 21) | static_cast<u64>(c);
+}
+
+// 单字和双字的键用三元组用不到的最高位区分；规范化文本不含码位0，单字不会与双字冲突
+// (Unigram and bigram keys are told apart by the top bit trigrams never use; normalized text has no code point 0,
+// so a unigram never collides with a bigram)
+constexpr u64 SHORT_GRAM = 1ULL << 63;
+
+constexpr u64 UnigramKey(char32_t a) {
+    return SHORT_GRAM | static_cast<u64>(a);
+}
+
+constexpr u64 BigramKey(char32_t a, char32_t b) {
+    return SHORT_GRAM | (static_cast<u64>(a) << 21) | static_cast<u64>(b);
+}
+
+// 单字和双字列表的每项低2位是该文档的最佳匹配等级，与Verify相同，短查询因此无需逐个验证
+// (Every unigram and bigram entry carries the document's best match rank in its low 2 bits, the same rank Verify
+// would give, so short queries need no per-document check)
+constexpr u32 RANK_BITS = 2;
+constexpr u32 RANK_MASK = (1u << RANK_BITS) - 1;
+constexpr u32 RANK_AUTHOR = 3;
+
+/**
+ * @brief 查询中不重复的三元组
+ */
+void QueryTrigrams(const std::u32string& query, std::vector<u64>& out) {
+    out.clear();
+    for (std::size_t i = 0; i + 3 <= query.size(); i++) {
+        out.push_back(TrigramKey(query[i], query[i + 1], query[i + 2]));
+    }
+    std::ranges::sort(out);
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+} // namespace
+
+std::u32string TitleSearchIndex::Normalize(std::string_view text) {
+    std::u32string out;
+    out.reserve(text.size());
+    for (std::size_t i = 0; i < text.size();) {
+        const char32_t c = FoldCodePoint(DecodeUtf8(text, i));
+        // 合并连续的分隔符并去掉开头的分隔符 (Collapse runs of separators and drop leading ones)
+        if (c == SPACE && (out.empty() || out.back() == SPACE)) {
+            continue;
+        }
+        out.push_back(c);
+    }
+    if (!out.empty() && out.back() == SPACE) {
+        out.pop_back();
+    }
+    return out;
+}
+
+void TitleSearchIndex::Build(const TitleTable& table) {
+    m_docs.clear();
+    m_doc_of.clear();
+    m_postings.clear();
+    m_dead = 0;
+    m_generation++;
+
+    m_docs.reserve(table.Size());
+    m_doc_of.reserve(table.Size());
+    for (std::size_t row = 0; row < table.Size(); row++) {
+        AddDoc(table.Id(row), Normalize(table.Name(row)), Normalize(table.Author(row)));
+    }
+}
+
+void TitleSearchIndex::Upsert(u64 id, std::string_view name, std::string_view author) {
+    auto name_key = Normalize(name);
+    auto author_key = Normalize(author);
+    if (const auto it = m_doc_of.find(id); it != m_doc_of.end()) {
+        Doc& doc = m_docs[it->second];
+        if (doc.name == name_key && doc.author == author_key) {
+            return;
+        }
+        // 旧文档作废，新文档追加在末尾以保持倒排列表升序 (Retire the old document and append, keeping postings ascending)
+        doc.alive = false;
+        m_dead++;
+    }
+    m_generation++;
+    AddDoc(id, std::move(name_key), std::move(author_key));
+    if (m_dead > m_docs.size() / 2) {
+        Compact();
+    }
+}
+
+void TitleSearchIndex::Remove(const std::vector<u64>& ids) {
+    bool changed = false;
+    for (u64 id : ids) {
+        const auto it = m_doc_of.find(id);
+        if (it == m_doc_of.end()) {
+            continue;
+        }
+        m_docs[it->second].alive = false;
+        m_doc_of.erase(it);
+        m_dead++;
+        changed = true;
+    }
+    if (!changed) {
+        return;
+    }
+    m_generation++;
+    if (m_dead > m_docs.size() / 2) {
+        Compact();
+    }
+}
+
+void TitleSearchIndex::AddDoc(u64 id, std::u32string&& name, std::u32string&& author) {
+    const auto doc = static_cast<u32>(m_docs.size());
+    m_docs.push_back(Doc{id, std::move(name), std::move(author), true});
+    m_doc_of[id] = doc;
+    IndexText(doc, m_docs[doc].name, true);
+    IndexText(doc, m_docs[doc].author, false);
+}
+
+void TitleSearchIndex::IndexText(u32 doc, const std::u32string& text, bool is_name) {
+    // 文档按升序加入，只需和末尾比较去重 (Documents arrive in ascending order, comparing with the back dedupes)
+    const auto add = [this, doc](u64 key) {
+        auto& list = m_postings[key];
+        if (list.empty() || list.back() != doc) {
+            list.push_back(doc);
+        }
+    };
+    // 同一文档重复出现时保留更好的等级；名称先于发行商加入 (A repeat in the same document keeps the better rank; the name goes in before the publisher)
+    const auto add_ranked = [this, doc](u64 key, u32 rank) {
+        auto& list = m_postings[key];
+        const u32 entry = (doc << RANK_BITS) | rank;
+        if (list.empty() || (list.back() >> RANK_BITS) != doc) {
+            list.push_back(entry);
+        } else if ((list.back() & RANK_MASK) > rank) {
+            list.back() = entry;
+        }
+    };
+    for (std::size_t i = 0; i < text.size(); i++) {
+        // 名称开头、词首、名称中间、发行商 (Name start, word start, inside the name, publisher)
+        const u32 rank = !is_name ? RANK_AUTHOR : i == 0 ? 0 : text[i - 1] == SPACE ? 1 : 2;
+        add_ranked(UnigramKey(text[i]), rank);
+        if (i + 2 <= text.size()) {
+            add_ranked(BigramKey(text[i], text[i + 1]), rank);
+        }
+        if (i + 3 <= text.size()) {
+            add(TrigramKey(text[i], text[i + 1], text[i + 2]));
+        }
+    }
+}
+
+void TitleSearchIndex::Compact() {
+    std::vector<Doc> docs = std::move(m_docs);
+    m_docs.clear();
+    m_doc_of.clear();
+    m_postings.clear();
+    m_dead = 0;
+    m_generation++;
+    for (auto& doc : docs) {
+        if (doc.alive) {
+            AddDoc(doc.id, std::move(doc.name), std::move(doc.author));
+        }
+    }
+}
+
+bool TitleSearchIndex::Verify(const Doc& doc, const std::u32string& query, u32& rank) const {
+    auto pos = doc.name.find(query);
+    if (pos == 0) {
+        rank = 0;
+        return true;
+    }
+    if (pos != std::u32string::npos) {
+        rank = 2;
+        for (; pos != std::u32string::npos; pos = doc.name.find(query, pos + 1)) {
+            if (doc.name[pos - 1] == SPACE) {
+                rank = 1;
+                break;
+            }
+        }
+        return true;
+    }
+    if (doc.author.find(query) != std::u32string::npos) {
+        rank = 3;
+        return true;
+    }
+    return false;
+}
+
+void TitleSearchIndex::SubstringCandidates(const std::u32string& query, std::vector<u32>& out) const {
+    out.clear();
+    std::vector<u64> keys;
+    QueryTrigrams(query, keys);
+    std::vector<const std::vector<u32>*> lists;
+    lists.reserve(keys.size());
+    for (u64 key : keys) {
+        const auto it = m_postings.find(key);
+        if (it == m_postings.end()) {
+            return;
+        }
+        lists.push_back(&it->second);
+    }
+    // 从最短的列表开始求交集 (Intersect starting from the shortest list)
+    std::ranges::sort(lists, [](const auto* a, const auto* b) { return a->size() < b->size(); });
+    out = *lists.front();
+    std::vector<u32> next;
+    for (std::size_t i = 1; i < lists.size() && !out.empty(); i++) {
+        next.clear();
+        std::ranges::set_intersection(out, *lists[i], std::back_inserter(next));
+        out.swap(next);
+    }
+    std::erase_if(out, [this](u32 doc) { return !m_docs[doc].alive; });
+}
+
+void TitleSearchIndex::FuzzyCandidates(const std::u32string& query, std::vector<u64>& hits) {
+    static constexpr u16 MATCHED = 0xFFFF;
+
+    std::vector<u64> keys;
+    QueryTrigrams(query, keys);
+    if (keys.size() < 2) {
+        return;
+    }
+
+    // 已经按子串匹配的文档不再计数 (Documents that already matched as substrings are not counted again)
+    m_trigram_hits.assign(m_docs.size(), 0);
+    for (u64 hit : hits) {
+        m_trigram_hits[static_cast<u32>(hit)] = MATCHED;
+    }
+
+    std::vector<u32> touched;
+    for (u64 key : keys) {
+        const auto it = m_postings.find(key);
+        if (it == m_postings.end()) {
+            continue;
+        }
+        for (u32 doc : it->second) {
+            u16& count = m_trigram_hits[doc];
+            if (count == MATCHED) {
+                continue;
+            }
+            if (count++ == 0) {
+                touched.push_back(doc);
+            }
+        }
+    }
+
+    // 至少共享一半的三元组，一个错字会破坏最多三个三元组；缺得越少越靠前
+    // (Share at least half of the trigrams, one typo breaks up to three of them; fewer misses first)
+    const std::size_t threshold = (keys.size() + 1) / 2;
+    for (u32 doc : touched) {
+        const u16 count = m_trigram_hits[doc];
+        if (count >= threshold && m_docs[doc].alive) {
+            const auto missing = static_cast<u32>(keys.size() - count);
+            const auto length = static_cast<u32>(std::min<std::size_t>(m_docs[doc].name.size(), 0xFFFF));
+            hits.push_back(HitKey(4, (missing << 16) | length, doc));
+        }
+    }
+}
+
+void TitleSearchIndex::SortHits(std::size_t substring_hits) {
+    // 子串匹配按文档升序产生，按(等级, 名称长度)稳定计数排序与比较整个排序键的结果相同；模糊匹配等级最低且通常很少，单独排序
+    // (Substring hits come in ascending document order, so a stable counting sort by (rank, name length) gives the
+    // same order as comparing whole keys; fuzzy hits rank last and are usually few, so they are sorted on their own)
+    static constexpr u32 RANKS = 4;
+    static constexpr u32 MAX_LENGTH = 512;  // NACP名称最多0x200字节 (NACP names are at most 0x200 bytes)
+    const auto bucket = [](u64 hit) {
+        const auto rank = static_cast<u32>(hit >> 61);
+        const auto length = std::min(static_cast<u32>(hit >> 32) & ((1u << 29) - 1), MAX_LENGTH);
+        return rank * (MAX_LENGTH + 1) + length;
+    };
+
+    m_bucket_start.assign(RANKS * (MAX_LENGTH + 1) + 1, 0);
+    for (std::size_t i = 0; i < substring_hits; i++) {
+        m_bucket_start[bucket(m_hits[i]) + 1]++;
+    }
+    for (std::size_t i = 1; i < m_bucket_start.size(); i++) {
+        m_bucket_start[i] += m_bucket_start[i - 1];
+    }
+    m_sorted_hits.resize(m_hits.size());
+    for (std::size_t i = 0; i < substring_hits; i++) {
+        m_sorted_hits[m_bucket_start[bucket(m_hits[i])]++] = m_hits[i];
+    }
+    std::copy(m_hits.begin() + static_cast<std::ptrdiff_t>(substring_hits), m_hits.end(),
+        m_sorted_hits.begin() + static_cast<std::ptrdiff_t>(substring_hits));
+    std::sort(m_sorted_hits.begin() + static_cast<std::ptrdiff_t>(substring_hits), m_sorted_hits.end());
+    m_hits.swap(m_sorted_hits);
+}
+
+const std::vector<u64>& TitleSearchIndex::Search(std::string_view text) {
+    m_results.clear();
+    std::u32string query = Normalize(text);
+    if (m_history_generation != m_generation) {
+        m_history.clear();
+        m_history_generation = m_generation;
+    }
+    // 只保留仍是本次查询前缀的历史 (Keep only the history that is still a prefix of this query)
+    while (!m_history.empty() && !query.starts_with(m_history.back().query)) {
+        m_history.pop_back();
+    }
+    if (query.empty()) {
+        return m_results;
+    }
+    // 退格回到之前输入过的查询时直接使用当时的结果 (Backspacing to a query typed earlier reuses its results)
+    if (!m_history.empty() && m_history.back().query == query) {
+        m_results = m_history.back().results;
+        return m_results;
+    }
+
+    m_hits.clear();
+    std::vector<u32> matches;
+    if (query.size() < 3) {
+        // 不足一个三元组，单字或双字列表就是全部匹配且已带等级 (Shorter than a trigram, the unigram or bigram list is every match, ranks included)
+        const u64 key = query.size() == 1 ? UnigramKey(query[0]) : BigramKey(query[0], query[1]);
+        if (const auto it = m_postings.find(key); it != m_postings.end()) {
+            for (u32 entry : it->second) {
+                const u32 doc = entry >> RANK_BITS;
+                if (m_docs[doc].alive) {
+                    m_hits.push_back(HitKey(entry & RANK_MASK, static_cast<u32>(m_docs[doc].name.size()), doc));
+                    matches.push_back(doc);
+                }
+            }
+        }
+    } else {
+        // 查询在上一步之后追加了字符时，匹配项一定在上一步的匹配中 (When the query extends the previous step, every match is among that step's matches)
+        std::vector<u32> candidates;
+        if (!m_history.empty()) {
+            candidates = m_history.back().matches;
+        } else {
+            SubstringCandidates(query, candidates);
+        }
+        for (u32 doc : candidates) {
+            u32 rank = 0;
+            if (Verify(m_docs[doc], query, rank)) {
+                // 同等级内名称越短越接近查询 (Within a rank, shorter names are closer to the query)
+                m_hits.push_back(HitKey(rank, static_cast<u32>(m_docs[doc].name.size()), doc));
+                matches.push_back(doc);
+            }
+        }
+    }
+
+    const std::size_t substring_hits = m_hits.size();
+    FuzzyCandidates(query, m_hits);
+
+    SortHits(substring_hits);
+    m_results.reserve(m_hits.size());
+    for (u64 hit : m_hits) {
+        m_results.push_back(m_docs[static_cast<u32>(hit)].id);
+    }
+    m_history.push_back(Step{std::move(query), std::move(matches), m_results});
+    return m_results;
+}
+
+} // namespace tj
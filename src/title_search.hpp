@@ -0,0 +1,124 @@
+/**
+ * @file title_search.hpp
+ * @brief 应用名称和发行商的搜索索引：预先规范化的文本加三元组倒排索引
+ *        (Search index over title names and publishers: pre-normalized text plus a trigram inverted index)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+namespace tj {
+
+class TitleTable;
+
+/**
+ * @brief 应用搜索索引
+ *
+ * 每个应用的名称和发行商在加入时规范化一次：转为小写，全角ASCII转半角，平假名转片假名，去掉拉丁字母的重音，
+ * 标点和空白合并为一个空格。规范化文本的每个三元组（连续三个码位，CJK和拉丁文字相同）映射到包含它的文档列表。
+ *
+ * 查询按顺序尝试：名称前缀、名称中的词首、名称子串、发行商子串，最后是模糊匹配（共享至少一半查询三元组的文档）。
+ * 三个码位以上的查询由三元组列表的交集得到候选，更短的查询直接取单字或双字列表；在上次查询后追加字符时只检查上次的结果，
+ * 退格回到本次输入过的查询时直接返回当时的结果。删除应用只标记文档失效，失效文档过半时整体压缩。
+ * 非线程安全，由App::entries_mutex保护。
+ *
+ * Each title's name and publisher are normalized once when added: lower-cased, full-width ASCII folded to
+ * half-width, hiragana folded to katakana, accents stripped from Latin letters, and punctuation and whitespace
+ * collapsed into one space. Every trigram of the normalized text (three consecutive code points, the same for CJK
+ * and Latin) maps to the documents containing it.
+ *
+ * A query tries, in rank order: name prefix, word start in the name, name substring, publisher substring, then
+ * fuzzy matches (documents sharing at least half of the query's trigrams). Queries of three or more code
+ * points take their candidates from the intersection of the trigram lists, shorter ones straight from the unigram
+ * or bigram list; a query that extends the previous one only re-checks the previous results, and backspacing to a
+ * query typed earlier returns its results as they were. Removing a title only marks its document dead; the index is
+ * compacted once more than half are dead. Not thread safe, guarded by App::entries_mutex.
+ */
+class TitleSearchIndex {
+public:
+    /**
+     * @brief 从应用列表的所有行重建索引
+     */
+    void Build(const TitleTable& table);
+
+    /**
+     * @brief 加入应用，已存在时替换
+     */
+    void Upsert(u64 id, std::string_view name, std::string_view author);
+
+    /**
+     * @brief 移除应用
+     */
+    void Remove(const std::vector<u64>& ids);
+
+    /**
+     * @brief 查询，结果按匹配等级排序
+     * @return 匹配的应用ID，查询为空时返回空列表
+     */
+    const std::vector<u64>& Search(std::string_view query);
+
+    std::size_t Size() const { return m_doc_of.size(); }
+
+    /**
+     * @brief 把UTF-8文本规范化为码位序列
+     */
+    static std::u32string Normalize(std::string_view text);
+
+private:
+    struct Doc {
+        u64 id;
+        std::u32string name;
+        std::u32string author;
+        bool alive;
+    };
+
+    /**
+     * @brief 本次输入中的一步查询 (One query step of the current typing session)
+     */
+    struct Step {
+        std::u32string query;
+        std::vector<u32> matches;   ///< 子串匹配，追加字符时作为候选 (Substring matches, the candidates when a character is appended)
+        std::vector<u64> results;   ///< 排好序的结果，退格回来时直接返回 (Sorted results, returned as is when backspacing here)
+    };
+
+    /**
+     * @brief 匹配项的排序键：高3位为匹配等级，其后29位为同等级内的次序，低32位为文档，排序只比较整数
+     *        (Sort key of a match: 3 bits of rank, then 29 bits of order within the rank, then 32 bits of document, so sorting compares integers)
+     */
+    static constexpr u64 HitKey(u32 rank, u32 tiebreak, u32 doc) {
+        constexpr u32 MAX_TIEBREAK = (1u << 29) - 1;
+        return (static_cast<u64>(rank) << 61) | (static_cast<u64>(tiebreak < MAX_TIEBREAK ? tiebreak : MAX_TIEBREAK) << 32) | doc;
+    }
+
+    void AddDoc(u64 id, std::u32string&& name, std::u32string&& author);
+    void IndexText(u32 doc, const std::u32string& text, bool is_name);
+    void Compact();
+    bool Verify(const Doc& doc, const std::u32string& query, u32& rank) const;
+    void SubstringCandidates(const std::u32string& query, std::vector<u32>& out) const;
+    void FuzzyCandidates(const std::u32string& query, std::vector<u64>& hits);
+    void SortHits(std::size_t substring_hits);
+
+    std::vector<Doc> m_docs;
+    std::unordered_map<u64, u32> m_doc_of;                  ///< 应用ID到存活文档 (Application id to live document)
+    std::unordered_map<u64, std::vector<u32>> m_postings;   ///< 单字、双字（带等级）和三元组到升序文档列表 (Unigram, bigram (ranked) and trigram to ascending document list)
+    std::size_t m_dead{};                                   ///< 失效文档数 (Dead documents)
+    u64 m_generation{};                                     ///< 每次修改递增，使增量查询缓存失效 (Bumped on every change, invalidating the incremental cache)
+
+    // 增量查询缓存：每步都是下一步的前缀 (Incremental query cache, each step is a prefix of the next)
+    std::vector<Step> m_history;
+    u64 m_history_generation{~0ULL};
+
+    std::vector<u64> m_hits;                                ///< 本次查询的排序键 (Sort keys of the current query)
+    std::vector<u64> m_sorted_hits;                         ///< 计数排序的输出 (Counting sort output)
+    std::vector<u32> m_bucket_start;                        ///< 计数排序每个(等级, 长度)桶的起点 (Counting sort start of every (rank, length) bucket)
+    std::vector<u16> m_trigram_hits;                        ///< 模糊匹配按文档计数 (Per-document counts for fuzzy matching)
+    std::vector<u64> m_results;
+};
+
+} // namespace tj
@@ -0,0 +1,75 @@
+// 应用信息服务 (Title service)
+#include "title_service.hpp"
+#ifdef UNTITLED_MOCK_NS
+// 模拟后端 (Mock backend)
+#include "title_service_mock.hpp"
+#endif // UNTITLED_MOCK_NS
+
+namespace tj {
+
+namespace {
+
+/**
+ * @brief 基于libnx NS服务的实现 (libnx NS service backend)
+ */
+class NsTitleService final : public TitleService {
+public:
+    Result ListApplicationRecords(NsApplicationRecord* records, s32 count, s32 offset, s32* out_count) override {
+        return nsListApplicationRecord(records, count, offset, out_count);
+    }
+
+    Result GetApplicationControlData(u64 application_id, NsApplicationControlData* data, u64* out_size) override {
+        return nsGetApplicationControlData(NsApplicationControlSource_Storage, application_id, data, sizeof(NsApplicationControlData), out_size);
+    }
+
+    Result CalculateApplicationOccupiedSize(u64 application_id, ApplicationOccupiedSize* out) override {
+        return nsCalculateApplicationOccupiedSize(application_id, reinterpret_cast<NsApplicationOccupiedSize*>(out));
+    }
+
+    Result DeleteApplicationCompletely(u64 application_id) override {
+        return nsDeleteApplicationCompletely(application_id);
+    }
+
+    Result GetTotalSpaceSize(NcmStorageId storage_id, s64* out) override {
+        return nsGetTotalSpaceSize(storage_id, out);
+    }
+
+    Result GetFreeSpaceSize(NcmStorageId storage_id, s64* out) override {
+        return nsGetFreeSpaceSize(storage_id, out);
+    }
+};
+
+#ifdef UNTITLED_MOCK_NS
+// 模拟应用数量，通过make MOCK_NS=<数量>设置 (Mock title count, set with make MOCK_NS=<count>)
+#ifndef UNTITLED_MOCK_NS_TITLES
+    #define UNTITLED_MOCK_NS_TITLES 1000
+#endif
+// 延迟配置：0=无延迟 1=典型 2=20.x慢速 (Latency profile: 0=instant 1=typical 2=slow firmware 20)
+#ifndef UNTITLED_MOCK_NS_PROFILE
+    #define UNTITLED_MOCK_NS_PROFILE 0
+#endif
+
+MockTitleServiceConfig MockConfigFromDefines() {
+    MockTitleServiceConfig config{};
+    config.title_count = UNTITLED_MOCK_NS_TITLES;
+    switch (UNTITLED_MOCK_NS_PROFILE) {
+        case 1: config.latency = MockLatencyProfile::Typical(); break;
+        case 2: config.latency = MockLatencyProfile::SlowFirmware20(); break;
+        default: config.latency = MockLatencyProfile::Instant(); break;
+    }
+    return config;
+}
+#endif // UNTITLED_MOCK_NS
+
+} // namespace
+
+TitleService& GetTitleService() {
+#ifdef UNTITLED_MOCK_NS
+    static MockTitleService service{MockConfigFromDefines()};
+#else
+    static NsTitleService service{};
+#endif // UNTITLED_MOCK_NS
+    return service;
+}
+
+} // namespace tj
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+
+namespace tj {
+
+// 感谢Shchmue的贡献 (Thank you Shchmue ^^)
+// 应用程序占用空间条目结构体 (Application occupied size entry structure)
+struct ApplicationOccupiedSizeEntry {
+    std::uint8_t storageId;        // 存储设备ID (Storage device ID)
+    std::uint64_t sizeApplication; // 应用程序本体大小 (Application base size)
+    std::uint64_t sizePatch;       // 补丁大小 (Patch size)
+    std::uint64_t sizeAddOnContent; // 追加内容大小 (Add-on content size)
+};
+
+// 应用程序占用空间结构体 (Application occupied size structure)
+struct ApplicationOccupiedSize {
+    ApplicationOccupiedSizeEntry entry[4]; // 最多4个存储设备的条目 (Up to 4 storage device entries)
+};
+
+static_assert(sizeof(ApplicationOccupiedSize) == sizeof(NsApplicationOccupiedSize));
+
+/**
+ * @brief 应用信息服务接口 (Title service interface)
+ *
+ * App中所有应用发现、大小查询和删除操作都通过此接口进行，
+ * 以便在真实NS服务和模拟后端之间切换。
+ * All title discovery, size queries and deletion in App go through this interface,
+ * so the real NS service can be swapped for a mock backend.
+ */
+class TitleService {
+public:
+    virtual ~TitleService() = default;
+
+    // 分页列出应用记录 (List application records page by page)
+    virtual Result ListApplicationRecords(NsApplicationRecord* records, s32 count, s32 offset, s32* out_count) = 0;
+
+    // 获取控制数据(NACP+JPEG图标)，out_size为NACP与图标的总大小
+    // Get control data (NACP + JPEG icon), out_size is the combined NACP and icon size
+    virtual Result GetApplicationControlData(u64 application_id, NsApplicationControlData* data, u64* out_size) = 0;
+
+    // 计算应用占用空间 (Calculate application occupied size)
+    virtual Result CalculateApplicationOccupiedSize(u64 application_id, ApplicationOccupiedSize* out) = 0;
+
+    // 完全删除应用 (Delete application completely)
+    virtual Result DeleteApplicationCompletely(u64 application_id) = 0;
+
+    // 存储空间查询 (Storage space queries)
+    virtual Result GetTotalSpaceSize(NcmStorageId storage_id, s64* out) = 0;
+    virtual Result GetFreeSpaceSize(NcmStorageId storage_id, s64* out) = 0;
+
+    // 是否允许读写libnxtc缓存，模拟后端不应污染真实缓存
+    // Whether the libnxtc cache may be used, mock backends must not pollute the real cache
+    virtual bool UsesTitleCache() const { return true; }
+};
+
+/**
+ * @brief 获取当前使用的应用信息服务 (Get the active title service)
+ *
+ * 默认使用libnx NS后端；编译时定义UNTITLED_MOCK_NS则使用模拟后端。
+ * Uses the libnx NS backend by default; defining UNTITLED_MOCK_NS at compile time selects the mock backend.
+ */
+TitleService& GetTitleService();
+
+} // namespace tj
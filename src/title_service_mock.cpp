@@ -0,0 +1,353 @@
+// 模拟应用信息服务 (Mock title service)
+#include "title_service_mock.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+
+namespace tj {
+
+namespace {
+
+// 模拟应用ID的起始值和步长，与真实应用ID的对齐方式一致
+// Base and stride for mock application IDs, aligned like real application IDs
+constexpr u64 MOCK_ID_BASE = 0x0100000000010000ULL;
+constexpr u64 MOCK_ID_STRIDE = 0x2000ULL;
+
+// 模拟后端的错误码 (Error codes returned by the mock backend)
+constexpr u32 MOCK_RESULT_MODULE = 16; // ns
+constexpr Result MOCK_RESULT_NOT_FOUND = MAKERESULT(MOCK_RESULT_MODULE, 1);
+constexpr Result MOCK_RESULT_CORRUPTED = MAKERESULT(MOCK_RESULT_MODULE, 2);
+
+// 应用记录的最后事件类型：已安装 (Last event type for records: installed)
+constexpr u8 MOCK_RECORD_TYPE_INSTALLED = 0x3;
+
+constexpr std::array<const char*, 8> NAME_PREFIXES{
+    "Super", "Mega", "Tiny", "Ancient", "Neon", "Silent", "Crimson", "Electric",
+};
+constexpr std::array<const char*, 8> NAME_SUFFIXES{
+    "Quest", "Racer", "Tactics", "Legends", "Party", "Odyssey", "Frontier", "Arena",
+};
+
+// splitmix32，用于从种子和索引生成确定性的属性 (splitmix32 for deterministic per-title attributes)
+std::uint32_t Mix(std::uint32_t x) {
+    x += 0x9E3779B9u;
+    x = (x ^ (x >> 16)) * 0x85EBCA6Bu;
+    x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+    return x ^ (x >> 16);
+}
+
+// JPEG位写入器，处理0xFF字节填充 (JPEG bit writer with 0xFF byte stuffing)
+struct JpegBitWriter {
+    std::vector<std::uint8_t>& out;
+    std::uint32_t acc{};
+    int bits{};
+
+    void Put(std::uint32_t code, int length) {
+        for (int i = length - 1; i >= 0; i--) {
+            acc = (acc << 1) | ((code >> i) & 1);
+            if (++bits == 8) {
+                out.push_back(static_cast<std::uint8_t>(acc));
+                if (acc == 0xFF) {
+                    out.push_back(0x00);
+                }
+                acc = 0;
+                bits = 0;
+            }
+        }
+    }
+
+    // 用1填充剩余位 (Pad the remaining bits with ones)
+    void Flush() {
+        if (bits) {
+            Put((1u << (8 - bits)) - 1, 8 - bits);
+        }
+    }
+};
+
+// 标准亮度DC哈夫曼表 (Standard luminance DC Huffman table)
+constexpr std::array<std::uint8_t, 16> DC_BITS{0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+constexpr std::array<std::uint8_t, 12> DC_VALS{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+// 纯色图像只需要EOB和ZRL (A solid image only needs EOB and ZRL)
+constexpr std::array<std::uint8_t, 16> AC_BITS{0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+constexpr std::array<std::uint8_t, 2> AC_VALS{0x00, 0xF0};
+
+struct HuffCode {
+    std::uint16_t code;
+    std::uint8_t length;
+};
+
+// 根据BITS/VALS生成规范哈夫曼码 (Build canonical Huffman codes from BITS/VALS)
+template<std::size_t N>
+std::array<HuffCode, 256> BuildHuffCodes(const std::array<std::uint8_t, 16>& bits, const std::array<std::uint8_t, N>& vals) {
+    std::array<HuffCode, 256> codes{};
+    std::uint16_t code = 0;
+    std::size_t k = 0;
+    for (int length = 1; length <= 16; length++) {
+        for (int i = 0; i < bits[length - 1] && k < N; i++) {
+            codes[vals[k++]] = HuffCode{code, static_cast<std::uint8_t>(length)};
+            code++;
+        }
+        code <<= 1;
+    }
+    return codes;
+}
+
+void PutU16(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+} // namespace
+
+MockLatencyProfile MockLatencyProfile::Instant() {
+    return MockLatencyProfile{};
+}
+
+MockLatencyProfile MockLatencyProfile::Typical() {
+    MockLatencyProfile profile{};
+    profile.list_records = std::chrono::microseconds{800};
+    profile.control_data = std::chrono::microseconds{3000};
+    profile.occupied_size = std::chrono::microseconds{1500};
+    profile.delete_app = std::chrono::microseconds{150000};
+    profile.space_query = std::chrono::microseconds{300};
+    return profile;
+}
+
+MockLatencyProfile MockLatencyProfile::SlowFirmware20() {
+    MockLatencyProfile profile = Typical();
+    profile.control_data = std::chrono::microseconds{60000};
+    profile.occupied_size = std::chrono::microseconds{8000};
+    return profile;
+}
+
+MockTitleService::MockTitleService(const MockTitleServiceConfig& config) : m_config{config} {
+    m_config.icon_size = std::max<std::uint32_t>(8, m_config.icon_size & ~7u);
+    m_titles.reserve(m_config.title_count);
+
+    for (std::size_t i = 0; i < m_config.title_count; i++) {
+        MockTitle title{};
+        title.application_id = MOCK_ID_BASE + i * MOCK_ID_STRIDE;
+        title.hash = Mix(m_config.seed ^ static_cast<std::uint32_t>(i));
+
+        // 大小范围约100MB到16GB，部分应用跨NAND和SD卡 (Sizes from ~100MB to ~16GB, some titles span NAND and SD)
+        const std::uint64_t size = (100ULL << 20) + (static_cast<std::uint64_t>(Mix(title.hash)) % (16ULL << 10)) * (1ULL << 20);
+        switch (title.hash % 4) {
+            case 0: title.size_nand = size; break;
+            case 1: title.size_nand = size / 4; title.size_sd = size - size / 4; break;
+            default: title.size_sd = size; break;
+        }
+
+        title.corrupted = m_config.corrupted_every && (i % m_config.corrupted_every) == m_config.corrupted_every - 1;
+        m_titles.push_back(title);
+    }
+}
+
+MockTitleService::MockTitle* MockTitleService::FindTitle(u64 application_id) {
+    if (application_id < MOCK_ID_BASE || (application_id - MOCK_ID_BASE) % MOCK_ID_STRIDE) {
+        return nullptr;
+    }
+    const auto index = (application_id - MOCK_ID_BASE) / MOCK_ID_STRIDE;
+    if (index >= m_titles.size() || m_titles[index].deleted) {
+        return nullptr;
+    }
+    return &m_titles[index];
+}
+
+void MockTitleService::Sleep(std::chrono::microseconds duration) {
+    if (duration.count() > 0) {
+        std::this_thread::sleep_for(duration);
+    }
+}
+
+Result MockTitleService::ListApplicationRecords(NsApplicationRecord* records, s32 count, s32 offset, s32* out_count) {
+    Sleep(m_config.latency.list_records);
+
+    std::scoped_lock lock{m_mutex};
+    s32 skipped = 0;
+    s32 written = 0;
+    for (std::size_t i = 0; i < m_titles.size() && written < count; i++) {
+        const auto& title = m_titles[i];
+        if (title.deleted) {
+            continue;
+        }
+        if (skipped < offset) {
+            skipped++;
+            continue;
+        }
+
+        // 偏移0x10处为最后更新时间戳 (Offset 0x10 holds the last-updated timestamp)
+        auto& record = records[written++];
+        std::memset(&record, 0, sizeof(record));
+        record.application_id = title.application_id;
+        record.type = MOCK_RECORD_TYPE_INSTALLED;
+        const u64 timestamp = 1700000000ULL + title.hash % 100000000ULL;
+        std::memcpy(&record.unk_x10, &timestamp, sizeof(timestamp));
+    }
+
+    *out_count = written;
+    return 0;
+}
+
+Result MockTitleService::GetApplicationControlData(u64 application_id, NsApplicationControlData* data, u64* out_size) {
+    Sleep(m_config.latency.control_data);
+
+    std::uint32_t hash{};
+    std::size_t index{};
+    {
+        std::scoped_lock lock{m_mutex};
+        const auto* title = FindTitle(application_id);
+        if (!title) {
+            return MOCK_RESULT_NOT_FOUND;
+        }
+        if (title->corrupted) {
+            return MOCK_RESULT_CORRUPTED;
+        }
+        hash = title->hash;
+        index = (application_id - MOCK_ID_BASE) / MOCK_ID_STRIDE;
+    }
+
+    std::memset(&data->nacp, 0, sizeof(data->nacp));
+    char name[0x40];
+    std::snprintf(name, sizeof(name), "%s %s %zu", NAME_PREFIXES[hash % NAME_PREFIXES.size()], NAME_SUFFIXES[(hash >> 8) % NAME_SUFFIXES.size()], index + 1);
+    for (auto& lang : data->nacp.lang) {
+        std::snprintf(lang.name, sizeof(lang.name), "%s", name);
+        std::snprintf(lang.author, sizeof(lang.author), "Mock Publisher %u", (hash >> 16) % 32);
+    }
+    std::snprintf(data->nacp.display_version, sizeof(data->nacp.display_version), "1.%u.%u", (hash >> 4) % 10, (hash >> 12) % 10);
+
+    const auto icon = EncodeSolidJpeg(m_config.icon_size, m_config.icon_size, static_cast<std::uint8_t>(hash), static_cast<std::uint8_t>(hash >> 8), static_cast<std::uint8_t>(hash >> 16));
+    const auto icon_size = std::min(icon.size(), sizeof(data->icon));
+    std::memcpy(data->icon, icon.data(), icon_size);
+    *out_size = sizeof(data->nacp) + icon_size;
+    return 0;
+}
+
+Result MockTitleService::CalculateApplicationOccupiedSize(u64 application_id, ApplicationOccupiedSize* out) {
+    Sleep(m_config.latency.occupied_size);
+
+    std::scoped_lock lock{m_mutex};
+    const auto* title = FindTitle(application_id);
+    if (!title) {
+        return MOCK_RESULT_NOT_FOUND;
+    }
+
+    std::memset(out, 0, sizeof(*out));
+    out->entry[0].storageId = NcmStorageId_BuiltInUser;
+    out->entry[0].sizeApplication = title->size_nand;
+    out->entry[1].storageId = NcmStorageId_SdCard;
+    out->entry[1].sizeApplication = title->size_sd;
+    return 0;
+}
+
+Result MockTitleService::DeleteApplicationCompletely(u64 application_id) {
+    Sleep(m_config.latency.delete_app);
+
+    std::scoped_lock lock{m_mutex};
+    auto* title = FindTitle(application_id);
+    if (!title) {
+        return MOCK_RESULT_NOT_FOUND;
+    }
+    title->deleted = true;
+    return 0;
+}
+
+Result MockTitleService::GetTotalSpaceSize(NcmStorageId storage_id, s64* out) {
+    Sleep(m_config.latency.space_query);
+    *out = storage_id == NcmStorageId_SdCard ? SD_TOTAL : NAND_TOTAL;
+    return 0;
+}
+
+Result MockTitleService::GetFreeSpaceSize(NcmStorageId storage_id, s64* out) {
+    Sleep(m_config.latency.space_query);
+
+    std::scoped_lock lock{m_mutex};
+    s64 used = 0;
+    for (const auto& title : m_titles) {
+        if (!title.deleted) {
+            used += static_cast<s64>(storage_id == NcmStorageId_SdCard ? title.size_sd : title.size_nand);
+        }
+    }
+    const s64 total = storage_id == NcmStorageId_SdCard ? SD_TOTAL : NAND_TOTAL;
+    *out = std::max<s64>(0, total - used);
+    return 0;
+}
+
+std::vector<std::uint8_t> MockTitleService::EncodeSolidJpeg(std::uint32_t width, std::uint32_t height, std::uint8_t y, std::uint8_t cb, std::uint8_t cr) {
+    static const auto dc_codes = BuildHuffCodes(DC_BITS, DC_VALS);
+    static const auto ac_codes = BuildHuffCodes(AC_BITS, AC_VALS);
+
+    std::vector<std::uint8_t> out;
+    out.reserve(256 + (width / 8) * (height / 8) * 2);
+
+    // SOI
+    out.insert(out.end(), {0xFF, 0xD8});
+
+    // DQT：全1量化表，DC系数即为电平值 (DQT: all-ones table, DC coefficient equals the level)
+    out.insert(out.end(), {0xFF, 0xDB});
+    PutU16(out, 2 + 1 + 64);
+    out.push_back(0x00);
+    out.insert(out.end(), 64, 0x01);
+
+    // SOF0：8位YCbCr，无色度抽样 (SOF0: 8-bit YCbCr, no chroma subsampling)
+    out.insert(out.end(), {0xFF, 0xC0});
+    PutU16(out, 2 + 6 + 3 * 3);
+    out.push_back(8);
+    PutU16(out, height);
+    PutU16(out, width);
+    out.push_back(3);
+    for (std::uint8_t component = 1; component <= 3; component++) {
+        out.insert(out.end(), {component, 0x11, 0x00});
+    }
+
+    // DHT：DC表0和AC表0 (DHT: DC table 0 and AC table 0)
+    out.insert(out.end(), {0xFF, 0xC4});
+    PutU16(out, 2 + (1 + 16 + DC_VALS.size()) + (1 + 16 + AC_VALS.size()));
+    out.push_back(0x00);
+    out.insert(out.end(), DC_BITS.begin(), DC_BITS.end());
+    out.insert(out.end(), DC_VALS.begin(), DC_VALS.end());
+    out.push_back(0x10);
+    out.insert(out.end(), AC_BITS.begin(), AC_BITS.end());
+    out.insert(out.end(), AC_VALS.begin(), AC_VALS.end());
+
+    // SOS
+    out.insert(out.end(), {0xFF, 0xDA});
+    PutU16(out, 2 + 1 + 3 * 2 + 3);
+    out.push_back(3);
+    for (std::uint8_t component = 1; component <= 3; component++) {
+        out.insert(out.end(), {component, 0x00});
+    }
+    out.insert(out.end(), {0x00, 0x3F, 0x00});
+
+    // 纯色块的DC值为8*(p-128)，之后每块差值为0 (Solid block DC is 8*(p-128), every later block has a zero diff)
+    const std::array<int, 3> dc{8 * (y - 128), 8 * (cb - 128), 8 * (cr - 128)};
+    std::array<int, 3> prev{};
+    JpegBitWriter writer{out};
+    const auto blocks = (width / 8) * (height / 8);
+    for (std::uint32_t block = 0; block < blocks; block++) {
+        for (std::size_t c = 0; c < dc.size(); c++) {
+            const int diff = dc[c] - prev[c];
+            prev[c] = dc[c];
+
+            int category = 0;
+            for (int magnitude = diff < 0 ? -diff : diff; magnitude; magnitude >>= 1) {
+                category++;
+            }
+            writer.Put(dc_codes[category].code, dc_codes[category].length);
+            if (category) {
+                const int bits = diff < 0 ? diff + (1 << category) - 1 : diff;
+                writer.Put(static_cast<std::uint32_t>(bits), category);
+            }
+            writer.Put(ac_codes[0x00].code, ac_codes[0x00].length);
+        }
+    }
+    writer.Flush();
+
+    // EOI
+    out.insert(out.end(), {0xFF, 0xD9});
+    return out;
+}
+
+} // namespace tj
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "title_service.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+namespace tj {
+
+/**
+ * @brief 模拟后端每次调用的延迟配置 (Per-call latency profile for the mock backend)
+ */
+struct MockLatencyProfile {
+    std::chrono::microseconds list_records{};   // 每页nsListApplicationRecord (Per nsListApplicationRecord page)
+    std::chrono::microseconds control_data{};   // 每次nsGetApplicationControlData (Per nsGetApplicationControlData call)
+    std::chrono::microseconds occupied_size{};  // 每次nsCalculateApplicationOccupiedSize (Per size calculation)
+    std::chrono::microseconds delete_app{};     // 每次nsDeleteApplicationCompletely (Per deletion)
+    std::chrono::microseconds space_query{};    // 每次存储空间查询 (Per storage space query)
+
+    // 无延迟，用于测量纯CPU开销 (No latency, measures pure CPU overhead)
+    static MockLatencyProfile Instant();
+    // 接近19.x及更早系统的典型延迟 (Typical latency on 19.x and earlier)
+    static MockLatencyProfile Typical();
+    // 20.x系统NS获取应用信息异常缓慢 (NS control data is abnormally slow on 20.x)
+    static MockLatencyProfile SlowFirmware20();
+};
+
+/**
+ * @brief 模拟后端配置 (Mock backend configuration)
+ */
+struct MockTitleServiceConfig {
+    std::size_t title_count{1000};          // 合成的应用数量 (Number of synthesized titles)
+    std::uint32_t seed{0x554E5449};         // 确定性随机种子 (Deterministic seed)
+    std::uint32_t icon_size{256};           // 合成图标边长，必须是8的倍数 (Synthesized icon edge, multiple of 8)
+    std::uint32_t corrupted_every{0};       // 每N个应用一个损坏安装，0为禁用 (One corrupted install every N titles, 0 disables)
+    MockLatencyProfile latency{MockLatencyProfile::Instant()};
+};
+
+/**
+ * @brief 确定性模拟应用信息服务 (Deterministic mock title service)
+ *
+ * 合成N个应用的记录、NACP、纯色JPEG图标和占用空间，并按配置模拟每次调用的延迟。
+ * 不访问任何系统服务，只使用libnx的类型定义；主机端构建由tests/host/switch.h提供这些类型，见tests/Makefile。
+ * Synthesizes records, NACPs, solid-colour JPEG icons and occupied sizes for N titles,
+ * and simulates per-call latency as configured. It touches no system service and only uses libnx type
+ * definitions; host builds get those from tests/host/switch.h, see tests/Makefile.
+ */
+class MockTitleService final : public TitleService {
+public:
+    explicit MockTitleService(const MockTitleServiceConfig& config);
+
+    Result ListApplicationRecords(NsApplicationRecord* records, s32 count, s32 offset, s32* out_count) override;
+    Result GetApplicationControlData(u64 application_id, NsApplicationControlData* data, u64* out_size) override;
+    Result CalculateApplicationOccupiedSize(u64 application_id, ApplicationOccupiedSize* out) override;
+    Result DeleteApplicationCompletely(u64 application_id) override;
+    Result GetTotalSpaceSize(NcmStorageId storage_id, s64* out) override;
+    Result GetFreeSpaceSize(NcmStorageId storage_id, s64* out) override;
+    bool UsesTitleCache() const override { return false; }
+
+    // 生成指定尺寸的纯色基线JPEG (Encode a solid-colour baseline JPEG of the given size)
+    static std::vector<std::uint8_t> EncodeSolidJpeg(std::uint32_t width, std::uint32_t height, std::uint8_t y, std::uint8_t cb, std::uint8_t cr);
+
+private:
+    struct MockTitle {
+        u64 application_id;
+        std::uint32_t hash;
+        std::uint64_t size_nand;
+        std::uint64_t size_sd;
+        bool corrupted;
+        bool deleted;
+    };
+
+    MockTitle* FindTitle(u64 application_id);
+    static void Sleep(std::chrono::microseconds duration);
+
+    MockTitleServiceConfig m_config;
+    std::vector<MockTitle> m_titles;
+    std::mutex m_mutex;
+
+    static constexpr s64 NAND_TOTAL = 32LL * 1024 * 1024 * 1024;
+    static constexpr s64 SD_TOTAL = 512LL * 1024 * 1024 * 1024;
+};
+
+} // namespace tj
@@ -0,0 +1,205 @@
+/**
+ * @file title_snapshot.cpp
+ * @brief 应用列表快照的实现
+ */
+#include "title_snapshot.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace tj {
+
+namespace {
+
+constexpr u64 FNV_OFFSET = 0xCBF29CE484222325ULL;
+constexpr u64 FNV_PRIME = 0x100000001B3ULL;
+
+u64 Fnv1a(const void* data, std::size_t size, u64 hash = FNV_OFFSET) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// 将字符串追加到字符串表，返回偏移 (Append a string to the string table, returns its offset)
+u32 AppendString(std::vector<char>& strings, const std::string& str) {
+    const auto offset = static_cast<u32>(strings.size());
+    strings.insert(strings.end(), str.begin(), str.end());
+    return offset;
+}
+
+} // namespace
+
+TitleSnapshot::TitleSnapshot(const char* path) : m_path(path) {
+}
+
+u64 TitleSnapshot::RecordFingerprint(const NsApplicationRecord& record) {
+    // 应用ID之后的字段包含记录类型和最后更新时间 (The fields after the id hold the record type and last-updated time)
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&record);
+    return Fnv1a(bytes + sizeof(record.application_id), sizeof(record) - sizeof(record.application_id));
+}
+
+bool TitleSnapshot::Load(int language) {
+    m_titles.clear();
+
+    std::FILE* file = std::fopen(m_path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    // 一次读入整个文件 (Read the whole file in one go)
+    std::vector<unsigned char> data;
+    if (std::fseek(file, 0, SEEK_END) == 0) {
+        const long size = std::ftell(file);
+        if (size > 0 && std::fseek(file, 0, SEEK_SET) == 0) {
+            data.resize(static_cast<std::size_t>(size));
+            if (std::fread(data.data(), 1, data.size(), file) != data.size()) {
+                data.clear();
+            }
+        }
+    }
+    std::fclose(file);
+
+    if (data.size() < sizeof(Header)) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION || header.language != static_cast<u32>(language)) {
+        return false;
+    }
+
+    const std::size_t table_bytes = static_cast<std::size_t>(header.title_count) * sizeof(FileEntry);
+    if (data.size() != sizeof(Header) + table_bytes + header.string_bytes) {
+        return false;
+    }
+    if (Fnv1a(data.data() + sizeof(Header), table_bytes + header.string_bytes) != header.checksum) {
+        return false;
+    }
+
+    const auto* table = data.data() + sizeof(Header);
+    const auto* strings = reinterpret_cast<const char*>(table + table_bytes);
+    auto read_string = [&](u32 offset, u32 length, std::string& out) {
+        if (static_cast<u64>(offset) + length > header.string_bytes) {
+            return false;
+        }
+        out.assign(strings + offset, length);
+        return true;
+    };
+
+    m_titles.resize(header.title_count);
+    for (u32 i = 0; i < header.title_count; i++) {
+        FileEntry entry;
+        std::memcpy(&entry, table + i * sizeof(FileEntry), sizeof(entry));
+
+        auto& title = m_titles[i];
+        title.application_id = entry.application_id;
+        title.record_fingerprint = entry.record_fingerprint;
+        title.icon_hash = entry.icon_hash;
+        title.size_nand = entry.size_nand;
+        title.size_sd = entry.size_sd;
+        title.corrupted = entry.flags & FLAG_CORRUPTED;
+        if (!read_string(entry.name_offset, entry.name_length, title.name) ||
+            !read_string(entry.author_offset, entry.author_length, title.author) ||
+            !read_string(entry.version_offset, entry.version_length, title.display_version)) {
+            m_titles.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TitleSnapshot::Save(const std::vector<SnapshotTitle>& titles, int language) {
+    std::vector<FileEntry> table(titles.size());
+    std::vector<char> strings;
+    for (std::size_t i = 0; i < titles.size(); i++) {
+        const auto& title = titles[i];
+        auto& entry = table[i];
+        entry = {};
+        entry.application_id = title.application_id;
+        entry.record_fingerprint = title.record_fingerprint;
+        entry.icon_hash = title.icon_hash;
+        entry.size_nand = title.size_nand;
+        entry.size_sd = title.size_sd;
+        entry.flags = title.corrupted ? FLAG_CORRUPTED : 0;
+        entry.name_offset = AppendString(strings, title.name);
+        entry.name_length = static_cast<u32>(title.name.size());
+        entry.author_offset = AppendString(strings, title.author);
+        entry.author_length = static_cast<u32>(title.author.size());
+        entry.version_offset = AppendString(strings, title.display_version);
+        entry.version_length = static_cast<u32>(title.display_version.size());
+    }
+
+    Header header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.language = static_cast<u32>(language);
+    header.title_count = static_cast<u32>(table.size());
+    header.string_bytes = static_cast<u32>(strings.size());
+    header.checksum = Fnv1a(strings.data(), strings.size(), Fnv1a(table.data(), table.size() * sizeof(FileEntry)));
+
+    // 先写临时文件，完整写入后再替换旧快照 (Write a temporary file first, replace the old snapshot once complete)
+    const std::string temp_path = std::string{m_path} + ".tmp";
+    std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+        std::fwrite(table.data(), sizeof(FileEntry), table.size(), file) == table.size() &&
+        std::fwrite(strings.data(), 1, strings.size(), file) == strings.size();
+    std::fclose(file);
+
+    if (!written) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    // 直接覆盖旧快照，旧文件始终可用；只有文件系统拒绝覆盖时才先删除 (Rename straight over the old snapshot so it stays readable; only remove it first when the filesystem refuses to overwrite)
+    if (std::rename(temp_path.c_str(), m_path) == 0) {
+        return true;
+    }
+    std::remove(m_path);
+    return std::rename(temp_path.c_str(), m_path) == 0;
+}
+
+TitleSnapshotDiff TitleSnapshot::Diff(const std::vector<KnownTitle>& known_titles, const std::vector<NsApplicationRecord>& records) {
+    std::unordered_map<u64, const KnownTitle*> known;
+    known.reserve(known_titles.size());
+    for (const auto& title : known_titles) {
+        known.emplace(title.application_id, &title);
+    }
+
+    TitleSnapshotDiff diff;
+    std::unordered_set<u64> present;
+    present.reserve(records.size());
+    for (const auto& record : records) {
+        present.insert(record.application_id);
+
+        const auto it = known.find(record.application_id);
+        if (it == known.end()) {
+            diff.added.push_back(record.application_id);
+        } else if (it->second->corrupted || it->second->record_fingerprint != RecordFingerprint(record)) {
+            diff.updated.push_back(record.application_id);
+        } else {
+            diff.unchanged++;
+        }
+    }
+
+    for (const auto& title : known_titles) {
+        if (!present.contains(title.application_id)) {
+            diff.removed.push_back(title.application_id);
+        }
+    }
+
+    return diff;
+}
+
+} // namespace tj
@@ -0,0 +1,136 @@
+/**
+ * @file title_snapshot.hpp
+ * @brief 已扫描应用列表的二进制快照：启动时立即显示列表，后台只重新查询变化的应用
+ *        (Binary snapshot of the scanned title list: the list shows at launch, only changed titles are re-queried)
+ */
+#pragma once
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace tj {
+
+/**
+ * @brief 快照中的一个应用
+ */
+struct SnapshotTitle {
+    u64 application_id;
+    u64 record_fingerprint;     ///< 应用记录的指纹，记录变化表示应用被更新 (Fingerprint of the application record, changes on update)
+    u64 icon_hash;              ///< 图标JPEG数据的哈希，用于查询图标缓存 (Hash of the icon JPEG, keys the icon cache)
+    u64 size_nand;
+    u64 size_sd;
+    bool corrupted;             ///< 损坏的安装，下次启动时重新查询 (Corrupted install, re-queried on the next launch)
+    std::string name;
+    std::string author;
+    std::string display_version;
+};
+
+/**
+ * @brief 已知应用的记录状态，来自快照或当前列表 (Known record state of a title, from the snapshot or the current list)
+ */
+struct KnownTitle {
+    u64 application_id;
+    u64 record_fingerprint;
+    bool corrupted;
+};
+
+/**
+ * @brief 已知应用与当前应用记录的差异
+ */
+struct TitleSnapshotDiff {
+    std::vector<u64> added;     ///< 新安装的应用 (Newly installed titles)
+    std::vector<u64> updated;   ///< 记录已变化或上次损坏的应用 (Titles whose record changed, or that were corrupted)
+    std::vector<u64> removed;   ///< 已卸载的应用 (Uninstalled titles)
+    std::size_t unchanged{};    ///< 无需重新查询的应用数量 (Titles that need no re-query)
+
+    bool Empty() const { return added.empty() && updated.empty() && removed.empty(); }
+};
+
+/**
+ * @brief 应用列表快照
+ *
+ * 文件由头部、固定大小的条目表和字符串表组成，所有字段为定长小端整数，字符串以偏移和长度引用。
+ * 加载时一次读入整个文件并校验，布局可以直接映射使用；Horizon上的sdmc不支持mmap，因此整体读取。
+ * 名称按系统语言获取，语言变化时快照失效。
+ *
+ * The file holds a header, a fixed-size entry table and a string table; every field is a fixed-width
+ * little-endian integer and strings are referenced by offset and length. Loading reads the whole file in one
+ * go and validates it; the layout is mappable as is, but sdmc on Horizon has no mmap so it is read whole.
+ * Names depend on the system language, so a language change invalidates the snapshot.
+ */
+class TitleSnapshot {
+public:
+    /**
+     * @brief 构造函数
+     * @param path 快照文件路径
+     */
+    explicit TitleSnapshot(const char* path);
+
+    /**
+     * @brief 读取并校验快照
+     * @param language 当前系统语言，与快照不一致时视为无效
+     * @return 成功返回true，文件不存在、损坏或语言不同返回false
+     */
+    bool Load(int language);
+
+    /**
+     * @brief 写入快照，先写临时文件再替换，写入中断不会留下损坏的快照
+     * @param titles 当前完整的应用列表
+     * @param language 当前系统语言
+     * @return 成功返回true
+     */
+    bool Save(const std::vector<SnapshotTitle>& titles, int language);
+
+    /**
+     * @brief 比较已知应用与当前应用记录
+     * @param known 上次已知的应用状态
+     * @param records 当前的应用记录
+     */
+    static TitleSnapshotDiff Diff(const std::vector<KnownTitle>& known, const std::vector<NsApplicationRecord>& records);
+
+    /**
+     * @brief 计算应用记录中除应用ID外所有字段的指纹
+     */
+    static u64 RecordFingerprint(const NsApplicationRecord& record);
+
+    const std::vector<SnapshotTitle>& GetTitles() const { return m_titles; }
+
+private:
+    struct Header {
+        u32 magic;
+        u32 version;
+        u32 language;
+        u32 title_count;
+        u32 string_bytes;
+        u32 reserved;
+        u64 checksum;           ///< 条目表与字符串表的FNV-1a哈希 (FNV-1a hash of the entry and string tables)
+    };
+
+    struct FileEntry {
+        u64 application_id;
+        u64 record_fingerprint;
+        u64 icon_hash;
+        u64 size_nand;
+        u64 size_sd;
+        u32 flags;
+        u32 name_offset;
+        u32 name_length;
+        u32 author_offset;
+        u32 author_length;
+        u32 version_offset;
+        u32 version_length;
+        u32 reserved;
+    };
+
+    static constexpr u32 MAGIC = 0x504E5355; // "USNP"
+    static constexpr u32 VERSION = 2; // 2: 发行商和版本不再为空，旧快照作废 (2: publisher and version are filled in, older snapshots are dropped)
+    static constexpr u32 FLAG_CORRUPTED = 1 << 0;
+
+    const char* m_path;                         ///< 快照文件路径
+    std::vector<SnapshotTitle> m_titles;        ///< 已加载的应用列表
+};
+
+} // namespace tj
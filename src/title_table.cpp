@@ -0,0 +1,526 @@
+/**
+ * @file title_table.cpp
+ * @brief 按列存储的应用列表的实现
+ */
+#include "title_table.hpp"
+#include "app_entry.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace tj {
+
+void TitleTable::Reset(std::size_t expected) {
+    m_ids.clear();
+    m_size_nand.clear();
+    m_size_sd.clear();
+    m_size_total.clear();
+    m_flags.clear();
+    m_icon_hash.clear();
+    m_fingerprint.clear();
+    m_name_prefix.clear();
+    m_author_prefix.clear();
+    m_name_rank.clear();
+    m_author_rank.clear();
+    m_name_ranked = false;
+    m_author_ranked = false;
+    m_text.clear();
+    m_icon_data.clear();
+    m_order.clear();
+    m_row_of.clear();
+    m_full_order.clear();
+    m_filtered = false;
+
+    m_ids.reserve(expected);
+    m_size_nand.reserve(expected);
+    m_size_sd.reserve(expected);
+    m_size_total.reserve(expected);
+    m_flags.reserve(expected);
+    m_icon_hash.reserve(expected);
+    m_fingerprint.reserve(expected);
+    m_name_prefix.reserve(expected);
+    m_author_prefix.reserve(expected);
+    m_text.reserve(expected);
+    m_icon_data.reserve(expected);
+    m_order.reserve(expected);
+    m_row_of.reserve(expected);
+    m_index.Reset(expected);
+    m_selection.Reset();
+    m_visible_selected = 0;
+    m_total_nand = 0;
+    m_total_sd = 0;
+    m_pending_sizes = 0;
+    m_sorted = false;
+}
+
+void TitleTable::Store(u32 slot, AppEntry&& entry) {
+    StoreSizes(slot, entry.size_nand, entry.size_sd);
+
+    m_ids[slot] = entry.id;
+    m_pending_sizes -= IsUnclaimed(m_flags[slot]) ? 1 : 0;
+    m_pending_sizes += entry.size_pending ? 1 : 0;
+    m_flags[slot] = static_cast<u8>(
+        (entry.corrupted ? FLAG_CORRUPTED : 0) |
+        (entry.has_cached_icon ? FLAG_HAS_ICON : 0) |
+        (entry.size_pending ? FLAG_SIZE_PENDING : 0));
+    m_icon_hash[slot] = entry.icon_hash;
+    m_fingerprint[slot] = entry.record_fingerprint;
+    m_text[slot] = TitleText{std::move(entry.name), std::move(entry.author), std::move(entry.display_version), {}, {}};
+    m_icon_data[slot] = std::move(entry.cached_icon_data);
+    StoreKeys(slot);
+}
+
+void TitleTable::StoreSizes(u32 slot, std::size_t size_nand, std::size_t size_sd) {
+    // 总容量和已选中容量随应用容量变化 (Totals and selected totals follow the title's sizes)
+    m_total_nand = m_total_nand - m_size_nand[slot] + size_nand;
+    m_total_sd = m_total_sd - m_size_sd[slot] + size_sd;
+    m_selection.UpdateSizes(slot, m_size_nand[slot], m_size_sd[slot], size_nand, size_sd);
+
+    m_size_nand[slot] = size_nand;
+    m_size_sd[slot] = size_sd;
+    m_size_total[slot] = size_nand + size_sd;
+}
+
+void TitleTable::StoreKeys(u32 slot) {
+    auto& text = m_text[slot];
+    text.name_key = MakeCollationKey(text.name, m_locale);
+    text.author_key = MakeCollationKey(text.author, m_locale);
+    m_name_prefix[slot] = CollationPrefix(text.name_key);
+    m_author_prefix[slot] = CollationPrefix(text.author_key);
+    // 新的排序键可能落在任意两个名次之间 (A new key may fall between any two ranks)
+    m_name_ranked = false;
+    m_author_ranked = false;
+}
+
+std::size_t TitleTable::Append(AppEntry&& entry) {
+    const auto slot = static_cast<u32>(m_ids.size());
+    m_ids.emplace_back();
+    m_size_nand.emplace_back();
+    m_size_sd.emplace_back();
+    m_size_total.emplace_back();
+    m_flags.emplace_back();
+    m_icon_hash.emplace_back();
+    m_fingerprint.emplace_back();
+    m_name_prefix.emplace_back();
+    m_author_prefix.emplace_back();
+    m_text.emplace_back();
+    m_icon_data.emplace_back();
+    m_selection.PushBack();
+    m_index.Insert(entry.id, slot);
+    const bool selected = entry.selected;
+    Store(slot, std::move(entry));
+    m_selection.Set(slot, selected, m_size_nand[slot], m_size_sd[slot]);
+
+    // 过滤时新应用只进入完整顺序 (While filtered a new title only joins the full order)
+    m_row_of.push_back(NO_ROW);
+    auto& order = m_filtered ? m_full_order : m_order;
+    std::size_t row = order.size();
+    if (m_sorted) {
+        WithCompare([&](auto compare) { row = Place(order, NPOS, slot, compare); });
+    } else {
+        order.push_back(slot);
+        if (!m_filtered) {
+            m_row_of[slot] = static_cast<u32>(row);
+        }
+    }
+    return m_filtered ? NPOS : row;
+}
+
+bool TitleTable::Replace(AppEntry&& entry) {
+    const std::size_t slot = m_index.Find(entry.id);
+    if (slot == IdIndex::NPOS) {
+        return false;
+    }
+    Store(static_cast<u32>(slot), std::move(entry));
+    Reposition(static_cast<u32>(slot));
+    return true;
+}
+
+bool TitleTable::SetSizes(u64 id, std::size_t size_nand, std::size_t size_sd) {
+    const std::size_t slot = m_index.Find(id);
+    if (slot == IdIndex::NPOS) {
+        return false;
+    }
+    m_pending_sizes -= IsUnclaimed(m_flags[slot]) ? 1 : 0;
+    m_flags[slot] &= static_cast<u8>(~(FLAG_SIZE_PENDING | FLAG_SIZE_CLAIMED));
+    StoreSizes(static_cast<u32>(slot), size_nand, size_sd);
+    Reposition(static_cast<u32>(slot));
+    return true;
+}
+
+bool TitleTable::ClaimPendingSize(std::size_t near_row, u64& id) {
+    if (!m_pending_sizes) {
+        return false;
+    }
+    const auto claim = [this, &id](u32 slot) {
+        if (!IsUnclaimed(m_flags[slot])) {
+            return false;
+        }
+        m_flags[slot] |= FLAG_SIZE_CLAIMED;
+        m_pending_sizes--;
+        id = m_ids[slot];
+        return true;
+    };
+
+    // 从near_row向下和向上交替查找，视口附近的应用先领取 (Alternate downwards and upwards from near_row, so titles near the viewport go first)
+    const std::size_t rows = m_order.size();
+    near_row = std::min(near_row, rows ? rows - 1 : 0);
+    for (std::size_t step = 0; near_row + step < rows || step < near_row; step++) {
+        if (near_row + step < rows && claim(m_order[near_row + step])) {
+            return true;
+        }
+        if (step < near_row && claim(m_order[near_row - step - 1])) {
+            return true;
+        }
+    }
+    // 被过滤隐藏的应用 (Titles hidden by the filter)
+    for (u32 slot : m_full_order) {
+        if (claim(slot)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TitleTable::SetIconData(u64 id, std::vector<unsigned char>&& jpeg, u64 icon_hash) {
+    const std::size_t slot = m_index.Find(id);
+    if (slot == IdIndex::NPOS) {
+        return false;
+    }
+    m_icon_data[slot] = std::move(jpeg);
+    m_icon_hash[slot] = icon_hash;
+    m_flags[slot] |= FLAG_HAS_ICON;
+    return true;
+}
+
+std::size_t TitleTable::FindRow(u64 id) const {
+    const std::size_t slot = m_index.Find(id);
+    if (slot == IdIndex::NPOS || m_row_of[slot] == NO_ROW) {
+        return NPOS;
+    }
+    return m_row_of[slot];
+}
+
+std::size_t TitleTable::Remove(const std::vector<u64>& ids) {
+    std::vector<bool> erase(m_ids.size(), false);
+    std::size_t erased = 0;
+    std::size_t erased_selected = 0;
+    for (u64 id : ids) {
+        const std::size_t slot = m_index.Find(id);
+        if (slot != IdIndex::NPOS && !erase[slot]) {
+            erase[slot] = true;
+            erased++;
+            erased_selected += m_selection.Set(slot, false, m_size_nand[slot], m_size_sd[slot]) ? 1 : 0;
+            m_pending_sizes -= IsUnclaimed(m_flags[slot]) ? 1 : 0;
+            m_total_nand -= m_size_nand[slot];
+            m_total_sd -= m_size_sd[slot];
+        }
+    }
+    if (!erased) {
+        return 0;
+    }
+
+    // 单次压缩所有列，记录旧存储槽到新存储槽的映射 (Compact every column in one pass, remembering old to new slots)
+    std::vector<u32> new_slot(m_ids.size(), 0);
+    u32 out = 0;
+    for (u32 slot = 0; slot < m_ids.size(); slot++) {
+        if (erase[slot]) {
+            continue;
+        }
+        new_slot[slot] = out;
+        if (out != slot) {
+            m_ids[out] = m_ids[slot];
+            m_size_nand[out] = m_size_nand[slot];
+            m_size_sd[out] = m_size_sd[slot];
+            m_size_total[out] = m_size_total[slot];
+            m_flags[out] = m_flags[slot];
+            m_icon_hash[out] = m_icon_hash[slot];
+            m_fingerprint[out] = m_fingerprint[slot];
+            m_name_prefix[out] = m_name_prefix[slot];
+            m_author_prefix[out] = m_author_prefix[slot];
+            if (m_name_ranked) {
+                m_name_rank[out] = m_name_rank[slot];
+            }
+            if (m_author_ranked) {
+                m_author_rank[out] = m_author_rank[slot];
+            }
+            m_text[out] = std::move(m_text[slot]);
+            m_icon_data[out] = std::move(m_icon_data[slot]);
+        }
+        out++;
+    }
+    m_ids.resize(out);
+    m_size_nand.resize(out);
+    m_size_sd.resize(out);
+    m_size_total.resize(out);
+    m_flags.resize(out);
+    m_icon_hash.resize(out);
+    m_fingerprint.resize(out);
+    m_name_prefix.resize(out);
+    m_author_prefix.resize(out);
+    // 删除不改变其余应用的相对顺序，名次仍然有效 (Removal keeps the others' relative order, so the ranks stay valid)
+    if (m_name_ranked) {
+        m_name_rank.resize(out);
+    }
+    if (m_author_ranked) {
+        m_author_rank.resize(out);
+    }
+    m_text.resize(out);
+    m_icon_data.resize(out);
+
+    // 显示顺序去掉被删除的槽并改用新槽号 (Drop removed slots from the display order and renumber the rest)
+    for (auto* order : {&m_order, &m_full_order}) {
+        std::erase_if(*order, [&erase](u32 slot) { return erase[slot]; });
+        for (auto& slot : *order) {
+            slot = new_slot[slot];
+        }
+    }
+
+    m_selection.Compact(erase);
+    RebuildRows();
+    RecountVisibleSelected();
+    m_index.Rebuild(m_ids, [](u64 id) { return id; });
+    return erased_selected;
+}
+
+void TitleTable::RebuildRows() {
+    m_row_of.assign(m_ids.size(), NO_ROW);
+    for (std::size_t row = 0; row < m_order.size(); row++) {
+        m_row_of[m_order[row]] = static_cast<u32>(row);
+    }
+}
+
+void TitleTable::RecountVisibleSelected() {
+    m_visible_selected = 0;
+    if (m_filtered) {
+        for (u32 slot : m_order) {
+            m_visible_selected += m_selection.Test(slot) ? 1 : 0;
+        }
+    }
+}
+
+template<typename Fn>
+void TitleTable::WithCompare(Fn fn) {
+    // 主字段决定顺序，相同时交给升序的次要字段 (The primary field decides, ties go to the ascending tie-breakers)
+    const auto by = [this, descending = m_descending](auto primary) {
+        return [this, descending, primary](u32 a, u32 b) {
+            const std::weak_ordering order = primary(a, b);
+            if (order != 0) {
+                return descending ? order > 0 : order < 0;
+            }
+            return TieBreak(a, b);
+        };
+    };
+    // 大小未知的应用总是排在最后，与方向无关 (Titles of unknown size always go last, whatever the direction)
+    const auto by_size = [this, &by](const std::vector<std::size_t>& sizes) {
+        return [this, sized = by([&sizes](u32 a, u32 b) -> std::weak_ordering { return sizes[a] <=> sizes[b]; })](u32 a, u32 b) {
+            const bool pending_a = m_flags[a] & FLAG_SIZE_PENDING;
+            const bool pending_b = m_flags[b] & FLAG_SIZE_PENDING;
+            if (pending_a != pending_b) {
+                return pending_b;
+            }
+            return sized(a, b);
+        };
+    };
+    switch (m_sort_key) {
+        case SortKey::NAME:
+            fn(by([this](u32 a, u32 b) { return CompareName(a, b); }));
+            break;
+        case SortKey::SIZE:
+            fn(by_size(m_size_total));
+            break;
+        case SortKey::NAND:
+            fn(by_size(m_size_nand));
+            break;
+        case SortKey::SD:
+            fn(by_size(m_size_sd));
+            break;
+        case SortKey::AUTHOR:
+            fn(by([this](u32 a, u32 b) { return CompareAuthor(a, b); }));
+            break;
+        case SortKey::ID:
+            fn(by([this](u32 a, u32 b) -> std::weak_ordering { return m_ids[a] <=> m_ids[b]; }));
+            break;
+    }
+}
+
+template<typename Compare>
+void TitleTable::SortOrders(Compare compare) {
+    std::ranges::sort(m_order, compare);
+    // 过滤时完整顺序也要排序，清除过滤后保持一致 (While filtered the full order is sorted too, so clearing the filter stays consistent)
+    if (m_filtered) {
+        std::ranges::sort(m_full_order, compare);
+    }
+    RebuildRows();
+}
+
+template<typename Compare>
+std::size_t TitleTable::Place(std::vector<u32>& order, std::size_t from, u32 slot, Compare compare) {
+    // 已在正确位置时不移动，大小变化通常不改变顺序 (Nothing moves when already in place, most size updates keep the order)
+    if (from != NPOS) {
+        if ((from == 0 || compare(order[from - 1], slot)) && (from + 1 == order.size() || compare(slot, order[from + 1]))) {
+            return from;
+        }
+        order.erase(order.begin() + static_cast<std::ptrdiff_t>(from));
+    }
+    const auto it = std::ranges::upper_bound(order, slot, compare);
+    const auto to = static_cast<std::size_t>(it - order.begin());
+    order.insert(it, slot);
+
+    // 只有显示顺序有行号，更新位置变化的区间 (Only the display order has rows, renumber the span that shifted)
+    if (&order == &m_order) {
+        const std::size_t first = std::min(from, to);
+        const std::size_t last = from == NPOS ? order.size() : std::max(from, to) + 1;
+        for (std::size_t row = first; row < last; row++) {
+            m_row_of[m_order[row]] = static_cast<u32>(row);
+        }
+        if (last - first > 1) {
+            m_moves++;
+        }
+    }
+    return to;
+}
+
+void TitleTable::Reposition(u32 slot) {
+    if (!m_sorted) {
+        return;
+    }
+    WithCompare([this, slot](auto compare) {
+        if (!m_filtered) {
+            Place(m_order, m_row_of[slot], slot, compare);
+            return;
+        }
+        // 过滤时显示顺序按匹配等级排列，只调整完整顺序 (While filtered the display order follows the match rank, only the full order is adjusted)
+        if (const auto it = std::ranges::find(m_full_order, slot); it != m_full_order.end()) {
+            Place(m_full_order, static_cast<std::size_t>(it - m_full_order.begin()), slot, compare);
+        }
+    });
+}
+
+void TitleTable::SetCollation(CollationLocale locale) {
+    if (locale == m_locale) {
+        return;
+    }
+    m_locale = locale;
+    for (u32 slot = 0; slot < m_ids.size(); slot++) {
+        StoreKeys(slot);
+    }
+}
+
+std::weak_ordering TitleTable::CompareName(u32 a, u32 b) const {
+    if (m_name_ranked) {
+        return m_name_rank[a] <=> m_name_rank[b];
+    }
+    // 前缀不同时无需读取冷数据中的完整排序键 (When the prefixes differ the full keys in cold storage are never read)
+    if (m_name_prefix[a] != m_name_prefix[b]) {
+        return m_name_prefix[a] <=> m_name_prefix[b];
+    }
+    return m_text[a].name_key.compare(m_text[b].name_key) <=> 0;
+}
+
+std::weak_ordering TitleTable::CompareAuthor(u32 a, u32 b) const {
+    if (m_author_ranked) {
+        return m_author_rank[a] <=> m_author_rank[b];
+    }
+    if (m_author_prefix[a] != m_author_prefix[b]) {
+        return m_author_prefix[a] <=> m_author_prefix[b];
+    }
+    return m_text[a].author_key.compare(m_text[b].author_key) <=> 0;
+}
+
+bool TitleTable::TieBreak(u32 a, u32 b) const {
+    if (const auto order = CompareName(a, b); order != 0) {
+        return order < 0;
+    }
+    return m_ids[a] < m_ids[b];
+}
+
+void TitleTable::Sort(SortKey key, bool descending) {
+    m_sort_key = key;
+    m_descending = descending;
+    m_sorted = true;
+    WithCompare([this](auto compare) { SortOrders(compare); });
+
+    // 排序后相同的键相邻，一次遍历即可得到名次 (Once sorted equal keys are adjacent, so one pass yields the ranks)
+    if (key == SortKey::NAME && !m_name_ranked) {
+        StoreRanks(m_name_rank, [this](u32 a, u32 b) { return CompareName(a, b); });
+        m_name_ranked = true;
+    } else if (key == SortKey::AUTHOR && !m_author_ranked) {
+        StoreRanks(m_author_rank, [this](u32 a, u32 b) { return CompareAuthor(a, b); });
+        m_author_ranked = true;
+    }
+}
+
+template<typename Compare>
+void TitleTable::StoreRanks(std::vector<u32>& rank, Compare compare) {
+    const auto& order = m_filtered ? m_full_order : m_order;
+    rank.resize(m_ids.size());
+    u32 next = 0;
+    for (std::size_t i = 0; i < order.size(); i++) {
+        // 降序时从末尾开始，名次总是随键递增 (Walk from the end when descending, ranks always grow with the key)
+        const u32 slot = m_descending ? order[order.size() - 1 - i] : order[i];
+        if (i > 0) {
+            const u32 prev = m_descending ? order[order.size() - i] : order[i - 1];
+            next += compare(prev, slot) != 0 ? 1 : 0;
+        }
+        rank[slot] = next;
+    }
+}
+
+void TitleTable::SetFilter(const std::vector<u64>& ids) {
+    if (!m_filtered) {
+        m_full_order = std::move(m_order);
+        m_filtered = true;
+    }
+    m_order.clear();
+    m_order.reserve(ids.size());
+    for (u64 id : ids) {
+        if (const std::size_t slot = m_index.Find(id); slot != IdIndex::NPOS) {
+            m_order.push_back(static_cast<u32>(slot));
+        }
+    }
+    RebuildRows();
+    RecountVisibleSelected();
+}
+
+void TitleTable::ClearFilter() {
+    if (!m_filtered) {
+        return;
+    }
+    m_order = std::move(m_full_order);
+    m_full_order.clear();
+    m_filtered = false;
+    m_visible_selected = 0;
+    RebuildRows();
+}
+
+void TitleTable::SetSelected(std::size_t row, bool selected) {
+    const u32 slot = m_order[row];
+    if (m_selection.Set(slot, selected, m_size_nand[slot], m_size_sd[slot]) && m_filtered) {
+        m_visible_selected = selected ? m_visible_selected + 1 : m_visible_selected - 1;
+    }
+}
+
+void TitleTable::SetAllSelected(bool selected) {
+    if (m_filtered) {
+        for (u32 slot : m_order) {
+            m_selection.Set(slot, selected, m_size_nand[slot], m_size_sd[slot]);
+        }
+        m_visible_selected = selected ? m_order.size() : 0;
+        return;
+    }
+    m_selection.SetAll(selected, m_total_nand, m_total_sd);
+}
+
+void TitleTable::InvertSelection() {
+    if (m_filtered) {
+        for (u32 slot : m_order) {
+            m_selection.Set(slot, !m_selection.Test(slot), m_size_nand[slot], m_size_sd[slot]);
+        }
+        m_visible_selected = m_order.size() - m_visible_selected;
+        return;
+    }
+    m_selection.Invert(m_total_nand, m_total_sd);
+}
+
+} // namespace tj
@@ -0,0 +1,249 @@
+/**
+ * @file title_table.hpp
+ * @brief 按列存储的应用列表：热数据连续存放，字符串和图标数据单独存放，排序只重排下标
+ *        (Column-stored title list: hot fields are contiguous, strings and icon bytes are kept apart, sorting only permutes indices)
+ */
+#pragma once
+
+#include "id_index.hpp"
+#include "selection_set.hpp"
+#include "collation.hpp"
+
+#include <switch.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <compare>
+
+namespace tj {
+
+struct AppEntry;
+
+/**
+ * @brief 应用列表
+ *
+ * 每个应用占用一个存储槽，各字段按列存放在独立的数组中：排序键、大小和标志位连续存放，每帧遍历只读取需要的列；
+ * 名称和发行商的排序键在存入时按界面语言生成一次，其8字节前缀存放在热数据中，排序大多只比较整数；
+ * 按名称或发行商排序一次后记下每个应用的名次，之后的切换和插入只比较名次，直到排序键改变；
+ * 名称等字符串和图标JPEG数据放在冷存储中，不参与遍历和排序。
+ * 显示顺序是存储槽的排列，排序只移动4字节的下标，存储槽在删除应用前保持不变，应用ID索引因此在排序后仍然有效。
+ * 选中状态保存在按存储槽索引的位集合中，选中数量和容量在修改时增量维护。
+ * 过滤时显示顺序只包含匹配的存储槽，完整顺序另存，排序和删除同时作用于两者；不可见的应用没有行号。
+ * 排序后新增的应用按二分查找插入，数据变化的应用只移动自身，扫描中的列表因此始终有序；大小未知的应用排在按大小排序的末尾。
+ * 对外接口使用显示顺序中的行号。非线程安全，由App::entries_mutex保护。
+ *
+ * Each title owns a storage slot and every field lives in its own column: sort keys, sizes and flags are
+ * contiguous so per-frame passes only read the columns they need. Collation keys for the name and publisher are
+ * built once per title for the UI language when stored, with their 8-byte prefixes kept hot so most sort
+ * comparisons are integer compares. The first name or publisher sort also records each title's rank, so later
+ * switches and inserts compare ranks only until a key changes. Strings and the icon JPEG sit in cold
+ * storage that passes and sorts never touch. The display order is a permutation of slots, so sorting moves 4-byte
+ * indices only; slots stay put until titles are removed, which keeps the id index and the selection bitset valid
+ * across sorts. Selection counts and byte totals are maintained incrementally as the selection changes.
+ * While filtered the display order holds only the matching slots and the full order is kept aside; sorts and
+ * removals apply to both, and hidden titles have no row.
+ * Once sorted, added titles are binary-inserted and titles whose data changes only move themselves, so the list
+ * stays ordered while a scan fills it in; titles whose size is still unknown go last in the size orders.
+ * The interface takes rows in display order. Not thread safe, guarded by App::entries_mutex.
+ */
+class TitleTable {
+public:
+    static constexpr std::size_t NPOS = IdIndex::NPOS;
+
+    /**
+     * @brief 排序字段
+     */
+    enum class SortKey : u8 {
+        NAME,
+        SIZE,       ///< 总容量 (Total size)
+        NAND,
+        SD,
+        AUTHOR,
+        ID,
+    };
+
+    std::size_t Size() const { return m_order.size(); }
+    bool Empty() const { return m_order.empty(); }
+
+    /**
+     * @brief 清空并预留容量
+     */
+    void Reset(std::size_t expected = 0);
+
+    /**
+     * @brief 追加应用，已排序时插入到排序位置，否则放在末尾
+     * @return 新应用的行号，过滤时应用不可见，返回NPOS
+     */
+    std::size_t Append(AppEntry&& entry);
+
+    /**
+     * @brief 用新的数据替换同ID的应用，保留选中状态，已排序时按新数据调整位置
+     * @return 应用不存在时返回false
+     */
+    bool Replace(AppEntry&& entry);
+
+    /**
+     * @brief 填入后台计算的大小，清除待计算标记，已排序时调整位置
+     * @return 应用不存在时返回false
+     */
+    bool SetSizes(u64 id, std::size_t size_nand, std::size_t size_sd);
+
+    /**
+     * @brief 领取一个大小待计算的应用，从near_row开始向上下两侧查找，被过滤隐藏的应用最后领取
+     * @param near_row 优先处理的行，通常是视口中间
+     * @return 没有待领取的应用时返回false
+     */
+    bool ClaimPendingSize(std::size_t near_row, u64& id);
+
+    /**
+     * @brief 插入和重新定位改变行号的累计次数，渲染线程据此让光标跟随原来的应用
+     *        (Running count of inserts and repositions that shifted rows, the render thread uses it to keep the cursor on its title)
+     */
+    u64 MoveCount() const { return m_moves; }
+
+    /**
+     * @brief 更新应用的图标JPEG数据
+     * @return 应用不存在时返回false
+     */
+    bool SetIconData(u64 id, std::vector<unsigned char>&& jpeg, u64 icon_hash);
+
+    /**
+     * @brief 按应用ID查找行号
+     * @return 不存在或被过滤隐藏时返回NPOS
+     */
+    std::size_t FindRow(u64 id) const;
+
+    /**
+     * @brief 批量移除应用，剩余应用保持原有顺序
+     * @return 被移除的应用中已选中的数量
+     */
+    std::size_t Remove(const std::vector<u64>& ids);
+
+    /**
+     * @brief 设置排序规则，已有应用的排序键随之重建
+     */
+    void SetCollation(CollationLocale locale);
+
+    /**
+     * @brief 按字段排序，只重排显示顺序
+     *
+     * 主字段相同时按名称排序，最后按应用ID排序，顺序因此是确定的。排序方式被记住，之后的追加和修改保持这一顺序。
+     * Ties on the primary field fall back to the name and finally to the application id, so the order is deterministic.
+     * The sort is remembered and later appends and updates keep to it.
+     * @param descending 主字段降序，次要字段总是升序 (Primary field descending, tie-breakers are always ascending)
+     */
+    void Sort(SortKey key, bool descending);
+
+    /**
+     * @brief 只显示给定的应用，按给定顺序排列，不存在的ID被忽略
+     */
+    void SetFilter(const std::vector<u64>& ids);
+
+    /**
+     * @brief 恢复显示所有应用
+     */
+    void ClearFilter();
+
+    bool IsFiltered() const { return m_filtered; }
+
+    // 按行读取 (Row accessors)
+    u64 Id(std::size_t row) const { return m_ids[m_order[row]]; }
+    std::size_t SizeNand(std::size_t row) const { return m_size_nand[m_order[row]]; }
+    std::size_t SizeSd(std::size_t row) const { return m_size_sd[m_order[row]]; }
+    std::size_t SizeTotal(std::size_t row) const { return m_size_total[m_order[row]]; }
+    bool IsSelected(std::size_t row) const { return m_selection.Test(m_order[row]); }
+    bool IsCorrupted(std::size_t row) const { return m_flags[m_order[row]] & FLAG_CORRUPTED; }
+    bool HasIcon(std::size_t row) const { return m_flags[m_order[row]] & FLAG_HAS_ICON; }
+    u64 IconHash(std::size_t row) const { return m_icon_hash[m_order[row]]; }
+    u64 RecordFingerprint(std::size_t row) const { return m_fingerprint[m_order[row]]; }
+    const std::string& Name(std::size_t row) const { return m_text[m_order[row]].name; }
+    const std::string& Author(std::size_t row) const { return m_text[m_order[row]].author; }
+    const std::string& DisplayVersion(std::size_t row) const { return m_text[m_order[row]].display_version; }
+    const std::vector<unsigned char>& IconData(std::size_t row) const { return m_icon_data[m_order[row]]; }
+
+    // 选中状态，数量和容量查询为O(1)；过滤时全选和反选只作用于可见的行
+    // (Selection, counts and totals are O(1); while filtered, select-all and invert only touch visible rows)
+    void SetSelected(std::size_t row, bool selected);
+    void SetAllSelected(bool selected);
+    void InvertSelection();
+    std::size_t CountSelected() const { return m_selection.Count(); }
+    /// 可见行中的选中数，未过滤时等于CountSelected (Selected visible rows, equal to CountSelected when unfiltered)
+    std::size_t CountVisibleSelected() const { return m_filtered ? m_visible_selected : m_selection.Count(); }
+    std::size_t SelectedNand() const { return m_selection.SelectedNand(); }
+    std::size_t SelectedSd() const { return m_selection.SelectedSd(); }
+
+private:
+    static constexpr u8 FLAG_CORRUPTED = 1 << 0;
+    static constexpr u8 FLAG_HAS_ICON = 1 << 1;
+    static constexpr u8 FLAG_SIZE_PENDING = 1 << 2;    ///< 大小尚未计算 (Size not computed yet)
+    static constexpr u8 FLAG_SIZE_CLAIMED = 1 << 3;    ///< 已被后台领取，正在计算 (Claimed by the background pass, being computed)
+    static constexpr u32 NO_ROW = ~0u;
+
+    // 大小待计算且未被领取 (Size pending and not claimed yet)
+    static bool IsUnclaimed(u8 flags) { return (flags & (FLAG_SIZE_PENDING | FLAG_SIZE_CLAIMED)) == FLAG_SIZE_PENDING; }
+
+    struct TitleText {
+        std::string name;
+        std::string author;
+        std::string display_version;
+        std::string name_key;       ///< 名称的排序键 (Collation key of the name)
+        std::string author_key;     ///< 发行商的排序键 (Collation key of the publisher)
+    };
+
+    void Store(u32 slot, AppEntry&& entry);
+    void StoreSizes(u32 slot, std::size_t size_nand, std::size_t size_sd);
+    void RebuildRows();
+    void RecountVisibleSelected();
+    template<typename Fn>
+    void WithCompare(Fn fn);
+    template<typename Compare>
+    void SortOrders(Compare compare);
+    template<typename Compare>
+    std::size_t Place(std::vector<u32>& order, std::size_t from, u32 slot, Compare compare);
+    void Reposition(u32 slot);
+    void StoreKeys(u32 slot);
+    std::weak_ordering CompareName(u32 a, u32 b) const;
+    std::weak_ordering CompareAuthor(u32 a, u32 b) const;
+    bool TieBreak(u32 a, u32 b) const;
+    template<typename Compare>
+    void StoreRanks(std::vector<u32>& rank, Compare compare);
+
+    // 热数据，按存储槽索引 (Hot columns, indexed by slot)
+    std::vector<u64> m_ids;
+    std::vector<std::size_t> m_size_nand;
+    std::vector<std::size_t> m_size_sd;
+    std::vector<std::size_t> m_size_total;
+    std::vector<u8> m_flags;
+    std::vector<u64> m_icon_hash;
+    std::vector<u64> m_fingerprint;
+    std::vector<u64> m_name_prefix;     ///< 名称排序键的前缀 (Prefix of the name collation key)
+    std::vector<u64> m_author_prefix;   ///< 发行商排序键的前缀 (Prefix of the publisher collation key)
+    std::vector<u32> m_name_rank;       ///< 名称的名次，相同名称名次相同 (Name rank, equal names share a rank)
+    std::vector<u32> m_author_rank;     ///< 发行商的名次 (Publisher rank)
+
+    // 冷数据，按存储槽索引 (Cold storage, indexed by slot)
+    std::vector<TitleText> m_text;
+    std::vector<std::vector<unsigned char>> m_icon_data;
+
+    std::vector<u32> m_order;       ///< 行号到存储槽 (Row to slot)
+    std::vector<u32> m_row_of;      ///< 存储槽到行号，隐藏的槽为NO_ROW (Slot to row, NO_ROW for hidden slots)
+    std::vector<u32> m_full_order;  ///< 过滤时保存的完整顺序 (Full order kept aside while filtered)
+    bool m_filtered{};
+    CollationLocale m_locale{CollationLocale::ROOT};
+    SortKey m_sort_key{SortKey::NAME};
+    bool m_descending{};
+    bool m_sorted{};                ///< 调用过Sort，追加和修改时保持顺序 (Sort was called, appends and updates keep the order)
+    bool m_name_ranked{};           ///< 名称名次有效，排序键改变时失效 (Name ranks are valid, invalidated when a key changes)
+    bool m_author_ranked{};         ///< 发行商名次有效 (Publisher ranks are valid)
+    u64 m_moves{};
+    std::size_t m_pending_sizes{};  ///< 大小待计算且未被领取的应用数 (Titles whose size is pending and unclaimed)
+    IdIndex m_index;                ///< 应用ID到存储槽 (Application id to slot)
+
+    SelectionSet m_selection;       ///< 按存储槽的选中状态 (Selection by slot)
+    std::size_t m_total_nand{};     ///< 所有应用在NAND上的总容量，用于全选和反选 (Total NAND size of all titles, for select-all and invert)
+    std::size_t m_total_sd{};       ///< 所有应用在SD卡上的总容量 (Total SD size of all titles)
+    std::size_t m_visible_selected{}; ///< 过滤时可见行中的选中数 (Selected visible rows while filtered)
+};
+
+} // namespace tj
@@ -0,0 +1,268 @@
+// 滑动图标预取基准：用真实的ListScroller和ResourceLoadManager按60帧模拟快慢滑动、反向滑动、慢速拖动和连续的最高速滑动，
+// 对比原先的预取（可见行加下方2行，100ms防抖）与按滑动速度预测的预取，统计滚动中可见行缺少图标的比例。
+// 解码按固定的后台线程数和每个图标的耗时模拟，分别测RGBA缓存命中和JPEG解码两种情况；预测预取的缺失率必须更低
+// Fling icon prefetch benchmark: drives the real ListScroller and ResourceLoadManager at 60 FPS through fast and
+// slow flings, an upward fling, a slow drag and repeated top-speed flings, comparing the former prefetch (visible rows plus 2 below, 100 ms
+// debounce) with the velocity-predicted prefetch by the share of visible rows drawn without their icon while
+// scrolling. Decoding is modelled as a fixed number of background workers and a per-icon cost, for both RGBA cache
+// hits and JPEG decodes of several costs. The predicted prefetch must miss less
+#include "list_scroller.hpp"
+#include "resource_load_manager.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+constexpr u64 FRAME_NS = 16666667;
+constexpr std::size_t ROWS = 2000;
+
+// 与App相同的列表尺寸和预取参数 (Same list geometry and prefetch constants as App)
+constexpr float BOX_HEIGHT = 120.f;
+constexpr std::size_t LIST_ROWS = 4;
+constexpr float PREFETCH_SECONDS = 0.5f;
+constexpr std::size_t PRELOAD_ABOVE = 1;
+constexpr std::size_t PRELOAD_BELOW = 2;
+constexpr std::size_t MAX_PREFETCH_ROWS = 24;
+constexpr u64 DEBOUNCE_NS = 100000000;
+constexpr std::size_t FORMER_PRELOAD_BELOW = 2;
+constexpr std::size_t FORMER_FIRST_SCREEN = 4;
+
+// 后台解码的模拟：任务在最早空闲的线程上执行，完成后的下一帧开始时上传 (Background decode model: each request runs on the earliest free worker and is uploaded at the start of the next frame after it finishes)
+class Decoder {
+public:
+    Decoder(std::size_t workers, u64 cost_ns) : m_free_at(workers, 0), m_cost_ns(cost_ns) {}
+
+    bool Submit(std::size_t row, u64 now) {
+        if (m_busy[row]) {
+            return false;
+        }
+        m_busy[row] = true;
+        auto& free_at = *std::ranges::min_element(m_free_at);
+        free_at = std::max(free_at, now) + m_cost_ns;
+        m_pending.push_back({row, free_at});
+        return true;
+    }
+
+    // 上传已完成的图标 (Upload the icons that finished)
+    void Upload(u64 now, std::vector<bool>& resident) {
+        std::erase_if(m_pending, [&](const Pending& pending) {
+            if (pending.done > now) {
+                return false;
+            }
+            resident[pending.row] = true;
+            return true;
+        });
+    }
+
+private:
+    struct Pending {
+        std::size_t row;
+        u64 done;
+    };
+
+    std::vector<u64> m_free_at;
+    u64 m_cost_ns;
+    std::vector<bool> m_busy = std::vector<bool>(ROWS);
+    std::vector<Pending> m_pending;
+};
+
+enum class Prefetch {
+    FORMER,
+    PREDICTED,
+};
+
+struct Sim {
+    Sim(Prefetch prefetch, std::size_t workers, u64 cost_ns) : prefetch(prefetch), decoder(workers, cost_ns) {
+        scroll.SetRowCount(ROWS);
+    }
+
+    Prefetch prefetch;
+    ListScroller scroll{BOX_HEIGHT, BOX_HEIGHT * LIST_ROWS};
+    ResourceLoadManager manager;
+    Decoder decoder;
+    std::vector<bool> resident = std::vector<bool>(ROWS);
+    u64 now{};
+    u64 last_load{};
+    std::pair<std::size_t, std::size_t> last_range{~std::size_t{0}, 0};
+    u64 rows_drawn{};
+    u64 misses{};
+
+    void Submit(std::size_t row, int priority) {
+        ResourceLoadTask task;
+        task.application_id = row;
+        task.priority = priority;
+        task.task_type = ResourceTaskType::ICON;
+        task.load_callback = [this, row] { return decoder.Submit(row, now); };
+        manager.submitLoadTask(task);
+    }
+
+    // 提交前的App::LoadVisibleAreaIcons (App::LoadVisibleAreaIcons before the change)
+    void LoadFormer() {
+        if (now - last_load < DEBOUNCE_NS) {
+            return;
+        }
+        last_load = now;
+        const auto [visible_start, visible_end] = scroll.VisibleRange();
+        if (last_range == std::pair{visible_start, visible_end}) {
+            return;
+        }
+        last_range = {visible_start, visible_end};
+        for (std::size_t i = visible_start; i < std::min(visible_end + FORMER_PRELOAD_BELOW, ROWS); i++) {
+            if (!resident[i]) {
+                Submit(i, i < FORMER_FIRST_SCREEN ? 0 : i < visible_end ? 1 : 2);
+            }
+        }
+    }
+
+    // 与App::LoadVisibleAreaIcons相同 (Same as App::LoadVisibleAreaIcons)
+    void LoadPredicted() {
+        const bool scrolling = scroll.IsMoving();
+        if (!scrolling && now - last_load < DEBOUNCE_NS) {
+            return;
+        }
+        last_load = now;
+        const auto [visible_start, visible_end] = scroll.VisibleRange();
+        auto [load_start, load_end] = scroll.PredictRange(PREFETCH_SECONDS);
+        load_start = std::max(load_start > PRELOAD_ABOVE ? load_start - PRELOAD_ABOVE : 0, visible_start > MAX_PREFETCH_ROWS ? visible_start - MAX_PREFETCH_ROWS : 0);
+        load_end = std::min(std::min(load_end + PRELOAD_BELOW, visible_end + MAX_PREFETCH_ROWS), ROWS);
+        if (last_range == std::pair{load_start, load_end}) {
+            return;
+        }
+        last_range = {load_start, load_end};
+
+        struct LoadInfo {
+            std::size_t row;
+            int priority;
+            std::size_t distance;
+        };
+        std::vector<LoadInfo> load_infos;
+        for (std::size_t i = load_start; i < load_end; i++) {
+            if (!resident[i]) {
+                const std::size_t distance = i < visible_start ? visible_start - i : (i >= visible_end ? i - visible_end + 1 : 0);
+                load_infos.push_back({i, distance == 0 ? 0 : distance <= LIST_ROWS ? 1 : 2, distance});
+            }
+        }
+        manager.reprioritize(ResourceTaskType::ICON, [&load_infos](u64 row) {
+            const auto it = std::ranges::find(load_infos, row, &LoadInfo::row);
+            return it != load_infos.end() ? it->priority : ResourceLoadManager::CANCEL_PRIORITY;
+        });
+        std::ranges::stable_sort(load_infos, {}, &LoadInfo::distance);
+        for (const auto& info : load_infos) {
+            Submit(info.row, info.priority);
+        }
+    }
+
+    // 一帧：上传、推进滚动、预取、出队，再绘制可见行 (One frame: upload, advance the scroll, prefetch, dequeue, then draw the visible rows)
+    void Frame() {
+        decoder.Upload(now, resident);
+        scroll.Update(armNsToTicks(now));
+        prefetch == Prefetch::FORMER ? LoadFormer() : LoadPredicted();
+        manager.processFrameLoads();
+        if (scroll.IsMoving()) {
+            const auto [first, last] = scroll.VisibleRange();
+            for (std::size_t row = first; row < last; row++) {
+                rows_drawn++;
+                misses += resident[row] ? 0 : 1;
+            }
+        }
+        now += FRAME_NS;
+    }
+
+    void Idle(int frames) {
+        for (int i = 0; i < frames; i++) {
+            Frame();
+        }
+    }
+
+    // 手指每帧移动speed像素，正值向下滚动；rest为松开前停顿的帧数，停顿后不惯性滑动 (The finger moves speed pixels per frame, positive scrolls down; rest frames before lifting cancel the fling)
+    void Swipe(float speed, int frames, int rest = 0) {
+        float y = speed > 0 ? 400.f : 80.f;
+        scroll.TouchDown(y, armNsToTicks(now));
+        for (int i = 0; i < frames + rest; i++) {
+            if (i < frames) {
+                y -= speed;
+                scroll.TouchMove(y, armNsToTicks(now));
+            }
+            Frame();
+        }
+        scroll.TouchUp(armNsToTicks(now));
+    }
+
+    // 等待惯性滑动停止 (Wait for the fling to stop)
+    void Coast(int max_frames) {
+        for (int i = 0; i < max_frames && scroll.IsMoving(); i++) {
+            Frame();
+        }
+    }
+};
+
+// 同一组手势 (The same gesture script for every run)
+void Play(Sim& sim) {
+    sim.Idle(30);
+    sim.Swipe(50.f, 6);         // 快速下滑，约3000像素/秒 (Fast fling down, about 3000 px/s)
+    sim.Coast(240);
+    sim.Idle(20);
+    sim.Swipe(20.f, 6);         // 中速下滑 (Medium fling down)
+    sim.Coast(240);
+    sim.Idle(20);
+    sim.Swipe(-50.f, 6);        // 快速上滑 (Fast fling up)
+    sim.Coast(240);
+    sim.Idle(20);
+    sim.Swipe(8.f, 90, 6);      // 慢速拖动后停下 (Slow drag, resting before release)
+    sim.Idle(20);
+    for (int i = 0; i < 6; i++) {
+        sim.Swipe(100.f, 4);    // 连续以最高速度下滑，每次打断上一次 (Repeated flings down at top speed, each interrupting the last)
+        sim.Coast(15);
+    }
+    sim.Coast(240);
+    sim.Idle(20);
+}
+
+// 解码在共享线程池上执行，假定扫描占用一半的工作线程；每个图标的耗时是假定值，不是设备上的测量
+// (Decoding runs on the shared thread pool, assumed half busy with the scan; per-icon costs are assumptions, not device measurements)
+struct Scenario {
+    const char* label;
+    std::size_t workers;
+    u64 cost_ns;
+};
+
+} // namespace
+
+int main() {
+    const Scenario scenarios[] = {
+        {"RGBA cache hit", 2, 2000000},
+        {"JPEG 10 ms", 2, 10000000},
+        {"JPEG 20 ms", 2, 20000000},
+        {"JPEG 40 ms", 2, 40000000},
+    };
+
+    bool ok = true;
+    for (const auto& scenario : scenarios) {
+        double rate[2]{};
+        for (const auto prefetch : {Prefetch::FORMER, Prefetch::PREDICTED}) {
+            Sim sim{prefetch, scenario.workers, scenario.cost_ns};
+            Play(sim);
+            const auto i = static_cast<std::size_t>(prefetch);
+            rate[i] = sim.rows_drawn ? static_cast<double>(sim.misses) / static_cast<double>(sim.rows_drawn) : 0.0;
+            const auto stats = sim.manager.getStats();
+            std::printf("  %-15s %-9s %6llu of %6llu scrolling rows missing their icon (%5.1f%%), %llu run, %llu cancelled\n",
+                scenario.label, prefetch == Prefetch::FORMER ? "former" : "predicted",
+                static_cast<unsigned long long>(sim.misses), static_cast<unsigned long long>(sim.rows_drawn), rate[i] * 100.0,
+                static_cast<unsigned long long>(stats.executed), static_cast<unsigned long long>(stats.cancelled));
+        }
+        if (rate[1] >= rate[0]) {
+            std::printf("  %s: predicted prefetch does not miss less\n", scenario.label);
+            ok = false;
+        }
+    }
+
+    if (!ok) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
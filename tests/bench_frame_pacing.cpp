@@ -0,0 +1,152 @@
+// 帧节奏基准：用真实的FramePacer分别以Sleep和Vsync模式运行主循环，每帧有4到12ms不等的工作，
+// 交换链按配置的深度模拟：提交的帧在之后的垂直同步显示，取得缓冲区要等更早的帧显示。
+// 两种模式各自用WriteReport写出循环间隔的报告，另统计画面实际更新的间隔；Vsync模式显示间隔的方差必须低于Sleep模式
+// Frame pacing benchmark: runs the main loop with the real FramePacer in Sleep and Vsync modes, with 4 to 12 ms of
+// work per frame and a simulated swapchain of the configured depth: a presented frame shows on a later vsync and
+// acquiring a buffer waits for an earlier frame to show. Each mode writes its loop interval report with WriteReport,
+// and the interval between frames actually reaching the screen is measured too; the Vsync variance of that displayed
+// interval must be below Sleep's
+#include "frame_pacer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+constexpr int FRAMES = 240;
+constexpr u64 MIN_WORK_NS = 4000000;
+constexpr u64 MAX_WORK_NS = 12000000;
+// 主循环相对垂直同步的起点是任意的，这里取周期中间 (The loop starts at an arbitrary point of the display period, half way here)
+constexpr u64 START_PHASE_NS = HOST_VSYNC_NS / 2;
+
+void SleepUntil(u64 ns) {
+    const u64 now = hostNowNs();
+    if (ns > now) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds{ns - now});
+    }
+}
+
+// 模拟的交换链：每次垂直同步最多显示一帧，深度为2时取得缓冲区要等上一帧显示 (Simulated swapchain: at most one frame shows per vsync, at depth 2 acquiring waits for the previous frame to show)
+class Swapchain {
+public:
+    explicit Swapchain(unsigned depth) : m_depth(depth) {}
+
+    // 与queue.acquireImage相同，没有空闲缓冲区时阻塞 (Like queue.acquireImage, blocks until a buffer is free)
+    void Acquire() {
+        while (m_shown_at.size() >= m_depth - 1) {
+            SleepUntil(m_shown_at.front());
+            m_shown_at.pop_front();
+        }
+    }
+
+    void Present() {
+        const u64 earliest = m_last_shown ? m_last_shown + HOST_VSYNC_NS : 0;
+        m_last_shown = std::max(hostNextVsyncNs(hostNowNs() + 1), earliest);
+        m_shown_at.push_back(m_last_shown);
+        m_history.push_back(m_last_shown);
+    }
+
+    // 相邻两帧显示的间隔（毫秒） (Intervals between consecutive frames reaching the screen, in ms)
+    std::vector<double> DisplayedIntervals() const {
+        std::vector<double> intervals;
+        for (std::size_t i = 1; i < m_history.size(); i++) {
+            intervals.push_back(static_cast<double>(m_history[i] - m_history[i - 1]) / 1000000.0);
+        }
+        return intervals;
+    }
+
+private:
+    unsigned m_depth;
+    u64 m_last_shown{};
+    std::deque<u64> m_shown_at;     ///< 尚未显示的已提交帧的显示时间 (When the presented frames not yet on screen show)
+    std::vector<u64> m_history;     ///< 每一帧显示的时间 (When every frame showed)
+};
+
+// 与App::Loop相同的顺序：采样输入、更新、取得缓冲区、绘制、提交、等待下一帧 (Same order as App::Loop: sample input, update, acquire, draw, present, wait for the next frame)
+bool Run(PacingMode mode, const char* report_path, double& displayed_variance) {
+    PacingConfig config{};
+    config.mode = mode;
+    FramePacer pacer;
+    pacer.Initialize(config);
+    Swapchain swapchain{pacer.Config().swapchain_depth};
+    std::mt19937 rng{0x50414345};
+    std::uniform_int_distribution<u64> work{MIN_WORK_NS, MAX_WORK_NS};
+
+    SleepUntil(hostNextVsyncNs(hostNowNs() + 1) + START_PHASE_NS);
+    for (int frame = 0; frame < FRAMES; frame++) {
+        const u64 frame_begin_tick = armGetSystemTick();
+        pacer.InputSampled(frame % 10 == 0);
+        const u64 frame_work = work(rng);
+        std::this_thread::sleep_for(std::chrono::nanoseconds{frame_work / 2});
+        swapchain.Acquire();
+        std::this_thread::sleep_for(std::chrono::nanoseconds{frame_work - frame_work / 2});
+        swapchain.Present();
+        pacer.Presented();
+        pacer.WaitNextFrame(frame_begin_tick);
+    }
+
+    if (!pacer.WriteReport(report_path)) {
+        std::printf("  cannot write %s\n", report_path);
+        return false;
+    }
+    std::FILE* file = std::fopen(report_path, "r");
+    if (!file) {
+        return false;
+    }
+    char line[160];
+    bool found = false;
+    double loop_variance = 0.0;
+    while (std::fgets(line, sizeof(line), file)) {
+        std::printf("  %s", line);
+        found |= std::sscanf(line, "frame_ms mean=%*f variance=%lf", &loop_variance) == 1;
+    }
+    std::fclose(file);
+    if (!found) {
+        std::printf("  no frame variance in %s\n", report_path);
+        return false;
+    }
+
+    // 同一帧显示两个周期即为一次卡顿 (A frame held on screen for two periods is a stutter)
+    const auto intervals = swapchain.DisplayedIntervals();
+    double mean = 0.0;
+    std::size_t repeated = 0;
+    for (const double ms : intervals) {
+        mean += ms;
+        repeated += ms > 1.5 * HOST_VSYNC_NS / 1000000.0 ? 1 : 0;
+    }
+    mean /= static_cast<double>(intervals.size());
+    displayed_variance = 0.0;
+    for (const double ms : intervals) {
+        displayed_variance += (ms - mean) * (ms - mean);
+    }
+    displayed_variance /= static_cast<double>(intervals.size());
+    std::printf("  displayed_ms frames=%zu mean=%.3f variance=%.4f repeated_vsyncs=%zu\n",
+        intervals.size() + 1, mean, displayed_variance, repeated);
+    return true;
+}
+
+} // namespace
+
+int main() {
+    double sleep_variance = 0.0;
+    double vsync_variance = 0.0;
+    bool ok = Run(PacingMode::Sleep, "build/frame_pacing_sleep.txt", sleep_variance);
+    ok &= Run(PacingMode::Vsync, "build/frame_pacing_vsync.txt", vsync_variance);
+    std::printf("  displayed frame interval variance: sleep %.4f ms^2, vsync %.4f ms^2\n", sleep_variance, vsync_variance);
+    if (ok && vsync_variance >= sleep_variance) {
+        std::printf("  vsync pacing does not reach the screen more steadily than sleep pacing\n");
+        ok = false;
+    }
+    if (!ok) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+// 应用ID索引基准：在不同应用数量下比较IdIndex查找与std::find_if线性查找的单次耗时，以及重建索引的耗时
+// Application id index benchmark: per-lookup cost of IdIndex against a linear std::find_if at several title counts, plus the rebuild cost
+#include "id_index.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t LOOKUPS = 1 << 20;
+
+double NanosecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+bool Run(std::size_t title_count) {
+    // 与真实应用ID相似：0x0100开头，低12位为0 (Shaped like real application ids: 0x0100 prefix, low 12 bits clear)
+    std::mt19937_64 rng{title_count};
+    std::vector<u64> ids(title_count);
+    for (auto& id : ids) {
+        id = 0x0100000000000000ULL | ((rng() & 0xFFFFFFFFFFFULL) << 12);
+    }
+
+    IdIndex index;
+    auto start = Clock::now();
+    index.Rebuild(ids, [](u64 id) { return id; });
+    const double rebuild_ns = NanosecondsSince(start);
+
+    // 一半命中一半未命中，顺序随机 (Half hits and half misses, in random order)
+    std::vector<u64> queries(LOOKUPS);
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        queries[i] = i % 2 ? ids[rng() % ids.size()] : (ids[rng() % ids.size()] | 0x800);
+    }
+
+    std::size_t hits = 0;
+    start = Clock::now();
+    for (const auto id : queries) {
+        const auto slot = index.Find(id);
+        hits += slot != IdIndex::NPOS && ids[slot] == id;
+    }
+    const double index_ns = NanosecondsSince(start) / static_cast<double>(queries.size());
+
+    // 线性查找按应用数量减少次数，总耗时保持相近 (Linear lookups are scaled down with the title count to keep the run short)
+    const std::size_t linear_lookups = std::max<std::size_t>(64, LOOKUPS / title_count);
+    std::size_t linear_hits = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < linear_lookups; i++) {
+        const auto id = queries[i];
+        linear_hits += std::find_if(ids.begin(), ids.end(), [id](u64 other) { return other == id; }) != ids.end();
+    }
+    const double linear_ns = NanosecondsSince(start) / static_cast<double>(linear_lookups);
+
+    std::printf("  %6zu titles  index %6.1f ns/lookup  find_if %10.1f ns/lookup  rebuild %8.1f us\n",
+        title_count, index_ns, linear_ns, rebuild_ns / 1000.0);
+
+    // 每个奇数下标的查询都命中 (Every odd query is a hit)
+    const std::size_t expected_linear = linear_lookups / 2;
+    if (hits != LOOKUPS / 2 || linear_hits != expected_linear) {
+        std::printf("  %zu index hits, expected %zu; %zu linear hits, expected %zu\n", hits, LOOKUPS / 2, linear_hits, expected_linear);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    for (const std::size_t title_count : {10, 100, 1000, 10000, 100000}) {
+        if (!Run(title_count)) {
+            std::printf("FAILED\n");
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+// 扫描器吞吐量基准：AppScanner对模拟应用信息服务扫描10、1000和10000个应用，报告每秒应用数
+// Scanner throughput benchmark: AppScanner scans 10, 1000 and 10000 titles from the mock title service and reports titles/sec
+#include "app_scanner.hpp"
+#include "app_entry.hpp"
+#include "title_service_mock.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stop_token>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+struct Case {
+    const char* profile_name;
+    MockLatencyProfile profile;
+    std::size_t title_count;
+    std::size_t workers;
+};
+
+// 与App::FetchAppMetadata相同：读取控制数据，失败即为损坏的安装 (Same as App::FetchAppMetadata: read control data, failure means a corrupted install)
+bool FetchMetadata(TitleService& service, u64 application_id, AppEntry& entry) {
+    entry.id = application_id;
+    // NsApplicationControlData约132KB，放在堆上 (NsApplicationControlData is about 132KB, keep it on the heap)
+    auto control = std::make_unique<NsApplicationControlData>();
+    u64 size = 0;
+    if (R_FAILED(service.GetApplicationControlData(application_id, control.get(), &size))) {
+        entry.corrupted = true;
+        return false;
+    }
+    const auto& lang = control->nacp.lang[0];
+    entry.name.assign(lang.name, strnlen(lang.name, sizeof(lang.name)));
+    entry.author.assign(lang.author, strnlen(lang.author, sizeof(lang.author)));
+    entry.icon_hash = size;
+    return true;
+}
+
+// 与App::GetAppSizeInfo相同的按存储设备求和 (Sums per storage device the same way as App::GetAppSizeInfo)
+void FetchSize(TitleService& service, u64 application_id, AppEntry& entry) {
+    ApplicationOccupiedSize size{};
+    entry.size_nand = entry.size_sd = 0;
+    if (R_SUCCEEDED(service.CalculateApplicationOccupiedSize(application_id, &size))) {
+        for (const auto& e : size.entry) {
+            const auto total = e.sizeApplication + e.sizeAddOnContent + e.sizePatch;
+            if (e.storageId == NcmStorageId_BuiltInUser) {
+                entry.size_nand = total;
+            } else if (e.storageId == NcmStorageId_SdCard) {
+                entry.size_sd = total;
+            }
+        }
+    }
+    entry.size_total = entry.size_nand + entry.size_sd;
+}
+
+bool Run(const Case& test) {
+    MockTitleServiceConfig service_config{};
+    service_config.title_count = test.title_count;
+    service_config.corrupted_every = 50;
+    service_config.latency = test.profile;
+    MockTitleService service{service_config};
+
+    std::vector<u64> app_ids;
+    app_ids.reserve(test.title_count);
+    std::array<NsApplicationRecord, 30> page;
+    s32 count = 0;
+    s32 offset = 0;
+    do {
+        if (R_FAILED(service.ListApplicationRecords(page.data(), static_cast<s32>(page.size()), offset, &count))) {
+            return false;
+        }
+        for (s32 i = 0; i < count; i++) {
+            app_ids.push_back(page[i].application_id);
+        }
+        offset += count;
+    } while (count > 0);
+
+    ScanConfig config{};
+    config.metadata_workers = test.workers;
+    config.size_workers = test.workers;
+    AppScanner scanner{config};
+
+    std::size_t merged = 0;
+    std::size_t corrupted = 0;
+    const auto stats = scanner.Run(std::stop_token{}, app_ids,
+        [&service](u64 application_id, AppEntry& entry) { return FetchMetadata(service, application_id, entry); },
+        [&service](u64 application_id, AppEntry& entry) { FetchSize(service, application_id, entry); },
+        // 合并回调在单个线程上调用 (The merge callback runs on a single thread)
+        [&merged, &corrupted](std::vector<AppEntry>&& batch) {
+            merged += batch.size();
+            for (const auto& entry : batch) {
+                corrupted += entry.corrupted;
+            }
+        });
+
+    std::printf("  %-8s %6zu titles %zu+%zu workers %10.2f ms %12.0f titles/s %5zu batches\n",
+        test.profile_name, test.title_count, test.workers, test.workers,
+        stats.elapsed.count() / 1000.0, stats.TitlesPerSecond(), stats.batches);
+
+    if (merged != test.title_count || stats.titles != test.title_count || corrupted != test.title_count / 50) {
+        std::printf("  merged %zu titles (%zu corrupted), expected %zu (%zu corrupted)\n",
+            merged, corrupted, test.title_count, test.title_count / 50);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const auto instant = MockLatencyProfile::Instant();
+    const auto typical = MockLatencyProfile::Typical();
+    // instant测量扫描器自身的开销，typical测量工作线程对NS延迟的并行效果
+    // instant measures the scanner's own overhead, typical measures how well the workers overlap NS latency
+    const Case cases[] = {
+        {"instant", instant, 10, 1},
+        {"instant", instant, 10, 2},
+        {"instant", instant, 1000, 1},
+        {"instant", instant, 1000, 2},
+        {"instant", instant, 10000, 1},
+        {"instant", instant, 10000, 2},
+        {"typical", typical, 10, 1},
+        {"typical", typical, 10, 2},
+        {"typical", typical, 200, 1},
+        {"typical", typical, 200, 2},
+        {"typical", typical, 200, 4},
+    };
+    for (const auto& test : cases) {
+        if (!Run(test)) {
+            std::printf("FAILED\n");
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+// 搜索索引基准：10000个合成应用（拉丁、带重音、全角和CJK名称），逐键输入并退格，报告每次按键的查询耗时，
+// 任何按键超出预算即失败
+// Search index benchmark: 10000 synthetic titles (Latin, accented, full-width and CJK names), typed one key at a time
+// and backspaced again, reporting the query time per keystroke and failing if any keystroke is over budget
+#include "title_search.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t TITLES = 10000;
+constexpr double BUDGET_US = 1000.0;    // 每次按键的预算 (Per-keystroke budget)
+// 每次输入重复几遍，按键取最快的一次，排除调度造成的偶发停顿 (Every session is typed several times and each keystroke keeps its fastest run, ruling out one-off scheduler stalls)
+constexpr int RUNS = 5;
+
+const char* const SERIES[] = {
+    "The Legend of Zelda", "Super Mario", "Mario Kart", "Pokémon", "Fire Emblem", "Xenoblade Chronicles",
+    "Animal Crossing", "Splatoon", "Metroid", "Kirby", "ゼルダの伝説", "スーパーマリオ", "ポケモン",
+    "どうぶつの森", "塞尔达传说", "马力欧赛车", "ＦＩＮＡＬ ＦＡＮＴＡＳＹ", "Dragon Quest",
+};
+const char* const SUFFIXES[] = {
+    "Deluxe", "Odyssey", "Wonder", "Tears of the Kingdom", "Édition Spéciale", "Remastered", "3D World", "Arceus",
+};
+const char* const AUTHORS[] = {
+    "Nintendo", "Game Freak", "Monolith Soft", "任天堂", "ＳＥＧＡ", "Square Enix", "Intelligent Systems",
+};
+
+struct Title {
+    u64 id;
+    std::string name;
+    std::string author;
+};
+
+std::vector<Title> MakeTitles() {
+    std::mt19937 rng{0x554E5449};
+    std::vector<Title> titles(TITLES);
+    for (std::size_t i = 0; i < titles.size(); i++) {
+        titles[i].id = 0x0100000000000000ULL + (i + 1) * 0x1000;
+        titles[i].name = std::string{SERIES[rng() % std::size(SERIES)]} + " " + SUFFIXES[rng() % std::size(SUFFIXES)] + " " + std::to_string(i);
+        titles[i].author = AUTHORS[rng() % std::size(AUTHORS)];
+    }
+    return titles;
+}
+
+// 按UTF-8字符逐个输入，再逐个退格 (Type one UTF-8 character at a time, then backspace one at a time)
+std::vector<std::string> Keystrokes(const std::string& query) {
+    std::vector<std::string> prefixes;
+    for (std::size_t i = 1; i <= query.size(); i++) {
+        if (i == query.size() || (static_cast<unsigned char>(query[i]) & 0xC0) != 0x80) {
+            prefixes.push_back(query.substr(0, i));
+        }
+    }
+    std::vector<std::string> keystrokes = prefixes;
+    for (auto it = prefixes.rbegin() + 1; it != prefixes.rend(); ++it) {
+        keystrokes.push_back(*it);
+    }
+    return keystrokes;
+}
+
+struct Session {
+    const char* query;
+    std::size_t expect_at_least;    // 完整查询至少命中的数量 (Minimum hits for the full query)
+};
+
+} // namespace
+
+int main() {
+    const auto titles = MakeTitles();
+
+    TitleSearchIndex index;
+    auto start = Clock::now();
+    for (const auto& title : titles) {
+        index.Upsert(title.id, title.name, title.author);
+    }
+    const double build_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::printf("%zu titles indexed in %.2f ms\n", index.Size(), build_ms);
+
+    const Session sessions[] = {
+        {"zelda", 1},
+        {"mario kart", 1},
+        {"pokemon", 1},         // 去掉重音后匹配Pokémon (Matches Pokémon once accents are stripped)
+        {"ｍａｒｉｏ", 1},      // 全角输入 (Full-width input)
+        {"ぜるだ", 1},          // 平假名匹配片假名 (Hiragana matches katakana)
+        {"塞尔达", 1},
+        {"final fantasy", 1},
+        {"edition speciale", 1},
+        {"xenoblde", 1},        // 拼写错误，模糊匹配 (Misspelt, fuzzy match)
+        {"nintendo", 1},        // 只匹配发行商 (Publisher only)
+        {"qzxv", 0},
+    };
+
+    bool ok = true;
+    double worst_us = 0;
+    std::size_t over_budget = 0;
+    for (const auto& session : sessions) {
+        const auto keystrokes = Keystrokes(session.query);
+        std::vector<double> best_us(keystrokes.size(), 1e30);
+        std::size_t full_hits = 0;
+        for (int run = 0; run < RUNS; run++) {
+            index.Search({});   // 清空搜索框，开始新的输入 (Clear the search box, starting a fresh session)
+            for (std::size_t key = 0; key < keystrokes.size(); key++) {
+                start = Clock::now();
+                const auto hits = index.Search(keystrokes[key]).size();
+                best_us[key] = std::min(best_us[key], std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+                if (keystrokes[key] == session.query) {
+                    full_hits = hits;
+                }
+            }
+        }
+        double total_us = 0;
+        double session_worst_us = 0;
+        for (const double us : best_us) {
+            total_us += us;
+            session_worst_us = std::max(session_worst_us, us);
+            over_budget += us > BUDGET_US;
+        }
+        worst_us = std::max(worst_us, session_worst_us);
+        std::printf("  %2zu keys  avg %7.1f us  worst %7.1f us  %5zu hits  \"%s\"\n",
+            keystrokes.size(), total_us / static_cast<double>(keystrokes.size()), session_worst_us, full_hits, session.query);
+        if (full_hits < session.expect_at_least || (session.expect_at_least == 0 && full_hits != 0)) {
+            std::printf("  expected %s hits for \"%s\"\n", session.expect_at_least ? "some" : "no", session.query);
+            ok = false;
+        }
+    }
+    std::printf("  worst keystroke %.1f us, %zu over the %.0f us budget\n", worst_us, over_budget, BUDGET_US);
+    if (over_budget) {
+        ok = false;
+    }
+
+    // 删除后的应用不再出现在结果中 (Removed titles no longer show up in the results)
+    const std::vector<u64> removed = index.Search("zelda");
+    index.Remove(removed);
+    if (std::ranges::any_of(index.Search("zelda"), [&removed](u64 id) { return std::ranges::find(removed, id) != removed.end(); })) {
+        std::printf("  removed titles still found\n");
+        ok = false;
+    }
+
+    if (!ok) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
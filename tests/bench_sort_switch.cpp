@@ -0,0 +1,212 @@
+// 切换排序的卡顿基准：10000个多语言应用，按Y键的顺序轮换全部12种排序，每次切换包括重排和重建渲染线程的视图，
+// 与原先按字节排序std::vector<AppEntry>以及每次比较都生成排序键的做法对比；另测排序后扫描逐个插入新应用的耗时。
+// 任何一次切换或插入超出预算即失败
+// Sort switch stall benchmark: 10000 multilingual titles cycle through all 12 sort modes in Y-button order, each switch
+// re-sorting and rebuilding the render thread's view, against the former byte-wise sort of std::vector<AppEntry> and a
+// locale-aware sort that builds keys on every comparison; also times the scan inserting titles one by one once sorted.
+// Fails if any switch or insert is over budget
+#include "app_entry.hpp"
+#include "collation.hpp"
+#include "title_list_view.hpp"
+#include "title_table.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t TITLES = 10000;
+constexpr std::size_t INSERTS = 1000;      // 排序后到达的应用 (Titles arriving after the sort)
+constexpr std::size_t ICON_BYTES = 4096;
+// 每项取最快的一轮，排除调度造成的偶发停顿 (Every measurement keeps its fastest round, ruling out one-off scheduler stalls)
+constexpr int RUNS = 5;
+// 在主机上一次切换不能超过一帧；主机时间不能直接换算到Switch (On the host a switch must fit in one frame; host timings do not carry over to the Switch directly)
+constexpr double SWITCH_BUDGET_US = 16667.0;
+constexpr double INSERT_BUDGET_US = 100.0;
+
+// 与App的SORT_MODES顺序相同 (Same order as App's SORT_MODES)
+struct Mode {
+    TitleTable::SortKey key;
+    bool descending;
+    const char* label;
+};
+constexpr Mode MODES[] = {
+    {TitleTable::SortKey::SIZE, true, "size desc"},
+    {TitleTable::SortKey::SIZE, false, "size asc"},
+    {TitleTable::SortKey::NAME, false, "name A-Z"},
+    {TitleTable::SortKey::NAME, true, "name Z-A"},
+    {TitleTable::SortKey::NAND, true, "NAND desc"},
+    {TitleTable::SortKey::NAND, false, "NAND asc"},
+    {TitleTable::SortKey::SD, true, "SD desc"},
+    {TitleTable::SortKey::SD, false, "SD asc"},
+    {TitleTable::SortKey::AUTHOR, false, "author A-Z"},
+    {TitleTable::SortKey::AUTHOR, true, "author Z-A"},
+    {TitleTable::SortKey::ID, false, "id asc"},
+    {TitleTable::SortKey::ID, true, "id desc"},
+};
+
+double MicrosecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+std::vector<AppEntry> MakeEntries(std::size_t count, u64 seed) {
+    static const char* const words[] = {
+        "Super", "Mario", "Zelda", "Légende", "Kart", "Éclair", "Tetris", "Ñandú", "Пингвин", "Дракон",
+        "ゼルダの伝説", "スーパーマリオ", "ぽけもん", "塞尔达传说", "马力欧", "ＦＩＮＡＬ", "Xenoblade", "Pikmin", "Kirby", "2",
+    };
+    static const char* const authors[] = {
+        "Nintendo", "Game Freak", "任天堂", "ＳＥＧＡ", "Square Enix", "Éditions Lumière", "Акелла", "acme",
+    };
+    std::mt19937_64 rng{seed};
+    std::vector<AppEntry> entries(count);
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        auto& entry = entries[i];
+        entry.id = 0x0100000000000000ULL | ((rng() & 0xFFFFFFFFFFFULL) << 12);
+        entry.name = std::string{words[rng() % std::size(words)]} + " " + words[rng() % std::size(words)] + " " + std::to_string(i);
+        entry.author = authors[rng() % std::size(authors)];
+        entry.size_nand = (rng() % 4096) * 1024 * 1024;
+        entry.size_sd = (rng() % 16384) * 1024 * 1024;
+        entry.size_total = entry.size_nand + entry.size_sd;
+        entry.cached_icon_data.assign(ICON_BYTES, static_cast<unsigned char>(i));
+        entry.has_cached_icon = true;
+    }
+    return entries;
+}
+
+// 与App::PublishTitleList相同，切换排序后同一帧内重建视图 (Same as App::PublishTitleList, the view is rebuilt in the same frame as the switch)
+std::size_t BuildView(const TitleTable& table) {
+    TitleListView view{};
+    view.rows.reserve(table.Size());
+    for (std::size_t row = 0; row < table.Size(); row++) {
+        view.rows.push_back(TitleRow{table.Id(row), table.Name(row), table.SizeNand(row), table.SizeSd(row),
+            table.SizeTotal(row), table.IsSelected(row), table.IsCorrupted(row)});
+    }
+    view.index.Rebuild(view.rows, [](const TitleRow& row) { return row.id; });
+    return view.rows.size();
+}
+
+} // namespace
+
+int main() {
+    const auto source = MakeEntries(TITLES, 0x554E5449);
+    bool ok = true;
+
+    // 原先的做法：对整个AppEntry按字节排序名称，顺序对日文、中文和重音字母是错的 (Former approach: byte-wise name sort moving whole AppEntry objects, wrong for Japanese, Chinese and accents)
+    double byte_sort_us = 1e30;
+    double keyless_sort_us = 1e30;
+    for (int run = 0; run < RUNS; run++) {
+        auto entries = source;
+        auto start = Clock::now();
+        std::ranges::sort(entries, {}, &AppEntry::name);
+        byte_sort_us = std::min(byte_sort_us, MicrosecondsSince(start));
+
+        // 正确的顺序但每次比较都生成排序键 (The right order, but building keys on every comparison)
+        entries = source;
+        start = Clock::now();
+        std::ranges::sort(entries, [](const AppEntry& a, const AppEntry& b) {
+            return MakeCollationKey(a.name, CollationLocale::ROOT) < MakeCollationKey(b.name, CollationLocale::ROOT);
+        });
+        keyless_sort_us = std::min(keyless_sort_us, MicrosecondsSince(start));
+    }
+
+    // 与App::FastScanNames相同，按应用总数预留 (Same as App::FastScanNames, reserved for the title count)
+    TitleTable table;
+    table.SetCollation(CollationLocale::ROOT);
+    table.Reset(TITLES + INSERTS);
+    auto start = Clock::now();
+    for (auto entry : source) {
+        table.Append(std::move(entry));
+    }
+    const double fill_us = MicrosecondsSince(start);
+
+    // 第一轮的名称和发行商排序还要比较完整排序键并记下名次，单独报告 (The first round's name and publisher sorts still compare full keys and record ranks, reported separately)
+    double first_us[std::size(MODES)];
+    double best_us[std::size(MODES)];
+    std::ranges::fill(best_us, 1e30);
+    for (int run = 0; run < RUNS; run++) {
+        for (std::size_t mode = 0; mode < std::size(MODES); mode++) {
+            start = Clock::now();
+            table.Sort(MODES[mode].key, MODES[mode].descending);
+            if (BuildView(table) != TITLES) {
+                ok = false;
+            }
+            const double us = MicrosecondsSince(start);
+            if (run == 0) {
+                first_us[mode] = us;
+            }
+            best_us[mode] = std::min(best_us[mode], us);
+        }
+    }
+
+    std::printf("%zu titles, %zu byte icons (TitleTable filled with keys in %.1f ms)\n", TITLES, ICON_BYTES, fill_us / 1000.0);
+    std::printf("  before: byte-wise vector<AppEntry> name sort %8.1f us, keys built per comparison %8.1f us\n",
+        byte_sort_us, keyless_sort_us);
+    double worst_us = 0;
+    for (std::size_t mode = 0; mode < std::size(MODES); mode++) {
+        std::printf("  Y -> %-10s sort + view %8.1f us (first %8.1f us)\n", MODES[mode].label, best_us[mode], first_us[mode]);
+        worst_us = std::max(worst_us, best_us[mode]);
+    }
+
+    // 按名称排序后扫描继续到达的应用，每个二分插入；每轮从同一张表开始 (Titles the scan delivers after a name sort, each binary-inserted; every round starts from the same table)
+    table.Sort(TitleTable::SortKey::NAME, false);
+    const auto arrivals = MakeEntries(INSERTS, 0x494E5352);
+    std::vector<double> insert_us(INSERTS, 1e30);
+    for (int run = 0; run < RUNS; run++) {
+        TitleTable scan_table;
+        scan_table.SetCollation(CollationLocale::ROOT);
+        scan_table.Reset(TITLES + INSERTS);
+        for (auto entry : source) {
+            scan_table.Append(std::move(entry));
+        }
+        scan_table.Sort(TitleTable::SortKey::NAME, false);
+        for (std::size_t i = 0; i < INSERTS; i++) {
+            auto entry = arrivals[i];
+            start = Clock::now();
+            scan_table.Append(std::move(entry));
+            insert_us[i] = std::min(insert_us[i], MicrosecondsSince(start));
+        }
+    }
+    for (auto entry : arrivals) {
+        table.Append(std::move(entry));
+    }
+    double insert_worst_us = 0;
+    double insert_total_us = 0;
+    for (const double us : insert_us) {
+        insert_total_us += us;
+        insert_worst_us = std::max(insert_worst_us, us);
+    }
+    std::printf("  %zu sorted inserts: avg %.2f us, worst %.2f us\n", INSERTS, insert_total_us / INSERTS, insert_worst_us);
+
+    // 插入后的顺序必须与重新排序一致 (The order after inserting must match a fresh sort)
+    std::vector<u64> inserted_order;
+    for (std::size_t row = 0; row < table.Size(); row++) {
+        inserted_order.push_back(table.Id(row));
+    }
+    table.Sort(TitleTable::SortKey::NAME, false);
+    for (std::size_t row = 0; row < table.Size(); row++) {
+        if (table.Id(row) != inserted_order[row]) {
+            std::printf("  inserted order differs from a full sort at row %zu\n", row);
+            ok = false;
+            break;
+        }
+    }
+
+    std::printf("  worst switch %.1f us (budget %.0f us), worst insert %.2f us (budget %.0f us)\n",
+        worst_us, SWITCH_BUDGET_US, insert_worst_us, INSERT_BUDGET_US);
+    if (worst_us > SWITCH_BUDGET_US || insert_worst_us > INSERT_BUDGET_US) {
+        ok = false;
+    }
+    if (!ok) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
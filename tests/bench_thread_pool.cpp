@@ -0,0 +1,96 @@
+// 线程池基准：比较util::async在线程池上提交任务与std::async(std::launch::async)每次创建线程的延迟和吞吐量
+// Thread pool benchmark: task spawn latency and throughput of util::async on the pool against std::async(std::launch::async), which starts a thread per call
+#include "async.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <stop_token>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t LATENCY_CALLS = 2000;
+constexpr std::size_t THROUGHPUT_TASKS = 20000;
+
+// 传入线程池而没有函数时不能匹配任何重载，而不是无限递归 (Passing a pool without a function matches no overload instead of recursing forever)
+template<typename Pool>
+concept CanAsyncWithoutFn = requires(Pool& pool) { util::async(pool); };
+static_assert(!CanAsyncWithoutFn<util::ThreadPool>);
+
+struct Latency {
+    double spawn_us{};      // 提交到任务开始运行 (Submit until the task starts running)
+    double round_trip_us{}; // 提交到取得结果 (Submit until the result is back)
+    double worst_spawn_us{};
+};
+
+template<typename Spawn>
+Latency MeasureLatency(Spawn spawn) {
+    Latency latency{};
+    for (std::size_t i = 0; i < LATENCY_CALLS; i++) {
+        const auto submitted = Clock::now();
+        auto future = spawn([]() { return Clock::now(); });
+        const auto started = future.get();
+        const auto done = Clock::now();
+        const double spawn_us = std::chrono::duration<double, std::micro>(started - submitted).count();
+        latency.spawn_us += spawn_us;
+        latency.round_trip_us += std::chrono::duration<double, std::micro>(done - submitted).count();
+        latency.worst_spawn_us = std::max(latency.worst_spawn_us, spawn_us);
+    }
+    latency.spawn_us /= LATENCY_CALLS;
+    latency.round_trip_us /= LATENCY_CALLS;
+    return latency;
+}
+
+// 一次提交大量小任务再全部等待，返回每秒任务数 (Submit many small tasks at once then wait for all, returns tasks/s)
+template<typename Spawn>
+double MeasureThroughput(Spawn spawn, std::size_t& sum) {
+    using Future = decltype(spawn([]() { return std::size_t{}; }));
+    std::vector<Future> futures;
+    futures.reserve(THROUGHPUT_TASKS);
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < THROUGHPUT_TASKS; i++) {
+        futures.emplace_back(spawn([i]() { return i; }));
+    }
+    sum = 0;
+    for (auto& future : futures) {
+        sum += future.get();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return seconds > 0 ? THROUGHPUT_TASKS / seconds : 0.0;
+}
+
+void Report(const char* path, const Latency& latency, double tasks_per_second) {
+    std::printf("  %-22s spawn %8.2f us (worst %9.2f)  round trip %8.2f us  %10.0f tasks/s\n",
+        path, latency.spawn_us, latency.worst_spawn_us, latency.round_trip_us, tasks_per_second);
+}
+
+} // namespace
+
+int main() {
+    util::ThreadPool pool{util::ThreadPoolConfig{.worker_count = 4}};
+    const auto pool_spawn = [&pool](auto fn) { return util::async(pool, std::move(fn)); };
+    const auto thread_spawn = [](auto fn) { return std::async(std::launch::async, std::move(fn)); };
+
+    std::size_t pool_sum = 0;
+    std::size_t thread_sum = 0;
+    const auto pool_latency = MeasureLatency(pool_spawn);
+    const auto pool_throughput = MeasureThroughput(pool_spawn, pool_sum);
+    const auto thread_latency = MeasureLatency(thread_spawn);
+    const auto thread_throughput = MeasureThroughput(thread_spawn, thread_sum);
+
+    std::printf("%zu sequential calls, %zu queued tasks, %zu pool workers\n", LATENCY_CALLS, THROUGHPUT_TASKS, pool.worker_count());
+    Report("util::async (pool)", pool_latency, pool_throughput);
+    Report("std::async (thread)", thread_latency, thread_throughput);
+
+    // 两条路径都必须运行每个任务 (Both paths must run every task)
+    const std::size_t expected = THROUGHPUT_TASKS * (THROUGHPUT_TASKS - 1) / 2;
+    if (pool_sum != expected || thread_sum != expected) {
+        std::printf("FAILED: sums %zu and %zu, expected %zu\n", pool_sum, thread_sum, expected);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// 模拟应用信息服务的基准：在10、1000和10000个应用下测量列出记录、读取元数据和大小、删除的耗时
+// Mock title service benchmark: times record listing, metadata and size queries, and deletion at 10, 1000 and 10000 titles
+#include "title_service_mock.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void Report(const char* stage, std::size_t titles, double ms) {
+    std::printf("  %-10s %6zu titles %10.2f ms %12.0f titles/s\n", stage, titles, ms, ms > 0 ? titles * 1000.0 / ms : 0.0);
+}
+
+// 与App::GetAllApplicationRecords相同的分页方式 (Pages the same way as App::GetAllApplicationRecords)
+bool ListAll(TitleService& service, std::vector<NsApplicationRecord>& records) {
+    std::array<NsApplicationRecord, 30> page;
+    s32 count = 0;
+    s32 offset = 0;
+    records.clear();
+    do {
+        if (R_FAILED(service.ListApplicationRecords(page.data(), static_cast<s32>(page.size()), offset, &count))) {
+            return false;
+        }
+        records.insert(records.end(), page.begin(), page.begin() + count);
+        offset += count;
+    } while (count > 0);
+    return true;
+}
+
+bool Run(std::size_t title_count) {
+    MockTitleServiceConfig config{};
+    config.title_count = title_count;
+    config.corrupted_every = 50;
+    MockTitleService service{config};
+    std::printf("%zu titles (instant latency profile)\n", title_count);
+
+    std::vector<NsApplicationRecord> records;
+    auto start = Clock::now();
+    if (!ListAll(service, records) || records.size() != title_count) {
+        std::printf("  list returned %zu records, expected %zu\n", records.size(), title_count);
+        return false;
+    }
+    Report("list", records.size(), MillisecondsSince(start));
+
+    // NsApplicationControlData约132KB，放在堆上 (NsApplicationControlData is about 132KB, keep it on the heap)
+    auto control = std::make_unique<NsApplicationControlData>();
+    std::size_t corrupted = 0;
+    start = Clock::now();
+    for (const auto& record : records) {
+        u64 size = 0;
+        if (R_FAILED(service.GetApplicationControlData(record.application_id, control.get(), &size))) {
+            corrupted++;
+        }
+    }
+    Report("metadata", records.size(), MillisecondsSince(start));
+    if (corrupted != title_count / 50) {
+        std::printf("  %zu corrupted titles, expected %zu\n", corrupted, title_count / 50);
+        return false;
+    }
+
+    start = Clock::now();
+    for (const auto& record : records) {
+        ApplicationOccupiedSize size{};
+        if (R_FAILED(service.CalculateApplicationOccupiedSize(record.application_id, &size))) {
+            return false;
+        }
+    }
+    Report("size", records.size(), MillisecondsSince(start));
+
+    start = Clock::now();
+    for (const auto& record : records) {
+        if (R_FAILED(service.DeleteApplicationCompletely(record.application_id))) {
+            return false;
+        }
+    }
+    Report("delete", records.size(), MillisecondsSince(start));
+
+    // 删除后列表为空 (The list is empty after deleting everything)
+    return ListAll(service, records) && records.empty();
+}
+
+} // namespace
+
+int main() {
+    for (const std::size_t title_count : {10, 1000, 10000}) {
+        if (!Run(title_count)) {
+            std::printf("FAILED\n");
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// 应用列表布局基准：10000个应用时，比较TitleTable按列存储的排序与原先对std::vector<AppEntry>的std::ranges::sort，
+// 以及每帧遍历大小的耗时
+// Title list layout benchmark: at 10000 titles, compares sorting the column-wise TitleTable against the former
+// std::ranges::sort over std::vector<AppEntry>, plus the per-frame pass over sizes
+#include "title_table.hpp"
+#include "app_entry.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t TITLES = 10000;
+constexpr std::size_t ICON_BYTES = 4096;    // 缓存的JPEG图标大小 (Size of the cached JPEG icon)
+constexpr int RUNS = 5;
+
+double MicrosecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+std::vector<AppEntry> MakeEntries() {
+    static const char* const words[] = {
+        "Super", "Mario", "Zelda", "Légende", "Kart", "Party", "Tetris", "Ñandú", "Пингвин", "Dragon",
+        "Quest", "Xenoblade", "Metroid", "Pikmin", "Kirby", "Splatoon", "Animal", "Crossing", "Fire", "Emblem",
+    };
+    std::mt19937_64 rng{0x554E5449};
+    std::vector<AppEntry> entries(TITLES);
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        auto& entry = entries[i];
+        entry.id = 0x0100000000000000ULL | ((rng() & 0xFFFFFFFFFFFULL) << 12);
+        entry.name = std::string{words[rng() % 20]} + " " + words[rng() % 20] + " " + std::to_string(i);
+        entry.author = words[rng() % 20];
+        entry.display_version = "1.0." + std::to_string(rng() % 10);
+        entry.size_nand = (rng() % 4096) * 1024 * 1024;
+        entry.size_sd = (rng() % 16384) * 1024 * 1024;
+        entry.size_total = entry.size_nand + entry.size_sd;
+        entry.cached_icon_data.assign(ICON_BYTES, static_cast<unsigned char>(i));
+        entry.has_cached_icon = true;
+    }
+    return entries;
+}
+
+struct Timing {
+    double total{};
+    double best{1e30};
+
+    void Add(double us) {
+        total += us;
+        best = std::min(best, us);
+    }
+};
+
+void Report(const char* what, const Timing& vector_time, const Timing& table_time) {
+    std::printf("  %-14s vector<AppEntry> %9.1f us (best %9.1f)   TitleTable %9.1f us (best %9.1f)\n",
+        what, vector_time.total / RUNS, vector_time.best, table_time.total / RUNS, table_time.best);
+}
+
+} // namespace
+
+int main() {
+    const auto source = MakeEntries();
+
+    // 原先的布局：每次排序前按ID打乱，与TitleTable的起始顺序相同 (Former layout: scrambled by id before each sort, the same starting order as TitleTable)
+    auto entries = source;
+    Timing vector_size;
+    Timing vector_name;
+    Timing vector_pass;
+    std::size_t vector_sum = 0;
+    for (int run = 0; run < RUNS; run++) {
+        std::ranges::sort(entries, {}, &AppEntry::id);
+        auto start = Clock::now();
+        std::ranges::sort(entries, std::ranges::greater{}, &AppEntry::size_total);
+        vector_size.Add(MicrosecondsSince(start));
+
+        std::ranges::sort(entries, {}, &AppEntry::id);
+        start = Clock::now();
+        std::ranges::sort(entries, {}, &AppEntry::name);
+        vector_name.Add(MicrosecondsSince(start));
+
+        start = Clock::now();
+        vector_sum = 0;
+        for (const auto& entry : entries) {
+            vector_sum += entry.size_total;
+        }
+        vector_pass.Add(MicrosecondsSince(start));
+    }
+
+    TitleTable table;
+    table.SetCollation(CollationLocale::ROOT);
+    table.Reset(source.size());
+    auto start = Clock::now();
+    for (auto entry : source) {
+        table.Append(std::move(entry));
+    }
+    const double fill_us = MicrosecondsSince(start);
+
+    Timing table_size;
+    Timing table_name;
+    Timing table_pass;
+    std::size_t table_sum = 0;
+    for (int run = 0; run < RUNS; run++) {
+        table.Sort(TitleTable::SortKey::ID, false);
+        start = Clock::now();
+        table.Sort(TitleTable::SortKey::SIZE, true);
+        table_size.Add(MicrosecondsSince(start));
+
+        table.Sort(TitleTable::SortKey::ID, false);
+        start = Clock::now();
+        table.Sort(TitleTable::SortKey::NAME, false);
+        table_name.Add(MicrosecondsSince(start));
+
+        start = Clock::now();
+        table_sum = 0;
+        for (std::size_t row = 0; row < table.Size(); row++) {
+            table_sum += table.SizeTotal(row);
+        }
+        table_pass.Add(MicrosecondsSince(start));
+    }
+
+    std::printf("%zu titles, %zu byte icons (TitleTable filled in %.1f us)\n", TITLES, ICON_BYTES, fill_us);
+    Report("sort by size", vector_size, table_size);
+    Report("sort by name", vector_name, table_name);
+    Report("size pass", vector_pass, table_pass);
+
+    // 两种布局的大小排序结果必须一致 (Both layouts must agree on the size order)
+    table.Sort(TitleTable::SortKey::SIZE, true);
+    std::ranges::stable_sort(entries, std::ranges::greater{}, &AppEntry::size_total);
+    bool same = table.Size() == entries.size() && table_sum == vector_sum;
+    for (std::size_t row = 0; same && row < entries.size(); row++) {
+        same = table.SizeTotal(row) == entries[row].size_total;
+    }
+    if (!same) {
+        std::printf("FAILED: TitleTable and vector<AppEntry> disagree\n");
+        return 1;
+    }
+    return 0;
+}
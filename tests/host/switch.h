@@ -0,0 +1,160 @@
+// 主机端构建使用的最小libnx替代头文件，只提供被测源文件用到的类型和函数
+// Minimal libnx stand-in for host builds, providing only the types and calls the sources under test use
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <thread>
+
+typedef std::uint8_t u8;
+typedef std::uint16_t u16;
+typedef std::uint32_t u32;
+typedef std::uint64_t u64;
+typedef std::int8_t s8;
+typedef std::int16_t s16;
+typedef std::int32_t s32;
+typedef std::int64_t s64;
+typedef u32 Result;
+typedef u32 Handle;
+
+#define BIT(n) (1U << (n))
+#define MAKERESULT(module, description) ((((module) & 0x1FF)) | ((description) & 0x1FFF) << 9)
+#define R_SUCCEEDED(res) ((res) == 0)
+#define R_FAILED(res) ((res) != 0)
+#define CUR_THREAD_HANDLE 0xFFFF8000
+
+// 与libnx的布局一致 (Same layouts as libnx)
+typedef struct {
+    u64 application_id;
+    u8 type;
+    u8 unk_x09;
+    u8 unk_x0A[6];
+    u8 unk_x10;
+    u8 unk_x11[7];
+} NsApplicationRecord;
+
+typedef struct {
+    char name[0x200];
+    char author[0x100];
+} NacpLanguageEntry;
+
+typedef struct {
+    NacpLanguageEntry lang[16];
+    u8 unk_x3000[0x60];
+    char display_version[0x10];
+    u8 unk_x3070[0xF90];
+} NacpStruct;
+
+typedef struct {
+    NacpStruct nacp;
+    u8 icon[0x20000];
+} NsApplicationControlData;
+
+typedef struct {
+    u8 unk_x0[0x80];
+} NsApplicationOccupiedSize;
+
+typedef enum {
+    NcmStorageId_None = 0,
+    NcmStorageId_Host = 1,
+    NcmStorageId_GameCard = 2,
+    NcmStorageId_BuiltInSystem = 3,
+    NcmStorageId_BuiltInUser = 4,
+    NcmStorageId_SdCard = 5,
+    NcmStorageId_Any = 6,
+} NcmStorageId;
+
+// 0表示让出CPU，与系统调用一致 (0 yields, like the system call)
+inline void svcSleepThread(s64 nano) {
+    if (nano <= 0) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::nanoseconds{nano});
+    }
+}
+
+// 系统计时器与硬件一样为19.2MHz，主机上由steady_clock换算 (The system counter runs at 19.2 MHz like the hardware, derived from steady_clock on the host)
+inline u64 armNsToTicks(u64 ns) {
+    return (ns * 12) / 625;
+}
+
+inline u64 armTicksToNs(u64 tick) {
+    return (tick * 625) / 12;
+}
+
+inline u64 hostNowNs() {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline u64 armGetSystemTick() {
+    return armNsToTicks(hostNowNs());
+}
+
+// 主机上模拟60Hz的显示器：从第一次调用起每16.667ms一次垂直同步 (A simulated 60 Hz display on the host: a vsync every 16.667 ms from the first call)
+constexpr u64 HOST_VSYNC_NS = 16666667;
+
+inline u64 hostVsyncBaseNs() {
+    static const u64 base = hostNowNs();
+    return base;
+}
+
+// 不晚于ns的最后一次垂直同步 (The last vsync at or before ns)
+inline u64 hostLastVsyncNs(u64 ns) {
+    const u64 base = hostVsyncBaseNs();
+    return ns <= base ? base : base + (ns - base) / HOST_VSYNC_NS * HOST_VSYNC_NS;
+}
+
+// 不早于ns的第一次垂直同步 (The first vsync at or after ns)
+inline u64 hostNextVsyncNs(u64 ns) {
+    const u64 last = hostLastVsyncNs(ns);
+    return last == ns || ns <= hostVsyncBaseNs() ? last : last + HOST_VSYNC_NS;
+}
+
+typedef struct {
+    u32 id;
+} ViDisplay;
+
+// 自动清除的事件，只支持垂直同步：记录最后一次被消费的垂直同步 (An auto-clearing event for vsync only, remembering the last vsync consumed)
+typedef struct {
+    u64 consumed_ns;
+} Event;
+
+inline Result viOpenDefaultDisplay(ViDisplay* display) {
+    display->id = 0;
+    return 0;
+}
+
+inline Result viGetDisplayVsyncEvent(ViDisplay*, Event* event) {
+    event->consumed_ns = hostLastVsyncNs(hostNowNs());
+    return 0;
+}
+
+// 上次等待后错过的垂直同步保持触发状态，立即返回；主机上的等待不会超时 (A vsync missed since the last wait stays signaled and returns at once; host waits never time out)
+inline Result eventWait(Event* event, u64) {
+    const u64 now = hostNowNs();
+    const u64 last = hostLastVsyncNs(now);
+    if (last > event->consumed_ns) {
+        event->consumed_ns = last;
+        return 0;
+    }
+    event->consumed_ns = last + HOST_VSYNC_NS;
+    std::this_thread::sleep_for(std::chrono::nanoseconds{event->consumed_ns - now});
+    return 0;
+}
+
+inline Result eventClear(Event* event) {
+    event->consumed_ns = hostLastVsyncNs(hostNowNs());
+    return 0;
+}
+
+inline void eventClose(Event*) {
+}
+
+inline void viCloseDisplay(ViDisplay*) {
+}
+
+// 主机上不绑定核心 (No core pinning on the host)
+inline Result svcSetThreadCoreMask(Handle, s32, u32) {
+    return 0;
+}
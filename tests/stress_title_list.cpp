@@ -0,0 +1,227 @@
+// 应用列表发布的压力测试：两个扫描线程按批次加入应用并只标记修改，一个删除线程移除应用、立即发布并通过SpscChannel报告进度，
+// 渲染线程以60 FPS发布积累的修改、取得视图、检查一致性并读取删除进度，同时记录取得视图的耗时和发布次数
+// Title list publishing stress test: two scan threads add titles in batches and only mark the change, a delete thread
+// removes titles, publishes right away and reports progress through an SpscChannel, and the render thread publishes the
+// accumulated changes, acquires views at 60 FPS, checks them and drains the progress channel, timing how long acquiring
+// a view takes and counting the publishes
+#include "title_list_view.hpp"
+#include "coro.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t SCAN_THREADS = 2;
+constexpr std::size_t TITLES_PER_SCAN_THREAD = 2000;
+constexpr std::size_t SCAN_BATCH = 8;
+constexpr std::size_t DELETES = 1000;
+
+struct DeleteResult {
+    u64 app_id;
+};
+
+// 与App相同：写入方持有互斥锁修改列表，并在锁内发布，因此发布序号单调递增；扫描只标记修改，由渲染线程每帧最多发布一次
+// Same as App: writers change the list under a mutex and publish while holding it, so publish serials only go up; scans only
+// mark the change and the render thread publishes it at most once a frame
+struct Model {
+    std::mutex mutex;
+    std::vector<TitleRow> rows;
+    u64 version{};
+    TitleListPublisher publisher;
+    std::atomic<std::size_t> scans_done{};
+    std::atomic<bool> dirty{};
+    std::size_t flushes{};  // mutex locked, 渲染线程发布的次数 (Publishes made by the render thread)
+
+    void PublishLocked() {
+        dirty.store(false, std::memory_order_relaxed);
+        auto view = std::make_shared<TitleListView>();
+        view->version = ++version;
+        view->rows = rows;
+        for (std::size_t i = 0; i < rows.size(); i++) {
+            if (rows[i].selected) {
+                view->selected_indices.push_back(i);
+                view->selected_nand += rows[i].size_nand;
+                view->selected_sd += rows[i].size_sd;
+            }
+        }
+        view->index.Rebuild(view->rows, [](const TitleRow& row) { return row.id; });
+        publisher.Publish(std::move(view));
+    }
+
+    // 与App::FlushTitleList相同：写入方持有锁时留到下一帧 (Same as App::FlushTitleList: left for the next frame while a writer holds the lock)
+    void Flush() {
+        if (!dirty.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::unique_lock lock{mutex, std::try_to_lock};
+        if (lock.owns_lock()) {
+            PublishLocked();
+            flushes++;
+        }
+    }
+};
+
+TitleRow MakeRow(u64 id) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "Title %016llX", static_cast<unsigned long long>(id));
+    const std::size_t size_nand = (id % 13) * 1024 * 1024;
+    const std::size_t size_sd = (id % 7) * 1024 * 1024;
+    return TitleRow{id, name, size_nand, size_sd, size_nand + size_sd, id % 7 == 0};
+}
+
+void ScanThread(Model& model, std::size_t thread_index) {
+    const u64 base = 0x0100000000000000ULL + thread_index * 0x100000000ULL;
+    for (std::size_t i = 0; i < TITLES_PER_SCAN_THREAD; i += SCAN_BATCH) {
+        {
+            std::scoped_lock lock{model.mutex};
+            for (std::size_t j = i; j < std::min(i + SCAN_BATCH, TITLES_PER_SCAN_THREAD); j++) {
+                model.rows.push_back(MakeRow(base + (j + 1) * 0x1000));
+            }
+            model.dirty.store(true, std::memory_order_release);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    }
+    model.scans_done.fetch_add(1, std::memory_order_release);
+}
+
+// 与删除协程相同：先从列表移除并发布，再把结果放入通道，通道满时让出直到渲染线程读取
+// Same as the deletion coroutine: remove from the list and publish first, then post the result, yielding while the channel is full
+void DeleteThread(Model& model, util::SpscChannel<DeleteResult, 64>& channel) {
+    std::size_t deleted = 0;
+    while (deleted < DELETES) {
+        DeleteResult result{};
+        {
+            std::scoped_lock lock{model.mutex};
+            if (model.rows.empty()) {
+                result.app_id = 0;
+            } else {
+                // 删除中间的应用，迫使后续行的下标移动 (Delete from the middle so the rows after it shift)
+                const auto it = model.rows.begin() + static_cast<std::ptrdiff_t>(model.rows.size() / 2);
+                result.app_id = it->id;
+                model.rows.erase(it);
+                model.PublishLocked();
+            }
+        }
+        if (!result.app_id) {
+            std::this_thread::yield();
+            continue;
+        }
+        while (!channel.try_push(result)) {
+            std::this_thread::yield();
+        }
+        deleted++;
+        std::this_thread::sleep_for(std::chrono::microseconds{500});
+    }
+    channel.close(true);
+}
+
+// 检查视图内部一致，返回false表示损坏 (Check that a view is self-consistent, false means it is torn)
+bool CheckView(const TitleListView& view) {
+    if (view.index.Size() != view.rows.size()) {
+        return false;
+    }
+    std::size_t selected = 0;
+    std::size_t selected_nand = 0;
+    std::size_t selected_sd = 0;
+    for (std::size_t i = 0; i < view.rows.size(); i++) {
+        const auto& row = view.rows[i];
+        if (view.index.Find(row.id) != i || row.size_total != row.size_nand + row.size_sd) {
+            return false;
+        }
+        if (row.selected) {
+            if (selected >= view.selected_indices.size() || view.selected_indices[selected] != i) {
+                return false;
+            }
+            selected++;
+            selected_nand += row.size_nand;
+            selected_sd += row.size_sd;
+        }
+    }
+    return selected == view.selected_indices.size() && selected_nand == view.selected_nand && selected_sd == view.selected_sd;
+}
+
+} // namespace
+
+int main() {
+    Model model;
+    util::SpscChannel<DeleteResult, 64> channel;
+
+    std::vector<std::jthread> writers;
+    for (std::size_t i = 0; i < SCAN_THREADS; i++) {
+        writers.emplace_back([&model, i] { ScanThread(model, i); });
+    }
+    writers.emplace_back([&model, &channel] { DeleteThread(model, channel); });
+
+    // 渲染线程：每帧取得视图并读取删除进度，不持有任何锁 (Render thread: acquire the view and drain progress every frame, holding no lock)
+    constexpr auto frame_time = std::chrono::microseconds{16667};
+    auto next_frame = Clock::now();
+    u64 last_version = 0;
+    std::size_t frames = 0;
+    std::size_t drained = 0;
+    std::size_t failures = 0;
+    std::chrono::nanoseconds acquire_total{};
+    std::chrono::nanoseconds acquire_max{};
+    std::vector<u64> deleted_ids;
+
+    for (bool closed = false; !closed;) {
+        closed = channel.is_closed() && model.scans_done.load(std::memory_order_acquire) == SCAN_THREADS;
+
+        deleted_ids.clear();
+        drained += channel.drain([&deleted_ids](const DeleteResult& result) { deleted_ids.push_back(result.app_id); });
+
+        model.Flush();
+        const auto start = Clock::now();
+        const auto view = model.publisher.Acquire();
+        const auto acquire = Clock::now() - start;
+        acquire_total += acquire;
+        acquire_max = std::max<std::chrono::nanoseconds>(acquire_max, acquire);
+        frames++;
+
+        if (view->version < last_version || !CheckView(*view)) {
+            failures++;
+        }
+        last_version = view->version;
+
+        // 删除在放入通道之前已发布，之后取得的视图不能再包含这些应用 (Deletes are published before they are posted, so a later view never holds them)
+        for (const auto id : deleted_ids) {
+            if (view->index.Contains(id)) {
+                failures++;
+            }
+        }
+
+        next_frame += frame_time;
+        std::this_thread::sleep_until(next_frame);
+    }
+    writers.clear();
+
+    const auto final_view = model.publisher.Acquire();
+    const std::size_t expected_rows = SCAN_THREADS * TITLES_PER_SCAN_THREAD - DELETES;
+    std::printf("  %zu frames, %zu deletes drained, final view v%llu with %zu rows\n",
+        frames, drained, static_cast<unsigned long long>(final_view->version), final_view->rows.size());
+    std::printf("  acquire: avg %.0f ns, max %.0f ns\n",
+        static_cast<double>(acquire_total.count()) / static_cast<double>(frames), static_cast<double>(acquire_max.count()));
+    // 扫描批次不再各自发布整张表 (Scan batches no longer publish the whole table each)
+    constexpr std::size_t scan_batches = SCAN_THREADS * ((TITLES_PER_SCAN_THREAD + SCAN_BATCH - 1) / SCAN_BATCH);
+    std::printf("  %zu scan batches published by %zu frame flushes\n", scan_batches, model.flushes);
+    if (model.flushes > frames) {
+        std::printf("FAILED: %zu flushes in %zu frames\n", model.flushes, frames);
+        return 1;
+    }
+
+    if (failures || drained != DELETES || !channel.is_completed() || final_view->rows.size() != expected_rows || !CheckView(*final_view)) {
+        std::printf("FAILED: %zu inconsistent frames, %zu/%zu deletes, %zu/%zu rows\n",
+            failures, drained, DELETES, final_view->rows.size(), expected_rows);
+        return 1;
+    }
+    return 0;
+}
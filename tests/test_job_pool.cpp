@@ -0,0 +1,151 @@
+// 专用线程池测试：扫描和删除在专用线程池上长时间阻塞时，共享线程池上的图标解码任务仍能及时运行
+// Job pool test: while a scan and a deletion block for a long time on the job pool, icon decode tasks on the shared
+// pool still run promptly
+#include "app_entry.hpp"
+#include "app_scanner.hpp"
+#include "async.hpp"
+#include "title_service_mock.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t TITLES = 200;
+constexpr std::size_t DECODES = 64;
+// 解码任务从提交到开始运行的上限，远小于一次扫描 (Upper bound from submitting a decode to it starting, far below one scan)
+constexpr auto DECODE_DEADLINE = std::chrono::milliseconds{50};
+
+std::vector<u64> ListIds(TitleService& service) {
+    std::vector<u64> ids;
+    std::array<NsApplicationRecord, 30> page;
+    s32 count = 0;
+    s32 offset = 0;
+    do {
+        if (R_FAILED(service.ListApplicationRecords(page.data(), static_cast<s32>(page.size()), offset, &count))) {
+            break;
+        }
+        for (s32 i = 0; i < count; i++) {
+            ids.push_back(page[i].application_id);
+        }
+        offset += count;
+    } while (count > 0);
+    return ids;
+}
+
+// 与App::FastScanNames相同：名称阶段之后是大小计算，都在任务内部创建并等待自己的工作线程
+// Same as App::FastScanNames: a name phase then a size pass, each starting and joining its own workers inside the job
+void Scan(std::stop_token stop_token, MockTitleService& service, const std::vector<u64>& ids, std::atomic<bool>& running) {
+    AppScanner scanner{ScanConfig{}};
+    std::vector<u64> pending;
+    scanner.Run(stop_token, ids,
+        [&service](u64 application_id, AppEntry& entry) {
+            auto control = std::make_unique<NsApplicationControlData>();
+            u64 size = 0;
+            entry.id = application_id;
+            return R_SUCCEEDED(service.GetApplicationControlData(application_id, control.get(), &size));
+        },
+        [](u64, AppEntry&) {},
+        [&pending](std::vector<AppEntry>&& batch) {
+            for (const auto& entry : batch) {
+                pending.push_back(entry.id);
+            }
+        });
+
+    std::mutex mutex;
+    scanner.RunSizePass(stop_token,
+        [&mutex, &pending](u64& application_id) {
+            std::scoped_lock lock{mutex};
+            if (pending.empty()) {
+                return false;
+            }
+            application_id = pending.back();
+            pending.pop_back();
+            return true;
+        },
+        [&service](u64 application_id, AppEntry&) {
+            ApplicationOccupiedSize size{};
+            service.CalculateApplicationOccupiedSize(application_id, &size);
+        },
+        [](std::vector<AppEntry>&&) {});
+    running = false;
+}
+
+} // namespace
+
+int main() {
+    MockTitleServiceConfig config{};
+    config.title_count = TITLES;
+    config.latency = MockLatencyProfile::Typical();
+    MockTitleService service{config};
+    const auto ids = ListIds(service);
+
+    // 与App相同：共享线程池给解码，两个工作线程的专用线程池给扫描和删除 (Same as App: the shared pool decodes, a two-worker job pool scans and deletes)
+    util::ThreadPool shared{util::ThreadPoolConfig{.worker_count = 4}};
+    util::ThreadPool jobs{util::ThreadPoolConfig{.worker_count = 2}};
+
+    std::atomic<bool> scanning{true};
+    std::atomic<bool> deleting{true};
+    const auto scan_start = Clock::now();
+    auto scan = util::async(jobs, [&]() { Scan(std::stop_token{}, service, ids, scanning); });
+    auto uninstall = util::async(jobs, [&]() {
+        for (std::size_t i = 0; i < 4; i++) {
+            service.DeleteApplicationCompletely(ids[i]);
+        }
+        deleting = false;
+    });
+
+    // 扫描期间陆续提交解码任务，记录每个任务等待的时间 (Submit decodes while the scan runs, recording how long each one waited)
+    std::vector<std::future<Clock::duration>> decodes;
+    decodes.reserve(DECODES);
+    std::size_t during_scan = 0;
+    for (std::size_t i = 0; i < DECODES; i++) {
+        const auto submitted = Clock::now();
+        decodes.emplace_back(util::submit_task<Clock::duration>(shared, [submitted]() {
+            const auto waited = Clock::now() - submitted;
+            volatile std::size_t sum = 0;
+            for (std::size_t n = 0; n < 20000; n++) {
+                sum = sum + n;
+            }
+            return waited;
+        }));
+        during_scan += scanning.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    }
+
+    Clock::duration worst{};
+    for (auto& decode : decodes) {
+        worst = std::max(worst, decode.get());
+    }
+    const bool overlapped = scanning.load() && deleting.load();
+    scan.get();
+    uninstall.get();
+    const auto scan_ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - scan_start).count();
+    const auto worst_us = std::chrono::duration_cast<std::chrono::microseconds>(worst).count();
+    std::printf("  scan %lld ms, %zu of %zu decodes submitted during it, worst decode wait %lld us\n",
+        static_cast<long long>(scan_ms), during_scan, DECODES, static_cast<long long>(worst_us));
+
+    // 解码必须在扫描和删除都还在运行时完成，否则测试没有覆盖并发的情况 (Decodes must finish while the scan and deletion still run, or the test didn't cover the overlap)
+    if (!overlapped || during_scan != DECODES) {
+        std::printf("FAILED: the scan finished before the decodes, nothing overlapped\n");
+        return 1;
+    }
+    if (worst > DECODE_DEADLINE) {
+        std::printf("FAILED: a decode waited longer than %lld ms\n", static_cast<long long>(DECODE_DEADLINE.count()));
+        return 1;
+    }
+    return 0;
+}
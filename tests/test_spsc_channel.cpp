@@ -0,0 +1,120 @@
+// SpscChannel测试：生产者协程在通道满时挂起，由消费者取出结果后恢复，不忙等；请求停止时无需轮询即可等到协程结束
+// SpscChannel test: a producer coroutine suspends on a full channel and is resumed by the consumer's drain, never
+// busy-waiting; a stop request lets the caller wait for the coroutine to finish without polling
+// GCC 12的std::stop_source构造函数在内联进util::spawn时会误报未初始化 (GCC 12 falsely reports std::stop_source's constructor as uninitialized once inlined into util::spawn)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <stop_token>
+#pragma GCC diagnostic pop
+
+#include "coro.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t VALUES = 20000;
+constexpr std::size_t CAPACITY = 8;
+
+using Channel = util::SpscChannel<std::size_t, CAPACITY>;
+
+struct Producer {
+    std::size_t pushed{};
+    std::size_t waits{};    // 通道满时挂起的次数 (Times it suspended on a full channel)
+    bool stopped{};
+};
+
+// 与App的删除协程相同的推送循环；count为0时一直推送直到停止 (The same push loop as App's deletion coroutine; count 0 pushes until stopped)
+util::Task<void> Produce(std::stop_token stop_token, Channel& channel, util::ThreadPool& pool, Producer& producer, std::size_t count) {
+    for (std::size_t value = 0; !count || value < count; value++) {
+        while (!channel.try_push(value)) {
+            producer.waits++;
+            if (!co_await channel.wait_for_space(pool, stop_token)) {
+                producer.stopped = true;
+                break;
+            }
+        }
+        if (producer.stopped) {
+            break;
+        }
+        producer.pushed++;
+    }
+    channel.close(!producer.stopped);
+}
+
+// 消费者按帧间隔取出结果，检查顺序和数量 (The consumer drains at frame-like intervals and checks order and count)
+bool TestBackpressure(util::ThreadPool& pool) {
+    Channel channel;
+    Producer producer;
+    auto task = util::spawn(pool, [&](std::stop_token token) { return Produce(std::move(token), channel, pool, producer, VALUES); });
+
+    std::size_t expected = 0;
+    std::size_t drains = 0;
+    bool in_order = true;
+    const auto start = Clock::now();
+    while (!channel.is_closed() || expected < VALUES) {
+        drains += channel.drain([&](const std::size_t& value) { in_order &= value == expected++; }) > 0;
+        std::this_thread::sleep_for(std::chrono::microseconds{20});
+    }
+    task.get();
+    channel.drain([&](const std::size_t& value) { in_order &= value == expected++; });
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::printf("  %zu values through %zu slots in %.1f ms, %zu drains, %zu producer waits\n",
+        expected, CAPACITY, ms, drains, producer.waits);
+    bool ok = true;
+    if (!in_order || expected != VALUES || producer.pushed != VALUES || !channel.is_completed()) {
+        std::printf("  values lost or out of order\n");
+        ok = false;
+    }
+    // 每次挂起都需要一次取出才能恢复，忙等会让等待次数远超取出次数 (Every suspension needs a drain to resume it, busy-waiting would push waits far past drains)
+    if (producer.waits > drains) {
+        std::printf("  producer waited %zu times for %zu drains\n", producer.waits, drains);
+        ok = false;
+    }
+    return ok;
+}
+
+// 通道已满且无人取出时请求停止，future直接完成 (Stop with a full channel nobody drains, the future completes by itself)
+bool TestStop(util::ThreadPool& pool) {
+    Channel channel;
+    Producer producer;
+    auto task = util::spawn(pool, [&](std::stop_token token) { return Produce(std::move(token), channel, pool, producer, 0); });
+    // 给生产者时间填满通道并挂起，计数在get之后才读取 (Give the producer time to fill the channel and suspend, the counters are only read after get)
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+    const auto start = Clock::now();
+    task.request_stop();
+    task.get();
+    const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    std::printf("  stop with a full channel: finished in %.1f us, %zu waits\n", us, producer.waits);
+    bool ok = true;
+    if (!producer.stopped || !channel.is_closed() || channel.is_completed() || producer.pushed != CAPACITY) {
+        std::printf("  producer did not stop cleanly\n");
+        ok = false;
+    }
+    // 没有取出时只会挂起一次 (Without a drain it suspends exactly once)
+    if (producer.waits != 1) {
+        std::printf("  producer woke %zu times with nothing drained\n", producer.waits);
+        ok = false;
+    }
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    util::ThreadPool pool{util::ThreadPoolConfig{.worker_count = 2}};
+    bool ok = TestBackpressure(pool);
+    ok &= TestStop(pool);
+    if (!ok) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
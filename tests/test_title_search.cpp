@@ -0,0 +1,149 @@
+// 发行商搜索测试：从模拟应用信息服务读取NACP，按App的方式填入TitleTable并建立搜索索引，检查按发行商能找到每个应用，
+// 以及一两个码位的查询与逐个比较文本得到的排序相同
+// Publisher search test: reads NACPs from the mock title service, fills a TitleTable and builds the search index the
+// way App does, and checks that every title is found by its publisher and that one and two code point queries rank
+// the same as comparing the text title by title
+#include "app_entry.hpp"
+#include "title_search.hpp"
+#include "title_service_mock.hpp"
+#include "title_table.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+constexpr std::size_t TITLES = 300;
+
+bool Contains(const std::vector<u64>& ids, u64 id) {
+    return std::ranges::find(ids, id) != ids.end();
+}
+
+// 短查询的参考结果：名称开头、词首、名称中间、发行商，同等级按名称长度，再按加入顺序
+// (Reference results for a short query: name start, word start, inside the name, publisher, then name length, then insertion order)
+std::vector<u64> ShortQueryReference(const TitleTable& table, const std::u32string& query) {
+    struct Hit {
+        int rank;
+        std::size_t length;
+        std::size_t row;
+    };
+    std::vector<Hit> hits;
+    for (std::size_t row = 0; row < table.Size(); row++) {
+        const auto name = TitleSearchIndex::Normalize(table.Name(row));
+        const auto author = TitleSearchIndex::Normalize(table.Author(row));
+        int rank = -1;
+        for (auto pos = name.find(query); pos != std::u32string::npos; pos = name.find(query, pos + 1)) {
+            const int here = pos == 0 ? 0 : name[pos - 1] == U' ' ? 1 : 2;
+            rank = rank < 0 ? here : std::min(rank, here);
+        }
+        if (rank < 0 && author.find(query) != std::u32string::npos) {
+            rank = 3;
+        }
+        if (rank >= 0) {
+            hits.push_back(Hit{rank, name.size(), row});
+        }
+    }
+    std::ranges::sort(hits, [](const Hit& a, const Hit& b) {
+        return std::tie(a.rank, a.length, a.row) < std::tie(b.rank, b.length, b.row);
+    });
+    std::vector<u64> ids;
+    for (const auto& hit : hits) {
+        ids.push_back(table.Id(hit.row));
+    }
+    return ids;
+}
+
+} // namespace
+
+int main() {
+    MockTitleServiceConfig config{};
+    config.title_count = TITLES;
+    MockTitleService service{config};
+
+    std::vector<u64> app_ids;
+    std::array<NsApplicationRecord, 30> page;
+    s32 count = 0;
+    s32 offset = 0;
+    do {
+        if (R_FAILED(service.ListApplicationRecords(page.data(), static_cast<s32>(page.size()), offset, &count))) {
+            std::printf("FAILED: list records\n");
+            return 1;
+        }
+        for (s32 i = 0; i < count; i++) {
+            app_ids.push_back(page[i].application_id);
+        }
+        offset += count;
+    } while (count > 0);
+
+    // 与App::TryGetAppBasicInfoWithIconCache的NS路径相同 (Same as the NS path of App::TryGetAppBasicInfoWithIconCache)
+    TitleTable table;
+    table.SetCollation(CollationLocale::ROOT);
+    std::map<std::string, std::vector<u64>> by_publisher;
+    auto control = std::make_unique<NsApplicationControlData>();
+    for (const auto id : app_ids) {
+        u64 size = 0;
+        if (R_FAILED(service.GetApplicationControlData(id, control.get(), &size))) {
+            std::printf("FAILED: control data for %016llX\n", static_cast<unsigned long long>(id));
+            return 1;
+        }
+        AppEntry entry{};
+        ReadNacpText(control->nacp, 0, entry);
+        entry.id = id;
+        if (entry.author.empty() || entry.display_version.empty()) {
+            std::printf("FAILED: %016llX has no publisher or version\n", static_cast<unsigned long long>(id));
+            return 1;
+        }
+        by_publisher[entry.author].push_back(id);
+        table.Append(std::move(entry));
+    }
+
+    TitleSearchIndex index;
+    index.Build(table);
+
+    // 模拟服务的名称不包含发行商，命中只能来自发行商 (Mock names never contain the publisher, so hits can only come from it)
+    bool ok = by_publisher.size() > 1;
+    for (const auto& [publisher, ids] : by_publisher) {
+        const auto& hits = index.Search(publisher);
+        const auto missing = std::ranges::count_if(ids, [&hits](u64 id) { return !Contains(hits, id); });
+        if (missing) {
+            std::printf("  \"%s\": %zu of %zu titles missing\n", publisher.c_str(), static_cast<std::size_t>(missing), ids.size());
+            ok = false;
+        }
+    }
+    const auto& all = index.Search("mock publisher");
+    if (all.size() != app_ids.size()) {
+        std::printf("  \"mock publisher\" found %zu of %zu titles\n", all.size(), app_ids.size());
+        ok = false;
+    }
+
+    // 单字和双字列表带的等级必须与逐个比较一致，包括先输入再退格的情况
+    // (The ranks carried by the unigram and bigram lists must match a title-by-title comparison, typed fresh or backspaced to)
+    std::size_t short_queries = 0;
+    for (const char* query : {"m", "mo", "o", "ck", "t", "ti", "1", "12", "e", " p", "zz"}) {
+        const auto expected = ShortQueryReference(table, TitleSearchIndex::Normalize(query));
+        index.Search({});
+        const auto fresh = index.Search(query);
+        index.Search(std::string{query} + "x");
+        const auto& backspaced = index.Search(query);
+        if (fresh != expected || backspaced != expected) {
+            std::printf("  \"%s\": %zu hits, expected %zu in reference order\n", query, fresh.size(), expected.size());
+            ok = false;
+        }
+        short_queries++;
+    }
+    std::printf("  %zu titles, %zu publishers, %zu short queries\n", app_ids.size(), by_publisher.size(), short_queries);
+
+    if (!ok) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+// TitleTable测试：按发行商排序，名次随排序键更新，过滤时可见行的选中数
+// (TitleTable tests: sorting by publisher, ranks following key changes, selected visible rows while filtered)
+#include "app_entry.hpp"
+#include "title_table.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace tj;
+
+namespace {
+
+std::size_t g_failures = 0;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::printf("  failed: %s\n", what);
+        g_failures++;
+    }
+}
+
+AppEntry MakeEntry(u64 id, const char* name, const char* author) {
+    AppEntry entry{};
+    entry.id = id;
+    entry.name = name;
+    entry.author = author;
+    entry.size_nand = id * 1024;
+    entry.size_sd = 0;
+    entry.size_total = entry.size_nand;
+    return entry;
+}
+
+std::vector<u64> Order(const TitleTable& table) {
+    std::vector<u64> ids;
+    for (std::size_t row = 0; row < table.Size(); row++) {
+        ids.push_back(table.Id(row));
+    }
+    return ids;
+}
+
+// 发行商顺序与名称顺序相反，排序结果只能来自发行商 (Publishers run opposite to the names, so the order can only come from the publisher)
+void TestSortByAuthor() {
+    TitleTable table;
+    table.SetCollation(CollationLocale::ROOT);
+    table.Append(MakeEntry(0x1000, "Alpha", "Zeta Games"));
+    table.Append(MakeEntry(0x2000, "Bravo", "Yellow Soft"));
+    table.Append(MakeEntry(0x3000, "Charlie", "Éditions Lumière"));    // 重音不影响字母顺序 (Accents don't change the letter order)
+    table.Append(MakeEntry(0x4000, "Delta", "acme"));                  // 大小写不影响 (Case doesn't matter)
+    table.Append(MakeEntry(0x5000, "Echo", "Yellow Soft"));            // 同一发行商按名称 (Same publisher falls back to the name)
+
+    table.Sort(TitleTable::SortKey::AUTHOR, false);
+    Check(Order(table) == std::vector<u64>{0x4000, 0x3000, 0x2000, 0x5000, 0x1000}, "author A-Z");
+
+    table.Sort(TitleTable::SortKey::AUTHOR, true);
+    Check(Order(table) == std::vector<u64>{0x1000, 0x2000, 0x5000, 0x3000, 0x4000}, "author Z-A, ties stay ascending by name");
+
+    table.Sort(TitleTable::SortKey::NAME, false);
+    Check(Order(table) == std::vector<u64>{0x1000, 0x2000, 0x3000, 0x4000, 0x5000}, "name A-Z differs from author order");
+
+    // 排序后追加的应用插入到发行商顺序中 (Titles appended after the sort land in publisher order)
+    table.Sort(TitleTable::SortKey::AUTHOR, false);
+    table.Append(MakeEntry(0x6000, "Foxtrot", "Bandai"));
+    Check(Order(table) == std::vector<u64>{0x4000, 0x6000, 0x3000, 0x2000, 0x5000, 0x1000}, "append keeps author order");
+}
+
+// 名称排序记下名次后，删除保留名次，替换和追加让名次失效，重新排序后顺序仍然正确
+// (After a name sort records ranks, removal keeps them while replace and append invalidate them, and re-sorting stays correct)
+void TestRanksFollowKeys() {
+    TitleTable table;
+    table.SetCollation(CollationLocale::ROOT);
+    table.Append(MakeEntry(0x1000, "Delta", "Publisher"));
+    table.Append(MakeEntry(0x2000, "Bravo", "Publisher"));
+    table.Append(MakeEntry(0x3000, "Alpha", "Publisher"));
+    table.Append(MakeEntry(0x4000, "Charlie", "Publisher"));
+    table.Sort(TitleTable::SortKey::NAME, true);
+    table.Sort(TitleTable::SortKey::ID, false);
+
+    table.Remove({0x2000});
+    table.Sort(TitleTable::SortKey::NAME, false);
+    Check(Order(table) == std::vector<u64>{0x3000, 0x4000, 0x1000}, "ranks survive a removal");
+
+    // 改名后应用移到新位置，之后的排序按新名称 (A renamed title moves, and later sorts use the new name)
+    table.Replace(MakeEntry(0x1000, "Able", "Publisher"));
+    Check(Order(table) == std::vector<u64>{0x1000, 0x3000, 0x4000}, "replace repositions by the new name");
+    table.Append(MakeEntry(0x5000, "Baker", "Publisher"));
+    table.Sort(TitleTable::SortKey::ID, false);
+    table.Sort(TitleTable::SortKey::NAME, true);
+    Check(Order(table) == std::vector<u64>{0x4000, 0x5000, 0x3000, 0x1000}, "re-sort after replace and append");
+}
+
+// 可见选中数随选中、全选、反选、删除和追加增量维护 (The visible selected count follows select, select-all, invert, remove and append)
+void TestVisibleSelected() {
+    TitleTable table;
+    for (u64 id = 1; id <= 6; id++) {
+        table.Append(MakeEntry(id * 0x1000, "Title", "Publisher"));
+    }
+    table.SetSelected(0, true);     // 0x1000，过滤后隐藏 (Hidden once filtered)
+    table.SetSelected(2, true);     // 0x3000，过滤后可见 (Visible once filtered)
+
+    table.SetFilter({0x2000, 0x3000, 0x4000});
+    Check(table.CountSelected() == 2, "hidden selection still counted in total");
+    Check(table.CountVisibleSelected() == 1, "filter counts only visible selected rows");
+
+    table.SetAllSelected(true);
+    Check(table.CountVisibleSelected() == table.Size(), "select-all fills the visible rows");
+    Check(table.CountSelected() == 4, "select-all leaves hidden rows alone");
+
+    table.SetSelected(1, false);
+    Check(table.CountVisibleSelected() == 2, "deselect one visible row");
+    table.SetSelected(1, false);
+    Check(table.CountVisibleSelected() == 2, "deselecting twice changes nothing");
+
+    table.InvertSelection();
+    Check(table.CountVisibleSelected() == 1 && table.IsSelected(1), "invert flips visible rows only");
+    Check(table.CountSelected() == 2, "invert leaves the hidden selected row");
+
+    table.SetAllSelected(false);
+    Check(table.CountVisibleSelected() == 0 && table.CountSelected() == 1, "deselect-all keeps the hidden selection");
+
+    table.SetSelected(0, true);
+    table.SetSelected(2, true);
+    table.Remove({0x2000, 0x5000});
+    Check(table.Size() == 2 && table.CountVisibleSelected() == 1, "remove drops a visible selected row");
+
+    // 过滤时追加的应用不可见 (Titles appended while filtered are not visible)
+    auto entry = MakeEntry(0x7000, "Title", "Publisher");
+    entry.selected = true;
+    table.Append(std::move(entry));
+    Check(table.CountVisibleSelected() == 1 && table.CountSelected() == 3, "append while filtered stays hidden");
+
+    table.ClearFilter();
+    Check(table.CountVisibleSelected() == table.CountSelected(), "unfiltered count equals the total");
+}
+
+} // namespace
+
+int main() {
+    TestSortByAuthor();
+    TestRanksFollowKeys();
+    TestVisibleSelected();
+    if (g_failures) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}